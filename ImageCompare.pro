@@ -10,6 +10,7 @@ QT          += core gui
 QT          += quickwidgets
 QT          += qml quick
 QT          += widgets
+QT          += network
 
 macx: {
 # Icon
@@ -34,6 +35,26 @@ SOURCES     += src/main.cpp \
             src/preferencesdialog.cpp \
             src/renamefiledialog.cpp \
             src/worker.cpp \
+            src/imagetransformer.cpp \
+            src/filetransfer.cpp \
+            src/imagecache.cpp \
+            src/imagenormalizer.cpp \
+            src/deepcompare.cpp \
+            src/headless.cpp \
+            src/registration.cpp \
+            src/framecompare.cpp \
+            src/resultcache.cpp \
+            src/comparedaemon.cpp \
+            src/sharedimage.cpp \
+            src/mappedimage.cpp \
+            src/decodedcache.cpp \
+            src/blockhash.cpp \
+            src/directorymodel.cpp \
+            src/thumbnailcache.cpp \
+            src/tiledimage.cpp \
+            src/imagescaler.cpp \
+            src/comparemask.cpp \
+            src/masklearner.cpp \
             src/settings.cpp \
             src/utility.cpp \
 
@@ -51,6 +72,26 @@ HEADERS     += src/mainwindow.h \
             src/preferencesdialog.h \
             src/renamefiledialog.h \
             src/worker.h \
+            src/imagetransformer.h \
+            src/filetransfer.h \
+            src/imagecache.h \
+            src/imagenormalizer.h \
+            src/deepcompare.h \
+            src/headless.h \
+            src/registration.h \
+            src/framecompare.h \
+            src/resultcache.h \
+            src/comparedaemon.h \
+            src/sharedimage.h \
+            src/mappedimage.h \
+            src/decodedcache.h \
+            src/blockhash.h \
+            src/directorymodel.h \
+            src/thumbnailcache.h \
+            src/tiledimage.h \
+            src/imagescaler.h \
+            src/comparemask.h \
+            src/masklearner.h \
             src/settings.h \
             src/defaultsettings.h \
             src/utility.h \
@@ -77,9 +118,20 @@ OTHER_FILES += \
 macx: {
 # Libs
 LIBS        += -framework Carbon
+# Include Path For Homebrew/MacPorts libjpeg
+INCLUDEPATH += /usr/local/include
+LIBS        += -L/usr/local/lib
 } else {
 }
 
+# POSIX Shared Memory For Shared Image Inputs
+linux: {
+LIBS        += -lrt
+}
+
+# libjpeg For Lossless JPEG Transforms
+LIBS        += -ljpeg
+
 # Output/Intermediate Dirs
 OBJECTS_DIR = ./objs
 OBJMOC      = ./objs
@@ -60,7 +60,7 @@ Item {
                 var fileName = mainViewController.currentFileLeft
 
                 if (fileName.length > 0) {
-                    return "file://" + fileName;
+                    return "image://imagecache/" + encodeURIComponent(fileName) + "?" + mainViewController.fileRevision + "&frame=" + mainViewController.currentFrame;
                 }
 
                 return "";
@@ -94,8 +94,9 @@ Item {
             Behavior on width { NumberAnimation { duration: Const.defaultAnimDuration } }
             Behavior on height { NumberAnimation { duration: Const.defaultAnimDuration } }
 
-            anchors.horizontalCenterOffset: mainViewController.panPosX
-            anchors.verticalCenterOffset: mainViewController.panPosY
+            // Shift Right Image Onto the Left One By the Estimated Registration Offset
+            anchors.horizontalCenterOffset: mainViewController.panPosX - mainViewController.alignOffsetX * mainViewController.zoomLevel
+            anchors.verticalCenterOffset: mainViewController.panPosY - mainViewController.alignOffsetY * mainViewController.zoomLevel
 
             Behavior on anchors.horizontalCenterOffset { NumberAnimation { duration: mainViewController.manualPanning ? 0 : Const.defaultAnimDuration } }
             Behavior on anchors.verticalCenterOffset { NumberAnimation { duration: mainViewController.manualPanning ? 0 : Const.defaultAnimDuration } }
@@ -113,7 +114,7 @@ Item {
                 var fileName = mainViewController.currentFileRight;
 
                 if (fileName.length > 0) {
-                    return "file://" + fileName;
+                    return "image://imagecache/" + encodeURIComponent(fileName) + "?" + mainViewController.fileRevision + "&frame=" + mainViewController.currentFrame;
                 }
 
                 return "";
@@ -128,6 +129,38 @@ Item {
         }
     }
 
+    Item {
+        id: maskImageContainer
+        anchors.fill: parent
+
+        clip: true
+
+        Image {
+            id: maskImage
+
+            // Mask Is In Left Image Pixels
+            width: leftImage.width
+            height: leftImage.height
+
+            // Mapped Like the CPU Compare - Mask Pixel P Gates Right Pixel P + Align Offset
+            x: rightImage.x + mainViewController.alignOffsetX * mainViewController.zoomLevel
+            y: rightImage.y + mainViewController.alignOffsetY * mainViewController.zoomLevel
+
+            fillMode: Image.Stretch
+            smooth: false
+
+            source: {
+                var fileName = mainViewController.currentFileLeft;
+
+                if (fileName.length > 0 && mainViewController.compareMaskFile.length > 0) {
+                    return "image://comparemask/" + fileName + "?" + mainViewController.fileRevision;
+                }
+
+                return "";
+            }
+        }
+    }
+
     ShaderEffect {
         id: compareShader
         anchors.fill: parent
@@ -148,6 +181,13 @@ Item {
             hideSource: mainViewController.hideSources
         }
 
+        property variant maskImageSource: ShaderEffectSource {
+            sourceItem: maskImageContainer
+            hideSource: true
+        }
+
+        property real maskEnabled: maskImage.status === Image.Ready ? 1.0 : 0.0
+
         property real threshold: mainViewController.threshold
 
         visible: (leftImage.source != "") && (rightImage.source != "")
@@ -155,8 +195,10 @@ Item {
         fragmentShader: "
             uniform sampler2D leftImageSource;
             uniform sampler2D rightImageSource;
+            uniform sampler2D maskImageSource;
             varying highp vec2 qt_TexCoord0;
             uniform float threshold;
+            uniform lowp float maskEnabled;
             void main() {
                 // Just Draw Source
                 //gl_FragColor = texture2D(rightImage, qt_TexCoord0);
@@ -173,7 +215,10 @@ Item {
                 result.b = (abs(leftTexture.b - rightTexture.b) - (threshold * 0.01)) * 10.0;
                 result.a = 0.5;
 
-                gl_FragColor = result;
+                // Suppress Ignored Regions - Mask Alpha Is Zero There
+                lowp float keep = mix(1.0, texture2D(maskImageSource, qt_TexCoord0).a, maskEnabled);
+
+                gl_FragColor = result * keep;
             }
         "
 
@@ -193,6 +238,10 @@ Item {
         currentFileLeft: mainViewController.currentFileLeft
         currentFileRight: mainViewController.currentFileRight
 
+        fileRevision: mainViewController.fileRevision
+
+        currentFrame: mainViewController.currentFrame
+
         zoomLevelIndex: mainViewController.zoomLevelIndex
 
         zoomLevel: mainViewController.zoomLevel
@@ -202,6 +251,8 @@ Item {
 
         showGrid: mainViewController.showGrid
 
+        autoAlign: mainViewController.autoAlign
+
         onStatusChanged: {
             //console.log("compositor.onStatusChanged - status: " + compositor.status + " - operation: " + compositor.operation);
 
@@ -231,6 +282,16 @@ Item {
             // Set Source Composite Height
             compositorViewController.sourceCompositeHeight = aCompositeHeight;
         }
+
+        onAlignOffsetXChanged: {
+            // Set Align Offset X
+            mainViewController.alignOffsetX = aAlignOffsetX;
+        }
+
+        onAlignOffsetYChanged: {
+            // Set Align Offset Y
+            mainViewController.alignOffsetY = aAlignOffsetY;
+        }
     }
 
     ThresholdSlider {
@@ -260,6 +321,23 @@ Item {
             visible: opacity > 0.0
             color: "#77FFFFFF"
         }
+
+        Text {
+            text: compositor.match ? "Visible Part Matches" : "Visible Part Differs"
+            opacity: mainViewController.currentFileLeft != "" && mainViewController.currentFileRight != "" && compositor.status === 0 ? 1.0 : 0.0
+            Behavior on opacity { NumberAnimation { duration: 200 } }
+            visible: opacity > 0.0
+            color: "#77FFFFFF"
+        }
+
+        Text {
+            text: compositor.wholeProgress < 1.0 ? "Checking Whole Image " + Math.round(compositor.wholeProgress * 100) + "%"
+                                                 : (compositor.wholeMatch ? "Whole Image Matches" : "Whole Image Differs")
+            opacity: mainViewController.currentFileLeft != "" && mainViewController.currentFileRight != "" ? 1.0 : 0.0
+            Behavior on opacity { NumberAnimation { duration: 200 } }
+            visible: opacity > 0.0
+            color: "#77FFFFFF"
+        }
     }
 
     Image {
@@ -54,7 +54,7 @@ Item {
             var fileName = sideViewController.side === "left" ? mainViewController.currentFileLeft : mainViewController.currentFileRight;
 
             if (fileName.length > 0) {
-                return "file://" + fileName;
+                return "image://imagecache/" + encodeURIComponent(fileName) + "?" + mainViewController.fileRevision + "&frame=" + mainViewController.currentFrame;
             }
 
             return "";
@@ -0,0 +1,207 @@
+import QtQuick 2.0
+import "js/constants.js" as Const
+
+Item {
+    id: thumbnailStripRoot
+
+    width: 800
+    height: 120
+
+    // Selection Anchor - Last Ctrl Clicked File, Start of Ctrl + Shift Ranges
+    property string selectionAnchor: ""
+
+    // Toggle File Selection
+    function toggleSelection(aFilePath) {
+        // Get Selected Files - Copied, Written Back As a Whole
+        var files = mainViewController.selectedFiles;
+        // Get Index
+        var index = files.indexOf(aFilePath);
+
+        // Check Index
+        if (index >= 0) {
+            // Remove File
+            files.splice(index, 1);
+        } else {
+            // Add File
+            files.push(aFilePath);
+        }
+
+        // Set Selected Files
+        mainViewController.selectedFiles = files;
+        // Set Selection Anchor
+        selectionAnchor = aFilePath;
+    }
+
+    // Select Range From the Selection Anchor
+    function selectRange(aFilePath) {
+        // Get Range Indexes
+        var first = directoryModel.indexOf(selectionAnchor);
+        var last = directoryModel.indexOf(aFilePath);
+
+        // Check Anchor
+        if (first < 0) {
+            // Toggle File Selection
+            toggleSelection(aFilePath);
+            return;
+        }
+
+        // Get Selected Files
+        var files = mainViewController.selectedFiles;
+
+        // Go Thru Range
+        for (var i = Math.min(first, last); i <= Math.max(first, last); i++) {
+            // Get File Path
+            var path = directoryModel.filePath(i);
+            // Check Selected
+            if (files.indexOf(path) < 0) {
+                // Add File
+                files.push(path);
+            }
+        }
+
+        // Set Selected Files
+        mainViewController.selectedFiles = files;
+    }
+
+    Connections {
+        target: mainViewController
+
+        onCurrentFileLeftChanged: {
+            // Get Index
+            var index = directoryModel.indexOf(mainViewController.currentFileLeft);
+            // Check Index
+            if (index >= 0) {
+                // Keep Left File In View
+                thumbnailList.positionViewAtIndex(index, ListView.Contain);
+            }
+        }
+    }
+
+    Rectangle {
+        anchors.fill: parent
+        color: Const.defaultViewBackgroundColor
+    }
+
+    ListView {
+        id: thumbnailList
+        anchors.fill: parent
+        anchors.margins: Const.defaultThumbMargins
+
+        orientation: ListView.Horizontal
+        spacing: Const.defaultThumbSpacing
+
+        // Only Visible Delegates Are Created, Nothing Kept Around Off Screen
+        cacheBuffer: 0
+
+        boundsBehavior: Flickable.StopAtBounds
+        clip: true
+
+        model: directoryModel
+
+        delegate: Rectangle {
+            id: thumbnailDelegate
+
+            width: thumbnailList.height
+            height: thumbnailList.height
+
+            // Selected
+            property bool selected: mainViewController.selectedFiles.indexOf(filePath) >= 0
+
+            color: "transparent"
+
+            border.width: 2
+            border.color: {
+                if (filePath === mainViewController.currentFileLeft) {
+                    return Const.defaultHighlightColorFocused;
+                }
+
+                if (filePath === mainViewController.currentFileRight) {
+                    return Const.defaultHighlightColor;
+                }
+
+                return Const.defaultBorderColor;
+            }
+
+            Image {
+                anchors.fill: parent
+                anchors.margins: parent.border.width
+
+                fillMode: Image.PreserveAspectFit
+
+                // Decoded On the Thumbnail Pool, Held By the Thumbnail Cache Only
+                asynchronous: true
+                cache: false
+
+                sourceSize.width: thumbnailList.height
+                sourceSize.height: thumbnailList.height
+
+                // Encoded - Paths May Contain #, ? Or %
+                source: "image://thumbnail/" + encodeURIComponent(filePath)
+            }
+
+            Text {
+                anchors.left: parent.left
+                anchors.right: parent.right
+                anchors.bottom: parent.bottom
+                anchors.margins: 4
+
+                horizontalAlignment: Text.AlignHCenter
+                elide: Text.ElideMiddle
+
+                color: Const.defaultFontColor
+                style: Text.Outline
+                styleColor: Const.defaultFontShadowColor
+                font.pixelSize: Const.defaultFontSize + 2
+
+                text: fileName
+            }
+
+            Rectangle {
+                anchors.fill: parent
+                anchors.margins: parent.border.width
+
+                color: Const.defaultSelectionColor
+
+                visible: thumbnailDelegate.selected
+            }
+
+            MouseArea {
+                anchors.fill: parent
+
+                acceptedButtons: Qt.LeftButton | Qt.RightButton
+
+                onClicked: {
+                    // Check Modifiers - Ctrl Click Toggles Selection, Ctrl + Shift Click Selects a Range
+                    if (mouse.button === Qt.LeftButton && (mouse.modifiers & Qt.ControlModifier)) {
+                        // Check Shift
+                        if (mouse.modifiers & Qt.ShiftModifier) {
+                            // Select Range
+                            thumbnailStripRoot.selectRange(filePath);
+                        } else {
+                            // Toggle Selection
+                            thumbnailStripRoot.toggleSelection(filePath);
+                        }
+                    } else if (mouse.button === Qt.RightButton || (mouse.modifiers & Qt.ShiftModifier)) {
+                        // Check Button & Modifiers - Right Click Or Shift Click Opens On the Right
+                        // Set Current File Right
+                        mainViewController.currentFileRight = filePath;
+                    } else {
+                        // Set Current File Left
+                        mainViewController.currentFileLeft = filePath;
+                    }
+                }
+            }
+        }
+    }
+
+    Text {
+        anchors.centerIn: parent
+
+        color: Const.defaultFontColor
+        font.pixelSize: Const.defaultFontSize + 4
+
+        text: directoryModel.scanning ? "Scanning..." : "No Images"
+
+        visible: thumbnailList.count === 0
+    }
+}
@@ -1,4 +1,5 @@
 import QtQuick 2.0
+import customcomponents 0.1
 import "qrc:/qml/js/constants.js" as Const
 
 Rectangle {
@@ -9,54 +10,45 @@ Rectangle {
 
     color: Const.defaultViewBackgroundColor
 
-    // Viewer Image
-    Image {
+    // Viewer Image - Drawn From Tiles, Only the Visible Ones Are Decoded
+    TiledImage {
         id: viewerImage
-        anchors.centerIn: parent
-
-        width: sourceSize.width * viewerViewController.zoomLevel
-        height: sourceSize.height * viewerViewController.zoomLevel
-
-        Behavior on width { NumberAnimation { duration: Const.defaultAnimDuration } }
-        Behavior on height { NumberAnimation { duration: Const.defaultAnimDuration } }
-
-        anchors.horizontalCenterOffset: viewerViewController.panPosX
-        anchors.verticalCenterOffset: viewerViewController.panPosY
+        anchors.fill: parent
 
-        horizontalAlignment: Image.AlignHCenter
-        verticalAlignment: Image.AlignVCenter
+        clip: true
 
-        fillMode: Image.PreserveAspectFit
+        zoomLevel: viewerViewController.zoomLevel
+        Behavior on zoomLevel { NumberAnimation { duration: Const.defaultAnimDuration } }
 
-        asynchronous: true
+        panPosX: viewerViewController.panPosX
+        panPosY: viewerViewController.panPosY
 
-        opacity: viewerImage.status === Image.Ready ? 1.0 : 0.0
+        opacity: viewerImage.status === TiledImage.TSReady ? 1.0 : 0.0
         Behavior on opacity { NumberAnimation { duration: Const.defaultAnimDuration } }
         visible: opacity > 0.0
 
-        source: {
-            if (viewerViewController.currentFile === "") {
-                return "";
-            }
+        source: viewerViewController.currentFile
+        preloadSources: viewerViewController.neighbourFiles
 
-            return "file://" + viewerViewController.currentFile;
+        onSourceWidthChanged: {
+            // Set Image Source Width
+            viewerViewController.imageSourceWidth = viewerImage.sourceWidth;
+            // Set Image Width
+            viewerViewController.imageWidth = viewerImage.sourceWidth * viewerImage.zoomLevel;
         }
 
-        onSourceSizeChanged: {
-            // Set Image Source Width
-            viewerViewController.imageSourceWidth = viewerImage.sourceSize.width;
+        onSourceHeightChanged: {
             // Set Image Source Height
-            viewerViewController.imageSourceHeight = viewerImage.sourceSize.height;
+            viewerViewController.imageSourceHeight = viewerImage.sourceHeight;
+            // Set Image Height
+            viewerViewController.imageHeight = viewerImage.sourceHeight * viewerImage.zoomLevel;
         }
 
-        onWidthChanged: {
+        onZoomLevelChanged: {
             // Set Image Width
-            viewerViewController.imageWidth = viewerImage.width;
-        }
-
-        onHeightChanged: {
+            viewerViewController.imageWidth = viewerImage.sourceWidth * viewerImage.zoomLevel;
             // Set Image Height
-            viewerViewController.imageHeight = viewerImage.height;
+            viewerViewController.imageHeight = viewerImage.sourceHeight * viewerImage.zoomLevel;
         }
     }
 
@@ -69,9 +61,8 @@ Rectangle {
         font.pixelSize: Const.defaultFontSize
         color: Const.defaultFontColor
         visible: opacity > 0.0
-        opacity: viewerImage.status !== Image.Ready ? 1.0 : 0.0
+        opacity: viewerImage.status === TiledImage.TSLoading ? 1.0 : 0.0
         Behavior on opacity { NumberAnimation { duration: 200 } }
         text: qsTr("Loading...")
     }
 }
-
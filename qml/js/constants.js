@@ -6,6 +6,8 @@ var defaultBorderColor                  = "#77777777";
 var defaultHighlightColor               = "#77FFFFFF";
 var defaultHighlightColorFocused        = "orange";
 
+var defaultSelectionColor               = "#5533AAFF";
+
 var defaultFontColor                    = "#FFFFFFFF";
 
 var defaultFontShadowColor              = "#FF000000";
@@ -0,0 +1,241 @@
+#include <QDebug>
+#include <QRunnable>
+#include <QThread>
+#include <QThreadPool>
+#include <QSemaphore>
+
+#include <string.h>
+
+#include "blockhash.h"
+#include "constants.h"
+
+
+//==============================================================================
+// Block Hash Task Class - Hashes a Band of Block Rows
+//==============================================================================
+class BlockHashTask : public QRunnable
+{
+public:
+
+    // Constructor
+    BlockHashTask(const uchar* aBits, const int& aBytesPerLine, const int& aFirstBlockRow, const int& aBlockRowCount, BlockHashGrid& aGrid, QSemaphore& aDone)
+        : bits(aBits)
+        , bytesPerLine(aBytesPerLine)
+        , firstBlockRow(aFirstBlockRow)
+        , blockRowCount(aBlockRowCount)
+        , grid(aGrid)
+        , done(aDone)
+    {
+    }
+
+    // Run
+    virtual void run()
+    {
+        // Hash Block Rows - Each Band Writes Its Own Part of the Grid
+        hashBlockRows(bits, bytesPerLine, firstBlockRow, blockRowCount, grid);
+
+        // Release Done
+        done.release();
+    }
+
+private:
+    // Bits
+    const uchar*    bits;
+    // Bytes Per Line
+    int             bytesPerLine;
+    // First Block Row
+    int             firstBlockRow;
+    // Block Row Count
+    int             blockRowCount;
+    // Grid
+    BlockHashGrid&  grid;
+    // Done Semaphore
+    QSemaphore&     done;
+};
+
+//==============================================================================
+// Mix Word Into Hash
+//==============================================================================
+static inline quint64 mixHash(const quint64& aHash, const quint64& aWord)
+{
+    // Multiply - Spreads Low Bits Upwards
+    quint64 hash = (aHash ^ aWord) * DEFAULT_BLOCK_HASH_MULTIPLIER;
+
+    // Rotate - Brings High Bits Back Down
+    return (hash << 31) | (hash >> 33);
+}
+
+//==============================================================================
+// Init Grid For Image - Hashes Left To Fill
+//==============================================================================
+void BlockHashGrid::init(const QImage& aImage)
+{
+    // Set Layout
+    blockSize = DEFAULT_BLOCK_HASH_SIZE;
+    imageSize = aImage.size();
+    size = QSize((imageSize.width() + blockSize - 1) / blockSize, (imageSize.height() + blockSize - 1) / blockSize);
+    imageKey = aImage.cacheKey();
+
+    // Reset Hashes
+    hashes.fill(0, size.width() * size.height());
+}
+
+//==============================================================================
+// Check If Grid Belongs To Image
+//==============================================================================
+bool BlockHashGrid::isValidFor(const QImage& aImage) const
+{
+    return blockSize > 0 && !aImage.isNull() && imageKey == aImage.cacheKey() && imageSize == aImage.size();
+}
+
+//==============================================================================
+// Get Block Rect In Pixels - Clipped To the Image
+//==============================================================================
+QRect BlockHashGrid::blockRect(const int& aIndex) const
+{
+    return QRect((aIndex % size.width()) * blockSize, (aIndex / size.width()) * blockSize, blockSize, blockSize).intersected(QRect(QPoint(0, 0), imageSize));
+}
+
+//==============================================================================
+// Hash Block Rows of 32 Bit Pixels Into the Grid
+//==============================================================================
+void hashBlockRows(const uchar* aBits, const int& aBytesPerLine, const int& aFirstBlockRow, const int& aBlockRowCount, BlockHashGrid& aGrid)
+{
+    // Get Grid Width
+    int gridWidth = aGrid.size.width();
+    // Get Image Width
+    int width = aGrid.imageSize.width();
+
+    // Go Thru Block Rows
+    for (int blockRow = aFirstBlockRow; blockRow < aFirstBlockRow + aBlockRowCount; blockRow++) {
+        // Get Block Row Hashes
+        quint64* rowHashes = aGrid.hashes.data() + blockRow * gridWidth;
+        // Get Pixel Rows
+        int firstY = blockRow * aGrid.blockSize;
+        int lastY = qMin(firstY + aGrid.blockSize, aGrid.imageSize.height());
+
+        // Seed Hashes - Content Only, Equal Blocks At Shifted Positions Hash Equal For Aligned Compares
+        for (int blockColumn = 0; blockColumn < gridWidth; blockColumn++) {
+            rowHashes[blockColumn] = DEFAULT_BLOCK_HASH_SEED;
+        }
+
+        // Go Thru Pixel Rows - Row Major, Each Row Feeds Every Block of the Block Row
+        for (int y = firstY; y < lastY; y++) {
+            // Get Line
+            const uchar* line = aBits + (qint64)y * aBytesPerLine;
+
+            // Go Thru Blocks
+            for (int blockColumn = 0; blockColumn < gridWidth; blockColumn++) {
+                // Get Pixel Range
+                int firstX = blockColumn * aGrid.blockSize;
+                int lastX = qMin(firstX + aGrid.blockSize, width);
+                // Init Hash
+                quint64 hash = rowHashes[blockColumn];
+                // Init Word
+                quint64 word = 0;
+                // Init X
+                int x = firstX;
+
+                // Go Thru Pixel Pairs
+                for (; x + 2 <= lastX; x += 2) {
+                    // Copy Word - Two Pixels
+                    memcpy(&word, line + x * 4, sizeof(word));
+                    // Mix Word
+                    hash = mixHash(hash, word);
+                }
+
+                // Check Odd Pixel
+                if (x < lastX) {
+                    // Init Pixel
+                    quint32 pixel = 0;
+                    // Copy Pixel
+                    memcpy(&pixel, line + x * 4, sizeof(pixel));
+                    // Mix Pixel
+                    hash = mixHash(hash, pixel);
+                }
+
+                // Set Hash
+                rowHashes[blockColumn] = hash;
+            }
+        }
+    }
+}
+
+//==============================================================================
+// Compute Block Hashes of 32 Bit Image - Block Rows Hashed In Parallel Bands
+//==============================================================================
+BlockHashGrid computeBlockHashes(const QImage& aImage)
+{
+    // Init Grid
+    BlockHashGrid grid;
+
+    // Check Image
+    if (aImage.isNull() || aImage.depth() != 32) {
+        return grid;
+    }
+
+    // Init Grid
+    grid.init(aImage);
+
+    // Get Block Rows
+    int blockRows = grid.size.height();
+    // Get Band Count - Small Images Are Not Worth Splitting
+    int bandCount = qBound(1, blockRows * grid.blockSize / DEFAULT_NORMALIZE_MIN_BAND_ROWS, QThread::idealThreadCount());
+    // Get Band Block Rows
+    int bandBlockRows = (blockRows + bandCount - 1) / bandCount;
+
+    // Init Done Semaphore
+    QSemaphore done(0);
+    // Init Started Bands
+    int startedBands = 0;
+
+    // Go Thru Bands
+    for (int firstBlockRow = 0; firstBlockRow < blockRows; firstBlockRow += bandBlockRows) {
+        // Init Task
+        BlockHashTask* task = new BlockHashTask(aImage.constBits(), aImage.bytesPerLine(), firstBlockRow, qMin(bandBlockRows, blockRows - firstBlockRow), grid, done);
+
+        // Check Last Band - Run On the Calling Thread
+        if (firstBlockRow + bandBlockRows >= blockRows) {
+            // Run Task
+            task->run();
+            // Delete Task
+            delete task;
+        } else {
+            // Start Task
+            QThreadPool::globalInstance()->start(task);
+        }
+
+        // Inc Started Bands
+        startedBands++;
+    }
+
+    // Wait For Bands
+    done.acquire(startedBands);
+
+    return grid;
+}
+
+//==============================================================================
+// Get Differing Blocks of Two Grids of the Same Layout - Empty If Nothing Changed
+//==============================================================================
+QVector<int> differingBlocks(const BlockHashGrid& aLeftGrid, const BlockHashGrid& aRightGrid)
+{
+    // Init Result
+    QVector<int> result;
+
+    // Get Hashes
+    const quint64* leftHashes = aLeftGrid.hashes.constData();
+    const quint64* rightHashes = aRightGrid.hashes.constData();
+    // Get Count
+    int count = qMin(aLeftGrid.hashes.count(), aRightGrid.hashes.count());
+
+    // Go Thru Hashes
+    for (int i = 0; i < count; i++) {
+        // Check Hashes
+        if (leftHashes[i] != rightHashes[i]) {
+            result << i;
+        }
+    }
+
+    return result;
+}
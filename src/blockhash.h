@@ -0,0 +1,49 @@
+#ifndef BLOCKHASH_H
+#define BLOCKHASH_H
+
+#include <QImage>
+#include <QSize>
+#include <QRect>
+#include <QVector>
+
+//==============================================================================
+// Block Hash Grid - One 64 Bit Hash Per Block of a 32 Bit Image
+//
+// Equal Hashes Are Taken As Equal Blocks, Differing Hashes Always Mean Differing Pixels
+//==============================================================================
+struct BlockHashGrid
+{
+    // Block Size In Pixels
+    int                 blockSize;
+    // Image Size In Pixels
+    QSize               imageSize;
+    // Grid Size In Blocks
+    QSize               size;
+    // Cache Key of the Hashed Image - Ties the Grid To Exactly That Pixel Data
+    qint64              imageKey;
+    // Hashes - Row Major
+    QVector<quint64>    hashes;
+
+    // Constructor
+    BlockHashGrid() : blockSize(0), imageKey(0) { }
+
+    // Init Grid For Image - Hashes Left To Fill
+    void init(const QImage& aImage);
+
+    // Check If Grid Belongs To Image
+    bool isValidFor(const QImage& aImage) const;
+
+    // Get Block Rect In Pixels - Clipped To the Image
+    QRect blockRect(const int& aIndex) const;
+};
+
+// Hash Block Rows of 32 Bit Pixels Into the Grid
+void hashBlockRows(const uchar* aBits, const int& aBytesPerLine, const int& aFirstBlockRow, const int& aBlockRowCount, BlockHashGrid& aGrid);
+
+// Compute Block Hashes of 32 Bit Image - Block Rows Hashed In Parallel Bands
+BlockHashGrid computeBlockHashes(const QImage& aImage);
+
+// Get Differing Blocks of Two Grids of the Same Layout - Empty If Nothing Changed
+QVector<int> differingBlocks(const BlockHashGrid& aLeftGrid, const BlockHashGrid& aRightGrid);
+
+#endif // BLOCKHASH_H
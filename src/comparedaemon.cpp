@@ -0,0 +1,980 @@
+#include <QDebug>
+#include <QDataStream>
+#include <QFileInfo>
+#include <QImageReader>
+#include <QRunnable>
+#include <QThread>
+#include <QMutexLocker>
+#include <QtEndian>
+
+#ifdef Q_OS_UNIX
+
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <sys/socket.h>
+
+#endif // Q_OS_UNIX
+
+#include "comparedaemon.h"
+#include "resultcache.h"
+#include "deepcompare.h"
+#include "sharedimage.h"
+#include "mappedimage.h"
+#include "comparemask.h"
+#include "constants.h"
+#include "defaultsettings.h"
+
+
+//==============================================================================
+// Frame Message - Prefixes Length
+//==============================================================================
+static QByteArray frameMessage(const QByteArray& aMessage)
+{
+    // Init Frame
+    QByteArray frame(sizeof(quint32), 0);
+    // Set Length
+    qToBigEndian<quint32>(aMessage.size(), (uchar*)frame.data());
+
+    return frame + aMessage;
+}
+
+//==============================================================================
+// Error Message - Status Code, No Payload
+//==============================================================================
+static QByteArray errorMessage(const quint32& aRequestID, const DaemonErrorStatus& aStatus)
+{
+    // Init Message
+    QByteArray message;
+    // Init Stream
+    QDataStream stream(&message, QIODevice::WriteOnly);
+    stream.setVersion(DEFAULT_DAEMON_STREAM_VERSION);
+
+    // Write Error
+    stream << (quint8)DMTError << aRequestID << (quint8)aStatus;
+
+    return message;
+}
+
+//==============================================================================
+// Take Message From Socket - False Until a Whole Message Arrived
+//==============================================================================
+static bool takeMessage(QLocalSocket* aSocket, QByteArray& aMessage)
+{
+    // Check Length Available
+    if (aSocket->bytesAvailable() < (qint64)sizeof(quint32)) {
+        return false;
+    }
+
+    // Peek Length
+    QByteArray lengthBytes = aSocket->peek(sizeof(quint32));
+    // Get Length
+    quint32 length = qFromBigEndian<quint32>((const uchar*)lengthBytes.constData());
+
+    // Check Length - Protocol Error, Drop the Connection
+    if (length > DEFAULT_DAEMON_MAX_MESSAGE_SIZE) {
+        qDebug() << "takeMessage - length: " << length << " - ERROR: MESSAGE TOO LONG!";
+        // Abort Socket
+        aSocket->abort();
+        return false;
+    }
+
+    // Check Message Available
+    if (aSocket->bytesAvailable() < (qint64)(sizeof(quint32) + length)) {
+        return false;
+    }
+
+    // Skip Length
+    aSocket->read(sizeof(quint32));
+    // Read Message
+    aMessage = aSocket->read(length);
+
+    return true;
+}
+
+
+
+//==============================================================================
+// Daemon Compare Task Class
+//==============================================================================
+class DaemonCompareTask : public QRunnable
+{
+public:
+
+    // Constructor
+    DaemonCompareTask(CompareDaemon* aDaemon, const quint32& aConnectionID, const quint32& aRequestID, const QString& aLeftFile, const QString& aRightFile, const quint16& aTolerance)
+        : daemon(aDaemon)
+        , connectionID(aConnectionID)
+        , requestID(aRequestID)
+        , leftFile(aLeftFile)
+        , rightFile(aRightFile)
+        , tolerance(aTolerance)
+    {
+    }
+
+    // Constructor - Shared Images, Mapped By the Daemon
+    DaemonCompareTask(CompareDaemon* aDaemon, const quint32& aConnectionID, const quint32& aRequestID, const QImage& aLeftImage, const QImage& aRightImage, const quint16& aTolerance)
+        : daemon(aDaemon)
+        , connectionID(aConnectionID)
+        , requestID(aRequestID)
+        , leftImage(aLeftImage)
+        , rightImage(aRightImage)
+        , tolerance(aTolerance)
+    {
+    }
+
+    // Run
+    virtual void run()
+    {
+        // Init Result
+        CachedCompareResult result;
+        // Init Cached
+        bool cached = false;
+        // Init Error
+        QString error;
+        // Init Ok
+        bool ok = false;
+
+        // Get Mask Version - Compare Mask of the Left File Applied As By --compare, Shared Images Have None
+        QByteArray maskVersion = leftImage.isNull() ? compareMaskVersion(leftFile) : QByteArray();
+        // Get Key - Content Hashes Stay Warm In the Daemon, Shared Images Are Not Cached
+        QByteArray key = leftImage.isNull() ? ResultCache::getInstance()->key(leftFile, rightFile, DEFAULT_RESULT_CACHE_MODE_DEEP, tolerance, maskVersion) : QByteArray();
+
+        // Lookup Result
+        if (!key.isEmpty() && ResultCache::getInstance()->lookup(key, result)) {
+            // Set Cached
+            cached = true;
+            ok = true;
+        } else {
+            // Check Images - Decoded Images Stay Warm In the Daemon
+            if (leftImage.isNull()) {
+                // Get Images
+                leftImage = daemon->decodedImage(leftFile, error);
+                rightImage = leftImage.isNull() ? QImage() : daemon->decodedImage(rightFile, error);
+            }
+
+            // Get Keep Mask - Rasterized At the Left Image Size
+            QImage keepMask = maskVersion.isEmpty() || leftImage.isNull() ? QImage() : compareMask(leftFile, leftImage.size());
+
+            // Compare Images
+            ok = !rightImage.isNull() && compareImagesDeep(leftImage, rightImage, tolerance, result.stats, error, &result.diffMap, keepMask);
+
+            // Check Ok
+            if (ok) {
+                // Get Regions
+                result.regions = result.diffMap.regions();
+
+                // Check Key
+                if (!key.isEmpty()) {
+                    // Store Result
+                    ResultCache::getInstance()->store(key, result);
+                }
+            }
+        }
+
+        // Init Response
+        QByteArray response;
+        // Init Stream
+        QDataStream stream(&response, QIODevice::WriteOnly);
+        stream.setVersion(DEFAULT_DAEMON_STREAM_VERSION);
+
+        // Write Response
+        stream << (quint8)DMTResult << requestID << ok << error
+               << (qint64)result.stats.pixels << (qint64)result.stats.differingPixels
+               << (quint16)result.stats.maxDifference << result.stats.meanDifference()
+               << (qint32)result.stats.leftDepth << (qint32)result.stats.rightDepth
+               << (qint32)result.regions.count() << cached;
+
+        // Release Images - Shared Images Are Unmapped Here
+        leftImage = QImage();
+        rightImage = QImage();
+
+        // Send Response - Sockets Live In the Daemon Thread
+        QMetaObject::invokeMethod(daemon, "sendResponse", Qt::QueuedConnection, Q_ARG(quint32, connectionID), Q_ARG(QByteArray, response));
+    }
+
+private:
+    // Daemon
+    CompareDaemon*  daemon;
+    // Connection ID
+    quint32         connectionID;
+    // Request ID
+    quint32         requestID;
+    // Left File
+    QString         leftFile;
+    // Right File
+    QString         rightFile;
+    // Left Image
+    QImage          leftImage;
+    // Right Image
+    QImage          rightImage;
+    // Tolerance
+    quint16         tolerance;
+};
+
+
+
+//==============================================================================
+// Constructor
+//==============================================================================
+CompareDaemon::CompareDaemon(QObject* aParent)
+    : QObject(aParent)
+    , nextConnectionID(1)
+    , pendingRequests(0)
+    , decodedAccessCounter(0)
+    , decodedUsedBytes(0)
+{
+    qDebug() << "CompareDaemon::CompareDaemon";
+
+    // Init Result Cache - Before Workers Use It
+    ResultCache::getInstance();
+
+    // Set Max Thread Count - Tiles Of Each Compare Run On the Global Pool
+    workerPool.setMaxThreadCount(DEFAULT_DAEMON_WORKER_COUNT);
+
+    // Connect Signals
+    connect(&server, SIGNAL(newConnection()), this, SLOT(newConnection()));
+    connect(&descriptorServer, SIGNAL(newDescriptor(quintptr)), this, SLOT(newDescriptor(quintptr)));
+}
+
+//==============================================================================
+// Listen - Also On the Descriptor Socket Where Supported
+//==============================================================================
+bool CompareDaemon::listen(const QString& aServerName)
+{
+    // Set Socket Options - Only the Same User May Connect
+    server.setSocketOptions(QLocalServer::UserAccessOption);
+    descriptorServer.setSocketOptions(QLocalServer::UserAccessOption);
+
+    // Listen
+    if (server.listen(aServerName)) {
+        return listenDescriptors(aServerName);
+    }
+
+    // Check Address In Use - Left Over By a Crashed Daemon
+    if (server.serverError() == QAbstractSocket::AddressInUseError) {
+        // Check Live Daemon
+        QLocalSocket probe;
+        probe.connectToServer(aServerName);
+
+        // Wait For Connected
+        if (probe.waitForConnected(DEFAULT_DAEMON_CONNECT_TIMEOUT)) {
+            qDebug() << "CompareDaemon::listen - aServerName: " << aServerName << " - ERROR: DAEMON ALREADY RUNNING!";
+            return false;
+        }
+
+        // Remove Stale Server
+        QLocalServer::removeServer(aServerName);
+
+        // Listen Again
+        if (server.listen(aServerName)) {
+            return listenDescriptors(aServerName);
+        }
+    }
+
+    qDebug() << "CompareDaemon::listen - aServerName: " << aServerName << " - ERROR: " << server.errorString();
+
+    return false;
+}
+
+//==============================================================================
+// Listen On the Descriptor Socket - Path Requests Keep Working Without It
+//==============================================================================
+bool CompareDaemon::listenDescriptors(const QString& aServerName)
+{
+#ifdef Q_OS_UNIX
+
+    // Get Descriptor Server Name
+    QString descriptorServerName = aServerName + DEFAULT_DAEMON_DESCRIPTOR_SUFFIX;
+
+    // Remove Stale Server - The Main Socket Is Ours, So Is This One
+    QLocalServer::removeServer(descriptorServerName);
+
+    // Listen
+    if (!descriptorServer.listen(descriptorServerName)) {
+        qDebug() << "CompareDaemon::listenDescriptors - descriptorServerName: " << descriptorServerName << " - ERROR: " << descriptorServer.errorString();
+    }
+
+#else // Q_OS_UNIX
+
+    Q_UNUSED(aServerName);
+
+#endif // Q_OS_UNIX
+
+    return true;
+}
+
+//==============================================================================
+// Get Decoded Image - Cached Per Modification Time, Native Depth
+//==============================================================================
+QImage CompareDaemon::decodedImage(const QString& aFilePath, QString& aError)
+{
+    // Check Shared Image Source & Uncompressed File - Mapped, Not Cached, Page Cache Keeps Them Warm
+    if (isSharedImageSource(aFilePath) || isMappedImageFile(aFilePath)) {
+        return readDeepImage(aFilePath, aError);
+    }
+
+    // Get Last Modified
+    QDateTime lastModified = QFileInfo(aFilePath).lastModified();
+
+    // Lock Decoded Images
+    QMutexLocker locker(&decodedMutex);
+
+    // Check Decoded Image
+    if (decodedImages.contains(aFilePath) && decodedImages[aFilePath].lastModified == lastModified) {
+        // Update Last Access
+        decodedImages[aFilePath].lastAccess = ++decodedAccessCounter;
+
+        return decodedImages[aFilePath].image;
+    }
+
+    // Unlock Decoded Images - Concurrent Requests For the Same File May Decode Twice
+    locker.unlock();
+
+    // Init Reader
+    QImageReader reader(aFilePath);
+    // Read Image
+    QImage image = reader.read();
+
+    // Check Image
+    if (image.isNull()) {
+        // Set Error
+        aError = aFilePath + ": " + reader.errorString();
+        return image;
+    }
+
+    // Get Budget Bytes
+    qint64 budgetBytes = (qint64)DEFAULT_DAEMON_IMAGE_CACHE_MB * 1024 * 1024;
+
+    // Check Budget
+    if (image.byteCount() > budgetBytes) {
+        return image;
+    }
+
+    // Lock Decoded Images
+    locker.relock();
+
+    // Check Existing Entry
+    if (decodedImages.contains(aFilePath)) {
+        // Dec Used Bytes
+        decodedUsedBytes -= decodedImages[aFilePath].image.byteCount();
+        // Remove Entry
+        decodedImages.remove(aFilePath);
+    }
+
+    // Evict Least Recently Used Until It Fits
+    while (decodedUsedBytes + image.byteCount() > budgetBytes && !decodedImages.isEmpty()) {
+        // Init Victim
+        QHash<QString, DecodedEntry>::iterator victim = decodedImages.begin();
+
+        // Go Thru Entries
+        for (QHash<QString, DecodedEntry>::iterator it = decodedImages.begin(); it != decodedImages.end(); ++it) {
+            // Check Older
+            if (it.value().lastAccess < victim.value().lastAccess) {
+                victim = it;
+            }
+        }
+
+        // Dec Used Bytes
+        decodedUsedBytes -= victim.value().image.byteCount();
+        // Remove Victim
+        decodedImages.erase(victim);
+    }
+
+    // Init Entry
+    DecodedEntry entry;
+    entry.image = image;
+    entry.lastModified = lastModified;
+    entry.lastAccess = ++decodedAccessCounter;
+
+    // Add Entry
+    decodedImages[aFilePath] = entry;
+    // Inc Used Bytes
+    decodedUsedBytes += image.byteCount();
+
+    return image;
+}
+
+//==============================================================================
+// New Connection Slot
+//==============================================================================
+void CompareDaemon::newConnection()
+{
+    // Go Thru Pending Connections
+    while (server.hasPendingConnections()) {
+        // Get Socket
+        QLocalSocket* socket = server.nextPendingConnection();
+        // Get Connection ID
+        quint32 connectionID = nextConnectionID++;
+
+        qDebug() << "CompareDaemon::newConnection - connectionID: " << connectionID;
+
+        // Add Connection
+        connections[connectionID] = socket;
+
+        // Connect Signals
+        connect(socket, SIGNAL(readyRead()), this, SLOT(socketReadyRead()));
+        connect(socket, SIGNAL(disconnected()), this, SLOT(socketDisconnected()));
+
+        // Process Requests - Data May Have Arrived With the Connection
+        processRequests(socket);
+    }
+}
+
+//==============================================================================
+// Socket Ready Read Slot
+//==============================================================================
+void CompareDaemon::socketReadyRead()
+{
+    // Get Socket
+    QLocalSocket* socket = qobject_cast<QLocalSocket*>(sender());
+
+    // Check Socket
+    if (socket) {
+        // Process Requests
+        processRequests(socket);
+    }
+}
+
+//==============================================================================
+// Socket Disconnected Slot
+//==============================================================================
+void CompareDaemon::socketDisconnected()
+{
+    // Get Socket
+    QLocalSocket* socket = qobject_cast<QLocalSocket*>(sender());
+
+    // Check Socket
+    if (socket) {
+        qDebug() << "CompareDaemon::socketDisconnected - connectionID: " << connections.key(socket);
+
+        // Remove Connection - Results Still In Flight Are Dropped
+        connections.remove(connections.key(socket));
+        // Delete Socket
+        socket->deleteLater();
+    }
+}
+
+//==============================================================================
+// New Descriptor Slot
+//==============================================================================
+void CompareDaemon::newDescriptor(const quintptr& aSocketDescriptor)
+{
+    // Get Connection ID
+    quint32 connectionID = nextConnectionID++;
+
+    qDebug() << "CompareDaemon::newDescriptor - connectionID: " << connectionID;
+
+#ifdef Q_OS_UNIX
+    // Set Non Blocking - Replies Never Stall the Event Loop On a Client That Does Not Read
+    fcntl((int)aSocketDescriptor, F_SETFL, fcntl((int)aSocketDescriptor, F_GETFL) | O_NONBLOCK);
+#endif // Q_OS_UNIX
+
+    // Init Notifier
+    QSocketNotifier* notifier = new QSocketNotifier((qintptr)aSocketDescriptor, QSocketNotifier::Read, this);
+    // Init Writer - Enabled Only While Output Is Queued
+    QSocketNotifier* writer = new QSocketNotifier((qintptr)aSocketDescriptor, QSocketNotifier::Write, this);
+    writer->setEnabled(false);
+
+    // Add Descriptor Connection
+    descriptorConnections[connectionID] = notifier;
+    // Add Descriptor Writer
+    descriptorWriters[connectionID] = writer;
+
+    // Connect Signals
+    connect(notifier, SIGNAL(activated(int)), this, SLOT(descriptorActivated(int)));
+    connect(writer, SIGNAL(activated(int)), this, SLOT(descriptorWritable(int)));
+
+    // Process Shared Requests - Data May Have Arrived With the Connection
+    processSharedRequests(connectionID);
+}
+
+//==============================================================================
+// Descriptor Activated Slot
+//==============================================================================
+void CompareDaemon::descriptorActivated(int aSocketDescriptor)
+{
+    // Go Thru Descriptor Connections
+    foreach (QSocketNotifier* notifier, descriptorConnections) {
+        // Check Descriptor
+        if (notifier->socket() == aSocketDescriptor) {
+            // Process Shared Requests
+            processSharedRequests(descriptorConnections.key(notifier));
+            return;
+        }
+    }
+}
+
+//==============================================================================
+// Descriptor Writable Slot - Drains Queued Responses
+//==============================================================================
+void CompareDaemon::descriptorWritable(int aSocketDescriptor)
+{
+    // Go Thru Descriptor Writers
+    foreach (QSocketNotifier* writer, descriptorWriters) {
+        // Check Descriptor
+        if (writer->socket() == aSocketDescriptor) {
+            // Flush Descriptor Output
+            flushDescriptorOutput(descriptorWriters.key(writer));
+            return;
+        }
+    }
+}
+
+//==============================================================================
+// Process Shared Requests of Descriptor Connection - Stops While the Pending Limit Is Reached
+//==============================================================================
+void CompareDaemon::processSharedRequests(const quint32& aConnectionID)
+{
+    // Get Notifier
+    QSocketNotifier* notifier = descriptorConnections.value(aConnectionID, NULL);
+
+    // Check Notifier
+    if (!notifier) {
+        return;
+    }
+
+    // Init Request
+    SharedCompareRequest request;
+    // Init Descriptors
+    int leftDescriptor = -1;
+    int rightDescriptor = -1;
+
+    // Receive Requests - Unread Requests Wait In the Socket
+    while (pendingRequests < DEFAULT_DAEMON_MAX_PENDING) {
+        // Receive Request
+        int received = receiveSharedCompareRequest(notifier->socket(), request, leftDescriptor, rightDescriptor);
+
+        // Check Nothing Complete Yet
+        if (received == 0) {
+            break;
+        }
+
+        // Check Closed
+        if (received < 0) {
+            // Close Descriptor Connection
+            closeDescriptorConnection(aConnectionID);
+            return;
+        }
+
+        // Init Error
+        QString error;
+        // Map Images - Descriptors Are Closed Once Mapped
+        QImage leftImage = mapSharedImage(leftDescriptor, error);
+        QImage rightImage = mapSharedImage(rightDescriptor, error);
+
+        // Check Images
+        if (leftImage.isNull() || rightImage.isNull()) {
+            // Init Response
+            QByteArray response;
+            // Init Stream
+            QDataStream stream(&response, QIODevice::WriteOnly);
+            stream.setVersion(DEFAULT_DAEMON_STREAM_VERSION);
+
+            // Write Response - Failed Before Any Work
+            stream << (quint8)DMTResult << request.requestID << false << error
+                   << (qint64)0 << (qint64)0 << (quint16)0 << 0.0 << (qint32)0 << (qint32)0 << (qint32)0 << false;
+
+            // Write Response
+            writeResponse(aConnectionID, response);
+
+            // Check Connection Still Open
+            if (!descriptorConnections.contains(aConnectionID)) {
+                return;
+            }
+
+            continue;
+        }
+
+        // Inc Pending Requests
+        pendingRequests++;
+
+        // Start Task
+        workerPool.start(new DaemonCompareTask(this, aConnectionID, request.requestID, leftImage, rightImage, (quint16)qMin<quint32>(request.tolerance, 0xFFFF)));
+    }
+
+    // Set Notifier Enabled - Held Back While the Pending Limit Is Reached
+    notifier->setEnabled(pendingRequests < DEFAULT_DAEMON_MAX_PENDING);
+}
+
+//==============================================================================
+// Close Descriptor Connection
+//==============================================================================
+void CompareDaemon::closeDescriptorConnection(const quint32& aConnectionID)
+{
+    qDebug() << "CompareDaemon::closeDescriptorConnection - connectionID: " << aConnectionID;
+
+    // Take Notifier - Results Still In Flight Are Dropped
+    QSocketNotifier* notifier = descriptorConnections.take(aConnectionID);
+    // Take Writer
+    QSocketNotifier* writer = descriptorWriters.take(aConnectionID);
+
+    // Drop Queued Output
+    descriptorOutput.remove(aConnectionID);
+
+    // Check Writer
+    if (writer) {
+        // Disable Writer
+        writer->setEnabled(false);
+        // Delete Writer
+        writer->deleteLater();
+    }
+
+    // Check Notifier
+    if (notifier) {
+        // Disable Notifier
+        notifier->setEnabled(false);
+
+#ifdef Q_OS_UNIX
+        // Close Descriptor
+        ::close(notifier->socket());
+#endif // Q_OS_UNIX
+
+        // Delete Notifier
+        notifier->deleteLater();
+    }
+}
+
+//==============================================================================
+// Process Requests of Connection - Stops While the Pending Limit Is Reached
+//==============================================================================
+void CompareDaemon::processRequests(QLocalSocket* aSocket)
+{
+    // Get Connection ID
+    quint32 connectionID = connections.key(aSocket);
+    // Init Message
+    QByteArray message;
+
+    // Take Messages - Unread Requests Wait In the Socket Buffer
+    while (pendingRequests < DEFAULT_DAEMON_MAX_PENDING && takeMessage(aSocket, message)) {
+        // Init Stream
+        QDataStream stream(message);
+        stream.setVersion(DEFAULT_DAEMON_STREAM_VERSION);
+
+        // Init Request
+        quint8 type = 0;
+        quint32 requestID = 0;
+        QString leftFile;
+        QString rightFile;
+        quint16 tolerance = 0;
+
+        // Read Request
+        stream >> type >> requestID >> leftFile >> rightFile >> tolerance;
+
+        // Check Type
+        if (type != DMTCompare) {
+            qDebug() << "CompareDaemon::processRequests - connectionID: " << connectionID << " - type: " << type << " - ERROR: UNKNOWN TYPE!";
+            // Write Error Response
+            writeResponse(connectionID, errorMessage(requestID, DESUnknownType));
+            continue;
+        }
+
+        // Check Request
+        if (stream.status() != QDataStream::Ok) {
+            qDebug() << "CompareDaemon::processRequests - connectionID: " << connectionID << " - requestID: " << requestID << " - ERROR: INVALID REQUEST!";
+            // Write Error Response
+            writeResponse(connectionID, errorMessage(requestID, DESInvalidRequest));
+            continue;
+        }
+
+        // Inc Pending Requests
+        pendingRequests++;
+
+        // Start Task
+        workerPool.start(new DaemonCompareTask(this, connectionID, requestID, leftFile, rightFile, tolerance));
+    }
+}
+
+//==============================================================================
+// Send Response - Called Queued From Workers
+//==============================================================================
+void CompareDaemon::sendResponse(const quint32& aConnectionID, const QByteArray& aResponse)
+{
+    // Dec Pending Requests
+    pendingRequests--;
+
+    // Write Response
+    writeResponse(aConnectionID, aResponse);
+
+    // Go Thru Connections - Resume Those Held Back By the Pending Limit
+    foreach (QLocalSocket* connection, connections) {
+        // Check Pending Limit
+        if (pendingRequests >= DEFAULT_DAEMON_MAX_PENDING) {
+            break;
+        }
+
+        // Process Requests
+        processRequests(connection);
+    }
+
+    // Go Thru Descriptor Connections
+    foreach (quint32 connectionID, descriptorConnections.keys()) {
+        // Check Pending Limit
+        if (pendingRequests >= DEFAULT_DAEMON_MAX_PENDING) {
+            break;
+        }
+
+        // Process Shared Requests
+        processSharedRequests(connectionID);
+    }
+}
+
+//==============================================================================
+// Write Response - Dropped If the Connection Is Gone
+//==============================================================================
+void CompareDaemon::writeResponse(const quint32& aConnectionID, const QByteArray& aResponse)
+{
+    // Get Socket
+    QLocalSocket* socket = connections.value(aConnectionID, NULL);
+
+    // Check Socket
+    if (socket) {
+        // Write Response
+        socket->write(frameMessage(aResponse));
+    }
+
+#ifdef Q_OS_UNIX
+
+    // Check Descriptor Connection
+    if (descriptorConnections.contains(aConnectionID)) {
+        // Queue Response
+        descriptorOutput[aConnectionID] += frameMessage(aResponse);
+
+        // Check Output - A Client That Stopped Reading Is Dropped
+        if (descriptorOutput[aConnectionID].size() > DEFAULT_DAEMON_MAX_OUTPUT_BYTES) {
+            qDebug() << "CompareDaemon::writeResponse - connectionID: " << aConnectionID << " - ERROR: CLIENT NOT READING!";
+            // Close Descriptor Connection
+            closeDescriptorConnection(aConnectionID);
+            return;
+        }
+
+        // Flush Descriptor Output
+        flushDescriptorOutput(aConnectionID);
+    }
+
+#endif // Q_OS_UNIX
+}
+
+//==============================================================================
+// Flush Descriptor Output - Non Blocking, the Rest Waits For the Socket To Be Writable
+//==============================================================================
+void CompareDaemon::flushDescriptorOutput(const quint32& aConnectionID)
+{
+#ifdef Q_OS_UNIX
+
+    // Get Notifier
+    QSocketNotifier* notifier = descriptorConnections.value(aConnectionID, NULL);
+    // Get Writer
+    QSocketNotifier* writer = descriptorWriters.value(aConnectionID, NULL);
+
+    // Check Notifiers
+    if (!notifier || !writer) {
+        return;
+    }
+
+    // Get Output
+    QByteArray& output = descriptorOutput[aConnectionID];
+
+    // Send Output
+    while (!output.isEmpty()) {
+        // Send - Socket Is Non Blocking
+        ssize_t sent = send(notifier->socket(), output.constData(), output.size(), MSG_NOSIGNAL);
+
+        // Check Sent
+        if (sent > 0) {
+            // Remove Sent Bytes
+            output.remove(0, (int)sent);
+        } else if (sent < 0 && errno == EINTR) {
+            continue;
+        } else if (sent < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            break;
+        } else {
+            // Close Descriptor Connection
+            closeDescriptorConnection(aConnectionID);
+            return;
+        }
+    }
+
+    // Set Writer Enabled - Until the Client Read the Rest
+    writer->setEnabled(!output.isEmpty());
+
+#else // Q_OS_UNIX
+
+    Q_UNUSED(aConnectionID);
+
+#endif // Q_OS_UNIX
+}
+
+//==============================================================================
+// Destructor
+//==============================================================================
+CompareDaemon::~CompareDaemon()
+{
+    // Close Servers
+    server.close();
+    descriptorServer.close();
+
+    // Go Thru Descriptor Connections
+    foreach (quint32 connectionID, descriptorConnections.keys()) {
+        // Close Descriptor Connection
+        closeDescriptorConnection(connectionID);
+    }
+
+    // Wait For Workers - They Post Back To This Object
+    workerPool.waitForDone();
+
+    // Release Result Cache
+    ResultCache::getInstance()->release();
+
+    qDebug() << "CompareDaemon::~CompareDaemon";
+}
+
+
+
+//==============================================================================
+// Get Client Source - Files Made Absolute, Shared Image Names Kept
+//==============================================================================
+static QString clientSource(const QString& aSource)
+{
+    return isSharedImageSource(aSource) ? aSource : QFileInfo(aSource).absoluteFilePath();
+}
+
+//==============================================================================
+// Run Compare Client - Sends Path Pairs Pipelined, Returns Process Exit Code
+//==============================================================================
+int runCompareClient(const QString& aServerName, const QStringList& aFiles, const quint16& aTolerance, QTextStream& aOutput)
+{
+    // Check Files
+    if (aFiles.isEmpty() || aFiles.count() % 2 != 0) {
+        aOutput << "Error: --client needs pairs of files" << endl;
+        return DEFAULT_HEADLESS_EXIT_ERROR;
+    }
+
+    // Init Socket
+    QLocalSocket socket;
+    // Connect To Server
+    socket.connectToServer(aServerName);
+
+    // Wait For Connected
+    if (!socket.waitForConnected(DEFAULT_DAEMON_CONNECT_TIMEOUT)) {
+        aOutput << "Error: " << socket.errorString() << endl;
+        return DEFAULT_HEADLESS_EXIT_ERROR;
+    }
+
+    // Go Thru Pairs - All Requests Sent Before Any Result Is Read
+    for (int i = 0; i < aFiles.count(); i += 2) {
+        // Init Request
+        QByteArray request;
+        // Init Stream
+        QDataStream stream(&request, QIODevice::WriteOnly);
+        stream.setVersion(DEFAULT_DAEMON_STREAM_VERSION);
+
+        // Write Request - Absolute Paths, the Daemon Runs Elsewhere
+        stream << (quint8)DMTCompare << (quint32)(i / 2) << clientSource(aFiles[i]) << clientSource(aFiles[i + 1]) << aTolerance;
+
+        // Write Request
+        socket.write(frameMessage(request));
+    }
+
+    // Flush Socket
+    socket.flush();
+
+    // Init Pending Results
+    int pendingResults = aFiles.count() / 2;
+    // Init Exit Code
+    int exitCode = DEFAULT_HEADLESS_EXIT_MATCH;
+    // Init Message
+    QByteArray message;
+
+    // Read Results
+    while (pendingResults > 0) {
+        // Take Message
+        if (!takeMessage(&socket, message)) {
+            // Wait For More Data
+            if (!socket.waitForReadyRead(DEFAULT_DAEMON_RESPONSE_TIMEOUT)) {
+                aOutput << "Error: " << socket.errorString() << endl;
+                return DEFAULT_HEADLESS_EXIT_ERROR;
+            }
+
+            continue;
+        }
+
+        // Init Stream
+        QDataStream stream(message);
+        stream.setVersion(DEFAULT_DAEMON_STREAM_VERSION);
+
+        // Init Result
+        quint8 type = 0;
+        quint32 requestID = 0;
+        bool ok = false;
+        QString error;
+        qint64 pixels = 0;
+        qint64 differingPixels = 0;
+        quint16 maxDifference = 0;
+        double meanDifference = 0.0;
+        qint32 leftDepth = 0;
+        qint32 rightDepth = 0;
+        qint32 regions = 0;
+        bool cached = false;
+
+        // Read Type & Request ID
+        stream >> type >> requestID;
+
+        // Check Error
+        if (type == DMTError && stream.status() == QDataStream::Ok && requestID < (quint32)(aFiles.count() / 2)) {
+            // Init Status
+            quint8 status = 0;
+            // Read Status
+            stream >> status;
+
+            // Dec Pending Results
+            pendingResults--;
+
+            aOutput << "ERROR " << aFiles[requestID * 2] << " " << aFiles[requestID * 2 + 1] << " request rejected: " << status << endl;
+            // Set Exit Code
+            exitCode = DEFAULT_HEADLESS_EXIT_ERROR;
+            continue;
+        }
+
+        // Read Result
+        stream >> ok >> error >> pixels >> differingPixels >> maxDifference >> meanDifference >> leftDepth >> rightDepth >> regions >> cached;
+
+        // Check Result
+        if (type != DMTResult || stream.status() != QDataStream::Ok || requestID >= (quint32)(aFiles.count() / 2)) {
+            aOutput << "Error: invalid response" << endl;
+            return DEFAULT_HEADLESS_EXIT_ERROR;
+        }
+
+        // Dec Pending Results
+        pendingResults--;
+
+        // Get Pair
+        QString pair = aFiles[requestID * 2] + " " + aFiles[requestID * 2 + 1];
+
+        // Check Ok
+        if (!ok) {
+            aOutput << "ERROR " << pair << " " << error << endl;
+            // Set Exit Code
+            exitCode = DEFAULT_HEADLESS_EXIT_ERROR;
+            continue;
+        }
+
+        // Output Result
+        aOutput << (differingPixels == 0 ? "MATCH " : "DIFFER ") << pair
+                << " pixels=" << pixels
+                << " differing=" << differingPixels
+                << " max=" << maxDifference
+                << " mean=" << QString::number(meanDifference, 'f', 3)
+                << " depth=" << leftDepth << "/" << rightDepth
+                << " regions=" << regions
+                << " cached=" << (cached ? 1 : 0) << endl;
+
+        // Check Differing - Errors Take Precedence
+        if (differingPixels > 0 && exitCode == DEFAULT_HEADLESS_EXIT_MATCH) {
+            // Set Exit Code
+            exitCode = DEFAULT_HEADLESS_EXIT_DIFFER;
+        }
+    }
+
+    return exitCode;
+}
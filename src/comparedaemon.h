@@ -0,0 +1,170 @@
+#ifndef COMPAREDAEMON_H
+#define COMPAREDAEMON_H
+
+#include <QObject>
+#include <QLocalServer>
+#include <QLocalSocket>
+#include <QSocketNotifier>
+#include <QThreadPool>
+#include <QHash>
+#include <QImage>
+#include <QDateTime>
+#include <QMutex>
+#include <QTextStream>
+
+//==============================================================================
+// Daemon Message Type
+//==============================================================================
+enum DaemonMessageType
+{
+    DMTCompare      = 1,
+    DMTResult,
+    DMTError
+};
+
+//==============================================================================
+// Daemon Error Status - Sent Back For Requests That Are Not Run
+//==============================================================================
+enum DaemonErrorStatus
+{
+    DESInvalidRequest   = 1,
+    DESUnknownType
+};
+
+//==============================================================================
+// Descriptor Server Class - Hands Accepted Sockets Over As Raw Descriptors
+//
+// QLocalSocket Reads Ahead Without Ancillary Data, So Connections That Pass
+// Shared Image Descriptors As SCM_RIGHTS Are Read With recvmsg Instead
+//==============================================================================
+class DescriptorServer : public QLocalServer
+{
+    Q_OBJECT
+
+public:
+
+    // Constructor
+    explicit DescriptorServer(QObject* aParent = NULL) : QLocalServer(aParent) { }
+
+signals:
+
+    // New Descriptor Signal
+    void newDescriptor(const quintptr& aSocketDescriptor);
+
+protected:
+
+    // Incoming Connection
+    virtual void incomingConnection(quintptr aSocketDescriptor) { emit newDescriptor(aSocketDescriptor); }
+};
+
+//==============================================================================
+// Compare Daemon Class - Serves Compare Requests Over a Local Socket With Warm Caches
+//
+// Messages Are Length Prefixed: quint32 Byte Count, Then QDataStream Fields
+//   Compare: quint8 Type, quint32 Request ID, QString Left, QString Right, quint16 Tolerance
+//   Result:  quint8 Type, quint32 Request ID, bool Ok, QString Error, qint64 Pixels, qint64 Differing,
+//            quint16 Max, double Mean, qint32 Left Depth, qint32 Right Depth, qint32 Regions, bool Cached
+//   Error:   quint8 Type, quint32 Request ID, quint8 Status - For Rejected Requests, No Payload
+// Clients May Pipeline Requests, Results Come Back In Completion Order
+//
+// In Process Renderers May Connect To <name>.fd Instead & Send SharedCompareRequests
+// With Two Shared Image Descriptors Each, Getting the Same Result Messages Back
+//==============================================================================
+class CompareDaemon : public QObject
+{
+    Q_OBJECT
+
+public:
+
+    // Constructor
+    explicit CompareDaemon(QObject* aParent = NULL);
+
+    // Listen - Also On the Descriptor Socket Where Supported
+    bool listen(const QString& aServerName);
+
+    // Get Decoded Image - Cached Per Modification Time, Native Depth
+    QImage decodedImage(const QString& aFilePath, QString& aError);
+
+    // Destructor
+    virtual ~CompareDaemon();
+
+protected slots:
+
+    // New Connection Slot
+    void newConnection();
+    // Socket Ready Read Slot
+    void socketReadyRead();
+    // Socket Disconnected Slot
+    void socketDisconnected();
+
+    // New Descriptor Slot
+    void newDescriptor(const quintptr& aSocketDescriptor);
+    // Descriptor Activated Slot
+    void descriptorActivated(int aSocketDescriptor);
+    // Descriptor Writable Slot - Drains Queued Responses
+    void descriptorWritable(int aSocketDescriptor);
+
+    // Send Response - Called Queued From Workers
+    void sendResponse(const quint32& aConnectionID, const QByteArray& aResponse);
+
+protected:
+
+    // Process Requests of Connection - Stops While the Pending Limit Is Reached
+    void processRequests(QLocalSocket* aSocket);
+    // Process Shared Requests of Descriptor Connection - Stops While the Pending Limit Is Reached
+    void processSharedRequests(const quint32& aConnectionID);
+    // Close Descriptor Connection
+    void closeDescriptorConnection(const quint32& aConnectionID);
+    // Listen On the Descriptor Socket - Path Requests Keep Working Without It
+    bool listenDescriptors(const QString& aServerName);
+    // Write Response - Dropped If the Connection Is Gone
+    void writeResponse(const quint32& aConnectionID, const QByteArray& aResponse);
+    // Flush Descriptor Output - Non Blocking, the Rest Waits For the Socket To Be Writable
+    void flushDescriptorOutput(const quint32& aConnectionID);
+
+private:
+
+    // Decoded Image Entry
+    struct DecodedEntry
+    {
+        // Image
+        QImage      image;
+        // Last Modified Time of the File
+        QDateTime   lastModified;
+        // Last Access Stamp
+        quint64     lastAccess;
+    };
+
+    // Server
+    QLocalServer                    server;
+    // Worker Pool
+    QThreadPool                     workerPool;
+    // Descriptor Server
+    DescriptorServer                descriptorServer;
+    // Connections - Keyed By Connection ID, Results For Closed Ones Are Dropped
+    QHash<quint32, QLocalSocket*>   connections;
+    // Descriptor Connections - Share Connection IDs With Connections
+    QHash<quint32, QSocketNotifier*> descriptorConnections;
+    // Descriptor Write Notifiers - Enabled While Output Is Queued
+    QHash<quint32, QSocketNotifier*> descriptorWriters;
+    // Descriptor Output - Responses the Client Has Not Read Yet
+    QHash<quint32, QByteArray>      descriptorOutput;
+    // Next Connection ID
+    quint32                         nextConnectionID;
+    // Pending Requests
+    int                             pendingRequests;
+
+    // Decoded Image Mutex
+    QMutex                          decodedMutex;
+    // Decoded Images
+    QHash<QString, DecodedEntry>    decodedImages;
+    // Decoded Access Counter
+    quint64                         decodedAccessCounter;
+    // Decoded Used Bytes
+    qint64                          decodedUsedBytes;
+};
+
+// Run Compare Client - Sends Path Pairs Pipelined, Returns Process Exit Code
+int runCompareClient(const QString& aServerName, const QStringList& aFiles, const quint16& aTolerance, QTextStream& aOutput);
+
+#endif // COMPAREDAEMON_H
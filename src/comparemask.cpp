@@ -0,0 +1,277 @@
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QTextStream>
+#include <QImageReader>
+#include <QPainter>
+#include <QPolygonF>
+#include <QDateTime>
+#include <QHash>
+#include <QMutex>
+#include <QMutexLocker>
+
+#include "comparemask.h"
+#include "constants.h"
+
+// Compare Mask Cache Entry
+struct CompareMaskEntry
+{
+    // Mask
+    QImage      mask;
+    // Last Modified Time of the Mask File
+    QDateTime   lastModified;
+};
+
+// Compare Mask Cache Mutex
+static QMutex compareMaskMutex;
+// Compare Mask Cache - Keyed By Mask File & Image Size
+static QHash<QString, CompareMaskEntry> compareMaskCache;
+// Compare Mask Cache Order - Oldest First
+static QStringList compareMaskOrder;
+
+
+//==============================================================================
+// Get Compare Mask File For Image - Empty If There Is None
+//==============================================================================
+QString compareMaskFile(const QString& aImagePath)
+{
+    // Check Image Path
+    if (aImagePath.isEmpty()) {
+        return QString();
+    }
+
+    // Get Pair Mask File
+    QString pairMaskFile = aImagePath + DEFAULT_COMPARE_MASK_FILE_SUFFIX;
+
+    // Check Pair Mask File
+    if (QFile::exists(pairMaskFile)) {
+        return pairMaskFile;
+    }
+
+    // Get Dir Mask File
+    QString dirMaskFile = QFileInfo(aImagePath).absoluteDir().filePath(DEFAULT_COMPARE_MASK_DIR_FILE_NAME);
+
+    // Check Dir Mask File
+    if (QFile::exists(dirMaskFile)) {
+        return dirMaskFile;
+    }
+
+    return QString();
+}
+
+//==============================================================================
+// Get Compare Mask Version For Image - Mask File & Modification Time, Empty If There Is No Mask
+//==============================================================================
+QByteArray compareMaskVersion(const QString& aImagePath)
+{
+    // Get Mask File
+    QString maskFile = compareMaskFile(aImagePath);
+
+    // Check Mask File
+    if (maskFile.isEmpty()) {
+        return QByteArray();
+    }
+
+    return QString("%1\n%2\n").arg(maskFile).arg(QFileInfo(maskFile).lastModified().toMSecsSinceEpoch()).toUtf8();
+}
+
+//==============================================================================
+// Rasterize Mask File Into Keep Mask
+//==============================================================================
+static QImage rasterizeMask(const QString& aMaskFile, const QSize& aImageSize)
+{
+    // Init Mask File
+    QFile maskFile(aMaskFile);
+
+    // Open Mask File
+    if (!maskFile.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        qDebug() << "rasterizeMask - aMaskFile: " << aMaskFile << " - ERROR OPENING MASK FILE!";
+        return QImage();
+    }
+
+    // Init Mask - Everything Compared
+    QImage mask(aImageSize, QImage::Format_ARGB32);
+    mask.fill(0xFFFFFFFF);
+
+    // Init Painter
+    QPainter painter(&mask);
+    // Set Composition Mode - Ignored Regions Are Written As Zero
+    painter.setCompositionMode(QPainter::CompositionMode_Source);
+    painter.setRenderHint(QPainter::Antialiasing, false);
+    painter.setPen(Qt::NoPen);
+    painter.setBrush(QColor(Qt::transparent));
+
+    // Init Text Stream
+    QTextStream maskStream(&maskFile);
+    // Init Line Number
+    int lineNumber = 0;
+
+    // Read Lines
+    while (!maskStream.atEnd()) {
+        // Get Line
+        QString line = maskStream.readLine().trimmed();
+        // Inc Line Number
+        lineNumber++;
+
+        // Check Line
+        if (line.isEmpty() || line.startsWith('#')) {
+            continue;
+        }
+
+        // Get Shape Type
+        QString shapeType = line.section(' ', 0, 0, QString::SectionSkipEmpty).toLower();
+        // Get Arguments
+        QStringList arguments = line.section(' ', 1, -1, QString::SectionSkipEmpty).split(' ', QString::SkipEmptyParts);
+
+        // Check Shape Type
+        if (shapeType == "rect" && arguments.count() == 4) {
+            // Fill Rect
+            painter.drawRect(QRectF(arguments[0].toDouble(), arguments[1].toDouble(), arguments[2].toDouble(), arguments[3].toDouble()));
+
+        } else if (shapeType == "poly" && arguments.count() >= 6 && arguments.count() % 2 == 0) {
+            // Init Polygon
+            QPolygonF polygon;
+
+            // Go Thru Points
+            for (int i = 0; i < arguments.count(); i += 2) {
+                polygon << QPointF(arguments[i].toDouble(), arguments[i + 1].toDouble());
+            }
+
+            // Fill Polygon
+            painter.drawPolygon(polygon);
+
+        } else if (shapeType == "image" && arguments.count() > 0) {
+            // Get Mask Image Path - Relative To the Mask File
+            QString maskImagePath = QFileInfo(aMaskFile).absoluteDir().absoluteFilePath(line.section(' ', 1, -1, QString::SectionSkipEmpty));
+            // Load Mask Image
+            QImage maskImage = QImageReader(maskImagePath).read();
+
+            // Check Mask Image
+            if (maskImage.isNull()) {
+                qDebug() << "rasterizeMask - maskImagePath: " << maskImagePath << " - ERROR LOADING MASK IMAGE!";
+                continue;
+            }
+
+            // Check Size
+            if (maskImage.size() != aImageSize) {
+                // Scale Mask Image - Nearest, Keeps Edges Hard
+                maskImage = maskImage.scaled(aImageSize);
+            }
+
+            // Convert To 32 Bit
+            maskImage = maskImage.convertToFormat(QImage::Format_ARGB32);
+
+            // Go Thru Rows
+            for (int y = 0; y < aImageSize.height(); y++) {
+                // Get Lines
+                const QRgb* sourceLine = (const QRgb*)maskImage.constScanLine(y);
+                QRgb* targetLine = (QRgb*)mask.scanLine(y);
+
+                // Go Thru Pixels
+                for (int x = 0; x < aImageSize.width(); x++) {
+                    // Check White Opaque Pixel
+                    if (qAlpha(sourceLine[x]) > 127 && qGray(sourceLine[x]) > 127) {
+                        targetLine[x] = 0;
+                    }
+                }
+            }
+
+        } else {
+            qDebug() << "rasterizeMask - aMaskFile: " << aMaskFile << ":" << lineNumber << " - INVALID SHAPE: " << line;
+        }
+    }
+
+    return mask;
+}
+
+//==============================================================================
+// Get Compare Mask For Image - Rasterized Once Into a 32 Bit Keep Mask: Compared Pixels 0xFFFFFFFF, Ignored Pixels 0
+//==============================================================================
+QImage compareMask(const QString& aImagePath, const QSize& aImageSize)
+{
+    // Get Mask File
+    QString maskFile = compareMaskFile(aImagePath);
+
+    // Check Mask File & Image Size
+    if (maskFile.isEmpty() || aImageSize.isEmpty()) {
+        return QImage();
+    }
+
+    // Get Last Modified
+    QDateTime lastModified = QFileInfo(maskFile).lastModified();
+    // Get Cache Key
+    QString cacheKey = QString("%1:%2x%3").arg(maskFile).arg(aImageSize.width()).arg(aImageSize.height());
+
+    // Lock Cache
+    QMutexLocker locker(&compareMaskMutex);
+
+    // Check Cache
+    if (compareMaskCache.contains(cacheKey) && compareMaskCache[cacheKey].lastModified == lastModified) {
+        return compareMaskCache[cacheKey].mask;
+    }
+
+    // Init Entry
+    CompareMaskEntry entry;
+    // Rasterize Mask
+    entry.mask = rasterizeMask(maskFile, aImageSize);
+    entry.lastModified = lastModified;
+
+    // Update Cache Order
+    compareMaskOrder.removeAll(cacheKey);
+    compareMaskOrder << cacheKey;
+    // Add Entry
+    compareMaskCache[cacheKey] = entry;
+
+    // Evict Oldest
+    while (compareMaskOrder.count() > DEFAULT_COMPARE_MASK_CACHE_COUNT) {
+        compareMaskCache.remove(compareMaskOrder.takeFirst());
+    }
+
+    return entry.mask;
+}
+
+//==============================================================================
+// Clear Compare Mask Cache
+//==============================================================================
+void clearCompareMasks()
+{
+    // Lock Cache
+    QMutexLocker locker(&compareMaskMutex);
+
+    // Clear Cache
+    compareMaskCache.clear();
+    compareMaskOrder.clear();
+}
+
+
+
+//==============================================================================
+// Constructor
+//==============================================================================
+CompareMaskProvider::CompareMaskProvider()
+    : QQuickImageProvider(QQuickImageProvider::Image, QQmlImageProviderBase::ForceAsynchronousImageLoading)
+{
+}
+
+//==============================================================================
+// Request Image
+//==============================================================================
+QImage CompareMaskProvider::requestImage(const QString& aID, QSize* aSize, const QSize& aRequestedSize)
+{
+    Q_UNUSED(aRequestedSize);
+
+    // Get Image Path - Strip Revision Query
+    QString imagePath = aID.section('?', 0, 0);
+
+    // Get Mask - Image Size Read From the Header, Cached Mask Shared With the Compositor
+    QImage mask = compareMask(imagePath, QImageReader(imagePath).size());
+
+    // Check Size
+    if (aSize) {
+        // Set Size
+        *aSize = mask.size();
+    }
+
+    return mask;
+}
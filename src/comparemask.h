@@ -0,0 +1,51 @@
+#ifndef COMPAREMASK_H
+#define COMPAREMASK_H
+
+#include <QImage>
+#include <QString>
+#include <QSize>
+#include <QByteArray>
+#include <QQuickImageProvider>
+
+//==============================================================================
+// Compare Masks - Regions Ignored When Comparing, Read From a Text Sidecar
+//
+// Sidecar Is <image file>.mask For a Single Pair, Or .compare.mask In the
+// Directory For Every Image In It. One Shape Per Line, In Image Pixels:
+//
+//   rect <x> <y> <width> <height>
+//   poly <x1> <y1> <x2> <y2> <x3> <y3> ...
+//   image <mask image path>     - White Opaque Pixels Are Ignored
+//
+// Empty Lines & Lines Starting With # Are Skipped.
+//==============================================================================
+
+// Get Compare Mask File For Image - Empty If There Is None
+QString compareMaskFile(const QString& aImagePath);
+
+// Get Compare Mask Version For Image - Mask File & Modification Time, Empty If There Is No Mask
+QByteArray compareMaskVersion(const QString& aImagePath);
+
+// Get Compare Mask For Image - Rasterized Once Into a 32 Bit Keep Mask: Compared Pixels 0xFFFFFFFF, Ignored Pixels 0
+QImage compareMask(const QString& aImagePath, const QSize& aImageSize);
+
+// Clear Compare Mask Cache
+void clearCompareMasks();
+
+
+
+//==============================================================================
+// Compare Mask Provider Class - Serves image://comparemask/<image path> To QML
+//==============================================================================
+class CompareMaskProvider : public QQuickImageProvider
+{
+public:
+
+    // Constructor
+    CompareMaskProvider();
+
+    // Request Image
+    virtual QImage requestImage(const QString& aID, QSize* aSize, const QSize& aRequestedSize);
+};
+
+#endif // COMPAREMASK_H
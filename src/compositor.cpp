@@ -1,11 +1,235 @@
 
 #include <QDebug>
+#include <QQuickWindow>
+#include <QRunnable>
+
+#include <string.h>
 
 #include "mainwindow.h"
 #include "compositor.h"
+#include "imagecache.h"
+#include "registration.h"
+#include "comparemask.h"
+#include "utility.h"
+#include "imagescaler.h"
+#include "resultcache.h"
 #include "constants.h"
 #include "defaultsettings.h"
 
+//==============================================================================
+// Whole Compare Task Class - Compares the Whole Images Band By Band At Low Priority
+//==============================================================================
+class CompositorWholeTask : public QRunnable
+{
+public:
+
+    // Constructor
+    CompositorWholeTask(Compositor* aCompositor, const int& aGeneration, const QImage& aLeftImage, const BlockHashGrid& aLeftGrid,
+                        const QImage& aRightImage, const BlockHashGrid& aRightGrid, const QImage& aKeepMask, const QPoint& aAlignOffset,
+                        const QString& aLeftFile, const QString& aRightFile, const QString& aMode, const QByteArray& aMaskVersion, const QByteArray& aKey)
+        : compositor(aCompositor)
+        , generation(aGeneration)
+        , leftImage(aLeftImage)
+        , leftGrid(aLeftGrid)
+        , rightImage(aRightImage)
+        , rightGrid(aRightGrid)
+        , keepMask(aKeepMask)
+        , alignOffset(aAlignOffset)
+        , leftFile(aLeftFile)
+        , rightFile(aRightFile)
+        , mode(aMode)
+        , maskVersion(aMaskVersion)
+        , key(aKey)
+    {
+    }
+
+    // Run
+    virtual void run()
+    {
+        // Init Cached Result
+        CachedCompareResult cachedResult;
+        // Get Content Key - Identity Key Was Already Looked Up On the GUI Thread
+        QByteArray contentKey = ResultCache::getInstance()->key(leftFile, rightFile, mode, 0.0, maskVersion, true);
+
+        // Init Result
+        bool result = false;
+
+        // Lookup Content Key - Copies & Touched Files Keep Their Verdict
+        if (!contentKey.isEmpty() && ResultCache::getInstance()->lookup(contentKey, cachedResult)) {
+            // Set Result
+            result = cachedResult.stats.differingPixels == 0;
+        } else {
+            // Compare Images
+            result = compareImages();
+
+            // Check Generation - Aborted Compares Have No Verdict
+            if (compositor->wholeGeneration.load() != generation) {
+                return;
+            }
+
+            // Get Compared Region
+            QRect region = leftImage.rect().intersected(rightImage.rect().translated(-alignOffset));
+
+            // Reset Cached Statistics
+            memset(&cachedResult.stats, 0, sizeof(cachedResult.stats));
+            // Set Cached Statistics - Verdict Only, Compare Stops At the First Difference
+            cachedResult.stats.pixels = (qint64)region.width() * region.height();
+            cachedResult.stats.differingPixels = result ? 0 : 1;
+            // Set Depths - Normalized 8 Bit Pixels
+            cachedResult.stats.leftDepth = 8;
+            cachedResult.stats.rightDepth = 8;
+
+            // Check Content Key
+            if (!contentKey.isEmpty()) {
+                // Store Verdict
+                ResultCache::getInstance()->store(contentKey, cachedResult);
+            }
+        }
+
+        // Check Key
+        if (!key.isEmpty()) {
+            // Store Verdict - Identity Key Hits Next Time Without Reading the Files
+            ResultCache::getInstance()->store(key, cachedResult);
+        }
+
+        // Check Generation - Inputs Changed Meanwhile
+        if (compositor->wholeGeneration.load() == generation) {
+            // Post Whole Compare Finished
+            QMetaObject::invokeMethod(compositor, "wholeCompareFinished", Qt::QueuedConnection, Q_ARG(int, generation), Q_ARG(bool, result));
+        }
+    }
+
+protected:
+
+    // Check Current - False Once the Inputs Changed, Posts Progress Otherwise. Yields While the Compositor Is Busy
+    bool checkCurrent(const qreal& aProgress)
+    {
+        // Wait While Paused - Thread Priorities Are Ignored By the Default Linux Scheduler, So Yield Explicitly
+        while (compositor->wholePaused.load() != 0 && compositor->wholeGeneration.load() == generation) {
+            // Sleep
+            QThread::msleep(DEFAULT_COMPOSITOR_WHOLE_YIELD_MS);
+        }
+
+        // Check Generation
+        if (compositor->wholeGeneration.load() != generation) {
+            return false;
+        }
+
+        // Post Whole Compare Progress
+        QMetaObject::invokeMethod(compositor, "wholeCompareProgress", Qt::QueuedConnection, Q_ARG(int, generation), Q_ARG(qreal, aProgress));
+
+        return true;
+    }
+
+    // Compare Rect - In Left Image Pixels
+    bool compareRect(const QRect& aRect)
+    {
+        // Init Keep Row - Used When There Is No Mask, Every Pixel Compared
+        QVector<QRgb> keepAll(keepMask.isNull() ? aRect.width() : 0, 0xFFFFFFFF);
+
+        // Go Thru Rows
+        for (int y = aRect.top(); y <= aRect.bottom(); y++) {
+            // Get Rows
+            const QRgb* leftRow = (const QRgb*)leftImage.constScanLine(y) + aRect.x();
+            const QRgb* rightRow = (const QRgb*)rightImage.constScanLine(y + alignOffset.y()) + aRect.x() + alignOffset.x();
+            const QRgb* keepRow = keepMask.isNull() ? keepAll.constData() : (const QRgb*)keepMask.constScanLine(y) + aRect.x();
+
+            // Compare Rows
+            if (!comparePixelRows(leftRow, rightRow, keepRow, aRect.width())) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    // Compare Images - Over the Overlap of the Shifted Right Image
+    bool compareImages()
+    {
+        // Check Pixel Depths - Rows Are Compared As 32 Bit Pixels
+        if (leftImage.depth() != 32 || rightImage.depth() != 32) {
+            return false;
+        }
+
+        // Check Sizes - Unaligned Images Only Match With the Same Size
+        if (alignOffset.isNull() && leftImage.size() != rightImage.size()) {
+            return false;
+        }
+
+        // Get Left Region Overlapping the Shifted Right Image
+        QRect region = leftImage.rect().intersected(rightImage.rect().translated(-alignOffset));
+
+        // Check Region
+        if (region.isEmpty()) {
+            return false;
+        }
+
+        // Check Unshifted & Hashed - Only Blocks With Differing Hashes Need Their Pixels Compared
+        if (alignOffset.isNull() && leftGrid.isValidFor(leftImage) && rightGrid.isValidFor(rightImage) && leftGrid.size == rightGrid.size) {
+            // Get Differing Blocks
+            QVector<int> blocks = differingBlocks(leftGrid, rightGrid);
+
+            // Go Thru Differing Blocks
+            for (int i = 0; i < blocks.count(); i++) {
+                // Check Current Every Band of Blocks
+                if (i % DEFAULT_COMPOSITOR_WHOLE_BAND_BLOCKS == 0 && !checkCurrent((qreal)i / blocks.count())) {
+                    return false;
+                }
+
+                // Compare Block - Masked Pixels May Still Match
+                if (!compareRect(leftGrid.blockRect(blocks[i]).intersected(region))) {
+                    return false;
+                }
+            }
+
+            return true;
+        }
+
+        // Go Thru Bands
+        for (int firstRow = region.top(); firstRow <= region.bottom(); firstRow += DEFAULT_COMPOSITOR_WHOLE_BAND_ROWS) {
+            // Check Current
+            if (!checkCurrent((qreal)(firstRow - region.top()) / region.height())) {
+                return false;
+            }
+
+            // Compare Band
+            if (!compareRect(QRect(region.x(), firstRow, region.width(), qMin(DEFAULT_COMPOSITOR_WHOLE_BAND_ROWS, region.bottom() + 1 - firstRow)))) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+private:
+    // Compositor
+    Compositor*     compositor;
+    // Generation
+    int             generation;
+    // Left Image
+    QImage          leftImage;
+    // Left Image Block Hashes
+    BlockHashGrid   leftGrid;
+    // Right Image
+    QImage          rightImage;
+    // Right Image Block Hashes
+    BlockHashGrid   rightGrid;
+    // Keep Mask - In Left Image Pixels
+    QImage          keepMask;
+    // Align Offset
+    QPoint          alignOffset;
+    // Left File
+    QString         leftFile;
+    // Right File
+    QString         rightFile;
+    // Result Cache Mode
+    QString         mode;
+    // Compare Mask Version
+    QByteArray      maskVersion;
+    // Result Cache Identity Key
+    QByteArray      key;
+};
+
 //==============================================================================
 // Constructor
 //==============================================================================
@@ -15,14 +239,22 @@ Compositor::Compositor(QQuickItem* aParent)
     , status(CSIdle)
     , operation(COTNoOperation)
     , match(false)
+    , wholeMatch(false)
+    , wholeProgress(0.0)
     , currentFileLeft("")
     , currentFileRight("")
     , imageLeft(QImage())
     , imageScaledLeft(QImage())
+    , scaledOriginLeft(0, 0)
+    , scaledSizeLeft(0, 0)
+    , maskLeft(QImage())
+    , maskScaledLeft(QImage())
     , sourceRectLeft(QRect(0, 0, 0, 0))
     , targetRectLeft(QRect(0, 0, 0, 0))
     , imageRight(QImage())
     , imageScaledRight(QImage())
+    , scaledOriginRight(0, 0)
+    , scaledSizeRight(0, 0)
     , sourceRectRight(QRect(0, 0, 0, 0))
     , targetRectRight(QRect(0, 0, 0, 0))
     , zoomLevelIndex(DEFAULT_ZOOM_LEVEL_INDEX)
@@ -32,12 +264,28 @@ Compositor::Compositor(QQuickItem* aParent)
     , threshold(DEFAULT_COMPARE_THRESHOLD)
     , showGrid(false)
     , gridStep(gridSteps[zoomLevelIndex])
+    , fileRevision(0)
+    , currentFrame(0)
+    , autoAlign(DEFAULT_AUTO_ALIGN)
+    , alignOffset(0, 0)
+    , registrationDirty(true)
+    , registrationGeneration(0)
+    , wholeGeneration(0)
+    , wholePaused(0)
+    , wholeKeyLeft(-1)
+    , wholeKeyRight(-1)
+    , wholeKeyMask(-1)
+    , wholeAlignOffset(0, 0)
     , gridPen(QBrush(QColor::fromRgba(DEFAULT_GRID_COLOR)), DEFAULT_GRID_WIDTH)
     , gridSectionPen(QBrush(QColor::fromRgba(DEFAULT_GRID_SECTION_MARKER_COLOR)), DEFAULT_GRID_SECTION_MARKER_WIDTH)
     , gridStartX(0.0)
     , gridStartY(0.0)
     , gridSectionWidth(gridSectionSteps[zoomLevelIndex])
     , worker(NULL)
+    , pendingOperation(COTNoOperation)
+    , workerBusy(false)
+    , frameWindow(NULL)
+    , dispatchTimerID(-1)
 {
     // Set Antialiasing
     setAntialiasing(false);
@@ -48,6 +296,9 @@ Compositor::Compositor(QQuickItem* aParent)
     // Set Smoothing
     setSmooth(false);
 
+    // Set Whole Compare Pool Max Thread Count - One Compare At a Time
+    wholePool.setMaxThreadCount(1);
+
     // ...
 }
 
@@ -56,12 +307,6 @@ Compositor::Compositor(QQuickItem* aParent)
 //==============================================================================
 void Compositor::initWorker()
 {
-    // Check Worker Thread
-    if (workerThread.isRunning()) {
-        // Terminate Worker Thread
-        workerThread.terminate();
-    }
-
     // Check Worker
     if (!worker) {
         qDebug() << "Compositor::initWorker";
@@ -72,6 +317,8 @@ void Compositor::initWorker()
         connect(worker, SIGNAL(resultReady(int,int)), this, SLOT(workerResultReady(int,int)), Qt::QueuedConnection);
         connect(this, SIGNAL(operateWorker(int)), worker, SLOT(doWork(int)), Qt::DirectConnection);
         connect(worker, SIGNAL(refreshCompositor()), this, SLOT(update()));
+        connect(this, SIGNAL(operateRegistration(QImage,QImage,int)), worker, SLOT(doRegistration(QImage,QImage,int)), Qt::QueuedConnection);
+        connect(worker, SIGNAL(registrationReady(QPoint,int)), this, SLOT(workerRegistrationReady(QPoint,int)), Qt::QueuedConnection);
 
         // ...
 
@@ -79,10 +326,145 @@ void Compositor::initWorker()
         worker->moveToThread(&workerThread);
     }
 
-    // Start Worker Thread
-    workerThread.start();
-    // Set Priprity
-    workerThread.setPriority(QThread::IdlePriority);
+    // Check Worker Thread - Kept Running, Its Event Loop Serves Queued Registrations
+    if (!workerThread.isRunning()) {
+        // Start Worker Thread
+        workerThread.start();
+        // Set Priprity
+        workerThread.setPriority(QThread::IdlePriority);
+    }
+}
+
+//==============================================================================
+// Merge Operations - Returns the Single Operation That Covers Both
+//==============================================================================
+static int mergeOperations(const int& aPending, const int& aOperation)
+{
+    // Check Pending Operation
+    if (aPending == COTNoOperation || aPending == aOperation) {
+        return aOperation;
+    }
+
+    // Check Update Rects - Scaling Updates the Rects Too
+    if (aOperation == COTUpdateRects) {
+        return aPending;
+    }
+
+    // Check Pending Update Rects
+    if (aPending == COTUpdateRects) {
+        return aOperation;
+    }
+
+    // Any Other Combination of Scale Operations Needs Both Sides Scaled
+    return COTScaleImages;
+}
+
+//==============================================================================
+// Schedule Operation - Coalesced To At Most One Dispatch Per Frame
+//==============================================================================
+void Compositor::scheduleOperation(const int& aOperation)
+{
+    // Merge With Pending Operation, Intermediate States Are Dropped
+    pendingOperation = mergeOperations(pendingOperation, aOperation);
+
+    // Check Window
+    if (!frameWindow) {
+        // No Frames To Pace By, Dispatch Right Away
+        dispatchPendingOperation();
+        return;
+    }
+
+    // Request Dispatch
+    requestDispatch();
+}
+
+//==============================================================================
+// Request Dispatch - Next Frame Swap Or the Fallback Timer, Whichever Comes First
+//==============================================================================
+void Compositor::requestDispatch()
+{
+    // Request Frame
+    frameWindow->update();
+
+    // Check Fallback Timer - QQuickWidget May Render Without Emitting Frame Swapped
+    if (dispatchTimerID == -1) {
+        // Start Fallback Timer
+        dispatchTimerID = startTimer(DEFAULT_COMPOSITOR_DISPATCH_FALLBACK_MS);
+    }
+}
+
+//==============================================================================
+// Dispatch Pending Operation
+//==============================================================================
+void Compositor::dispatchPendingOperation()
+{
+    // Check Fallback Timer
+    if (dispatchTimerID != -1) {
+        // Kill Fallback Timer
+        killTimer(dispatchTimerID);
+        // Reset Fallback Timer ID
+        dispatchTimerID = -1;
+    }
+
+    // Check Pending Operation
+    if (pendingOperation == COTNoOperation) {
+        return;
+    }
+
+    // Get Operation
+    int nextOperation = pendingOperation;
+    // Reset Pending Operation
+    pendingOperation = COTNoOperation;
+
+    // Set Worker Busy
+    workerBusy = true;
+
+    // Init Worker
+    initWorker();
+    // Emit Signal to Start Operation
+    emit operateWorker(nextOperation);
+}
+
+//==============================================================================
+// Frame Swapped Slot
+//==============================================================================
+void Compositor::frameSwapped()
+{
+    // Check Worker Busy - Pending Operation Is Dispatched When Result Is Ready
+    if (!workerBusy) {
+        // Dispatch Pending Operation
+        dispatchPendingOperation();
+    }
+}
+
+//==============================================================================
+// Whole Compare Progress Slot - Posted By the Whole Compare Task
+//==============================================================================
+void Compositor::wholeCompareProgress(const int& aGeneration, const qreal& aProgress)
+{
+    // Check Generation - Progress of a Dropped Compare May Still Be Queued
+    if (aGeneration == wholeGeneration.load()) {
+        // Set Whole Progress
+        setWholeProgress(aProgress);
+    }
+}
+
+//==============================================================================
+// Whole Compare Finished Slot - Posted By the Whole Compare Task
+//==============================================================================
+void Compositor::wholeCompareFinished(const int& aGeneration, const bool& aMatch)
+{
+    // Check Generation
+    if (aGeneration != wholeGeneration.load()) {
+        return;
+    }
+
+    qDebug() << "Compositor::wholeCompareFinished - aMatch: " << aMatch;
+
+    // Set Whole Match
+    setWholeMatch(aMatch);
+    // Set Whole Progress
+    setWholeProgress(1.0);
 }
 
 //==============================================================================
@@ -99,6 +481,88 @@ void Compositor::setMatch(const bool& aMatch)
     }
 }
 
+//==============================================================================
+// Set Whole Match
+//==============================================================================
+void Compositor::setWholeMatch(const bool& aWholeMatch)
+{
+    // Check Whole Match
+    if (wholeMatch != aWholeMatch) {
+        // Set Whole Match
+        wholeMatch = aWholeMatch;
+        // Emit Whole Match Changed Signal
+        emit wholeMatchChanged(wholeMatch);
+    }
+}
+
+//==============================================================================
+// Set Whole Progress
+//==============================================================================
+void Compositor::setWholeProgress(const qreal& aWholeProgress)
+{
+    // Check Whole Progress
+    if (wholeProgress != aWholeProgress) {
+        // Set Whole Progress
+        wholeProgress = aWholeProgress;
+        // Emit Whole Progress Changed Signal
+        emit wholeProgressChanged(wholeProgress);
+    }
+}
+
+//==============================================================================
+// Start Whole Compare - Unless the Verdict For the Current Inputs Is Already Known
+//==============================================================================
+void Compositor::startWholeCompare()
+{
+    // Check Inputs - Pans & Zooms Keep the Verdict
+    if (wholeKeyLeft == imageLeft.cacheKey() && wholeKeyRight == imageRight.cacheKey() && wholeKeyMask == maskLeft.cacheKey() && wholeAlignOffset == alignOffset) {
+        return;
+    }
+
+    // Set Inputs
+    wholeKeyLeft = imageLeft.cacheKey();
+    wholeKeyRight = imageRight.cacheKey();
+    wholeKeyMask = maskLeft.cacheKey();
+    wholeAlignOffset = alignOffset;
+
+    // Inc Generation - Drops the Running Compare
+    wholeGeneration.ref();
+    // Clear Queued Compare
+    wholePool.clear();
+
+    // Set Whole Match
+    setWholeMatch(false);
+    // Set Whole Progress
+    setWholeProgress(0.0);
+
+    // Check Images
+    if (imageLeft.isNull() || imageRight.isNull()) {
+        return;
+    }
+
+    // Get Mode - Frame, Alpha Handling & Align Offset Change the Verdict
+    QString mode = QString("%1#%2:%3@%4,%5").arg(DEFAULT_RESULT_CACHE_MODE_EXACT).arg(currentFrame).arg(ImageCache::getInstance()->getAlphaMode()).arg(alignOffset.x()).arg(alignOffset.y());
+    // Get Mask Version
+    QByteArray maskVersion = maskLeft.isNull() ? QByteArray() : compareMaskVersion(currentFileLeft);
+    // Get Identity Key - Stats Only, Cheap Enough For the GUI Thread
+    QByteArray key = ResultCache::getInstance()->key(currentFileLeft, currentFileRight, mode, 0.0, maskVersion);
+    // Init Cached Result
+    CachedCompareResult cachedResult;
+
+    // Lookup Result - Revisited Pairs Get Their Verdict Without a Pixel Read
+    if (!key.isEmpty() && ResultCache::getInstance()->lookup(key, cachedResult)) {
+        // Set Whole Match
+        setWholeMatch(cachedResult.stats.differingPixels == 0);
+        // Set Whole Progress
+        setWholeProgress(1.0);
+        return;
+    }
+
+    // Start Whole Compare Task
+    wholePool.start(new CompositorWholeTask(this, wholeGeneration.load(), imageLeft, hashGridLeft, imageRight, hashGridRight, maskLeft, alignOffset,
+                                            currentFileLeft, currentFileRight, mode, maskVersion, key));
+}
+
 //==============================================================================
 // Set Status
 //==============================================================================
@@ -108,6 +572,8 @@ void Compositor::setStatus(const int& aStatus)
     if (status != aStatus) {
         // Set Status
         status = aStatus;
+        // Set Whole Paused - Viewport Work Goes First
+        wholePaused.store(status == CSBusy ? 1 : 0);
         // Emit Status Changed Signal
         emit statusChanged(status);
     }
@@ -135,6 +601,22 @@ bool Compositor::getMatch()
     return match;
 }
 
+//==============================================================================
+// Get Whole Matching - Valid When the Whole Progress Reaches 1
+//==============================================================================
+bool Compositor::getWholeMatch()
+{
+    return wholeMatch;
+}
+
+//==============================================================================
+// Get Whole Progress
+//==============================================================================
+qreal Compositor::getWholeProgress()
+{
+    return wholeProgress;
+}
+
 //==============================================================================
 // Get Status
 //==============================================================================
@@ -172,7 +654,7 @@ qreal Compositor::getSourceCompositeHeight()
 //==============================================================================
 qreal Compositor::getCompositeWidth()
 {
-    return qMax(imageScaledLeft.width(), imageScaledRight.width());
+    return qMax(scaledSizeLeft.width(), scaledSizeRight.width());
 }
 
 //==============================================================================
@@ -180,7 +662,7 @@ qreal Compositor::getCompositeWidth()
 //==============================================================================
 qreal Compositor::getCompositeHeight()
 {
-    return qMax(imageScaledLeft.height(), imageScaledRight.height());
+    return qMax(scaledSizeLeft.height(), scaledSizeRight.height());
 }
 
 //==============================================================================
@@ -214,7 +696,13 @@ void Compositor::setCurrentFileLeft(const QString& aCurrentFile)
         emit currentFileLeftChanged(currentFileLeft);
 
         // Load Image
-        imageLeft.load(currentFileLeft);
+        imageLeft = ImageCache::getInstance()->image(currentFileLeft, currentFrame);
+        // Get Block Hashes
+        hashGridLeft = ImageCache::getInstance()->blockHashes(currentFileLeft, currentFrame);
+        // Update Compare Mask
+        updateCompareMask();
+        // Set Registration Dirty
+        registrationDirty = true;
 
         // Notify Composite Sizes Changed
         notifyCompositeSizesChanged();
@@ -222,10 +710,8 @@ void Compositor::setCurrentFileLeft(const QString& aCurrentFile)
         // Update Positions
         //updatePositions();
 
-        // Init Worker
-        initWorker();
-        // Emit Signal to Start Operation
-        emit operateWorker(COTScaleLeftImage);
+        // Schedule Operation
+        scheduleOperation(COTScaleLeftImage);
 
         // ...
     }
@@ -262,7 +748,11 @@ void Compositor::setCurrentFileRight(const QString& aCurrentFile)
         emit currentFileRightChanged(currentFileRight);
 
         // Load Image
-        imageRight.load(currentFileRight);
+        imageRight = ImageCache::getInstance()->image(currentFileRight, currentFrame);
+        // Get Block Hashes
+        hashGridRight = ImageCache::getInstance()->blockHashes(currentFileRight, currentFrame);
+        // Set Registration Dirty
+        registrationDirty = true;
 
         // Notify Composite Sizes Changed
         notifyCompositeSizesChanged();
@@ -270,10 +760,8 @@ void Compositor::setCurrentFileRight(const QString& aCurrentFile)
         // Update Positions
         //updatePositions();
 
-        // Init Worker
-        initWorker();
-        // Emit Signal to Start Operation
-        emit operateWorker(COTScaleRightImage);
+        // Schedule Operation
+        scheduleOperation(COTScaleRightImage);
 
         // ...
     }
@@ -343,10 +831,8 @@ void Compositor::setZoomLevel(const qreal& aZoomLevel)
         // Emit Zoom Level Changed Signal
         emit zoomLevelChanged(zoomLevel);
 
-        // Init Worker
-        initWorker();
-        // Emit Signal to Start Operation
-        emit operateWorker(COTScaleImages);
+        // Schedule Operation
+        scheduleOperation(COTScaleImages);
 
         // ...
     }
@@ -385,10 +871,8 @@ void Compositor::setPanPosX(const qreal& aPanPosX)
         // Update Horizontal Positions
         updatePositions(true, false);
 
-        // Init Worker
-        initWorker();
-        // Emit Signal to Start Operation
-        emit operateWorker(COTUpdateRects);
+        // Schedule Operation
+        scheduleOperation(COTUpdateRects);
 
         // ...
     }
@@ -427,10 +911,8 @@ void Compositor::setPanPosY(const qreal& aPanPosY)
         // Update Vertical Positions
         updatePositions(false, true);
 
-        // Init Worker
-        initWorker();
-        // Emit Signal to Start Operation
-        emit operateWorker(COTUpdateRects);
+        // Schedule Operation
+        scheduleOperation(COTUpdateRects);
 
         // ...
     }
@@ -484,6 +966,345 @@ void Compositor::setShowGrid(const bool& aShowGrid)
     }
 }
 
+//==============================================================================
+// Get File Revision
+//==============================================================================
+int Compositor::getFileRevision()
+{
+    return fileRevision;
+}
+
+//==============================================================================
+// Set File Revision - Reloads Images Modified On Disk
+//==============================================================================
+void Compositor::setFileRevision(const int& aFileRevision)
+{
+    // Check File Revision
+    if (fileRevision != aFileRevision) {
+        qDebug() << "Compositor::setFileRevision - aFileRevision: " << aFileRevision;
+        // Set File Revision
+        fileRevision = aFileRevision;
+        // Emit File Revision Changed Signal
+        emit fileRevisionChanged(fileRevision);
+
+        // Reload Images
+        reloadImages();
+    }
+}
+
+//==============================================================================
+// Get Current Frame
+//==============================================================================
+int Compositor::getCurrentFrame()
+{
+    return currentFrame;
+}
+
+//==============================================================================
+// Set Current Frame - Reloads Images At the Frame
+//==============================================================================
+void Compositor::setCurrentFrame(const int& aCurrentFrame)
+{
+    // Check Current Frame
+    if (currentFrame != aCurrentFrame) {
+        // Set Current Frame
+        currentFrame = aCurrentFrame;
+        // Emit Current Frame Changed Signal
+        emit currentFrameChanged(currentFrame);
+
+        // Reload Images
+        reloadImages();
+    }
+}
+
+//==============================================================================
+// Get Changed Blocks of Reloaded Image - False If It Can Not Be Patched Block By Block
+//==============================================================================
+static bool changedBlocks(const QImage& aPrevious, const BlockHashGrid& aPreviousGrid, const QImage& aImage, const BlockHashGrid& aGrid, QVector<int>& aBlocks)
+{
+    // Check Grids - Both Must Belong To Their Images & Share the Layout
+    if (!aPreviousGrid.isValidFor(aPrevious) || !aGrid.isValidFor(aImage) || aPreviousGrid.imageSize != aGrid.imageSize) {
+        return false;
+    }
+
+    // Get Differing Blocks
+    aBlocks = differingBlocks(aPreviousGrid, aGrid);
+
+    // Check Changed Share - Rescaling the Whole Image Is Cheaper Past It
+    return aBlocks.count() * 100 <= aGrid.hashes.count() * DEFAULT_COMPOSITOR_PATCH_MAX_PERCENT;
+}
+
+//==============================================================================
+// Patch Scaled Image With Changed Blocks - False If the Zoom Level Is Not an Integer Factor
+//
+// The Scaled Image May Be a Replicated Region Only, Starting At the Scaled Origin
+//==============================================================================
+static bool patchScaledImage(const QImage& aImage, const BlockHashGrid& aGrid, const QVector<int>& aBlocks, const qreal& aZoomLevel, const QPoint& aScaledOrigin, QImage& aScaledImage)
+{
+    // Get Zoom Factor
+    int factor = qRound(aZoomLevel);
+    // Get Scaled Rect - In Whole Scaled Image Pixels
+    QRect scaledRect(aScaledOrigin, aScaledImage.size());
+
+    // Check Integer Factor & Scaled Region - Replicated Blocks Only Match a Nearest Neighbour Rescale Then
+    if (factor < 1 || factor != aZoomLevel || aScaledImage.depth() != 32 || scaledRect.isEmpty() ||
+        !QRect(QPoint(0, 0), aImage.size() * factor).contains(scaledRect) || !aGrid.isValidFor(aImage)) {
+        return false;
+    }
+
+    // Check Blocks
+    if (aBlocks.isEmpty()) {
+        return true;
+    }
+
+    // Init Painter - Detaches the Scaled Image From the Previous Source Pixels
+    QPainter painter(&aScaledImage);
+    // Set Composition Mode - Blocks Replace Pixels, Alpha Included
+    painter.setCompositionMode(QPainter::CompositionMode_Source);
+
+    // Go Thru Blocks
+    for (int i = 0; i < aBlocks.count(); i++) {
+        // Get Block Rect
+        QRect blockRect = aGrid.blockRect(aBlocks[i]);
+        // Get Scaled Block Rect
+        QRect scaledBlockRect(blockRect.topLeft() * factor, blockRect.size() * factor);
+
+        // Check Scaled Block Rect - Blocks Outside the Replicated Region Are Replicated On Demand Later
+        if (!scaledRect.intersects(scaledBlockRect)) {
+            continue;
+        }
+
+        // Draw Block - Nearest Neighbour Replication Like the Fast Transform Scale, Clipped To the Scaled Image
+        painter.drawImage(scaledBlockRect.translated(-aScaledOrigin), aImage, blockRect);
+    }
+
+    return true;
+}
+
+//==============================================================================
+// Reload Images - Only Changed Blocks Are Rescaled When Pixels Allow It
+//==============================================================================
+void Compositor::reloadImages()
+{
+    // Check Current Files
+    if (currentFileLeft.isEmpty() && currentFileRight.isEmpty()) {
+        return;
+    }
+
+    // Set Match
+    setMatch(false);
+    // Set Status
+    setStatus(CSBusy);
+
+    // Get Previous Images & Block Hashes - Changes Are Found Against Them
+    QImage previousLeft = imageLeft;
+    BlockHashGrid previousGridLeft = hashGridLeft;
+    QImage previousRight = imageRight;
+    BlockHashGrid previousGridRight = hashGridRight;
+
+    // Init Changed Blocks
+    QVector<int> blocksLeft;
+    QVector<int> blocksRight;
+    // Init Patchable
+    bool patchable = !imageScaledLeft.isNull() || !imageScaledRight.isNull();
+
+    // Check Current File Left
+    if (!currentFileLeft.isEmpty()) {
+        // Reload Image
+        imageLeft = ImageCache::getInstance()->image(currentFileLeft, currentFrame);
+        // Get Block Hashes
+        hashGridLeft = ImageCache::getInstance()->blockHashes(currentFileLeft, currentFrame);
+        // Update Compare Mask
+        updateCompareMask();
+        // Get Changed Blocks
+        patchable = patchable && changedBlocks(previousLeft, previousGridLeft, imageLeft, hashGridLeft, blocksLeft);
+    }
+
+    // Check Current File Right
+    if (!currentFileRight.isEmpty()) {
+        // Reload Image
+        imageRight = ImageCache::getInstance()->image(currentFileRight, currentFrame);
+        // Get Block Hashes
+        hashGridRight = ImageCache::getInstance()->blockHashes(currentFileRight, currentFrame);
+        // Get Changed Blocks
+        patchable = patchable && changedBlocks(previousRight, previousGridRight, imageRight, hashGridRight, blocksRight);
+    }
+
+    // Set Registration Dirty
+    registrationDirty = true;
+
+    // Notify Composite Sizes Changed
+    notifyCompositeSizesChanged();
+
+    // Check Patchable
+    if (patchable) {
+        qDebug() << "Compositor::reloadImages - changed blocks: " << blocksLeft.count() << " / " << blocksRight.count();
+
+        // Lock Patch Blocks
+        QMutexLocker locker(&patchMutex);
+        // Queue Changed Blocks - Appended, Earlier Reloads May Not Be Patched Yet
+        patchBlocksLeft += blocksLeft;
+        patchBlocksRight += blocksRight;
+        // Unlock Patch Blocks
+        locker.unlock();
+
+        // Set Operation
+        setOperation(COTPatchImages);
+        // Schedule Operation
+        scheduleOperation(COTPatchImages);
+    } else {
+        // Set Operation
+        setOperation(COTScaleImages);
+        // Schedule Operation
+        scheduleOperation(COTScaleImages);
+    }
+}
+
+//==============================================================================
+// Get Auto Align
+//==============================================================================
+bool Compositor::getAutoAlign()
+{
+    return autoAlign;
+}
+
+//==============================================================================
+// Set Auto Align
+//==============================================================================
+void Compositor::setAutoAlign(const bool& aAutoAlign)
+{
+    // Check Auto Align
+    if (autoAlign != aAutoAlign) {
+        qDebug() << "Compositor::setAutoAlign - aAutoAlign: " << aAutoAlign;
+        // Set Auto Align
+        autoAlign = aAutoAlign;
+        // Emit Auto Align Changed Signal
+        emit autoAlignChanged(autoAlign);
+
+        // Set Registration Dirty
+        registrationDirty = true;
+
+        // Check Current Files
+        if (currentFileLeft.isEmpty() || currentFileRight.isEmpty()) {
+            return;
+        }
+
+        // Set Match
+        setMatch(false);
+        // Set Status
+        setStatus(CSBusy);
+        // Set Operation
+        setOperation(COTUpdateRects);
+
+        // Schedule Operation
+        scheduleOperation(COTUpdateRects);
+    }
+}
+
+//==============================================================================
+// Get Align Offset X - Right Image Translation Relative To Left In Source Pixels
+//==============================================================================
+int Compositor::getAlignOffsetX()
+{
+    return alignOffset.x();
+}
+
+//==============================================================================
+// Get Align Offset Y - Right Image Translation Relative To Left In Source Pixels
+//==============================================================================
+int Compositor::getAlignOffsetY()
+{
+    return alignOffset.y();
+}
+
+//==============================================================================
+// Set Align Offset
+//==============================================================================
+void Compositor::setAlignOffset(const QPoint& aAlignOffset)
+{
+    // Check Align Offset X
+    if (alignOffset.x() != aAlignOffset.x()) {
+        // Set Align Offset X
+        alignOffset.setX(aAlignOffset.x());
+        // Emit Align Offset X Changed Signal
+        emit alignOffsetXChanged(alignOffset.x());
+    }
+
+    // Check Align Offset Y
+    if (alignOffset.y() != aAlignOffset.y()) {
+        // Set Align Offset Y
+        alignOffset.setY(aAlignOffset.y());
+        // Emit Align Offset Y Changed Signal
+        emit alignOffsetYChanged(alignOffset.y());
+    }
+}
+
+//==============================================================================
+// Update Compare Mask
+//==============================================================================
+void Compositor::updateCompareMask()
+{
+    // Get Compare Mask - Shared With the QML Overlay Through the Mask Cache
+    maskLeft = compareMask(currentFileLeft, imageLeft.size());
+    // Reset Scaled Mask - Regenerated With the Scaled Image
+    maskScaledLeft = QImage();
+}
+
+//==============================================================================
+// Update Registration - Estimates Align Offset When Images Changed
+//==============================================================================
+void Compositor::updateRegistration()
+{
+    // Check Registration Dirty
+    if (!registrationDirty) {
+        return;
+    }
+
+    // Reset Registration Dirty
+    registrationDirty = false;
+    // Inc Registration Generation - Estimates Still In Flight Are Dropped
+    registrationGeneration++;
+
+    // Check Auto Align & Images
+    if (autoAlign && !imageLeft.isNull() && !imageRight.isNull()) {
+        // Emit Operate Registration Signal - Offset Is Applied When the Estimate Is Ready
+        emit operateRegistration(imageLeft, imageRight, registrationGeneration);
+        return;
+    }
+
+    // Reset Align Offset
+    setAlignOffset(QPoint(0, 0));
+}
+
+//==============================================================================
+// Worker Registration Ready Slot
+//==============================================================================
+void Compositor::workerRegistrationReady(const QPoint& aOffset, const int& aGeneration)
+{
+    // Check Generation - Images Or Auto Align Changed While Estimating
+    if (aGeneration != registrationGeneration || registrationDirty) {
+        return;
+    }
+
+    // Check Align Offset
+    if (aOffset == alignOffset) {
+        return;
+    }
+
+    // Set Align Offset
+    setAlignOffset(aOffset);
+
+    // Set Match
+    setMatch(false);
+    // Set Status
+    setStatus(CSBusy);
+    // Set Operation
+    setOperation(COTScaleRightImage);
+
+    // Schedule Operation - Replicated Right Region & Compare Follow the Offset
+    scheduleOperation(COTScaleRightImage);
+}
+
 //==============================================================================
 // Paint
 //==============================================================================
@@ -606,8 +1427,24 @@ void Compositor::updateLeftScaledImage()
     // Check Left Image Width & Height
     if (imageLeft.width() > 0 && imageLeft.height() > 0) {
         qDebug() << "Compositor::updateLeftScaledImage";
-        // Generate Scaled Image
-        imageScaledLeft = imageLeft.scaled(imageLeft.width() * zoomLevel, imageLeft.height() * zoomLevel);
+        // Set Scaled Size
+        scaledSizeLeft = QSize(imageLeft.width() * zoomLevel, imageLeft.height() * zoomLevel);
+
+        // Get Replicated Zoom Factor
+        int factor = replicatedZoom(imageLeft);
+
+        // Check Factor - Integer Zoom Levels Only Replicate the Region Around the Viewport
+        if (factor > 0) {
+            // Replicate Left Image
+            replicateLeftImage(factor);
+        } else {
+            // Generate Scaled Image - Zoomed Out Views Are Area Averaged So Thin Lines Do Not Vanish
+            imageScaledLeft = zoomLevel < 1.0 ? downscaleImage(imageLeft, scaledSizeLeft) : imageLeft.scaled(scaledSizeLeft);
+            // Generate Scaled Mask - Nearest Neighbour Keeps Mask Values Intact
+            maskScaledLeft = maskLeft.isNull() ? QImage() : maskLeft.scaled(imageScaledLeft.size());
+            // Reset Scaled Origin
+            scaledOriginLeft = QPoint(0, 0);
+        }
 
         // Update Left Source Rect
         updateLeftSourceRect();
@@ -617,6 +1454,12 @@ void Compositor::updateLeftScaledImage()
     } else {
         // Reset Scaled Left Image
         imageScaledLeft = QImage();
+        // Reset Scaled Left Mask
+        maskScaledLeft = QImage();
+        // Reset Scaled Origin
+        scaledOriginLeft = QPoint(0, 0);
+        // Reset Scaled Size
+        scaledSizeLeft = QSize(0, 0);
         // Reset Source Rect
         sourceRectLeft = QRect(0, 0, 0, 0);
         // Reset Target Rect
@@ -632,8 +1475,22 @@ void Compositor::updateRightScaledImage()
     // Check Right Image Width & Height
     if (imageRight.width() > 0 && imageRight.height() > 0) {
         qDebug() << "Compositor::updateRightScaledImage";
-        // Generate Scaled Image
-        imageScaledRight = imageRight.scaled(imageRight.width() * zoomLevel, imageRight.height() * zoomLevel);
+        // Set Scaled Size
+        scaledSizeRight = QSize(imageRight.width() * zoomLevel, imageRight.height() * zoomLevel);
+
+        // Get Replicated Zoom Factor
+        int factor = replicatedZoom(imageRight);
+
+        // Check Factor - Integer Zoom Levels Only Replicate the Region Around the Viewport
+        if (factor > 0) {
+            // Replicate Right Image
+            replicateRightImage(factor);
+        } else {
+            // Generate Scaled Image - Zoomed Out Views Are Area Averaged So Thin Lines Do Not Vanish
+            imageScaledRight = zoomLevel < 1.0 ? downscaleImage(imageRight, scaledSizeRight) : imageRight.scaled(scaledSizeRight);
+            // Reset Scaled Origin
+            scaledOriginRight = QPoint(0, 0);
+        }
 
         // Update Right Source Rect
         updateRightSourceRect();
@@ -643,6 +1500,10 @@ void Compositor::updateRightScaledImage()
     } else {
         // Reset Scaled Right Image
         imageScaledRight = QImage();
+        // Reset Scaled Origin
+        scaledOriginRight = QPoint(0, 0);
+        // Reset Scaled Size
+        scaledSizeRight = QSize(0, 0);
         // Reset Source Rect
         sourceRectRight = QRect(0, 0, 0, 0);
         // Reset Target Rect
@@ -650,16 +1511,148 @@ void Compositor::updateRightScaledImage()
     }
 }
 
+//==============================================================================
+// Patch Scaled Images With the Changed Blocks of Reloaded Images
+//==============================================================================
+void Compositor::patchScaledImages()
+{
+    // Lock Patch Blocks
+    QMutexLocker locker(&patchMutex);
+    // Take Changed Blocks
+    QVector<int> blocksLeft = patchBlocksLeft;
+    QVector<int> blocksRight = patchBlocksRight;
+    // Reset Changed Blocks
+    patchBlocksLeft.clear();
+    patchBlocksRight.clear();
+    // Unlock Patch Blocks
+    locker.unlock();
+
+    qDebug() << "Compositor::patchScaledImages - blocks: " << blocksLeft.count() << " / " << blocksRight.count();
+
+    // Patch Left Scaled Image
+    if (patchScaledImage(imageLeft, hashGridLeft, blocksLeft, zoomLevel, scaledOriginLeft, imageScaledLeft)) {
+        // Get Replicated Zoom Factor
+        int factor = replicatedZoom(imageLeft);
+        // Generate Scaled Mask - Mask File May Have Changed Too, Replicated Over the Same Region
+        maskScaledLeft = maskLeft.isNull() ? QImage() : factor > 0 ? replicateImageRegion(maskLeft, factor, QRect(scaledOriginLeft, imageScaledLeft.size()))
+                                                                   : maskLeft.scaled(imageScaledLeft.size());
+        // Update Left Source Rect
+        updateLeftSourceRect();
+        // Update Left Target Rect
+        updateLeftTargetRect();
+    } else {
+        // Update Left Scaled Image - Zoom Changed Since the Reload
+        updateLeftScaledImage();
+    }
+
+    // Patch Right Scaled Image
+    if (patchScaledImage(imageRight, hashGridRight, blocksRight, zoomLevel, scaledOriginRight, imageScaledRight)) {
+        // Update Right Source Rect
+        updateRightSourceRect();
+        // Update Right Target Rect
+        updateRightTargetRect();
+    } else {
+        // Update Right Scaled Image - Zoom Changed Since the Reload
+        updateRightScaledImage();
+    }
+}
+
+//==============================================================================
+// Get Replicated Zoom Factor - 0 Unless the Zoom Level Is an Integer Factor Above 1 & the Image Is 32 Bit
+//==============================================================================
+int Compositor::replicatedZoom(const QImage& aImage)
+{
+    // Get Zoom Factor
+    int factor = qRound(zoomLevel);
+
+    // Check Integer Factor & Image
+    if (factor < 2 || factor > DEFAULT_COMPOSITOR_REPLICATE_MAX_ZOOM || factor != zoomLevel || aImage.depth() != 32) {
+        return 0;
+    }
+
+    return factor;
+}
+
+//==============================================================================
+// Get Visible Rect of the Scaled Image of Size
+//==============================================================================
+QRect Compositor::visibleScaledRect(const QSize& aScaledSize)
+{
+    return QRect(qMax((qreal)aScaledSize.width() / 2 - boundingRect().width() / 2 - panPosX, 0.0),
+                 qMax((qreal)aScaledSize.height() / 2 - boundingRect().height() / 2 - panPosY, 0.0),
+                 qMin(boundingRect().width(), (qreal)aScaledSize.width()),
+                 qMin(boundingRect().height(), (qreal)aScaledSize.height()));
+}
+
+//==============================================================================
+// Get Needed Right Rect - Visible Right Rect & Visible Left Rect Shifted By the Align Offset
+//==============================================================================
+QRect Compositor::neededRightRect()
+{
+    // Get Visible Left Rect Shifted By the Scaled Align Offset - Compared Against the Right Image
+    QRect shiftedRect = visibleScaledRect(scaledSizeLeft).translated(qRound(alignOffset.x() * zoomLevel), qRound(alignOffset.y() * zoomLevel));
+
+    return visibleScaledRect(scaledSizeRight).united(shiftedRect).intersected(QRect(QPoint(0, 0), scaledSizeRight));
+}
+
+//==============================================================================
+// Replicate Left Image & Mask Around the Visible Rect
+//==============================================================================
+void Compositor::replicateLeftImage(const int& aFactor)
+{
+    // Get Region - Margin Keeps Short Pans From Replicating Again
+    QRect region = visibleScaledRect(scaledSizeLeft).adjusted(-DEFAULT_COMPOSITOR_REPLICATE_MARGIN, -DEFAULT_COMPOSITOR_REPLICATE_MARGIN,
+                                                              DEFAULT_COMPOSITOR_REPLICATE_MARGIN, DEFAULT_COMPOSITOR_REPLICATE_MARGIN);
+    // Clip Region
+    region = region.intersected(QRect(QPoint(0, 0), scaledSizeLeft));
+
+    //qDebug() << "Compositor::replicateLeftImage - aFactor: " << aFactor << " - region: " << region;
+
+    // Replicate Image
+    imageScaledLeft = replicateImageRegion(imageLeft, aFactor, region);
+    // Replicate Mask - Nearest Neighbour Keeps Mask Values Intact
+    maskScaledLeft = maskLeft.isNull() ? QImage() : replicateImageRegion(maskLeft, aFactor, region);
+    // Set Scaled Origin
+    scaledOriginLeft = region.topLeft();
+}
+
+//==============================================================================
+// Replicate Right Image Around the Needed Rect
+//==============================================================================
+void Compositor::replicateRightImage(const int& aFactor)
+{
+    // Get Region - Margin Keeps Short Pans From Replicating Again
+    QRect region = neededRightRect().adjusted(-DEFAULT_COMPOSITOR_REPLICATE_MARGIN, -DEFAULT_COMPOSITOR_REPLICATE_MARGIN,
+                                              DEFAULT_COMPOSITOR_REPLICATE_MARGIN, DEFAULT_COMPOSITOR_REPLICATE_MARGIN);
+    // Clip Region
+    region = region.intersected(QRect(QPoint(0, 0), scaledSizeRight));
+
+    //qDebug() << "Compositor::replicateRightImage - aFactor: " << aFactor << " - region: " << region;
+
+    // Replicate Image
+    imageScaledRight = replicateImageRegion(imageRight, aFactor, region);
+    // Set Scaled Origin
+    scaledOriginRight = region.topLeft();
+}
+
 //==============================================================================
 // Update Left Source Rect
 //==============================================================================
 void Compositor::updateLeftSourceRect()
 {
-    // Set Source Rect
-    sourceRectLeft = QRect(qMax((qreal)imageScaledLeft.width() / 2 - boundingRect().width() / 2 - panPosX, 0.0),
-                           qMax((qreal)imageScaledLeft.height() / 2 - boundingRect().height() / 2 - panPosY, 0.0),
-                           qMin(boundingRect().width(), (qreal)imageScaledLeft.width()),
-                           qMin(boundingRect().height(), (qreal)imageScaledLeft.height()));
+    // Get Visible Rect
+    QRect visibleRect = visibleScaledRect(scaledSizeLeft);
+    // Get Replicated Zoom Factor
+    int factor = replicatedZoom(imageLeft);
+
+    // Check Replicated Region - Panned Past the Margin
+    if (factor > 0 && !QRect(scaledOriginLeft, imageScaledLeft.size()).contains(visibleRect)) {
+        // Replicate Left Image
+        replicateLeftImage(factor);
+    }
+
+    // Set Source Rect - In Scaled Region Pixels
+    sourceRectLeft = visibleRect.translated(-scaledOriginLeft);
 }
 
 //==============================================================================
@@ -668,10 +1661,10 @@ void Compositor::updateLeftSourceRect()
 void Compositor::updateLeftTargetRect()
 {
     // Set Target Rect
-    targetRectLeft = QRect(qMax(boundingRect().width() / 2 - (qreal)imageScaledLeft.width() / 2, 0.0),
-                           qMax(boundingRect().height() / 2 - (qreal)imageScaledLeft.height() / 2, 0.0),
-                           qMin(boundingRect().width(), (qreal)imageScaledLeft.width()),
-                           qMin(boundingRect().height(), (qreal)imageScaledLeft.height()));
+    targetRectLeft = QRect(qMax(boundingRect().width() / 2 - (qreal)scaledSizeLeft.width() / 2, 0.0),
+                           qMax(boundingRect().height() / 2 - (qreal)scaledSizeLeft.height() / 2, 0.0),
+                           qMin(boundingRect().width(), (qreal)scaledSizeLeft.width()),
+                           qMin(boundingRect().height(), (qreal)scaledSizeLeft.height()));
 }
 
 //==============================================================================
@@ -679,11 +1672,17 @@ void Compositor::updateLeftTargetRect()
 //==============================================================================
 void Compositor::updateRightSourceRect()
 {
-    // Set Source Rect
-    sourceRectRight = QRect(qMax((qreal)imageScaledRight.width() / 2 - boundingRect().width() / 2 - panPosX, 0.0),
-                            qMax((qreal)imageScaledRight.height() / 2 - boundingRect().height() / 2 - panPosY, 0.0),
-                            qMin(boundingRect().width(), (qreal)imageScaledRight.width()),
-                            qMin(boundingRect().height(), (qreal)imageScaledRight.height()));
+    // Get Replicated Zoom Factor
+    int factor = replicatedZoom(imageRight);
+
+    // Check Replicated Region - Panned Past the Margin Or Align Offset Changed
+    if (factor > 0 && !QRect(scaledOriginRight, imageScaledRight.size()).contains(neededRightRect())) {
+        // Replicate Right Image
+        replicateRightImage(factor);
+    }
+
+    // Set Source Rect - In Scaled Region Pixels
+    sourceRectRight = visibleScaledRect(scaledSizeRight).translated(-scaledOriginRight);
 }
 
 //==============================================================================
@@ -692,10 +1691,10 @@ void Compositor::updateRightSourceRect()
 void Compositor::updateRightTargetRect()
 {
     // Set Target Rect
-    targetRectRight = QRect(qMax(boundingRect().width() / 2 - (qreal)imageScaledRight.width() / 2, 0.0),
-                            qMax(boundingRect().height() / 2 - (qreal)imageScaledRight.height() / 2, 0.0),
-                            qMin(boundingRect().width(), (qreal)imageScaledRight.width()),
-                            qMin(boundingRect().height(), (qreal)imageScaledRight.height()));
+    targetRectRight = QRect(qMax(boundingRect().width() / 2 - (qreal)scaledSizeRight.width() / 2, 0.0),
+                            qMax(boundingRect().height() / 2 - (qreal)scaledSizeRight.height() / 2, 0.0),
+                            qMin(boundingRect().width(), (qreal)scaledSizeRight.width()),
+                            qMin(boundingRect().height(), (qreal)scaledSizeRight.height()));
 }
 
 //==============================================================================
@@ -716,38 +1715,71 @@ void Compositor::compareImages()
         return;
     }
 
-    // Check Source Sizes
-    if (sourceRectLeft.width() == sourceRectRight.width() && sourceRectLeft.height() == sourceRectRight.height()) {
-
-        qDebug() << "Compositor::compareImages - [" << lWidth << "x" << lHeight << "]@[" << sourceRectLeft.x() << ":" << sourceRectLeft.y() << "]";
+    // Check Source Sizes - Aligned Images Are Compared Over Their Overlap Instead
+    if (alignOffset.isNull() && (sourceRectLeft.width() != sourceRectRight.width() || sourceRectLeft.height() != sourceRectRight.height())) {
+        return;
+    }
 
-        // Iterate Thru Image's Source Pixels
-        for (int y = sourceRectRight.y(); y < sourceRectRight.y() + lHeight && y < imageScaledLeft.height(); ++y) {
-            for (int x = sourceRectRight.x(); x < sourceRectRight.x() + lWidth && x < imageScaledLeft.width(); ++x) {
+    // Check Whole Verdict - Whole Images Matching For the Current Inputs Covers the Viewport
+    if (wholeProgress >= 1.0 && wholeMatch && wholeKeyLeft == imageLeft.cacheKey() && wholeKeyRight == imageRight.cacheKey() &&
+        wholeKeyMask == maskLeft.cacheKey() && wholeAlignOffset == alignOffset) {
+        // Set Match
+        setMatch(true);
+        return;
+    }
 
-//                if (x & 0x2) {
-//                    fprintf(stderr, ".");
-//                }
+    // Get Replicated Zoom Factor
+    int factor = replicatedZoom(imageRight);
 
-                if (imageScaledLeft.pixel(x, y) != imageScaledRight.pixel(x, y)) {
-                    qDebug() << "Compositor::compareImages - no match";
+    // Check Replicated Right Region - Align Offset May Have Changed Since the Rects Were Updated
+    if (factor > 0 && !QRect(scaledOriginRight, imageScaledRight.size()).contains(neededRightRect())) {
+        // Replicate Right Image
+        replicateRightImage(factor);
+    }
 
-//                    fprintf(stderr, "\n");
+    // Check Pixel Depths - Rows Are Compared As 32 Bit Pixels
+    if (imageScaledLeft.depth() != 32 || imageScaledRight.depth() != 32) {
+        qDebug() << "Compositor::compareImages - ERROR: UNSUPPORTED PIXEL DEPTH!";
+        return;
+    }
 
-                    // Set Match
-                    setMatch(false);
-                    return;
-                }
-            }
+    // Get Scaled Align Offset - Between the Scaled Regions
+    int offsetX = qRound(alignOffset.x() * zoomLevel) + scaledOriginLeft.x() - scaledOriginRight.x();
+    int offsetY = qRound(alignOffset.y() * zoomLevel) + scaledOriginLeft.y() - scaledOriginRight.y();
 
-//            fprintf(stderr, "\n");
-        }
+    // Get Left Region Overlapping the Shifted Right Image
+    int startX = qMax((int)sourceRectLeft.x(), -offsetX);
+    int startY = qMax((int)sourceRectLeft.y(), -offsetY);
+    int endX = qMin(qMin((int)sourceRectLeft.x() + lWidth, imageScaledLeft.width()), imageScaledRight.width() - offsetX);
+    int endY = qMin(qMin((int)sourceRectLeft.y() + lHeight, imageScaledLeft.height()), imageScaledRight.height() - offsetY);
 
+    // Check Overlap
+    if (startX >= endX || startY >= endY) {
         // Set Match
-        setMatch(true);
+        setMatch(false);
+        return;
+    }
 
-        qDebug() << "Compositor::compareImages - done";
+    qDebug() << "Compositor::compareImages - [" << endX - startX << "x" << endY - startY << "]@[" << startX << ":" << startY << "] - offset: [" << offsetX << ":" << offsetY << "] - masked: " << !maskScaledLeft.isNull();
+
+    // Get Block Hashes - Computed While Normalizing
+    BlockHashGrid leftGrid = ImageCache::getInstance()->blockHashes(currentFileLeft, currentFrame);
+    BlockHashGrid rightGrid = ImageCache::getInstance()->blockHashes(currentFileRight, currentFrame);
+
+    // Compare Regions - Unscaled Images Skip Blocks With Equal Hashes, Others Are Sampled Coarse To Fine & Verified In Parallel
+    if (!comparePixelRegions(imageScaledLeft, QPoint(startX, startY), imageScaledRight, QPoint(startX + offsetX, startY + offsetY), QSize(endX - startX, endY - startY), maskScaledLeft,
+                             &leftGrid, &rightGrid)) {
+        qDebug() << "Compositor::compareImages - no match";
+
+        // Set Match
+        setMatch(false);
+        return;
     }
+
+    // Set Match
+    setMatch(true);
+
+    qDebug() << "Compositor::compareImages - done";
 }
 
 //==============================================================================
@@ -760,9 +1792,9 @@ void Compositor::notifyCompositeSizesChanged()
     // Emit Source Composite Height Changed
     emit sourceCompositeHeightChanged(qMax(imageLeft.height(), imageRight.height()));
     // Emit Composite Width Changed Signal
-    emit compositeWidthChanged(qMax(imageScaledLeft.width(), imageScaledRight.width()));
+    emit compositeWidthChanged(qMax(scaledSizeLeft.width(), scaledSizeRight.width()));
     // Emit Composite Height Changed Signal
-    emit compositeHeightChanged(qMax(imageScaledLeft.height(), imageScaledRight.height()));
+    emit compositeHeightChanged(qMax(scaledSizeLeft.height(), scaledSizeRight.height()));
 }
 
 //==============================================================================
@@ -820,6 +1852,30 @@ void Compositor::stopWorkerThread()
 //==============================================================================
 void Compositor::workerResultReady(const int& aOperation, const int& aResult)
 {
+    // Reset Worker Busy
+    workerBusy = false;
+
+    // Check Pending Operation - Newer Input Arrived, Drop the Stale Compare
+    if (pendingOperation != COTNoOperation && aOperation != COTNoOperation) {
+        // Update
+        update();
+        // Notify Composite Sizes Changed
+        notifyCompositeSizesChanged();
+        // Update Positions
+        updatePositions();
+
+        // Check Window
+        if (frameWindow) {
+            // Request Dispatch
+            requestDispatch();
+        } else {
+            // Dispatch Pending Operation
+            dispatchPendingOperation();
+        }
+
+        return;
+    }
+
     switch (aOperation) {
         case COTNoOperation:
             // NOOP
@@ -828,6 +1884,7 @@ void Compositor::workerResultReady(const int& aOperation, const int& aResult)
         case COTScaleImages:
         case COTScaleLeftImage:
         case COTScaleRightImage:
+        case COTPatchImages:
             // Update
             update();
             // Notify Composite Sizes Changed
@@ -838,13 +1895,16 @@ void Compositor::workerResultReady(const int& aOperation, const int& aResult)
             // Update Positions
             updatePositions();
 
-            // ...
+            // Start Whole Compare - Images & Align Offset Are Settled By Now
+            startWholeCompare();
 
             // Set Operation
             setOperation(COTCompareImages);
             // Set Status
             setStatus(CSBusy);
 
+            // Set Worker Busy
+            workerBusy = true;
             // Emit Signal to Start Operation
             emit operateWorker(COTCompareImages);
         return;
@@ -860,11 +1920,16 @@ void Compositor::workerResultReady(const int& aOperation, const int& aResult)
             // Set Status
             setStatus(CSIdle);
 
+            // Start Whole Compare - Align Offset May Have Changed
+            startWholeCompare();
+
             // Set Operation
             setOperation(COTCompareImages);
             // Set Status
             setStatus(CSBusy);
 
+            // Set Worker Busy
+            workerBusy = true;
             // Emit Signal to Start Operation
             emit operateWorker(COTCompareImages);
         return;
@@ -889,18 +1954,71 @@ void Compositor::geometryChanged(const QRectF& aNewGeometry, const QRectF& aOldG
     //qDebug() << "Compositor::geometryChanged - aNewGeometry: " << aNewGeometry;
 
     if (currentFileLeft != "" || currentFileRight != "") {
-        // Init Worker
-        initWorker();
-        // Emit Signal to Start Operation
-        emit operateWorker(COTUpdateRects);
+        // Schedule Operation
+        scheduleOperation(COTUpdateRects);
+    }
+}
+
+//==============================================================================
+// Item Change
+//==============================================================================
+void Compositor::itemChange(ItemChange aChange, const ItemChangeData& aValue)
+{
+    // Calling Super Item Change
+    QQuickPaintedItem::itemChange(aChange, aValue);
+
+    // Check Change
+    if (aChange == ItemSceneChange) {
+        // Check Previous Frame Window
+        if (frameWindow) {
+            // Disconnect Frame Swapped Signal
+            disconnect(frameWindow, SIGNAL(frameSwapped()), this, SLOT(frameSwapped()));
+        }
+
+        // Set Frame Window
+        frameWindow = aValue.window;
+
+        // Check New Frame Window
+        if (frameWindow) {
+            // Connect Frame Swapped Signal
+            connect(frameWindow, SIGNAL(frameSwapped()), this, SLOT(frameSwapped()));
+        }
     }
 }
 
+//==============================================================================
+// Timer Event
+//==============================================================================
+void Compositor::timerEvent(QTimerEvent* aEvent)
+{
+    // Check Event
+    if (aEvent && aEvent->timerId() == dispatchTimerID) {
+        // Kill Fallback Timer
+        killTimer(dispatchTimerID);
+        // Reset Fallback Timer ID
+        dispatchTimerID = -1;
+
+        // No Frame Swapped Arrived In Time, Dispatch Anyway
+        frameSwapped();
+        return;
+    }
+
+    // Calling Super Timer Event
+    QQuickPaintedItem::timerEvent(aEvent);
+}
+
 //==============================================================================
 // Destructor
 //==============================================================================
 Compositor::~Compositor()
 {
+    // Inc Whole Generation - Drops the Running Compare
+    wholeGeneration.ref();
+    // Clear Queued Compare
+    wholePool.clear();
+    // Wait For Running Compare
+    wholePool.waitForDone();
+
     // Stop Worker Thread
     stopWorkerThread();
 
@@ -964,6 +2082,12 @@ void CompositorWorker::doWork(const int& aOperation)
 
     //qDebug() << "CompositorWorker::doWork - aOperation: " << aOperation;
 
+    // Check Operation
+    if (aOperation != COTCompareImages) {
+        // Update Registration - Queues an Estimate When Images Or Auto Align Changed
+        compositor->updateRegistration();
+    }
+
     // Switch Operation
     switch (aOperation) {
         case COTScaleImages:
@@ -981,6 +2105,11 @@ void CompositorWorker::doWork(const int& aOperation)
             compositor->updateRightScaledImage();
         break;
 
+        case COTPatchImages:
+            // Patch Scaled Images
+            compositor->patchScaledImages();
+        break;
+
         case COTCompareImages:
             // Compare Images
             compositor->compareImages();
@@ -1008,6 +2137,21 @@ void CompositorWorker::doWork(const int& aOperation)
     emit resultReady(aOperation, 0);
 }
 
+//==============================================================================
+// Do Registration - Estimates Align Offset Off the GUI Thread
+//==============================================================================
+void CompositorWorker::doRegistration(const QImage& aImageLeft, const QImage& aImageRight, const int& aGeneration)
+{
+    // Init Offset
+    QPoint offset(0, 0);
+
+    // Estimate Translation - Offset Stays Zero When There Is No Reliable Peak
+    estimateTranslation(aImageLeft, aImageRight, offset);
+
+    // Emit Registration Ready Signal
+    emit registrationReady(offset, aGeneration);
+}
+
 //==============================================================================
 // Stop
 //==============================================================================
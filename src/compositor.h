@@ -4,10 +4,20 @@
 #include <QQuickPaintedItem>
 #include <QPainter>
 #include <QImage>
+#include <QPoint>
 #include <QThread>
+#include <QMutex>
+#include <QVector>
+#include <QThreadPool>
+#include <QAtomicInt>
+#include <QTimerEvent>
+
+#include "blockhash.h"
 
 class MainWindow;
 class CompositorWorker;
+class CompositorWholeTask;
+class QQuickWindow;
 
 //==============================================================================
 // Worker Class Operation Types
@@ -22,6 +32,7 @@ enum COperationType
     COTUpdateRects,
     COTUpdateLeftRects,
     COTUpdateRightRects,
+    COTPatchImages,
 };
 
 
@@ -34,6 +45,8 @@ class Compositor : public QQuickPaintedItem
     Q_OBJECT
 
     Q_PROPERTY(bool match READ getMatch NOTIFY matchChanged)
+    Q_PROPERTY(bool wholeMatch READ getWholeMatch NOTIFY wholeMatchChanged)
+    Q_PROPERTY(qreal wholeProgress READ getWholeProgress NOTIFY wholeProgressChanged)
 
     Q_PROPERTY(int status READ getStatus NOTIFY statusChanged)
     Q_PROPERTY(int operation READ getOperation NOTIFY operationChanged)
@@ -57,6 +70,14 @@ class Compositor : public QQuickPaintedItem
 
     Q_PROPERTY(bool showGrid READ getShowGrid WRITE setShowGrid NOTIFY showGridChanged)
 
+    Q_PROPERTY(int fileRevision READ getFileRevision WRITE setFileRevision NOTIFY fileRevisionChanged)
+
+    Q_PROPERTY(int currentFrame READ getCurrentFrame WRITE setCurrentFrame NOTIFY currentFrameChanged)
+
+    Q_PROPERTY(bool autoAlign READ getAutoAlign WRITE setAutoAlign NOTIFY autoAlignChanged)
+    Q_PROPERTY(int alignOffsetX READ getAlignOffsetX NOTIFY alignOffsetXChanged)
+    Q_PROPERTY(int alignOffsetY READ getAlignOffsetY NOTIFY alignOffsetYChanged)
+
 public:
 
     // Compositor Status Type
@@ -71,9 +92,14 @@ public:
     // Constructor
     Compositor(QQuickItem* aParent = NULL);
 
-    // Get Matching
+    // Get Matching - Visible Part Only
     bool getMatch();
 
+    // Get Whole Matching - Valid When the Whole Progress Reaches 1
+    bool getWholeMatch();
+    // Get Whole Progress
+    qreal getWholeProgress();
+
     // Get Status
     int getStatus();
 
@@ -130,6 +156,26 @@ public:
     // Set Show Grid
     void setShowGrid(const bool& aShowGrid);
 
+    // Get File Revision
+    int getFileRevision();
+    // Set File Revision - Reloads Images Modified On Disk
+    void setFileRevision(const int& aFileRevision);
+
+    // Get Current Frame
+    int getCurrentFrame();
+    // Set Current Frame - Reloads Images At the Frame
+    void setCurrentFrame(const int& aCurrentFrame);
+
+    // Get Auto Align
+    bool getAutoAlign();
+    // Set Auto Align
+    void setAutoAlign(const bool& aAutoAlign);
+
+    // Get Align Offset X - Right Image Translation Relative To Left In Source Pixels
+    int getAlignOffsetX();
+    // Get Align Offset Y - Right Image Translation Relative To Left In Source Pixels
+    int getAlignOffsetY();
+
     // Paint
     virtual void paint(QPainter* aPainter);
 
@@ -140,6 +186,10 @@ signals:
 
     // Match Changed Signal
     void matchChanged(const bool& aMatch);
+    // Whole Match Changed Signal
+    void wholeMatchChanged(const bool& aWholeMatch);
+    // Whole Progress Changed Signal
+    void wholeProgressChanged(const qreal& aWholeProgress);
 
     // Source Composite Width Changed Signal
     void sourceCompositeWidthChanged(const qreal& aCompositeWidth);
@@ -177,16 +227,45 @@ signals:
     // Show Grid Changed Signal
     void showGridChanged(const bool& aShowGrid);
 
+    // File Revision Changed Signal
+    void fileRevisionChanged(const int& aFileRevision);
+
+    // Current Frame Changed Signal
+    void currentFrameChanged(const int& aCurrentFrame);
+
+    // Auto Align Changed Signal
+    void autoAlignChanged(const bool& aAutoAlign);
+    // Align Offset X Changed Signal
+    void alignOffsetXChanged(const int& aAlignOffsetX);
+    // Align Offset Y Changed Signal
+    void alignOffsetYChanged(const int& aAlignOffsetY);
+
     // Operate Worker Signel
     void operateWorker(const int& aOperation);
+    // Operate Registration Signal - Queued To the Worker Thread
+    void operateRegistration(const QImage& aImageLeft, const QImage& aImageRight, const int& aGeneration);
 
 protected:
 
     // Init Worker
     void initWorker();
 
+    // Schedule Operation - Coalesced To At Most One Dispatch Per Frame
+    void scheduleOperation(const int& aOperation);
+    // Request Dispatch - Next Frame Swap Or the Fallback Timer, Whichever Comes First
+    void requestDispatch();
+    // Dispatch Pending Operation
+    void dispatchPendingOperation();
+
     // Set Match
     void setMatch(const bool& aMatch);
+    // Set Whole Match
+    void setWholeMatch(const bool& aWholeMatch);
+    // Set Whole Progress
+    void setWholeProgress(const qreal& aWholeProgress);
+
+    // Start Whole Compare - Unless the Verdict For the Current Inputs Is Already Known
+    void startWholeCompare();
 
     // Set Status
     void setStatus(const int& aStatus);
@@ -202,6 +281,20 @@ protected:
     // Update Right Scaled Image According to Zoom Level
     void updateRightScaledImage();
 
+    // Patch Scaled Images With the Changed Blocks of Reloaded Images
+    void patchScaledImages();
+
+    // Get Replicated Zoom Factor - 0 Unless the Zoom Level Is an Integer Factor Above 1 & the Image Is 32 Bit
+    int replicatedZoom(const QImage& aImage);
+    // Get Visible Rect of the Scaled Image of Size
+    QRect visibleScaledRect(const QSize& aScaledSize);
+    // Get Needed Right Rect - Visible Right Rect & Visible Left Rect Shifted By the Align Offset
+    QRect neededRightRect();
+    // Replicate Left Image & Mask Around the Visible Rect
+    void replicateLeftImage(const int& aFactor);
+    // Replicate Right Image Around the Needed Rect
+    void replicateRightImage(const int& aFactor);
+
     // Update Left Source Rect
     void updateLeftSourceRect();
     // Update Left Target Rect
@@ -212,6 +305,17 @@ protected:
     // Update Right Target Rect
     void updateRightTargetRect();
 
+    // Update Compare Mask
+    void updateCompareMask();
+
+    // Reload Images
+    void reloadImages();
+
+    // Update Registration - Estimates Align Offset When Images Changed
+    void updateRegistration();
+    // Set Align Offset
+    void setAlignOffset(const QPoint& aAlignOffset);
+
     // Compare Images
     void compareImages();
 
@@ -228,14 +332,29 @@ protected slots:
 
     // Worker Result Ready Slot
     void workerResultReady(const int& aOperation, const int& aResult);
+    // Worker Registration Ready Slot
+    void workerRegistrationReady(const QPoint& aOffset, const int& aGeneration);
+
+    // Frame Swapped Slot
+    void frameSwapped();
+
+    // Whole Compare Progress Slot - Posted By the Whole Compare Task
+    void wholeCompareProgress(const int& aGeneration, const qreal& aProgress);
+    // Whole Compare Finished Slot - Posted By the Whole Compare Task
+    void wholeCompareFinished(const int& aGeneration, const bool& aMatch);
 
 protected:
 
     // Geometry Changed
     virtual void geometryChanged(const QRectF& aNewGeometry, const QRectF& aOldGeometry);
+    // Item Change
+    virtual void itemChange(ItemChange aChange, const ItemChangeData& aValue);
+    // Timer Event
+    virtual void timerEvent(QTimerEvent* aEvent);
 
 private:
     friend class CompositorWorker;
+    friend class CompositorWholeTask;
 
     // Main Window
     MainWindow*         mainWindow;
@@ -245,8 +364,12 @@ private:
     // Operation
     int                 operation;
 
-    // Match
+    // Match - Visible Part Only
     bool                match;
+    // Whole Match
+    bool                wholeMatch;
+    // Whole Progress
+    qreal               wholeProgress;
 
     // Current Left File
     QString             currentFileLeft;
@@ -255,8 +378,18 @@ private:
 
     // Left Image
     QImage              imageLeft;
-    // Left Image Scaled
+    // Left Image Block Hashes
+    BlockHashGrid       hashGridLeft;
+    // Left Image Scaled - Only a Region Around the Viewport When Replicated
     QImage              imageScaledLeft;
+    // Left Image Scaled Origin - Top Left of the Scaled Region
+    QPoint              scaledOriginLeft;
+    // Left Image Scaled Size - Whole Scaled Image
+    QSize               scaledSizeLeft;
+    // Left Compare Mask - Keep Mask In Left Image Pixels
+    QImage              maskLeft;
+    // Left Compare Mask Scaled
+    QImage              maskScaledLeft;
     // Left Source Rect
     QRectF              sourceRectLeft;
     // Left Target Rect
@@ -264,8 +397,14 @@ private:
 
     // Right Image
     QImage              imageRight;
-    // Right Image
+    // Right Image Block Hashes
+    BlockHashGrid       hashGridRight;
+    // Right Image Scaled - Only a Region Around the Viewport When Replicated
     QImage              imageScaledRight;
+    // Right Image Scaled Origin - Top Left of the Scaled Region
+    QPoint              scaledOriginRight;
+    // Right Image Scaled Size - Whole Scaled Image
+    QSize               scaledSizeRight;
     // Right Source Rect
     QRectF              sourceRectRight;
     // Right Target Rect
@@ -296,6 +435,43 @@ private:
     // Grid Step
     int                 gridStep;
 
+    // File Revision
+    int                 fileRevision;
+
+    // Current Frame of Animated & Multi Page Images
+    int                 currentFrame;
+
+    // Auto Align
+    bool                autoAlign;
+    // Align Offset - Right Image Translation Relative To Left
+    QPoint              alignOffset;
+    // Registration Dirty - Images Changed Since Last Estimate
+    bool                registrationDirty;
+    // Registration Generation - Drops Estimates For Replaced Images
+    int                 registrationGeneration;
+
+    // Patch Mutex - Blocks Are Queued By the GUI Thread, Taken By the Worker
+    QMutex              patchMutex;
+    // Changed Blocks of the Left Image Waiting To Be Patched
+    QVector<int>        patchBlocksLeft;
+    // Changed Blocks of the Right Image Waiting To Be Patched
+    QVector<int>        patchBlocksRight;
+
+    // Whole Compare Generation - Bumped To Drop the Running Compare When Inputs Change
+    QAtomicInt          wholeGeneration;
+    // Whole Compare Paused - Set While the Compositor Is Busy, the Whole Compare Yields Between Bands
+    QAtomicInt          wholePaused;
+    // Whole Compare Pool
+    QThreadPool         wholePool;
+    // Whole Compare Left Image Key
+    qint64              wholeKeyLeft;
+    // Whole Compare Right Image Key
+    qint64              wholeKeyRight;
+    // Whole Compare Mask Key
+    qint64              wholeKeyMask;
+    // Whole Compare Align Offset
+    QPoint              wholeAlignOffset;
+
     // Grid Normal Pen
     QPen                gridPen;
     // Grid Section Pen
@@ -313,6 +489,15 @@ private:
     QThread             workerThread;
     // Compositor Worker
     CompositorWorker*   worker;
+
+    // Pending Operation - Latest Coalesced Input Waiting For the Next Frame
+    int                 pendingOperation;
+    // Worker Busy
+    bool                workerBusy;
+    // Window Providing the Frame Swapped Signal
+    QQuickWindow*       frameWindow;
+    // Dispatch Fallback Timer ID - Frame Swapped Is Not Reliable Under QQuickWidget
+    int                 dispatchTimerID;
 };
 
 
@@ -343,11 +528,17 @@ signals:
     // Refresh Compositor
     void refreshCompositor();
 
+    // Registration Ready Signal
+    void registrationReady(const QPoint& aOffset, const int& aGeneration);
+
 public slots:
 
     // Do Work
     void doWork(const int& aOperation);
 
+    // Do Registration - Estimates Align Offset Off the GUI Thread
+    void doRegistration(const QImage& aImageLeft, const QImage& aImageRight, const int& aGeneration);
+
     // Stop
     void stop();
 
@@ -7,7 +7,8 @@
 //==============================================================================
 ConfirmationDialog::ConfirmationDialog(QWidget* aParent)
     : QDialog(aParent),
-    ui(new Ui::ConfirmationDialog)
+    ui(new Ui::ConfirmationDialog),
+    clickedButton(QDialogButtonBox::NoButton)
 {
     ui->setupUi(this);
 }
@@ -21,6 +22,32 @@ void ConfirmationDialog::setConfirmationText(const QString& aConfirmationText)
     ui->confirmationTextLabel->setText(aConfirmationText);
 }
 
+//==============================================================================
+// Set Standard Buttons
+//==============================================================================
+void ConfirmationDialog::setStandardButtons(const QDialogButtonBox::StandardButtons& aButtons)
+{
+    // Set Buttons
+    ui->buttonBox->setStandardButtons(aButtons);
+}
+
+//==============================================================================
+// Get Clicked Button
+//==============================================================================
+int ConfirmationDialog::getClickedButton()
+{
+    return clickedButton;
+}
+
+//==============================================================================
+// Button Box Clicked Slot
+//==============================================================================
+void ConfirmationDialog::on_buttonBox_clicked(QAbstractButton* aButton)
+{
+    // Set Clicked Button
+    clickedButton = ui->buttonBox->standardButton(aButton);
+}
+
 //==============================================================================
 // Destructor
 //==============================================================================
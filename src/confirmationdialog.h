@@ -2,6 +2,7 @@
 #define CONFIRMATIONDIALOG_H
 
 #include <QDialog>
+#include <QDialogButtonBox>
 
 namespace Ui {
 class ConfirmationDialog;
@@ -22,13 +23,27 @@ public:
     // Set Confirmation Text
     void setConfirmationText(const QString& aConfirmationText);
 
+    // Set Standard Buttons
+    void setStandardButtons(const QDialogButtonBox::StandardButtons& aButtons);
+
+    // Get Clicked Button
+    int getClickedButton();
+
     // Destructor
     virtual ~ConfirmationDialog();
 
+private slots:
+
+    // Button Box Clicked Slot
+    void on_buttonBox_clicked(QAbstractButton* aButton);
+
 private:
 
     // UI
     Ui::ConfirmationDialog*     ui;
+
+    // Clicked Button
+    int                         clickedButton;
 };
 
 #endif // CONFIRMATIONDIALOG_H
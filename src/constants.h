@@ -17,15 +17,19 @@
 
 #define DEFAULT_CUSTOM_COMPONENTS                       "customcomponents"
 #define DEFAULT_CUSTOM_COMPONENT_COMPOSITOR             "Compositor"
+#define DEFAULT_CUSTOM_COMPONENT_TILED_IMAGE            "TiledImage"
 
 #define CONTEXT_PROPERTY_SIDE                           "side"
 
 #define CONTEXT_PROPERTY_SIDE_VALUE_LEFT                "left"
 #define CONTEXT_PROPERTY_SIDE_VALUE_RIGHT               "right"
 
+#define CONTEXT_PROPERTY_DIRECTORY_MODEL                "directoryModel"
+
 #define QML_SOURCE_SIDE_VIEW                            "qrc:/qml/ImageView.qml"
 #define QML_SOURCE_COMPOSITE_VIEW                       "qrc:/qml/CompositeView.qml"
 #define QML_SOURCE_VIEWER_VIEW                          "qrc:/qml/Viewer.qml"
+#define QML_SOURCE_THUMBNAIL_STRIP                      "qrc:/qml/ThumbnailStrip.qml"
 
 // Settings Groups
 
@@ -60,6 +64,16 @@
 #define SETTINGS_KEY_OPACITY_LEFT                       SETTINGS_GROUP_UI"/opacityLeft"
 #define SETTINGS_KEY_OPACITY_RIGHT                      SETTINGS_GROUP_UI"/opacityRight"
 
+#define SETTINGS_KEY_RESULT_CACHE_SIZE_MB               SETTINGS_GROUP_MAIN"/resultCacheSizeMB"
+
+#define SETTINGS_KEY_DECODED_CACHE_ENABLED              SETTINGS_GROUP_MAIN"/decodedCacheEnabled"
+#define SETTINGS_KEY_DECODED_CACHE_SIZE_MB              SETTINGS_GROUP_MAIN"/decodedCacheSizeMB"
+#define SETTINGS_KEY_DECODED_CACHE_PYRAMID              SETTINGS_GROUP_MAIN"/decodedCachePyramid"
+
+#define SETTINGS_KEY_WATCH_FILES                        SETTINGS_GROUP_MAIN"/watchFiles"
+
+#define SETTINGS_KEY_TILED_IMAGE_TEXTURE_CACHE_MB       SETTINGS_GROUP_MAIN"/tiledImageTextureCacheMB"
+
 
 // Supported Formats
 
@@ -70,8 +84,10 @@
 #define DEFAULT_SUPPORTED_FORMAT_JPEG                   "jpeg"
 #define DEFAULT_SUPPORTED_FORMAT_GIF                    "gif"
 #define DEFAULT_SUPPORTED_FORMAT_PNG                    "png"
+#define DEFAULT_SUPPORTED_FORMAT_TIF                    "tif"
+#define DEFAULT_SUPPORTED_FORMAT_TIFF                   "tiff"
 
-#define DEFAULT_SUPPORTED_FORMATS_FILTER                "*.png *.jpg *.jpeg *.bmp *.gif"
+#define DEFAULT_SUPPORTED_FORMATS_FILTER                "*.png *.jpg *.jpeg *.bmp *.gif *.tif *.tiff *.pam *.ppm *.pgm *.raw"
 
 
 
@@ -93,6 +109,8 @@ const int gridSectionSteps[] =    {    1,    1,    1,    1,   40,   80,  160,  3
 #define TRANSFORM_ROTATE_LEFT                           -90
 #define TRANSFORM_ROTATE_RIGHT                          90
 
+#define DEFAULT_TRANSFORM_PROGRESS_INTERVAL             100
+
 
 enum FlipDirectionType
 {
@@ -111,6 +129,118 @@ enum RotationDirectionType
 #define DEFAULT_TRANSFER_OPTIONS_YES_TO_ALL             0x0001
 #define DEFAULT_TRANSFER_OPTIONS_NO_TO_ALL              0x0010
 
+#define DEFAULT_TRANSFER_CHUNK_SIZE                     (8 * 1024 * 1024)
+#define DEFAULT_TRANSFER_BUFFER_SIZE                    (1024 * 1024)
+#define DEFAULT_TRANSFER_DEVICE_PARALLELISM             2
+#define DEFAULT_TRANSFER_PROGRESS_INTERVAL              250
+
+#define DEFAULT_IMAGE_CACHE_PROVIDER_ID                 "imagecache"
+#define DEFAULT_IMAGE_CACHE_SOURCE_PREFIX               "image://imagecache/"
+#define DEFAULT_IMAGE_CACHE_RECENT_COUNT                2
+#define DEFAULT_IMAGE_CACHE_PREFETCH_YIELD_MS           10
+
+#define DEFAULT_NORMALIZE_MIN_BAND_ROWS                 64
+
+#define DEFAULT_COARSE_COMPARE_START_STRIDE             64
+#define DEFAULT_COARSE_COMPARE_END_STRIDE               8
+#define DEFAULT_COARSE_COMPARE_MIN_BAND_ROWS            256
+
+#define DEFAULT_BLOCK_HASH_SIZE                         32
+#define DEFAULT_BLOCK_HASH_SEED                         0x243F6A8885A308D3ULL
+#define DEFAULT_BLOCK_HASH_MULTIPLIER                   0x9E3779B97F4A7C15ULL
+
+#define DEFAULT_COMPOSITOR_PATCH_MAX_PERCENT            50
+#define DEFAULT_COMPOSITOR_REPLICATE_MARGIN             256
+#define DEFAULT_COMPOSITOR_REPLICATE_MAX_ZOOM           32
+#define DEFAULT_COMPOSITOR_WHOLE_BAND_ROWS              256
+#define DEFAULT_COMPOSITOR_WHOLE_BAND_BLOCKS            64
+#define DEFAULT_COMPOSITOR_WHOLE_YIELD_MS               10
+#define DEFAULT_COMPOSITOR_DISPATCH_FALLBACK_MS         32
+
+#define DEFAULT_DOWNSCALE_MIN_BAND_ROWS                 32
+
+#define DEFAULT_FILE_WATCH_DEBOUNCE_MS                  250
+#define DEFAULT_FILE_WATCH_MAX_CHECKS                   40
+#define DEFAULT_FILE_WATCH_MISSING_POLL_MS              1000
+
+#define DEFAULT_DIRECTORY_SCAN_BUFFER_SIZE              65536
+#define DEFAULT_DIRECTORY_SCAN_BATCH_SIZE               4096
+#define DEFAULT_DIRECTORY_WATCH_BUFFER_SIZE             16384
+
+#define DEFAULT_THUMBNAIL_PROVIDER_ID                   "thumbnail"
+#define DEFAULT_THUMBNAIL_DIR_NAME                      "thumbnails/normal"
+#define DEFAULT_THUMBNAIL_SIZE                          128
+#define DEFAULT_THUMBNAIL_KEY_URI                       "Thumb::URI"
+#define DEFAULT_THUMBNAIL_KEY_MTIME                     "Thumb::MTime"
+#define DEFAULT_THUMBNAIL_EXIF_READ_SIZE                65536
+#define DEFAULT_EXIF_TAG_THUMBNAIL_OFFSET               0x0201
+#define DEFAULT_EXIF_TAG_THUMBNAIL_LENGTH               0x0202
+
+#define DEFAULT_TILED_IMAGE_TILE_SIZE                   256
+#define DEFAULT_TILED_IMAGE_OVERVIEW_SIZE               2048
+#define DEFAULT_TILED_IMAGE_PRELOAD_TILES               1
+#define DEFAULT_TILED_IMAGE_OPENED_MAX_MB               256
+#define DEFAULT_TILED_IMAGE_OPEN_THREADS                2
+
+#define DEFAULT_DEEP_COMPARE_TILE_ROWS                  128
+#define DEFAULT_DEEP_COMPARE_FLUSH_INTERVAL             8192
+
+#define DEFAULT_DIFF_MAP_BLOCK_SIZE                     16
+
+#define DEFAULT_DISK_CACHE_LOCK_FILE_NAME               ".lock"
+#define DEFAULT_DISK_CACHE_USAGE_FILE_NAME              ".usage"
+#define DEFAULT_DISK_CACHE_LOCK_TIMEOUT                 100
+#define DEFAULT_DISK_CACHE_LOW_WATER_PERCENT            90
+
+#define DEFAULT_RESULT_CACHE_DIR_NAME                   "results"
+#define DEFAULT_RESULT_CACHE_FILE_SUFFIX                ".result"
+#define DEFAULT_RESULT_CACHE_MAGIC                      0x43524349
+#define DEFAULT_RESULT_CACHE_VERSION                    1
+#define DEFAULT_RESULT_CACHE_MODE_DEEP                  "deep"
+#define DEFAULT_RESULT_CACHE_MODE_EXACT                 "exact"
+
+#define DEFAULT_DECODED_CACHE_DIR_NAME                  "decoded"
+#define DEFAULT_DECODED_CACHE_FILE_SUFFIX               ".raw"
+#define DEFAULT_DECODED_CACHE_MIN_PIXELS                4194304
+#define DEFAULT_DECODED_CACHE_MIN_LEVEL_SIZE            256
+#define DEFAULT_DECODED_CACHE_MAX_PENDING_WRITES        2
+
+#define DEFAULT_FRAME_COMPARE_PIPELINE_DEPTH            8
+
+#define DEFAULT_HEADLESS_EXIT_MATCH                     0
+#define DEFAULT_HEADLESS_EXIT_DIFFER                    1
+#define DEFAULT_HEADLESS_EXIT_ERROR                     2
+
+#define DEFAULT_DAEMON_SERVER_NAME                      "ImageCompareDaemon"
+#define DEFAULT_DAEMON_STREAM_VERSION                   QDataStream::Qt_5_6
+#define DEFAULT_DAEMON_MAX_MESSAGE_SIZE                 65536
+#define DEFAULT_DAEMON_MAX_PENDING                      64
+#define DEFAULT_DAEMON_CONNECT_TIMEOUT                  1000
+#define DEFAULT_DAEMON_RESPONSE_TIMEOUT                 60000
+#define DEFAULT_DAEMON_DESCRIPTOR_SUFFIX                ".fd"
+#define DEFAULT_DAEMON_MAX_OUTPUT_BYTES                 1048576
+
+#define DEFAULT_SHARED_IMAGE_PREFIX                     "shm:"
+#define DEFAULT_SHARED_IMAGE_MAGIC                      0x49435349
+#define DEFAULT_SHARED_IMAGE_VERSION                    1
+
+#define DEFAULT_MAPPED_IMAGE_SUFFIXES                   "pam ppm pgm raw"
+#define DEFAULT_MAPPED_IMAGE_RAW_SUFFIX                 "raw"
+#define DEFAULT_MAPPED_IMAGE_MAX_TOKEN                  64
+
+#define DEFAULT_REGISTRATION_LEVEL_SIZE                 512
+#define DEFAULT_REGISTRATION_MIN_LEVEL_SIZE             16
+#define DEFAULT_REGISTRATION_MIN_CONFIDENCE             0.03
+#define DEFAULT_REGISTRATION_REFINE_SAMPLES             256
+#define DEFAULT_REGISTRATION_REFINE_RADIUS              1
+
+#define DEFAULT_COMPARE_MASK_PROVIDER_ID                "comparemask"
+#define DEFAULT_COMPARE_MASK_SOURCE_PREFIX              "image://comparemask/"
+#define DEFAULT_COMPARE_MASK_FILE_SUFFIX                ".mask"
+#define DEFAULT_COMPARE_MASK_DIR_FILE_NAME              ".compare.mask"
+#define DEFAULT_COMPARE_MASK_CACHE_COUNT                8
+#define DEFAULT_LEARNED_MASK_FILE_NAME                  ".compare.mask.png"
+
 
 #define DEFAULT_COLOR_IMAGE_COMPARE_MATCH               qRgba(0, 200, 0, 50)
 #define DEFAULT_COLOR_IMAGE_COMPARE_NOMATCH             qRgba(200, 0, 0, 50)
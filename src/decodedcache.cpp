@@ -0,0 +1,309 @@
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QSettings>
+#include <QStandardPaths>
+#include <QCryptographicHash>
+#include <QRunnable>
+
+#include <string.h>
+
+#include "decodedcache.h"
+#include "sharedimage.h"
+#include "mappedimage.h"
+#include "utility.h"
+#include "imagescaler.h"
+#include "constants.h"
+#include "defaultsettings.h"
+
+// Decoded Cache Singleton
+static DecodedCache* decodedCache = NULL;
+
+
+//==============================================================================
+// Decoded Store Task Class - Writes an Entry & Its Pyramid Levels
+//==============================================================================
+class DecodedStoreTask : public QRunnable
+{
+public:
+
+    // Constructor
+    DecodedStoreTask(DecodedCache* aCache, const QByteArray& aKeyBase, const QImage& aImage)
+        : cache(aCache)
+        , keyBase(aKeyBase)
+        , image(aImage)
+    {
+    }
+
+    // Run
+    virtual void run()
+    {
+        // Init Level Image
+        QImage levelImage = image;
+        // Release Image - Levels Are Derived From the Previous One
+        image = QImage();
+        // Init Level
+        int level = 0;
+        // Init Stored Bytes
+        qint64 storedBytes = 0;
+
+        // Write Levels - Each Halves the Previous One Until It Gets Too Small
+        while (!levelImage.isNull()) {
+            // Write Entry
+            qint64 entryBytes = cache->writeEntry(cache->entryFilePath(keyBase, level), levelImage);
+
+            // Check Entry Bytes
+            if (entryBytes <= 0) {
+                break;
+            }
+
+            // Inc Stored Bytes
+            storedBytes += entryBytes;
+
+            // Check Pyramid & Next Level Size
+            if (!cache->pyramid || qMin(levelImage.width(), levelImage.height()) / 2 < DEFAULT_DECODED_CACHE_MIN_LEVEL_SIZE) {
+                break;
+            }
+
+            // Scale Level Image
+            levelImage = downscaleImage(levelImage, QSize(levelImage.width() / 2, levelImage.height() / 2));
+            // Inc Level
+            level++;
+        }
+
+        // Release Level Image
+        levelImage = QImage();
+
+        // Check Stored Bytes
+        if (storedBytes > 0) {
+            // Account Stored Bytes
+            accountDiskCache(cache->cacheDir, DEFAULT_DECODED_CACHE_FILE_SUFFIX, cache->budgetBytes, storedBytes);
+        }
+
+        // Dec Pending Writes
+        cache->pendingWrites.deref();
+    }
+
+private:
+    // Cache
+    DecodedCache*   cache;
+    // Key Base
+    QByteArray      keyBase;
+    // Image
+    QImage          image;
+};
+
+
+
+//==============================================================================
+// Static Constructor
+//==============================================================================
+DecodedCache* DecodedCache::getInstance()
+{
+    // Check Singleton
+    if (!decodedCache) {
+        // Create Decoded Cache
+        decodedCache = new DecodedCache();
+    }
+
+    return decodedCache;
+}
+
+//==============================================================================
+// Release Instance
+//==============================================================================
+void DecodedCache::release()
+{
+    // Delete Decoded Cache
+    delete decodedCache;
+    // Reset Singleton
+    decodedCache = NULL;
+}
+
+//==============================================================================
+// Constructor
+//==============================================================================
+DecodedCache::DecodedCache()
+    : cacheDir(QDir(QStandardPaths::writableLocation(QStandardPaths::CacheLocation)).filePath(DEFAULT_DECODED_CACHE_DIR_NAME))
+    , enabled(QSettings().value(SETTINGS_KEY_DECODED_CACHE_ENABLED, DEFAULT_DECODED_CACHE_ENABLED).toBool())
+    , pyramid(QSettings().value(SETTINGS_KEY_DECODED_CACHE_PYRAMID, DEFAULT_DECODED_CACHE_PYRAMID).toBool())
+    , budgetBytes((qint64)QSettings().value(SETTINGS_KEY_DECODED_CACHE_SIZE_MB, DEFAULT_DECODED_CACHE_SIZE_MB).toInt() * 1024 * 1024)
+    , pendingWrites(0)
+{
+    qDebug() << "DecodedCache::DecodedCache - cacheDir: " << cacheDir << " - enabled: " << enabled;
+
+    // Set Max Thread Count - Writes Are Disk Bound
+    writerPool.setMaxThreadCount(1);
+
+    // Check Enabled
+    if (enabled) {
+        // Create Cache Dir
+        QDir().mkpath(cacheDir);
+    }
+}
+
+//==============================================================================
+// Lookup Decoded Image - Mapped From Disk, Null On Miss
+//==============================================================================
+QImage DecodedCache::lookup(const QString& aFilePath, const int& aFrame, const int& aAlphaMode, const int& aLevel)
+{
+    // Check Enabled
+    if (!enabled) {
+        return QImage();
+    }
+
+    // Get Key Base
+    QByteArray base = keyBase(aFilePath, aFrame, aAlphaMode);
+
+    // Check Key Base
+    if (base.isEmpty()) {
+        return QImage();
+    }
+
+    // Get Entry File Path
+    QString entryPath = entryFilePath(base, aLevel);
+
+    // Check Entry
+    if (!QFile::exists(entryPath)) {
+        return QImage();
+    }
+
+    // Init Error
+    QString error;
+    // Map Entry - Pixels Are Already Normalized
+    QImage image = mapImageFile(entryPath, error);
+
+    // Check Image
+    if (image.isNull()) {
+        qDebug() << "DecodedCache::lookup - ERROR: " << error;
+        return image;
+    }
+
+#if QT_VERSION >= QT_VERSION_CHECK(5, 10, 0)
+    // Init Entry File
+    QFile entryFile(entryPath);
+
+    // Touch Entry - Modification Time Is the Recency Eviction Goes By
+    if (entryFile.open(QIODevice::ReadOnly)) {
+        entryFile.setFileTime(QDateTime::currentDateTime(), QFileDevice::FileModificationTime);
+    }
+#endif // QT_VERSION >= 5.10
+
+    return image;
+}
+
+//==============================================================================
+// Store Decoded Image With Its Pyramid Levels - In the Background, Skipped When Disabled, Small Or the Writer Is Busy
+//==============================================================================
+void DecodedCache::store(const QString& aFilePath, const int& aFrame, const int& aAlphaMode, const QImage& aImage)
+{
+    // Check Enabled & Image Size - Small Images Decode Fast Enough
+    if (!enabled || aImage.isNull() || (qint64)aImage.width() * aImage.height() < DEFAULT_DECODED_CACHE_MIN_PIXELS) {
+        return;
+    }
+
+    // Check Pending Writes - Drop Rather Than Pile Up Decoded Images In Memory
+    if (pendingWrites.load() >= DEFAULT_DECODED_CACHE_MAX_PENDING_WRITES) {
+        qDebug() << "DecodedCache::store - aFilePath: " << aFilePath << " - WRITER BUSY, SKIPPED";
+        return;
+    }
+
+    // Get Key Base - Taken Now, the File May Change Before the Write
+    QByteArray base = keyBase(aFilePath, aFrame, aAlphaMode);
+
+    // Check Key Base
+    if (base.isEmpty()) {
+        return;
+    }
+
+    // Inc Pending Writes
+    pendingWrites.ref();
+
+    // Start Task
+    writerPool.start(new DecodedStoreTask(this, base, aImage));
+}
+
+//==============================================================================
+// Get Key Base - Path, Size, Modification Time, Frame & Alpha Mode. Empty If the File Is Gone
+//==============================================================================
+QByteArray DecodedCache::keyBase(const QString& aFilePath, const int& aFrame, const int& aAlphaMode)
+{
+    // Get File Info
+    QFileInfo fileInfo(aFilePath);
+
+    // Check File
+    if (!fileInfo.isFile()) {
+        return QByteArray();
+    }
+
+    // Build Key Base - Separated So Parts Can Not Run Into Each Other
+    return fileInfo.absoluteFilePath().toUtf8() + '\n'
+         + QByteArray::number(fileInfo.size()) + '\n'
+         + QByteArray::number(fileInfo.lastModified().toMSecsSinceEpoch()) + '\n'
+         + QByteArray::number(aFrame) + '\n'
+         + QByteArray::number(aAlphaMode) + '\n';
+}
+
+//==============================================================================
+// Get Entry File Path of Level
+//==============================================================================
+QString DecodedCache::entryFilePath(const QByteArray& aKeyBase, const int& aLevel)
+{
+    // Get Key Hex
+    QString keyHex = QString::fromLatin1(QCryptographicHash::hash(aKeyBase + QByteArray::number(aLevel), QCryptographicHash::Sha1).toHex());
+
+    // Fan Out By the First Byte - Keeps Directories Small
+    return QString("%1/%2/%3%4").arg(cacheDir).arg(keyHex.left(2)).arg(keyHex).arg(DEFAULT_DECODED_CACHE_FILE_SUFFIX);
+}
+
+//==============================================================================
+// Write Entry - Renamed Into Place, Returns Bytes Written
+//==============================================================================
+qint64 DecodedCache::writeEntry(const QString& aEntryPath, const QImage& aImage)
+{
+    // Init Header
+    SharedImageHeader header;
+    memset(&header, 0, sizeof(header));
+
+    // Set Header - Lines Kept As They Are In Memory, So the Entry Maps Back As Is
+    header.magic = DEFAULT_SHARED_IMAGE_MAGIC;
+    header.version = DEFAULT_SHARED_IMAGE_VERSION;
+    header.width = aImage.width();
+    header.height = aImage.height();
+    header.stride = aImage.bytesPerLine();
+    header.format = aImage.format();
+    header.dataOffset = sizeof(header);
+
+    // Create Entry Dir
+    QDir().mkpath(QFileInfo(aEntryPath).absolutePath());
+
+    // Init Entry File - Renamed Into Place, Readers Never See a Partial Entry
+    QSaveFile entryFile(aEntryPath);
+
+    // Get Pixel Bytes
+    qint64 pixelBytes = (qint64)aImage.bytesPerLine() * aImage.height();
+
+    // Write Entry
+    if (!entryFile.open(QIODevice::WriteOnly) ||
+        entryFile.write((const char*)&header, sizeof(header)) != (qint64)sizeof(header) ||
+        entryFile.write((const char*)aImage.constBits(), pixelBytes) != pixelBytes ||
+        !entryFile.commit()) {
+        qDebug() << "DecodedCache::writeEntry - aEntryPath: " << aEntryPath << " - ERROR: " << entryFile.errorString();
+        return 0;
+    }
+
+    return sizeof(header) + pixelBytes;
+}
+
+//==============================================================================
+// Destructor
+//==============================================================================
+DecodedCache::~DecodedCache()
+{
+    // Wait For Writer - Pending Entries Are Finished, Not Torn
+    writerPool.waitForDone();
+
+    qDebug() << "DecodedCache::~DecodedCache";
+}
@@ -0,0 +1,62 @@
+#ifndef DECODEDCACHE_H
+#define DECODEDCACHE_H
+
+#include <QString>
+#include <QByteArray>
+#include <QImage>
+#include <QThreadPool>
+#include <QAtomicInt>
+
+//==============================================================================
+// Decoded Cache Class - Normalized Pixels of Large Compressed Images Kept On Disk
+//
+// Entries Are Raw Images Keyed By Path, Size, Modification Time, Frame, Alpha Mode
+// & Pyramid Level. They Are Mapped Back Without Decoding, Writes Run In the Background
+//==============================================================================
+class DecodedCache
+{
+public:
+
+    // Static Constructor
+    static DecodedCache* getInstance();
+    // Release Instance
+    void release();
+
+    // Lookup Decoded Image - Mapped From Disk, Null On Miss
+    QImage lookup(const QString& aFilePath, const int& aFrame, const int& aAlphaMode, const int& aLevel = 0);
+    // Store Decoded Image With Its Pyramid Levels - In the Background, Skipped When Disabled, Small Or the Writer Is Busy
+    void store(const QString& aFilePath, const int& aFrame, const int& aAlphaMode, const QImage& aImage);
+
+protected:
+    friend class DecodedStoreTask;
+
+    // Constructor
+    DecodedCache();
+
+    // Destructor
+    virtual ~DecodedCache();
+
+    // Get Key Base - Path, Size, Modification Time, Frame & Alpha Mode. Empty If the File Is Gone
+    QByteArray keyBase(const QString& aFilePath, const int& aFrame, const int& aAlphaMode);
+    // Get Entry File Path of Level
+    QString entryFilePath(const QByteArray& aKeyBase, const int& aLevel);
+    // Write Entry - Renamed Into Place, Returns Bytes Written
+    qint64 writeEntry(const QString& aEntryPath, const QImage& aImage);
+
+private:
+
+    // Cache Dir
+    QString                     cacheDir;
+    // Enabled
+    bool                        enabled;
+    // Store Pyramid Levels
+    bool                        pyramid;
+    // Budget Bytes
+    qint64                      budgetBytes;
+    // Writer Pool
+    QThreadPool                 writerPool;
+    // Pending Writes - Each Holds a Decoded Image In Memory
+    QAtomicInt                  pendingWrites;
+};
+
+#endif // DECODEDCACHE_H
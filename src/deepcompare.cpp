@@ -0,0 +1,542 @@
+#include <QDebug>
+#include <QImageReader>
+#include <QRunnable>
+#include <QThread>
+#include <QThreadPool>
+#include <QSemaphore>
+#include <QVector>
+
+#include <string.h>
+
+#ifdef __SSE2__
+
+#include <emmintrin.h>
+
+#endif // __SSE2__
+
+#include "deepcompare.h"
+#include "sharedimage.h"
+#include "mappedimage.h"
+#include "constants.h"
+
+#if QT_VERSION >= QT_VERSION_CHECK(5, 12, 0)
+
+//==============================================================================
+// Get Rows of Image As RGBA64 - Wrapped When Already 16 Bit, Widened Otherwise
+//==============================================================================
+static QImage deepRows(const QImage& aImage, const int& aFirstRow, const int& aRowCount)
+{
+    // Wrap Rows - No Copy Of the Source Pixels
+    QImage rows(aImage.constScanLine(aFirstRow), aImage.width(), aRowCount, aImage.bytesPerLine(), aImage.format());
+
+    // Check Format
+    if (aImage.format() == QImage::Format_RGBA64) {
+        return rows;
+    }
+
+    // Set Color Table - Indexed Formats
+    rows.setColorTable(aImage.colorTable());
+
+    // Widen Rows - Only One Tile Per Thread Exists At a Time
+    return rows.convertToFormat(QImage::Format_RGBA64);
+}
+
+//==============================================================================
+// Compare 64 Bit Pixel Rows - Accumulates Statistics
+//==============================================================================
+static void compareDeepRows(const quint64* aLeftRow, const quint64* aRightRow, const int& aCount, const quint16& aTolerance, DeepCompareStats& aStats)
+{
+    // Init Index
+    int i = 0;
+
+#ifdef __SSE2__
+
+    // Init Constants
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i tolerance = _mm_set1_epi16((short)aTolerance);
+    const __m128i signFlip = _mm_set1_epi16((short)0x8000);
+
+    // Init Max - Kept Sign Flipped, SSE2 Has Only Signed 16 Bit Max
+    __m128i maxFlipped = signFlip;
+    // Init Sum
+    __m128i sum = zero;
+    // Init Pending Iterations
+    int pending = 0;
+
+    // Init Lanes
+    quint32 sumLanes[4];
+    quint16 maxLanes[8];
+
+    // Go Thru 2 Pixels At a Time
+    for (; i + 2 <= aCount; i += 2) {
+        // Load Pixels
+        __m128i left = _mm_loadu_si128((const __m128i*)(aLeftRow + i));
+        __m128i right = _mm_loadu_si128((const __m128i*)(aRightRow + i));
+
+        // Get Absolute Channel Differences
+        __m128i diff = _mm_or_si128(_mm_subs_epu16(left, right), _mm_subs_epu16(right, left));
+
+        // Update Max
+        maxFlipped = _mm_max_epi16(maxFlipped, _mm_xor_si128(diff, signFlip));
+        // Update Sum - Widened To 32 Bits
+        sum = _mm_add_epi32(sum, _mm_add_epi32(_mm_unpacklo_epi16(diff, zero), _mm_unpackhi_epi16(diff, zero)));
+
+        // Get Channels Within Tolerance
+        int within = _mm_movemask_epi8(_mm_cmpeq_epi16(_mm_subs_epu16(diff, tolerance), zero));
+
+        // Count Differing Pixels - Any Channel Over Tolerance
+        aStats.differingPixels += ((within & 0x00FF) != 0x00FF) + ((within & 0xFF00) != 0xFF00);
+
+        // Check Pending - Flush Before 32 Bit Lanes Can Overflow
+        if (++pending == DEFAULT_DEEP_COMPARE_FLUSH_INTERVAL) {
+            // Flush Sum
+            _mm_storeu_si128((__m128i*)sumLanes, sum);
+            aStats.differenceSum += (quint64)sumLanes[0] + sumLanes[1] + sumLanes[2] + sumLanes[3];
+            // Reset Sum
+            sum = zero;
+            pending = 0;
+        }
+    }
+
+    // Flush Sum
+    _mm_storeu_si128((__m128i*)sumLanes, sum);
+    aStats.differenceSum += (quint64)sumLanes[0] + sumLanes[1] + sumLanes[2] + sumLanes[3];
+
+    // Flush Max
+    _mm_storeu_si128((__m128i*)maxLanes, maxFlipped);
+    for (int l = 0; l < 8; l++) {
+        aStats.maxDifference = qMax<quint16>(aStats.maxDifference, maxLanes[l] ^ 0x8000);
+    }
+
+#endif // __SSE2__
+
+    // Go Thru Remaining Pixels
+    for (; i < aCount; i++) {
+        // Init Differing
+        bool differing = false;
+
+        // Go Thru Channels
+        for (int c = 0; c < 4; c++) {
+            // Get Channels
+            quint16 left = (quint16)(aLeftRow[i] >> (c * 16));
+            quint16 right = (quint16)(aRightRow[i] >> (c * 16));
+            // Get Difference
+            quint16 diff = left > right ? left - right : right - left;
+
+            // Update Statistics
+            aStats.maxDifference = qMax(aStats.maxDifference, diff);
+            aStats.differenceSum += diff;
+            differing |= diff > aTolerance;
+        }
+
+        // Check Differing
+        if (differing) {
+            aStats.differingPixels++;
+        }
+    }
+
+    // Add Pixels
+    aStats.pixels += aCount;
+}
+
+//==============================================================================
+// Compare 64 Bit Pixel Row Segment - Only Runs of Kept Pixels When There Is a Keep Row
+//==============================================================================
+static void compareDeepSegment(const quint64* aLeftRow, const quint64* aRightRow, const QRgb* aKeepRow, const int& aCount, const quint16& aTolerance, DeepCompareStats& aStats)
+{
+    // Check Keep Row
+    if (!aKeepRow) {
+        // Compare Rows
+        compareDeepRows(aLeftRow, aRightRow, aCount, aTolerance, aStats);
+        return;
+    }
+
+    // Init Index
+    int i = 0;
+
+    // Go Thru Runs
+    while (i < aCount) {
+        // Skip Ignored Pixels
+        while (i < aCount && !aKeepRow[i]) {
+            i++;
+        }
+
+        // Get Run Start
+        int start = i;
+
+        // Find Run End
+        while (i < aCount && aKeepRow[i]) {
+            i++;
+        }
+
+        // Check Run
+        if (i > start) {
+            // Compare Run
+            compareDeepRows(aLeftRow + start, aRightRow + start, i - start, aTolerance, aStats);
+        }
+    }
+}
+
+
+
+//==============================================================================
+// Deep Compare Tile Task Class
+//==============================================================================
+class DeepCompareTileTask : public QRunnable
+{
+public:
+
+    // Constructor
+    DeepCompareTileTask(const QImage& aLeftImage, const QImage& aRightImage, const QImage& aKeepMask, const QRect& aRegion, const QPoint& aAlignOffset,
+                        const int& aFirstRow, const int& aRowCount, const quint16& aTolerance, DeepCompareStats& aStats, uchar* aBlocks, const int& aBlockColumns, QSemaphore& aDone)
+        : leftImage(aLeftImage)
+        , rightImage(aRightImage)
+        , keepMask(aKeepMask)
+        , region(aRegion)
+        , alignOffset(aAlignOffset)
+        , firstRow(aFirstRow)
+        , rowCount(aRowCount)
+        , tolerance(aTolerance)
+        , stats(aStats)
+        , blocks(aBlocks)
+        , blockColumns(aBlockColumns)
+        , done(aDone)
+    {
+    }
+
+    // Run
+    virtual void run()
+    {
+        // Get Tiles - Right Rows Shifted By the Align Offset
+        QImage leftTile = deepRows(leftImage, firstRow, rowCount);
+        QImage rightTile = deepRows(rightImage, firstRow + alignOffset.y(), rowCount);
+
+        // Go Thru Rows
+        for (int y = 0; y < rowCount; y++) {
+            // Get Rows - Starting At the Region
+            const quint64* leftRow = (const quint64*)leftTile.constScanLine(y) + region.x();
+            const quint64* rightRow = (const quint64*)rightTile.constScanLine(y) + region.x() + alignOffset.x();
+            const QRgb* keepRow = keepMask.isNull() ? NULL : (const QRgb*)keepMask.constScanLine(firstRow + y) + region.x();
+
+            // Check Blocks
+            if (!blocks) {
+                // Compare Rows
+                compareDeepSegment(leftRow, rightRow, keepRow, region.width(), tolerance, stats);
+                continue;
+            }
+
+            // Get Block Row - Tiles Span Whole Block Rows, Tasks Never Share One
+            uchar* blockRow = blocks + ((firstRow + y) / DEFAULT_DIFF_MAP_BLOCK_SIZE) * blockColumns;
+
+            // Go Thru Blocks - Segments End At Block Boundaries In Left Image Pixels
+            for (int x = 0; x < region.width(); ) {
+                // Get Segment Width
+                int width = qMin(((region.x() + x) / DEFAULT_DIFF_MAP_BLOCK_SIZE + 1) * DEFAULT_DIFF_MAP_BLOCK_SIZE - region.x(), region.width()) - x;
+                // Get Differing Pixels Before
+                qint64 differingPixels = stats.differingPixels;
+
+                // Compare Block Row Segment
+                compareDeepSegment(leftRow + x, rightRow + x, keepRow ? keepRow + x : NULL, width, tolerance, stats);
+
+                // Check Differing Pixels
+                if (stats.differingPixels != differingPixels) {
+                    // Mark Block
+                    blockRow[(region.x() + x) / DEFAULT_DIFF_MAP_BLOCK_SIZE] = 1;
+                }
+
+                // Next Segment
+                x += width;
+            }
+        }
+
+        // Release Done
+        done.release();
+    }
+
+private:
+    // Left Image
+    const QImage&       leftImage;
+    // Right Image
+    const QImage&       rightImage;
+    // Keep Mask - Null If Every Pixel Is Compared
+    const QImage&       keepMask;
+    // Compared Region In Left Image Pixels
+    QRect               region;
+    // Align Offset
+    QPoint              alignOffset;
+    // First Row
+    int                 firstRow;
+    // Row Count
+    int                 rowCount;
+    // Tolerance
+    quint16             tolerance;
+    // Tile Statistics
+    DeepCompareStats&   stats;
+    // Diff Map Blocks - NULL If Not Wanted
+    uchar*              blocks;
+    // Diff Map Block Columns
+    int                 blockColumns;
+    // Done Semaphore
+    QSemaphore&         done;
+};
+
+#endif // QT_VERSION >= 5.12
+
+//==============================================================================
+// Get Bits Per Channel of Format
+//==============================================================================
+static int formatDepth(const QImage::Format& aFormat)
+{
+#if QT_VERSION >= QT_VERSION_CHECK(5, 12, 0)
+    // Check 16 Bit Formats
+    if (aFormat == QImage::Format_RGBA64 || aFormat == QImage::Format_RGBA64_Premultiplied || aFormat == QImage::Format_RGBX64) {
+        return 16;
+    }
+#endif // QT_VERSION >= 5.12
+
+    // Check 10 Bit Formats
+    if (aFormat == QImage::Format_A2BGR30_Premultiplied || aFormat == QImage::Format_BGR30 ||
+        aFormat == QImage::Format_A2RGB30_Premultiplied || aFormat == QImage::Format_RGB30) {
+        return 10;
+    }
+
+    return 8;
+}
+
+//==============================================================================
+// Get Differing Regions - Bounding Rects of Connected Differing Blocks, In Pixels
+//==============================================================================
+QVector<QRect> DeepCompareDiffMap::regions() const
+{
+    // Init Regions
+    QVector<QRect> result;
+    // Init Visited Blocks
+    QVector<bool> visited(blocks.size(), false);
+    // Init Pending Blocks
+    QVector<int> pending;
+
+    // Go Thru Blocks
+    for (int i = 0; i < blocks.size(); i++) {
+        // Check Block
+        if (!blocks[i] || visited[i]) {
+            continue;
+        }
+
+        // Init Bounds In Blocks
+        int left = i % size.width();
+        int right = left;
+        int top = i / size.width();
+        int bottom = top;
+
+        // Start Flood Fill
+        visited[i] = true;
+        pending << i;
+
+        // Go Thru Connected Blocks
+        while (!pending.isEmpty()) {
+            // Get Block
+            int block = pending.takeLast();
+            int x = block % size.width();
+            int y = block / size.width();
+
+            // Update Bounds
+            left = qMin(left, x);
+            right = qMax(right, x);
+            top = qMin(top, y);
+            bottom = qMax(bottom, y);
+
+            // Init Neighbours
+            int neighbours[4] = { x > 0 ? block - 1 : -1,
+                                  x + 1 < size.width() ? block + 1 : -1,
+                                  y > 0 ? block - size.width() : -1,
+                                  y + 1 < size.height() ? block + size.width() : -1 };
+
+            // Go Thru Neighbours
+            for (int n = 0; n < 4; n++) {
+                // Check Neighbour
+                if (neighbours[n] >= 0 && blocks[neighbours[n]] && !visited[neighbours[n]]) {
+                    // Add Neighbour
+                    visited[neighbours[n]] = true;
+                    pending << neighbours[n];
+                }
+            }
+        }
+
+        // Add Region - Clipped To the Image
+        result << QRect(left * blockSize, top * blockSize, (right - left + 1) * blockSize, (bottom - top + 1) * blockSize).intersected(QRect(QPoint(0, 0), imageSize));
+    }
+
+    return result;
+}
+
+//==============================================================================
+// Read Image At Native Depth - Shared Images & Uncompressed Files Are Mapped, Others Decoded
+//==============================================================================
+QImage readDeepImage(const QString& aSource, QString& aError)
+{
+    // Check Shared Image Source
+    if (isSharedImageSource(aSource)) {
+        return readSharedImage(aSource, aError);
+    }
+
+    // Map Image File
+    QImage mappedImage = mapImageFile(aSource, aError);
+
+    // Check Mapped Image Or Error
+    if (!mappedImage.isNull() || !aError.isEmpty()) {
+        return mappedImage;
+    }
+
+    // Init Reader
+    QImageReader reader(aSource);
+    // Read Image
+    QImage image = reader.read();
+
+    // Check Image
+    if (image.isNull()) {
+        // Set Error
+        aError = aSource + ": " + reader.errorString();
+    }
+
+    return image;
+}
+
+//==============================================================================
+// Check If File Decodes To More Than 8 Bits Per Channel
+//==============================================================================
+bool isHighBitDepthFile(const QString& aFilePath)
+{
+    return formatDepth(QImageReader(aFilePath).imageFormat()) > 8;
+}
+
+//==============================================================================
+// Compare Files At 16 Bits Per Channel - Row Tiles Compared In Parallel, Narrower Sources Widened Tile By Tile
+//==============================================================================
+bool compareFilesDeep(const QString& aLeftFile, const QString& aRightFile, const quint16& aTolerance, DeepCompareStats& aStats, QString& aError, DeepCompareDiffMap* aDiffMap,
+                      const QImage& aKeepMask, const QPoint& aAlignOffset)
+{
+    // Read Left Image - Decoded At Native Depth
+    QImage leftImage = readDeepImage(aLeftFile, aError);
+
+    // Check Left Image
+    if (leftImage.isNull()) {
+        return false;
+    }
+
+    // Read Right Image
+    QImage rightImage = readDeepImage(aRightFile, aError);
+
+    // Check Right Image
+    if (rightImage.isNull()) {
+        return false;
+    }
+
+    return compareImagesDeep(leftImage, rightImage, aTolerance, aStats, aError, aDiffMap, aKeepMask, aAlignOffset);
+}
+
+//==============================================================================
+// Compare Images At 16 Bits Per Channel - Left Pixel P Against Right Pixel P + Align Offset, Over the Overlap
+//==============================================================================
+bool compareImagesDeep(const QImage& aLeftImage, const QImage& aRightImage, const quint16& aTolerance, DeepCompareStats& aStats, QString& aError, DeepCompareDiffMap* aDiffMap,
+                       const QImage& aKeepMask, const QPoint& aAlignOffset)
+{
+    // Reset Statistics
+    memset(&aStats, 0, sizeof(aStats));
+
+    // Set Depths
+    aStats.leftDepth = formatDepth(aLeftImage.format());
+    aStats.rightDepth = formatDepth(aRightImage.format());
+
+    // Check Sizes - Unaligned Images Only Compare With the Same Size
+    if (aAlignOffset.isNull() && aLeftImage.size() != aRightImage.size()) {
+        // Set Error
+        aError = QString("Size mismatch: %1x%2 vs %3x%4").arg(aLeftImage.width()).arg(aLeftImage.height()).arg(aRightImage.width()).arg(aRightImage.height());
+        return false;
+    }
+
+    // Check Keep Mask - Rasterized For the Left Image
+    if (!aKeepMask.isNull() && (aKeepMask.size() != aLeftImage.size() || aKeepMask.depth() != 32)) {
+        // Set Error
+        aError = QString("Compare mask mismatch: %1x%2 for a %3x%4 image").arg(aKeepMask.width()).arg(aKeepMask.height()).arg(aLeftImage.width()).arg(aLeftImage.height());
+        return false;
+    }
+
+    // Get Region - Left Pixels Overlapping the Shifted Right Image
+    QRect region = aLeftImage.rect().intersected(aRightImage.rect().translated(-aAlignOffset));
+
+    // Check Region
+    if (region.isEmpty()) {
+        // Set Error
+        aError = QString("No overlap at align offset %1,%2").arg(aAlignOffset.x()).arg(aAlignOffset.y());
+        return false;
+    }
+
+#if QT_VERSION >= QT_VERSION_CHECK(5, 12, 0)
+
+    // Get First Tile - Tiles Start At Multiples of the Tile Rows, So They Never Share a Diff Map Block Row
+    int firstTile = region.top() / DEFAULT_DEEP_COMPARE_TILE_ROWS;
+    // Get Tile Count
+    int tileCount = region.bottom() / DEFAULT_DEEP_COMPARE_TILE_ROWS - firstTile + 1;
+    // Init Tile Statistics
+    QVector<DeepCompareStats> tileStats(tileCount);
+    // Reset Tile Statistics
+    memset(tileStats.data(), 0, sizeof(DeepCompareStats) * tileCount);
+
+    // Get Tile Statistics Data - Detached Once Here
+    DeepCompareStats* tileStatsData = tileStats.data();
+
+    // Init Diff Map Blocks
+    uchar* blocks = NULL;
+    // Get Block Columns
+    int blockColumns = (aLeftImage.width() + DEFAULT_DIFF_MAP_BLOCK_SIZE - 1) / DEFAULT_DIFF_MAP_BLOCK_SIZE;
+
+    // Check Diff Map
+    if (aDiffMap) {
+        // Init Diff Map
+        aDiffMap->blockSize = DEFAULT_DIFF_MAP_BLOCK_SIZE;
+        aDiffMap->imageSize = aLeftImage.size();
+        aDiffMap->size = QSize(blockColumns, (aLeftImage.height() + DEFAULT_DIFF_MAP_BLOCK_SIZE - 1) / DEFAULT_DIFF_MAP_BLOCK_SIZE);
+        aDiffMap->blocks.fill(0, aDiffMap->size.width() * aDiffMap->size.height());
+        // Get Blocks - Detached Once Here
+        blocks = (uchar*)aDiffMap->blocks.data();
+    }
+
+    // Init Done Semaphore
+    QSemaphore done(0);
+
+    // Go Thru Tiles
+    for (int t = 0; t < tileCount; t++) {
+        // Get First Row - Clipped To the Region
+        int firstRow = qMax((firstTile + t) * DEFAULT_DEEP_COMPARE_TILE_ROWS, region.top());
+        // Get Last Row
+        int lastRow = qMin((firstTile + t + 1) * DEFAULT_DEEP_COMPARE_TILE_ROWS - 1, region.bottom());
+        // Start Task
+        QThreadPool::globalInstance()->start(new DeepCompareTileTask(aLeftImage, aRightImage, aKeepMask, region, aAlignOffset, firstRow, lastRow - firstRow + 1,
+                                                                     aTolerance, tileStatsData[t], blocks, blockColumns, done));
+    }
+
+    // Wait For Tiles
+    done.acquire(tileCount);
+
+    // Merge Tile Statistics
+    for (int t = 0; t < tileCount; t++) {
+        aStats.pixels += tileStats[t].pixels;
+        aStats.differingPixels += tileStats[t].differingPixels;
+        aStats.differenceSum += tileStats[t].differenceSum;
+        aStats.maxDifference = qMax(aStats.maxDifference, tileStats[t].maxDifference);
+    }
+
+    return true;
+
+#else // QT_VERSION >= 5.12
+
+    Q_UNUSED(aTolerance);
+    Q_UNUSED(aDiffMap);
+
+    // Set Error
+    aError = QString("16 bit comparison requires Qt 5.12 or newer");
+
+    return false;
+
+#endif // QT_VERSION >= 5.12
+}
@@ -0,0 +1,66 @@
+#ifndef DEEPCOMPARE_H
+#define DEEPCOMPARE_H
+
+#include <QString>
+#include <QImage>
+#include <QByteArray>
+#include <QVector>
+#include <QRect>
+#include <QPoint>
+
+//==============================================================================
+// Deep Compare Statistics - Differences In Native 16 Bit Channel Units
+//==============================================================================
+struct DeepCompareStats
+{
+    // Compared Pixels
+    qint64      pixels;
+    // Pixels With Any Channel Differing More Than the Tolerance
+    qint64      differingPixels;
+    // Max Channel Difference
+    quint16     maxDifference;
+    // Sum of Channel Differences
+    quint64     differenceSum;
+    // Source Bits Per Channel - 8 Or 16
+    int         leftDepth;
+    int         rightDepth;
+
+    // Get Mean Channel Difference
+    double meanDifference() const { return pixels > 0 ? (double)differenceSum / (pixels * 4) : 0.0; }
+};
+
+//==============================================================================
+// Deep Compare Diff Map - One Byte Per Block, Non Zero Where Any Pixel Differs
+//==============================================================================
+struct DeepCompareDiffMap
+{
+    // Block Size In Pixels
+    int         blockSize;
+    // Image Size In Pixels
+    QSize       imageSize;
+    // Map Size In Blocks
+    QSize       size;
+    // Blocks - Row Major
+    QByteArray  blocks;
+
+    // Get Differing Regions - Bounding Rects of Connected Differing Blocks, In Pixels
+    QVector<QRect> regions() const;
+};
+
+// Read Image At Native Depth - Shared Images & Uncompressed Files Are Mapped, Others Decoded Whole
+// Decoded 16 Bit Sources Take 8 Bytes Per Pixel, Only the Widened Tiles of 8 Bit Sources Are Bounded
+QImage readDeepImage(const QString& aSource, QString& aError);
+
+// Check If File Decodes To More Than 8 Bits Per Channel
+bool isHighBitDepthFile(const QString& aFilePath);
+
+// Compare Files At 16 Bits Per Channel - Row Tiles Compared In Parallel, Narrower Sources Widened Tile By Tile
+bool compareFilesDeep(const QString& aLeftFile, const QString& aRightFile, const quint16& aTolerance, DeepCompareStats& aStats, QString& aError, DeepCompareDiffMap* aDiffMap = NULL,
+                      const QImage& aKeepMask = QImage(), const QPoint& aAlignOffset = QPoint(0, 0));
+
+// Compare Images At 16 Bits Per Channel - Left Pixel P Against Right Pixel P + Align Offset, Over the Overlap
+// Keep Mask Is In Left Image Pixels As Returned By compareMask, Ignored Pixels Count Neither As Compared Nor Differing
+bool compareImagesDeep(const QImage& aLeftImage, const QImage& aRightImage, const quint16& aTolerance, DeepCompareStats& aStats, QString& aError, DeepCompareDiffMap* aDiffMap = NULL,
+                       const QImage& aKeepMask = QImage(), const QPoint& aAlignOffset = QPoint(0, 0));
+
+#endif // DEEPCOMPARE_H
@@ -15,6 +15,52 @@
 // Default Zoom Level Index
 #define DEFAULT_ZOOM_LEVEL_INDEX                            4
 
+// Default Decoded Image Cache Budget in MB
+#define DEFAULT_IMAGE_CACHE_BUDGET_MB                       2048
+// Default Number of Files Prefetched In the Stepping Direction
+#define DEFAULT_PREFETCH_COUNT                              2
+
+// Default Thumbnail Memory Cache Budget in MB
+#define DEFAULT_THUMBNAIL_MEMORY_CACHE_MB                   32
+
+// Default Viewer Tile Texture Cache Budget in MB
+#define DEFAULT_TILED_IMAGE_TEXTURE_CACHE_MB                256
+
+// Default Alpha Mode - 0: Straight, 1: Premultiplied, 2: Ignored
+#define DEFAULT_ALPHA_MODE                                  0
+
+// Default On Disk Compare Result Cache Size in MB
+#define DEFAULT_RESULT_CACHE_SIZE_MB                        256
+
+// Default On Disk Decoded Image Cache - Off, Entries Are Large
+#define DEFAULT_DECODED_CACHE_ENABLED                       false
+// Default On Disk Decoded Image Cache Size in MB
+#define DEFAULT_DECODED_CACHE_SIZE_MB                       8192
+// Default Store Half Size Pyramid Levels With Decoded Images
+#define DEFAULT_DECODED_CACHE_PYRAMID                       false
+
+// Default Number of Requests the Compare Daemon Works On At Once
+#define DEFAULT_DAEMON_WORKER_COUNT                         4
+// Default Compare Daemon Decoded Image Cache Budget in MB
+#define DEFAULT_DAEMON_IMAGE_CACHE_MB                       1024
+
+// Default Deep Compare Tolerance In 16 Bit Channel Units
+#define DEFAULT_DEEP_COMPARE_TOLERANCE                      0
+
+// Default Frame Delay Difference In ms Still Treated As Same Timing
+#define DEFAULT_FRAME_TIMING_TOLERANCE                      0
+
+// Default Auto Align - Register Right Image Onto Left Before Comparing
+#define DEFAULT_AUTO_ALIGN                                  true
+
+// Default Watch Current Files & Reload Them When Changed On Disk
+#define DEFAULT_WATCH_FILES                                 true
+
+// Default Per Pixel Standard Deviation Above Which Learned Masks Ignore a Pixel
+#define DEFAULT_MASK_LEARN_STDDEV_THRESHOLD                 2.0
+// Default Learned Mask Dilate Radius In Pixels
+#define DEFAULT_MASK_LEARN_DILATE_RADIUS                    2
+
 
 #endif // DEFAULTSETTINGS
 
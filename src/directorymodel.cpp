@@ -0,0 +1,859 @@
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QRunnable>
+#include <QSocketNotifier>
+#include <QFileSystemWatcher>
+
+#include <algorithm>
+#include <string.h>
+
+#ifdef Q_OS_LINUX
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <dirent.h>
+#include <sys/syscall.h>
+#include <sys/inotify.h>
+
+#else // Q_OS_LINUX
+
+#include <QDirIterator>
+
+#endif // Q_OS_LINUX
+
+#include "directorymodel.h"
+#include "constants.h"
+
+#ifdef Q_OS_LINUX
+
+//==============================================================================
+// Directory Entry As Returned By getdents64
+//==============================================================================
+struct DirEntry64
+{
+    // Inode
+    quint64         inode;
+    // Offset of the Next Entry
+    qint64          offset;
+    // Record Length
+    unsigned short  recordLength;
+    // Type - DT_UNKNOWN On File Systems Not Filling It In
+    unsigned char   type;
+    // Name - Null Terminated
+    char            name[1];
+};
+
+#endif // Q_OS_LINUX
+
+//==============================================================================
+// Get Supported Image Suffixes - Lower Case, From the Supported Formats Filter
+//==============================================================================
+static QSet<QByteArray> supportedSuffixes()
+{
+    // Init Suffixes
+    QSet<QByteArray> suffixes;
+
+    // Go Thru Filters - *.<suffix>
+    foreach (QString filter, QString(DEFAULT_SUPPORTED_FORMATS_FILTER).split(' ', QString::SkipEmptyParts)) {
+        // Add Suffix
+        suffixes << filter.mid(2).toLower().toLatin1();
+    }
+
+    return suffixes;
+}
+
+//==============================================================================
+// Check If Name Is a Supported Image File Name - Hidden Files Are Skipped
+//==============================================================================
+static bool isSupportedImageName(const char* aName, const QSet<QByteArray>& aSuffixes)
+{
+    // Check Hidden, Current & Parent Dir
+    if (aName[0] == '.' || aName[0] == '\0') {
+        return false;
+    }
+
+    // Get Suffix
+    const char* suffix = strrchr(aName, '.');
+
+    return suffix && aSuffixes.contains(QByteArray(suffix + 1).toLower());
+}
+
+//==============================================================================
+// File Name Less Than - Case Insensitive Like the Dir Listings Were
+//==============================================================================
+static bool fileNameLessThan(const QString& aLeft, const QString& aRight)
+{
+    return QString::compare(aLeft, aRight, Qt::CaseInsensitive) < 0;
+}
+
+
+
+//==============================================================================
+// Directory Reader Class - Enumerates Supported Image File Names Without Stat
+//==============================================================================
+class DirectoryReader
+{
+public:
+
+    // Constructor
+    explicit DirectoryReader(const QString& aDirPath)
+        : suffixes(supportedSuffixes())
+#ifdef Q_OS_LINUX
+        , descriptor(open(QFile::encodeName(aDirPath).constData(), O_RDONLY | O_DIRECTORY | O_CLOEXEC))
+        , buffer(DEFAULT_DIRECTORY_SCAN_BUFFER_SIZE, 0)
+#else // Q_OS_LINUX
+        , iterator(aDirPath, QDir::Files)
+#endif // Q_OS_LINUX
+    {
+#ifdef Q_OS_LINUX
+        // Check Descriptor
+        if (descriptor < 0) {
+            qDebug() << "DirectoryReader::DirectoryReader - aDirPath: " << aDirPath << " - ERROR OPENING DIR!";
+        }
+#endif // Q_OS_LINUX
+    }
+
+    // Read Next Batch of File Names - False When the Dir Is Done
+    bool readBatch(QStringList& aFileNames)
+    {
+#ifdef Q_OS_LINUX
+
+        // Check Descriptor
+        if (descriptor < 0) {
+            return false;
+        }
+
+        // Read Entries - One Buffer Full Per Call
+        long length = syscall(SYS_getdents64, descriptor, buffer.data(), buffer.size());
+
+        // Check Length
+        if (length <= 0) {
+            return false;
+        }
+
+        // Go Thru Entries
+        for (long position = 0; position < length; ) {
+            // Get Entry
+            const DirEntry64* entry = (const DirEntry64*)(buffer.constData() + position);
+            // Inc Position
+            position += entry->recordLength;
+
+            // Check Type - Unknown & Links Are Taken Without Stat, Decoding Sorts Them Out
+            if (entry->type != DT_REG && entry->type != DT_LNK && entry->type != DT_UNKNOWN) {
+                continue;
+            }
+
+            // Check Name
+            if (isSupportedImageName(entry->name, suffixes)) {
+                // Add File Name
+                aFileNames << QFile::decodeName(entry->name);
+            }
+        }
+
+        return true;
+
+#else // Q_OS_LINUX
+
+        // Go Thru Entries
+        for (int i = 0; i < DEFAULT_DIRECTORY_SCAN_BATCH_SIZE; i++) {
+            // Check Next Entry
+            if (!iterator.hasNext()) {
+                return false;
+            }
+
+            // Next Entry
+            iterator.next();
+
+            // Get Encoded Name
+            QByteArray name = QFile::encodeName(iterator.fileName());
+
+            // Check Name
+            if (isSupportedImageName(name.constData(), suffixes)) {
+                // Add File Name
+                aFileNames << iterator.fileName();
+            }
+        }
+
+        return true;
+
+#endif // Q_OS_LINUX
+    }
+
+    // Destructor
+    ~DirectoryReader()
+    {
+#ifdef Q_OS_LINUX
+        // Check Descriptor
+        if (descriptor >= 0) {
+            // Close Descriptor
+            close(descriptor);
+        }
+#endif // Q_OS_LINUX
+    }
+
+private:
+    // Supported Suffixes
+    QSet<QByteArray>    suffixes;
+#ifdef Q_OS_LINUX
+    // Dir Descriptor
+    int                 descriptor;
+    // Entry Buffer
+    QByteArray          buffer;
+#else // Q_OS_LINUX
+    // Dir Iterator
+    QDirIterator        iterator;
+#endif // Q_OS_LINUX
+};
+
+
+
+//==============================================================================
+// Directory Scan Task Class - Posts Found Entries To the Model In Batches
+//==============================================================================
+class DirectoryScanTask : public QRunnable
+{
+public:
+
+    // Constructor
+    DirectoryScanTask(DirectoryModel* aModel, const QString& aDirPath, const int& aGeneration, QAtomicInt& aCurrentGeneration)
+        : model(aModel)
+        , dirPath(aDirPath)
+        , generation(aGeneration)
+        , currentGeneration(aCurrentGeneration)
+    {
+    }
+
+    // Run
+    virtual void run()
+    {
+        // Init Reader
+        DirectoryReader reader(dirPath);
+        // Init Batch
+        QStringList batch;
+        // Init More
+        bool more = true;
+
+        // Read Entries
+        while (more) {
+            // Check Generation - Dir Changed, Nobody Waits For the Rest
+            if (currentGeneration.load() != generation) {
+                return;
+            }
+
+            // Read Batch
+            more = reader.readBatch(batch);
+
+            // Check Batch - Posted When Full & At the End
+            if (batch.count() >= DEFAULT_DIRECTORY_SCAN_BATCH_SIZE || (!more && !batch.isEmpty())) {
+                // Post Entries
+                QMetaObject::invokeMethod(model, "entriesFound", Qt::QueuedConnection, Q_ARG(QStringList, batch), Q_ARG(int, generation));
+                // Clear Batch
+                batch.clear();
+            }
+        }
+
+        // Post Scan Finished
+        QMetaObject::invokeMethod(model, "scanFinished", Qt::QueuedConnection, Q_ARG(int, generation));
+    }
+
+private:
+    // Model
+    DirectoryModel*     model;
+    // Dir Path
+    QString             dirPath;
+    // Generation
+    int                 generation;
+    // Current Generation
+    QAtomicInt&         currentGeneration;
+};
+
+
+
+//==============================================================================
+// Read Supported Image File Names of Dir - Name Order, No Stat Per Entry
+//==============================================================================
+QStringList readImageFileNames(const QString& aDirPath)
+{
+    // Init Reader
+    DirectoryReader reader(aDirPath);
+    // Init File Names
+    QStringList fileNames;
+
+    // Read Entries
+    while (reader.readBatch(fileNames)) { }
+
+    // Sort File Names
+    std::sort(fileNames.begin(), fileNames.end(), fileNameLessThan);
+
+    return fileNames;
+}
+
+
+
+//==============================================================================
+// Constructor
+//==============================================================================
+DirectoryModel::DirectoryModel(QObject* aParent)
+    : QAbstractListModel(aParent)
+    , dirPath("")
+    , sorted(true)
+    , scanning(false)
+    , generation(0)
+    , watchDescriptor(-1)
+    , watchNotifier(NULL)
+    , directoryWatcher(NULL)
+{
+    // Set Max Thread Count - One Dir Scanned At a Time
+    scanPool.setMaxThreadCount(1);
+}
+
+//==============================================================================
+// Get Dir Path
+//==============================================================================
+QString DirectoryModel::getDirPath()
+{
+    return dirPath;
+}
+
+//==============================================================================
+// Set Dir Path - Starts a New Scan
+//==============================================================================
+void DirectoryModel::setDirPath(const QString& aDirPath)
+{
+    // Get Absolute Dir Path
+    QString absoluteDirPath = aDirPath.isEmpty() ? QString("") : QDir(aDirPath).absolutePath();
+
+    // Check Dir Path
+    if (dirPath != absoluteDirPath) {
+        qDebug() << "DirectoryModel::setDirPath - aDirPath: " << absoluteDirPath;
+
+        // Set Dir Path
+        dirPath = absoluteDirPath;
+        // Emit Dir Path Changed Signal
+        emit dirPathChanged(dirPath);
+
+        // Stop Watching
+        stopWatching();
+        // Start Watching - Before the Scan, So No Change Slips Between
+        startWatching();
+
+        // Start Scan
+        startScan();
+    }
+}
+
+//==============================================================================
+// Get Count
+//==============================================================================
+int DirectoryModel::getCount()
+{
+    return fileNames.count();
+}
+
+//==============================================================================
+// Get Scanning
+//==============================================================================
+bool DirectoryModel::getScanning()
+{
+    return scanning;
+}
+
+//==============================================================================
+// Set Scanning
+//==============================================================================
+void DirectoryModel::setScanning(const bool& aScanning)
+{
+    // Check Scanning
+    if (scanning != aScanning) {
+        // Set Scanning
+        scanning = aScanning;
+        // Emit Scanning Changed Signal
+        emit scanningChanged(scanning);
+    }
+}
+
+//==============================================================================
+// Get File Paths In Name Order - Sorts First If Needed
+//==============================================================================
+QStringList DirectoryModel::filePaths()
+{
+    // Sort Entries
+    sortEntries();
+
+    // Init Dir
+    QDir dir(dirPath);
+    // Init File Paths
+    QStringList paths;
+
+    // Reserve
+    paths.reserve(fileNames.count());
+
+    // Go Thru File Names
+    for (int i = 0; i < fileNames.count(); i++) {
+        // Add File Path
+        paths << dir.filePath(fileNames[i]);
+    }
+
+    return paths;
+}
+
+//==============================================================================
+// Get File Path of Row
+//==============================================================================
+QString DirectoryModel::filePath(const int& aRow)
+{
+    // Check Row
+    if (aRow < 0 || aRow >= fileNames.count()) {
+        return QString("");
+    }
+
+    return QDir(dirPath).filePath(fileNames[aRow]);
+}
+
+//==============================================================================
+// Get Row of File Path In Name Order - -1 If Not Listed
+//==============================================================================
+int DirectoryModel::indexOf(const QString& aFilePath)
+{
+    // Get File Info
+    QFileInfo fileInfo(aFilePath);
+
+    // Check Dir
+    if (fileInfo.absolutePath() != dirPath) {
+        return -1;
+    }
+
+    // Sort Entries
+    sortEntries();
+
+    // Get File Name
+    QString fileName = fileInfo.fileName();
+
+    // Find First Case Insensitive Match
+    QStringList::iterator it = std::lower_bound(fileNames.begin(), fileNames.end(), fileName, fileNameLessThan);
+
+    // Go Thru Case Insensitive Matches
+    for (; it != fileNames.end() && QString::compare(*it, fileName, Qt::CaseInsensitive) == 0; ++it) {
+        // Check Exact Match
+        if (*it == fileName) {
+            return it - fileNames.begin();
+        }
+    }
+
+    return -1;
+}
+
+//==============================================================================
+// Row Count
+//==============================================================================
+int DirectoryModel::rowCount(const QModelIndex& aParent) const
+{
+    return aParent.isValid() ? 0 : fileNames.count();
+}
+
+//==============================================================================
+// Data
+//==============================================================================
+QVariant DirectoryModel::data(const QModelIndex& aIndex, int aRole) const
+{
+    // Check Index
+    if (!aIndex.isValid() || aIndex.row() >= fileNames.count()) {
+        return QVariant();
+    }
+
+    // Switch Role
+    switch (aRole) {
+        case Qt::DisplayRole:
+        case FileNameRole:  return fileNames[aIndex.row()];
+        case FilePathRole:  return QDir(dirPath).filePath(fileNames[aIndex.row()]);
+
+        default:
+        break;
+    }
+
+    return QVariant();
+}
+
+//==============================================================================
+// Role Names
+//==============================================================================
+QHash<int, QByteArray> DirectoryModel::roleNames() const
+{
+    // Init Role Names
+    QHash<int, QByteArray> roles;
+
+    // Set Role Names
+    roles[FileNameRole] = "fileName";
+    roles[FilePathRole] = "filePath";
+
+    return roles;
+}
+
+//==============================================================================
+// Start Scan - Cancels the Running One
+//==============================================================================
+void DirectoryModel::startScan()
+{
+    // Inc Generation - Running Scan Stops At Its Next Batch
+    generation.ref();
+
+    // Reset Model
+    beginResetModel();
+    // Clear File Names
+    fileNames.clear();
+    fileNameSet.clear();
+    // Set Sorted
+    sorted = true;
+    // Reset Done
+    endResetModel();
+
+    // Emit Count Changed Signal
+    emit countChanged(0);
+
+    // Check Dir Path
+    if (dirPath.isEmpty()) {
+        // Set Scanning
+        setScanning(false);
+        return;
+    }
+
+    // Set Scanning
+    setScanning(true);
+
+    // Start Scan Task
+    scanPool.start(new DirectoryScanTask(this, dirPath, generation.load(), generation));
+}
+
+//==============================================================================
+// Entries Found Slot - Posted By the Scan Task
+//==============================================================================
+void DirectoryModel::entriesFound(const QStringList& aFileNames, const int& aGeneration)
+{
+    // Check Generation
+    if (aGeneration != generation.load()) {
+        return;
+    }
+
+    // Init New File Names
+    QStringList newFileNames;
+
+    // Go Thru File Names - Change Events May Have Added Some Already
+    for (int i = 0; i < aFileNames.count(); i++) {
+        // Check File Name Set
+        if (!fileNameSet.contains(aFileNames[i])) {
+            // Add File Name
+            fileNameSet.insert(aFileNames[i]);
+            newFileNames << aFileNames[i];
+        }
+    }
+
+    // Check New File Names
+    if (newFileNames.isEmpty()) {
+        return;
+    }
+
+    // Begin Insert Rows - Appended, Sorting Waits Until Order Is Needed
+    beginInsertRows(QModelIndex(), fileNames.count(), fileNames.count() + newFileNames.count() - 1);
+    // Add File Names
+    fileNames << newFileNames;
+    // Reset Sorted
+    sorted = false;
+    // End Insert Rows
+    endInsertRows();
+
+    // Emit Count Changed Signal
+    emit countChanged(fileNames.count());
+}
+
+//==============================================================================
+// Scan Finished Slot - Posted By the Scan Task
+//==============================================================================
+void DirectoryModel::scanFinished(const int& aGeneration)
+{
+    // Check Generation
+    if (aGeneration != generation.load()) {
+        return;
+    }
+
+    qDebug() << "DirectoryModel::scanFinished - dirPath: " << dirPath << " - count: " << fileNames.count();
+
+    // Sort Entries - Once For the Whole Dir
+    sortEntries();
+    // Set Scanning
+    setScanning(false);
+}
+
+//==============================================================================
+// Sort Entries - Once, Deltas Keep the Order After
+//==============================================================================
+void DirectoryModel::sortEntries()
+{
+    // Check Sorted
+    if (sorted) {
+        return;
+    }
+
+    // Emit Layout About To Be Changed Signal
+    emit layoutAboutToBeChanged();
+
+    // Get Persistent Indexes
+    QModelIndexList persistentIndexes = persistentIndexList();
+    // Init Persistent File Names
+    QStringList persistentFileNames;
+
+    // Go Thru Persistent Indexes
+    for (int i = 0; i < persistentIndexes.count(); i++) {
+        // Add File Name
+        persistentFileNames << fileNames.value(persistentIndexes[i].row());
+    }
+
+    // Sort File Names
+    std::sort(fileNames.begin(), fileNames.end(), fileNameLessThan);
+    // Set Sorted
+    sorted = true;
+
+    // Go Thru Persistent Indexes
+    for (int i = 0; i < persistentIndexes.count(); i++) {
+        // Update Persistent Index
+        changePersistentIndex(persistentIndexes[i], index(indexOf(QDir(dirPath).filePath(persistentFileNames[i]))));
+    }
+
+    // Emit Layout Changed Signal
+    emit layoutChanged();
+}
+
+//==============================================================================
+// Add Entry
+//==============================================================================
+void DirectoryModel::addEntry(const QString& aFileName)
+{
+    // Check File Name Set
+    if (fileNameSet.contains(aFileName)) {
+        return;
+    }
+
+    // Add File Name
+    fileNameSet.insert(aFileName);
+
+    // Get Row - Sorted Position Once Sorted
+    int row = sorted ? std::lower_bound(fileNames.begin(), fileNames.end(), aFileName, fileNameLessThan) - fileNames.begin() : fileNames.count();
+
+    // Begin Insert Rows
+    beginInsertRows(QModelIndex(), row, row);
+    // Insert File Name
+    fileNames.insert(row, aFileName);
+    // End Insert Rows
+    endInsertRows();
+
+    // Emit Count Changed Signal
+    emit countChanged(fileNames.count());
+}
+
+//==============================================================================
+// Remove Entry
+//==============================================================================
+void DirectoryModel::removeEntry(const QString& aFileName)
+{
+    // Remove From File Name Set
+    if (!fileNameSet.remove(aFileName)) {
+        return;
+    }
+
+    // Get Row
+    int row = sorted ? indexOf(QDir(dirPath).filePath(aFileName)) : fileNames.indexOf(aFileName);
+
+    // Check Row
+    if (row < 0) {
+        return;
+    }
+
+    // Begin Remove Rows
+    beginRemoveRows(QModelIndex(), row, row);
+    // Remove File Name
+    fileNames.removeAt(row);
+    // End Remove Rows
+    endRemoveRows();
+
+    // Emit Count Changed Signal
+    emit countChanged(fileNames.count());
+}
+
+//==============================================================================
+// Start Watching Dir
+//==============================================================================
+void DirectoryModel::startWatching()
+{
+    // Check Dir Path
+    if (dirPath.isEmpty()) {
+        return;
+    }
+
+#ifdef Q_OS_LINUX
+
+    // Init inotify Instance
+    watchDescriptor = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+
+    // Check Watch Descriptor
+    if (watchDescriptor < 0) {
+        qDebug() << "DirectoryModel::startWatching - ERROR CREATING INOTIFY INSTANCE!";
+        return;
+    }
+
+    // Add Watch - Entries Coming & Going, and the Dir Itself Going
+    if (inotify_add_watch(watchDescriptor, QFile::encodeName(dirPath).constData(), IN_CREATE | IN_MOVED_TO | IN_DELETE | IN_MOVED_FROM | IN_DELETE_SELF | IN_MOVE_SELF | IN_ONLYDIR) < 0) {
+        qDebug() << "DirectoryModel::startWatching - dirPath: " << dirPath << " - ERROR ADDING WATCH!";
+        // Close Watch Descriptor
+        close(watchDescriptor);
+        // Reset Watch Descriptor
+        watchDescriptor = -1;
+        return;
+    }
+
+    // Create Watch Notifier
+    watchNotifier = new QSocketNotifier(watchDescriptor, QSocketNotifier::Read, this);
+    // Connect Signal
+    connect(watchNotifier, SIGNAL(activated(int)), this, SLOT(watchActivated()));
+
+#else // Q_OS_LINUX
+
+    // Create Directory Watcher
+    directoryWatcher = new QFileSystemWatcher(QStringList() << dirPath, this);
+    // Connect Signal
+    connect(directoryWatcher, SIGNAL(directoryChanged(QString)), this, SLOT(directoryChanged()));
+
+#endif // Q_OS_LINUX
+}
+
+//==============================================================================
+// Stop Watching Dir
+//==============================================================================
+void DirectoryModel::stopWatching()
+{
+    // Check Watch Notifier
+    if (watchNotifier) {
+        // Delete Watch Notifier
+        delete watchNotifier;
+        watchNotifier = NULL;
+    }
+
+#ifdef Q_OS_LINUX
+    // Check Watch Descriptor
+    if (watchDescriptor >= 0) {
+        // Close Watch Descriptor - Drops the Watch Too
+        close(watchDescriptor);
+        // Reset Watch Descriptor
+        watchDescriptor = -1;
+    }
+#endif // Q_OS_LINUX
+
+    // Check Directory Watcher
+    if (directoryWatcher) {
+        // Delete Directory Watcher
+        delete directoryWatcher;
+        directoryWatcher = NULL;
+    }
+}
+
+//==============================================================================
+// Watch Activated Slot - Reads Pending Change Events
+//==============================================================================
+void DirectoryModel::watchActivated()
+{
+#ifdef Q_OS_LINUX
+
+    // Init Event Buffer - Aligned For the Events In It
+    char buffer[DEFAULT_DIRECTORY_WATCH_BUFFER_SIZE] __attribute__((aligned(__alignof__(struct inotify_event))));
+    // Init Supported Suffixes
+    QSet<QByteArray> suffixes = supportedSuffixes();
+    // Init Rescan & Changed
+    bool rescan = false;
+    bool changed = false;
+
+    // Read Events
+    forever {
+        // Read
+        ssize_t length = read(watchDescriptor, buffer, sizeof(buffer));
+
+        // Check Length - Nothing More Pending
+        if (length <= 0) {
+            break;
+        }
+
+        // Go Thru Events
+        for (ssize_t position = 0; position < length; ) {
+            // Get Event
+            const struct inotify_event* event = (const struct inotify_event*)(buffer + position);
+            // Inc Position
+            position += sizeof(struct inotify_event) + event->len;
+
+            // Check Overflow & Dir Gone - Deltas Can Not Be Trusted Any More
+            if (event->mask & (IN_Q_OVERFLOW | IN_DELETE_SELF | IN_MOVE_SELF)) {
+                // Set Rescan
+                rescan = true;
+                continue;
+            }
+
+            // Check Dir & Name
+            if ((event->mask & IN_ISDIR) || event->len == 0 || !isSupportedImageName(event->name, suffixes)) {
+                continue;
+            }
+
+            // Check Event
+            if (event->mask & (IN_CREATE | IN_MOVED_TO)) {
+                // Add Entry
+                addEntry(QFile::decodeName(event->name));
+            } else {
+                // Remove Entry
+                removeEntry(QFile::decodeName(event->name));
+            }
+
+            // Set Changed
+            changed = true;
+        }
+    }
+
+    // Check Rescan
+    if (rescan) {
+        qDebug() << "DirectoryModel::watchActivated - dirPath: " << dirPath << " - RESCAN";
+        // Start Scan
+        startScan();
+    }
+
+    // Check Changed
+    if (changed || rescan) {
+        // Emit Files Changed Signal
+        emit filesChanged();
+    }
+
+#endif // Q_OS_LINUX
+}
+
+//==============================================================================
+// Directory Changed Slot - Where No Change Events Are Available
+//==============================================================================
+void DirectoryModel::directoryChanged()
+{
+    // Start Scan
+    startScan();
+
+    // Emit Files Changed Signal
+    emit filesChanged();
+}
+
+//==============================================================================
+// Destructor
+//==============================================================================
+DirectoryModel::~DirectoryModel()
+{
+    // Stop Watching
+    stopWatching();
+
+    // Inc Generation - Running Scan Stops
+    generation.ref();
+    // Wait For Scan Task
+    scanPool.waitForDone();
+
+    qDebug() << "DirectoryModel::~DirectoryModel";
+}
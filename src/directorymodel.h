@@ -0,0 +1,144 @@
+#ifndef DIRECTORYMODEL_H
+#define DIRECTORYMODEL_H
+
+#include <QAbstractListModel>
+#include <QString>
+#include <QStringList>
+#include <QSet>
+#include <QHash>
+#include <QThreadPool>
+#include <QAtomicInt>
+
+class QSocketNotifier;
+class QFileSystemWatcher;
+
+// Read Supported Image File Names of Dir - Directory Order, No Stat Per Entry
+QStringList readImageFileNames(const QString& aDirPath);
+
+//==============================================================================
+// Directory Model Class - Flat List of the Supported Image Files of a Dir
+//
+// Entries Are Enumerated In the Background & Exposed Batch By Batch, Sorted Only
+// When the Order Is First Needed. Changes Are Applied As Deltas From inotify
+//==============================================================================
+class DirectoryModel : public QAbstractListModel
+{
+    Q_OBJECT
+
+    Q_PROPERTY(QString dirPath READ getDirPath WRITE setDirPath NOTIFY dirPathChanged)
+    Q_PROPERTY(int count READ getCount NOTIFY countChanged)
+    Q_PROPERTY(bool scanning READ getScanning NOTIFY scanningChanged)
+
+public:
+
+    // Directory Model Roles
+    enum DirectoryModelRoles
+    {
+        FileNameRole    = Qt::UserRole + 1,
+        FilePathRole
+    };
+
+    // Constructor
+    explicit DirectoryModel(QObject* aParent = NULL);
+
+    // Get Dir Path
+    QString getDirPath();
+    // Set Dir Path - Starts a New Scan
+    void setDirPath(const QString& aDirPath);
+
+    // Get Count
+    int getCount();
+
+    // Get Scanning
+    bool getScanning();
+
+    // Get File Paths In Name Order - Sorts First If Needed
+    QStringList filePaths();
+
+    // Get File Path of Row
+    Q_INVOKABLE QString filePath(const int& aRow);
+    // Get Row of File Path In Name Order - -1 If Not Listed
+    Q_INVOKABLE int indexOf(const QString& aFilePath);
+
+    // Row Count
+    virtual int rowCount(const QModelIndex& aParent = QModelIndex()) const;
+    // Data
+    virtual QVariant data(const QModelIndex& aIndex, int aRole = Qt::DisplayRole) const;
+    // Role Names
+    virtual QHash<int, QByteArray> roleNames() const;
+
+    // Destructor
+    virtual ~DirectoryModel();
+
+signals:
+
+    // Dir Path Changed Signal
+    void dirPathChanged(const QString& aDirPath);
+    // Count Changed Signal
+    void countChanged(const int& aCount);
+    // Scanning Changed Signal
+    void scanningChanged(const bool& aScanning);
+
+    // Files Changed Signal - Files Added Or Removed After the Scan
+    void filesChanged();
+
+protected slots:
+
+    // Entries Found Slot - Posted By the Scan Task
+    void entriesFound(const QStringList& aFileNames, const int& aGeneration);
+    // Scan Finished Slot - Posted By the Scan Task
+    void scanFinished(const int& aGeneration);
+
+    // Watch Activated Slot - Reads Pending Change Events
+    void watchActivated();
+    // Directory Changed Slot - Where No Change Events Are Available
+    void directoryChanged();
+
+protected:
+
+    // Start Scan - Cancels the Running One
+    void startScan();
+
+    // Start Watching Dir
+    void startWatching();
+    // Stop Watching Dir
+    void stopWatching();
+
+    // Sort Entries - Once, Deltas Keep the Order After
+    void sortEntries();
+
+    // Add Entry
+    void addEntry(const QString& aFileName);
+    // Remove Entry
+    void removeEntry(const QString& aFileName);
+
+    // Set Scanning
+    void setScanning(const bool& aScanning);
+
+private:
+
+    // Dir Path
+    QString                 dirPath;
+    // File Names - Arrival Order Until Sorted
+    QStringList             fileNames;
+    // File Name Set - Keeps Repeated Create Events From Adding Twice
+    QSet<QString>           fileNameSet;
+    // Sorted
+    bool                    sorted;
+    // Scanning
+    bool                    scanning;
+
+    // Scan Generation - Bumped To Cancel the Running Scan
+    QAtomicInt              generation;
+    // Scan Thread Pool
+    QThreadPool             scanPool;
+
+    // Watch Descriptor - inotify Instance
+    int                     watchDescriptor;
+    // Watch Notifier
+    QSocketNotifier*        watchNotifier;
+    // Directory Watcher - Where inotify Is Not Available
+    QFileSystemWatcher*     directoryWatcher;
+};
+
+#endif // DIRECTORYMODEL_H
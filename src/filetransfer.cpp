@@ -0,0 +1,290 @@
+#include <QDebug>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QByteArray>
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+
+#ifdef Q_OS_LINUX
+
+#include <sys/sendfile.h>
+
+#endif // Q_OS_LINUX
+
+#include "filetransfer.h"
+#include "constants.h"
+
+
+//==============================================================================
+// Copy Modes - Fastest First, Downgraded When the Kernel Refuses
+//==============================================================================
+enum CopyModeType
+{
+    CMTCopyFileRange    = 0,
+    CMTSendFile,
+    CMTReadWrite
+};
+
+//==============================================================================
+// Get Device ID of the File System Containing Path
+//==============================================================================
+qint64 fileDeviceID(const QString& aPath)
+{
+    // Init Stat
+    struct stat pathStat;
+
+    // Stat Path
+    if (::stat(QFile::encodeName(aPath).constData(), &pathStat) != 0) {
+        return -1;
+    }
+
+    return (qint64)pathStat.st_dev;
+}
+
+//==============================================================================
+// Write All Bytes To File Descriptor
+//==============================================================================
+static bool writeAll(const int& aFd, const char* aData, qint64 aSize)
+{
+    // Write Until Done
+    while (aSize > 0) {
+        // Write
+        ssize_t written = ::write(aFd, aData, (size_t)aSize);
+
+        // Check Written
+        if (written < 0) {
+            // Check Interrupted
+            if (errno == EINTR) {
+                continue;
+            }
+
+            return false;
+        }
+
+        // Advance
+        aData += written;
+        aSize -= written;
+    }
+
+    return true;
+}
+
+//==============================================================================
+// Copy File Data Between Descriptors - Kernel Side Where Available
+//==============================================================================
+static bool copyFileData(const int& aSourceFd,
+                         const int& aTargetFd,
+                         const qint64& aSize,
+                         QAtomicInteger<qint64>& aBytesDone,
+                         const QAtomicInt& aCancelled,
+                         QString& aError)
+{
+#ifdef Q_OS_LINUX
+    // Init Copy Mode
+    int copyMode = CMTCopyFileRange;
+#else // Q_OS_LINUX
+    // Init Copy Mode
+    int copyMode = CMTReadWrite;
+#endif // Q_OS_LINUX
+
+    // Init Read Buffer - Only Used By the Read/Write Fallback
+    QByteArray buffer;
+    // Init Remaining
+    qint64 remaining = aSize;
+
+    // Copy Until Done - Chunked So Progress & Cancellation Are Checked Regularly
+    while (remaining > 0) {
+        // Check Cancelled
+        if (aCancelled.load()) {
+            // Set Error
+            aError = QString("Cancelled");
+            return false;
+        }
+
+        // Get Chunk Size
+        size_t chunkSize = (size_t)qMin<qint64>(remaining, DEFAULT_TRANSFER_CHUNK_SIZE);
+        // Init Copied
+        ssize_t copied = -1;
+
+#ifdef Q_OS_LINUX
+
+        // Check Copy Mode
+        if (copyMode == CMTCopyFileRange) {
+            // Copy Range In Kernel - Reflinks On File Systems That Support It
+            copied = ::copy_file_range(aSourceFd, NULL, aTargetFd, NULL, chunkSize, 0);
+
+            // Check Unsupported - Offsets Are Unchanged, Next Mode Picks Up Where We Are
+            if (copied < 0 && (errno == ENOSYS || errno == EXDEV || errno == EINVAL || errno == EOPNOTSUPP)) {
+                // Downgrade Copy Mode
+                copyMode = CMTSendFile;
+                continue;
+            }
+        } else if (copyMode == CMTSendFile) {
+            // Copy Through Page Cache In Kernel
+            copied = ::sendfile(aTargetFd, aSourceFd, NULL, chunkSize);
+
+            // Check Unsupported
+            if (copied < 0 && (errno == ENOSYS || errno == EINVAL)) {
+                // Downgrade Copy Mode
+                copyMode = CMTReadWrite;
+                continue;
+            }
+        }
+
+#endif // Q_OS_LINUX
+
+        // Check Copy Mode
+        if (copyMode == CMTReadWrite) {
+            // Check Buffer
+            if (buffer.isEmpty()) {
+                // Allocate Buffer
+                buffer.resize(DEFAULT_TRANSFER_BUFFER_SIZE);
+            }
+
+            // Read
+            copied = ::read(aSourceFd, buffer.data(), qMin<size_t>(chunkSize, (size_t)buffer.size()));
+
+            // Check Read & Write
+            if (copied > 0 && !writeAll(aTargetFd, buffer.constData(), copied)) {
+                // Set Error
+                aError = QString::fromLocal8Bit(strerror(errno));
+                return false;
+            }
+        }
+
+        // Check Copied
+        if (copied < 0) {
+            // Check Interrupted
+            if (errno == EINTR) {
+                continue;
+            }
+
+            // Set Error
+            aError = QString::fromLocal8Bit(strerror(errno));
+            return false;
+        }
+
+        // Check Source Shrank
+        if (copied == 0) {
+            // Set Error
+            aError = QString("Source file changed during copy");
+            return false;
+        }
+
+        // Advance
+        remaining -= copied;
+        // Add Bytes Done
+        aBytesDone.fetchAndAddRelaxed(copied);
+    }
+
+    return true;
+}
+
+//==============================================================================
+// Transfer File - Renames Within a File System, Copies Kernel Side Otherwise, Target Written Atomically
+//==============================================================================
+bool transferFile(const QString& aSourcePath,
+                  const QString& aTargetPath,
+                  const bool& aMove,
+                  QAtomicInteger<qint64>& aBytesDone,
+                  const QAtomicInt& aCancelled,
+                  QString& aError)
+{
+    // Init Source Info
+    QFileInfo sourceInfo(aSourcePath);
+
+    // Check Move Within the Same File System
+    if (aMove && fileDeviceID(aSourcePath) == fileDeviceID(QFileInfo(aTargetPath).absolutePath())) {
+        // Rename - Replaces Existing Target Atomically
+        if (::rename(QFile::encodeName(aSourcePath).constData(), QFile::encodeName(aTargetPath).constData()) == 0) {
+            // Add Bytes Done
+            aBytesDone.fetchAndAddRelaxed(sourceInfo.size());
+            return true;
+        }
+
+        // Check Cross Device - Bind Mounts Share Device IDs, Fall Back To Copy
+        if (errno != EXDEV) {
+            // Set Error
+            aError = QString::fromLocal8Bit(strerror(errno));
+            return false;
+        }
+    }
+
+    // Open Source
+    int sourceFd = ::open(QFile::encodeName(aSourcePath).constData(), O_RDONLY | O_CLOEXEC);
+
+    // Check Source
+    if (sourceFd < 0) {
+        // Set Error
+        aError = QString::fromLocal8Bit(strerror(errno));
+        return false;
+    }
+
+    // Init Source Stat
+    struct stat sourceStat;
+
+    // Stat Source
+    if (::fstat(sourceFd, &sourceStat) != 0) {
+        // Set Error
+        aError = QString::fromLocal8Bit(strerror(errno));
+        // Close Source
+        ::close(sourceFd);
+        return false;
+    }
+
+#ifdef Q_OS_LINUX
+    // Advise Sequential Read
+    ::posix_fadvise(sourceFd, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif // Q_OS_LINUX
+
+    // Init Target File - Written Next To the Target, Renamed Over It On Commit
+    QSaveFile targetFile(aTargetPath);
+
+    // Open Target File
+    if (!targetFile.open(QIODevice::WriteOnly)) {
+        // Set Error
+        aError = targetFile.errorString();
+        // Close Source
+        ::close(sourceFd);
+        return false;
+    }
+
+    // Copy File Data
+    bool result = copyFileData(sourceFd, targetFile.handle(), (qint64)sourceStat.st_size, aBytesDone, aCancelled, aError);
+
+    // Close Source
+    ::close(sourceFd);
+
+    // Check Result
+    if (!result) {
+        // Cancel Writing - Temporary File Is Removed
+        targetFile.cancelWriting();
+        return false;
+    }
+
+    // Commit
+    if (!targetFile.commit()) {
+        // Set Error
+        aError = targetFile.errorString();
+        return false;
+    }
+
+    // Copy Permissions
+    QFile::setPermissions(aTargetPath, sourceInfo.permissions());
+
+    // Check Move
+    if (aMove && !QFile::remove(aSourcePath)) {
+        // Set Error
+        aError = QString("Copied but failed to remove source");
+        return false;
+    }
+
+    return true;
+}
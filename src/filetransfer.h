@@ -0,0 +1,19 @@
+#ifndef FILETRANSFER_H
+#define FILETRANSFER_H
+
+#include <QString>
+#include <QAtomicInt>
+#include <QAtomicInteger>
+
+// Get Device ID of the File System Containing Path
+qint64 fileDeviceID(const QString& aPath);
+
+// Transfer File - Renames Within a File System, Copies Kernel Side Otherwise, Target Written Atomically
+bool transferFile(const QString& aSourcePath,
+                  const QString& aTargetPath,
+                  const bool& aMove,
+                  QAtomicInteger<qint64>& aBytesDone,
+                  const QAtomicInt& aCancelled,
+                  QString& aError);
+
+#endif // FILETRANSFER_H
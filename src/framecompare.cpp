@@ -0,0 +1,300 @@
+#include <QDebug>
+#include <QImage>
+#include <QImageReader>
+#include <QRunnable>
+#include <QThreadPool>
+#include <QSemaphore>
+#include <QMutex>
+#include <QMutexLocker>
+
+#include <algorithm>
+
+#include "framecompare.h"
+#include "imagenormalizer.h"
+#include "utility.h"
+#include "constants.h"
+
+
+//==============================================================================
+// Frame Compare Task Class
+//==============================================================================
+class FrameCompareTask : public QRunnable
+{
+public:
+
+    // Constructor
+    FrameCompareTask(const QImage& aLeftFrame, const QImage& aRightFrame, const FrameCompareStats& aStats, QMutex& aResultMutex, QVector<FrameCompareStats>& aResults, QSemaphore& aPipelineSlots)
+        : leftFrame(aLeftFrame)
+        , rightFrame(aRightFrame)
+        , stats(aStats)
+        , resultMutex(aResultMutex)
+        , results(aResults)
+        , pipelineSlots(aPipelineSlots)
+    {
+    }
+
+    // Run
+    virtual void run()
+    {
+        // Check Sizes
+        if (leftFrame.size() != rightFrame.size()) {
+            // Set Size Mismatch
+            stats.sizeMismatch = true;
+            // Set Differing Pixels
+            stats.differingPixels = qMax((qint64)leftFrame.width() * leftFrame.height(), (qint64)rightFrame.width() * rightFrame.height());
+        } else {
+            // Compare Pixels
+            comparePixels();
+        }
+
+        // Lock Results
+        QMutexLocker locker(&resultMutex);
+        // Add Statistics
+        results << stats;
+        // Unlock Results
+        locker.unlock();
+
+        // Release Pipeline Slot
+        pipelineSlots.release();
+    }
+
+private:
+
+    // Compare Pixels
+    void comparePixels()
+    {
+        // Get Format - Converted Here Directly, normalizeImage Would Wait On the Pool This Task Runs In
+        QImage::Format format = normalizedFormat(AMTStraight);
+        // Get Frames
+        QImage left = leftFrame.format() == format ? leftFrame : leftFrame.convertToFormat(format);
+        QImage right = rightFrame.format() == format ? rightFrame : rightFrame.convertToFormat(format);
+
+        // Get Width
+        int width = left.width();
+        // Init Keep Row - Whole Frame Compared
+        QVector<QRgb> keepAll(width, 0xFFFFFFFF);
+
+        // Go Thru Rows
+        for (int y = 0; y < left.height(); y++) {
+            // Get Lines
+            const QRgb* leftLine = (const QRgb*)left.constScanLine(y);
+            const QRgb* rightLine = (const QRgb*)right.constScanLine(y);
+
+            // Check Row - Vectorized, Matching Rows Skip the Per Pixel Pass
+            if (!comparePixelRows(leftLine, rightLine, keepAll.constData(), width)) {
+                // Go Thru Pixels
+                for (int x = 0; x < width; x++) {
+                    // Check Pixels
+                    if (leftLine[x] != rightLine[x]) {
+                        // Inc Differing Pixels
+                        stats.differingPixels++;
+                        // Update Max Difference
+                        stats.maxDifference = qMax(stats.maxDifference, qMax(qMax(qAbs(qRed(leftLine[x]) - qRed(rightLine[x])),
+                                                                                  qAbs(qGreen(leftLine[x]) - qGreen(rightLine[x]))),
+                                                                             qMax(qAbs(qBlue(leftLine[x]) - qBlue(rightLine[x])),
+                                                                                  qAbs(qAlpha(leftLine[x]) - qAlpha(rightLine[x])))));
+                    }
+                }
+            }
+        }
+
+        // Set Pixels
+        stats.pixels = (qint64)width * left.height();
+    }
+
+    // Left Frame
+    QImage                          leftFrame;
+    // Right Frame
+    QImage                          rightFrame;
+    // Frame Statistics
+    FrameCompareStats               stats;
+    // Result Mutex
+    QMutex&                         resultMutex;
+    // Results
+    QVector<FrameCompareStats>&     results;
+    // Pipeline Slots
+    QSemaphore&                     pipelineSlots;
+};
+
+//==============================================================================
+// Compare Frame Stats By Index
+//==============================================================================
+static bool frameLessThan(const FrameCompareStats& aLeft, const FrameCompareStats& aRight)
+{
+    return aLeft.frame < aRight.frame;
+}
+
+//==============================================================================
+// Read Next Frame of Sequence - Returns False When the Sequence Ended
+//==============================================================================
+bool readNextFrame(QImageReader& aReader, const int& aFrame, const int& aCount, QImage& aImage, int& aDelay)
+{
+    // Check Count - Known Counts Stop Handlers That Keep Reporting More Data
+    if (aCount > 0 && aFrame >= aCount) {
+        return false;
+    }
+
+    // Check Handler Still On the Previous Frame - Multi Page Handlers Only Advance When Asked
+    if (aFrame > 0 && aReader.currentImageNumber() == aFrame - 1) {
+        aReader.jumpToNextImage();
+    }
+
+    // Check More Frames
+    if (aFrame > 0 && !aReader.canRead()) {
+        return false;
+    }
+
+    // Read Frame
+    aImage = aReader.read();
+    // Get Delay of the Frame Just Read
+    aDelay = qMax(0, aReader.nextImageDelay());
+
+    return !aImage.isNull();
+}
+
+//==============================================================================
+// Get Frame Count of File - 1 For Still Images, 0 If Unreadable
+//==============================================================================
+int frameCount(const QString& aFilePath)
+{
+    // Init Reader
+    QImageReader reader(aFilePath);
+
+    // Check Reader
+    if (!reader.canRead()) {
+        return 0;
+    }
+
+    return qMax(1, reader.imageCount());
+}
+
+//==============================================================================
+// Compare Frame Sequences - Frames Compared In Parallel While Decoding Continues
+//==============================================================================
+bool compareFrameSequences(const QString& aLeftFile, const QString& aRightFile, const int& aTimingTolerance, FrameSequenceResult& aResult, QString& aError)
+{
+    // Reset Result
+    aResult.leftFrames = 0;
+    aResult.rightFrames = 0;
+    aResult.firstDifferingFrame = -1;
+    aResult.firstTimingFrame = -1;
+    aResult.differingFrames = 0;
+    aResult.timingFrames = 0;
+    aResult.frames.clear();
+
+    // Init Readers
+    QImageReader leftReader(aLeftFile);
+    QImageReader rightReader(aRightFile);
+
+    // Get Frame Counts - 0 When the Handler Can Not Tell Without Decoding
+    int leftCount = leftReader.imageCount();
+    int rightCount = rightReader.imageCount();
+
+    // Init Result Mutex
+    QMutex resultMutex;
+    // Init Pipeline Slots - Bounds Decoded Frames Waiting For Comparison
+    QSemaphore pipelineSlots(DEFAULT_FRAME_COMPARE_PIPELINE_DEPTH);
+
+    // Init Frames
+    QImage leftFrame;
+    QImage rightFrame;
+    // Init Delays
+    int leftDelay = 0;
+    int rightDelay = 0;
+    // Init Sequence Ended Flags
+    bool leftEnded = false;
+    bool rightEnded = false;
+
+    // Go Thru Frames
+    for (int frame = 0; !leftEnded || !rightEnded; frame++) {
+        // Read Left Frame
+        if (!leftEnded && readNextFrame(leftReader, frame, leftCount, leftFrame, leftDelay)) {
+            aResult.leftFrames++;
+        } else {
+            leftEnded = true;
+        }
+
+        // Read Right Frame
+        if (!rightEnded && readNextFrame(rightReader, frame, rightCount, rightFrame, rightDelay)) {
+            aResult.rightFrames++;
+        } else {
+            rightEnded = true;
+        }
+
+        // Check Both Frames - Extra Frames Only Count
+        if (leftEnded || rightEnded) {
+            continue;
+        }
+
+        // Init Frame Statistics
+        FrameCompareStats stats;
+        stats.frame = frame;
+        stats.pixels = 0;
+        stats.differingPixels = 0;
+        stats.maxDifference = 0;
+        stats.leftDelay = leftDelay;
+        stats.rightDelay = rightDelay;
+        stats.sizeMismatch = false;
+
+        // Acquire Pipeline Slot - Decoding Pauses While Comparison Lags Behind
+        pipelineSlots.acquire();
+
+        // Start Task
+        QThreadPool::globalInstance()->start(new FrameCompareTask(leftFrame, rightFrame, stats, resultMutex, aResult.frames, pipelineSlots));
+    }
+
+    // Wait For Tasks
+    pipelineSlots.acquire(DEFAULT_FRAME_COMPARE_PIPELINE_DEPTH);
+
+    // Check Left Frames
+    if (aResult.leftFrames == 0) {
+        // Set Error
+        aError = aLeftFile + ": " + leftReader.errorString();
+        return false;
+    }
+
+    // Check Right Frames
+    if (aResult.rightFrames == 0) {
+        // Set Error
+        aError = aRightFile + ": " + rightReader.errorString();
+        return false;
+    }
+
+    // Sort Frames - Tasks Finish Out of Order
+    std::sort(aResult.frames.begin(), aResult.frames.end(), frameLessThan);
+
+    // Go Thru Frames
+    for (int i = 0; i < aResult.frames.count(); i++) {
+        // Get Frame Statistics
+        const FrameCompareStats& stats = aResult.frames[i];
+
+        // Check Differing Pixels
+        if (stats.differingPixels > 0) {
+            // Check First Differing Frame
+            if (aResult.firstDifferingFrame < 0) {
+                aResult.firstDifferingFrame = stats.frame;
+            }
+
+            // Inc Differing Frames
+            aResult.differingFrames++;
+        }
+
+        // Check Timing
+        if (stats.timingDiffers(aTimingTolerance)) {
+            // Check First Timing Frame
+            if (aResult.firstTimingFrame < 0) {
+                aResult.firstTimingFrame = stats.frame;
+            }
+
+            // Inc Timing Frames
+            aResult.timingFrames++;
+        }
+    }
+
+    // Check Frame Counts - The First Missing Frame Differs
+    if (aResult.firstDifferingFrame < 0 && aResult.leftFrames != aResult.rightFrames) {
+        aResult.firstDifferingFrame = qMin(aResult.leftFrames, aResult.rightFrames);
+    }
+
+    return true;
+}
@@ -0,0 +1,64 @@
+#ifndef FRAMECOMPARE_H
+#define FRAMECOMPARE_H
+
+#include <QString>
+#include <QVector>
+#include <QImage>
+#include <QImageReader>
+
+//==============================================================================
+// Frame Compare Statistics
+//==============================================================================
+struct FrameCompareStats
+{
+    // Frame Index
+    int         frame;
+    // Compared Pixels
+    qint64      pixels;
+    // Differing Pixels - All Pixels When Sizes Differ
+    qint64      differingPixels;
+    // Max Channel Difference
+    int         maxDifference;
+    // Frame Delays In ms
+    int         leftDelay;
+    int         rightDelay;
+    // Sizes Differ
+    bool        sizeMismatch;
+
+    // Check Timing Differs
+    bool timingDiffers(const int& aTolerance) const { return qAbs(leftDelay - rightDelay) > aTolerance; }
+};
+
+//==============================================================================
+// Frame Sequence Compare Result
+//==============================================================================
+struct FrameSequenceResult
+{
+    // Decoded Frame Counts
+    int                         leftFrames;
+    int                         rightFrames;
+    // First Frame With Differing Pixels, -1 If None
+    int                         firstDifferingFrame;
+    // First Frame With Differing Delay, -1 If None
+    int                         firstTimingFrame;
+    // Frames With Differing Pixels
+    int                         differingFrames;
+    // Frames With Differing Delay
+    int                         timingFrames;
+    // Per Frame Statistics - Frames Both Files Have
+    QVector<FrameCompareStats>  frames;
+
+    // Check Sequences Match
+    bool matches() const { return leftFrames == rightFrames && differingFrames == 0 && timingFrames == 0; }
+};
+
+// Get Frame Count of File - 1 For Still Images, 0 If Unreadable
+int frameCount(const QString& aFilePath);
+
+// Read Next Frame of Sequence - Returns False When the Sequence Ended
+bool readNextFrame(QImageReader& aReader, const int& aFrame, const int& aCount, QImage& aImage, int& aDelay);
+
+// Compare Frame Sequences - Frames Compared In Parallel While Decoding Continues
+bool compareFrameSequences(const QString& aLeftFile, const QString& aRightFile, const int& aTimingTolerance, FrameSequenceResult& aResult, QString& aError);
+
+#endif // FRAMECOMPARE_H
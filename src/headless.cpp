@@ -0,0 +1,236 @@
+#include <QDebug>
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QCommandLineOption>
+#include <QElapsedTimer>
+#include <QImageReader>
+#include <QTextStream>
+
+#include <string.h>
+
+#include "headless.h"
+#include "deepcompare.h"
+#include "framecompare.h"
+#include "resultcache.h"
+#include "comparemask.h"
+#include "comparedaemon.h"
+#include "constants.h"
+#include "defaultsettings.h"
+
+
+//==============================================================================
+// Check If Command Line Asks For a Headless Run
+//==============================================================================
+bool isHeadlessCommand(int argc, char* argv[])
+{
+    // Go Thru Arguments
+    for (int i = 1; i < argc; i++) {
+        // Check Compare, Daemon & Client Options
+        if (strcmp(argv[i], "--compare") == 0 || strcmp(argv[i], "--daemon") == 0 || strcmp(argv[i], "--client") == 0) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+//==============================================================================
+// Run Headless Command - Returns Process Exit Code
+//==============================================================================
+int runHeadlessCommand(int argc, char* argv[])
+{
+    // Init Application - No Display Needed
+    QCoreApplication app(argc, argv);
+
+    // Set Application Name
+    app.setApplicationName(DEFAULT_APPLICATION_NAME);
+    // Set Organization Name
+    app.setOrganizationName(DEFAULT_ORGANIZATION_NAME);
+
+    // Init Output Stream
+    QTextStream output(stdout);
+
+    // Init Command Line Parser
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Compare two images without opening a window");
+    parser.addHelpOption();
+
+    // Init Options
+    QCommandLineOption compareOption("compare", "Compare <left> and <right> image files.");
+    QCommandLineOption toleranceOption("tolerance", "Max channel difference in 16 bit units treated as equal.", "units", QString::number(DEFAULT_DEEP_COMPARE_TOLERANCE));
+    QCommandLineOption offsetOption("offset", "Right image translation relative to the left one, in pixels.", "x,y", "0,0");
+    QCommandLineOption framesOption("frames", "Compare animated and multi page files frame by frame.");
+    QCommandLineOption cacheSizeOption("cache-size", "Result cache size.", "MB");
+    QCommandLineOption noCacheOption("no-cache", "Do not use the result cache.");
+    QCommandLineOption daemonOption("daemon", "Serve compare requests with warm caches over a local socket.");
+    QCommandLineOption clientOption("client", "Send <left> <right> pairs to a running daemon.");
+    QCommandLineOption socketOption("socket", "Local socket name of the daemon.", "name", DEFAULT_DAEMON_SERVER_NAME);
+
+    // Add Options
+    parser.addOption(compareOption);
+    parser.addOption(toleranceOption);
+    parser.addOption(offsetOption);
+    parser.addOption(framesOption);
+    parser.addOption(cacheSizeOption);
+    parser.addOption(noCacheOption);
+    parser.addOption(daemonOption);
+    parser.addOption(clientOption);
+    parser.addOption(socketOption);
+    parser.addPositionalArgument("left", "Left image file, or shm:<name> for a shared image.");
+    parser.addPositionalArgument("right", "Right image file, or shm:<name> for a shared image.");
+
+    // Process Arguments
+    parser.process(app);
+
+    // Get Positional Arguments
+    QStringList files = parser.positionalArguments();
+
+    // Init Tolerance Valid
+    bool toleranceValid = false;
+    // Get Tolerance Value
+    uint toleranceValue = parser.value(toleranceOption).toUInt(&toleranceValid);
+
+    // Check Tolerance - 16 Bit Channel Units
+    if (!toleranceValid || toleranceValue > 0xFFFF) {
+        output << "Error: --tolerance must be 0..65535, got " << parser.value(toleranceOption) << endl;
+        return DEFAULT_HEADLESS_EXIT_ERROR;
+    }
+
+    // Get Tolerance
+    quint16 tolerance = (quint16)toleranceValue;
+
+    // Get Offset Parts
+    QStringList offsetParts = parser.value(offsetOption).split(',');
+    // Init Offset Valid
+    bool offsetXValid = false;
+    bool offsetYValid = false;
+    // Get Align Offset
+    QPoint alignOffset(offsetParts.value(0).trimmed().toInt(&offsetXValid), offsetParts.value(1).trimmed().toInt(&offsetYValid));
+
+    // Check Align Offset
+    if (offsetParts.count() != 2 || !offsetXValid || !offsetYValid) {
+        output << "Error: --offset must be <x>,<y>, got " << parser.value(offsetOption) << endl;
+        return DEFAULT_HEADLESS_EXIT_ERROR;
+    }
+
+    // Check Cache Size Option
+    if (parser.isSet(cacheSizeOption)) {
+        // Set Budget
+        ResultCache::getInstance()->setBudget(parser.value(cacheSizeOption).toLongLong() * 1024 * 1024);
+    }
+
+    // Check Daemon Option
+    if (parser.isSet(daemonOption)) {
+        // Init Daemon
+        CompareDaemon daemon;
+
+        // Listen
+        if (!daemon.listen(parser.value(socketOption))) {
+            output << "Error: can not listen on " << parser.value(socketOption) << endl;
+            return DEFAULT_HEADLESS_EXIT_ERROR;
+        }
+
+        return app.exec();
+    }
+
+    // Check Client Option
+    if (parser.isSet(clientOption)) {
+        // Run Client
+        // Check Align Offset - Not Part of the Daemon Protocol
+        if (!alignOffset.isNull()) {
+            output << "Error: --offset is not supported with --client" << endl;
+            return DEFAULT_HEADLESS_EXIT_ERROR;
+        }
+
+        return runCompareClient(parser.value(socketOption), files, tolerance, output);
+    }
+
+    // Check Files
+    if (files.count() != 2) {
+        output << "Error: --compare needs exactly 2 files" << endl;
+        return DEFAULT_HEADLESS_EXIT_ERROR;
+    }
+
+    // Init Elapsed Timer
+    QElapsedTimer elapsedTimer;
+    elapsedTimer.start();
+
+    // Init Error
+    QString error;
+
+    // Check Frames Option
+    if (parser.isSet(framesOption)) {
+        // Init Frame Sequence Result
+        FrameSequenceResult result;
+
+        // Compare Frame Sequences
+        if (!compareFrameSequences(files[0], files[1], DEFAULT_FRAME_TIMING_TOLERANCE, result, error)) {
+            output << "Error: " << error << endl;
+            return DEFAULT_HEADLESS_EXIT_ERROR;
+        }
+
+        // Go Thru Frames
+        for (int i = 0; i < result.frames.count(); i++) {
+            // Get Frame Statistics
+            const FrameCompareStats& stats = result.frames[i];
+
+            // Output Frame
+            output << "frame=" << stats.frame
+                   << " differing=" << stats.differingPixels
+                   << " max=" << stats.maxDifference
+                   << " delay=" << stats.leftDelay << "/" << stats.rightDelay
+                   << (stats.sizeMismatch ? " size-mismatch" : "") << endl;
+        }
+
+        // Output Result
+        output << (result.matches() ? "MATCH" : "DIFFER")
+               << " frames=" << result.leftFrames << "/" << result.rightFrames
+               << " first=" << result.firstDifferingFrame
+               << " differing=" << result.differingFrames
+               << " timing=" << result.timingFrames
+               << " time=" << elapsedTimer.elapsed() << "ms" << endl;
+
+        return result.matches() ? DEFAULT_HEADLESS_EXIT_MATCH : DEFAULT_HEADLESS_EXIT_DIFFER;
+    }
+
+    // Init Result
+    CachedCompareResult result;
+    // Init Cached
+    bool cached = false;
+
+    // Compare Files - At 16 Bits, Lossless For 8 Bit Files Too, Compare Mask of the Left File Applied
+    bool compared = parser.isSet(noCacheOption) ? compareFilesDeep(files[0], files[1], tolerance, result.stats, error, &result.diffMap,
+                                                                   compareMask(files[0], QImageReader(files[0]).size()), alignOffset)
+                                                : compareFilesDeepCached(files[0], files[1], tolerance, result, cached, error, alignOffset);
+
+    // Release Result Cache
+    ResultCache::getInstance()->release();
+
+    // Check Compared
+    if (!compared) {
+        output << "Error: " << error << endl;
+        return DEFAULT_HEADLESS_EXIT_ERROR;
+    }
+
+    // Check No Cache Option - Cached Compares Already Carry Regions
+    if (parser.isSet(noCacheOption)) {
+        // Get Regions
+        result.regions = result.diffMap.regions();
+    }
+
+    // Get Statistics
+    const DeepCompareStats& stats = result.stats;
+
+    // Output Result
+    output << (stats.differingPixels == 0 ? "MATCH" : "DIFFER")
+           << " pixels=" << stats.pixels
+           << " differing=" << stats.differingPixels
+           << " max=" << stats.maxDifference
+           << " mean=" << QString::number(stats.meanDifference(), 'f', 3)
+           << " depth=" << stats.leftDepth << "/" << stats.rightDepth
+           << " regions=" << result.regions.count()
+           << " cached=" << (cached ? 1 : 0)
+           << " time=" << elapsedTimer.elapsed() << "ms" << endl;
+
+    return stats.differingPixels == 0 ? DEFAULT_HEADLESS_EXIT_MATCH : DEFAULT_HEADLESS_EXIT_DIFFER;
+}
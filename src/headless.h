@@ -0,0 +1,10 @@
+#ifndef HEADLESS_H
+#define HEADLESS_H
+
+// Check If Command Line Asks For a Headless Run
+bool isHeadlessCommand(int argc, char* argv[]);
+
+// Run Headless Command - Returns Process Exit Code
+int runHeadlessCommand(int argc, char* argv[]);
+
+#endif // HEADLESS_H
@@ -0,0 +1,602 @@
+#include <QDebug>
+#include <QFileInfo>
+#include <QImageReader>
+#include <QRunnable>
+#include <QThread>
+#include <QMutexLocker>
+#include <QUrl>
+
+#include "imagecache.h"
+#include "imagenormalizer.h"
+#include "mappedimage.h"
+#include "decodedcache.h"
+#include "framecompare.h"
+#include "constants.h"
+#include "defaultsettings.h"
+
+// Image Cache Singleton
+static ImageCache* imageCache = NULL;
+
+//==============================================================================
+// Get Cache Key - Frames After the First Are Cached Separately
+//==============================================================================
+static QString cacheKey(const QString& aFilePath, const int& aFrame)
+{
+    return aFrame > 0 ? QString("%1#%2").arg(aFilePath).arg(aFrame) : aFilePath;
+}
+
+
+//==============================================================================
+// Prefetch Task Class
+//==============================================================================
+class PrefetchTask : public QRunnable
+{
+public:
+
+    // Constructor
+    PrefetchTask(ImageCache* aCache, const QString& aFilePath, const int& aGeneration)
+        : cache(aCache)
+        , filePath(aFilePath)
+        , generation(aGeneration)
+    {
+    }
+
+    // Run
+    virtual void run()
+    {
+        // Wait For Visible Loads - Thread Priorities Are Ignored By the Default Linux Scheduler, So Yield Explicitly
+        while (cache->visibleLoads.load() > 0 && cache->prefetchGeneration.load() == generation) {
+            // Sleep
+            QThread::msleep(DEFAULT_IMAGE_CACHE_PREFETCH_YIELD_MS);
+        }
+
+        // Check Generation - Navigation Changed Direction
+        if (cache->prefetchGeneration.load() != generation) {
+            return;
+        }
+
+        // Get File Info
+        QFileInfo fileInfo(filePath);
+
+        // Check File
+        if (!fileInfo.isFile()) {
+            return;
+        }
+
+        // Get Last Modified
+        QDateTime lastModified = fileInfo.lastModified();
+        // Get Image Size From Header
+        QSize imageSize = QImageReader(filePath).size();
+
+        // Lock Cache
+        QMutexLocker locker(&cache->cacheMutex);
+
+        // Check Cached Or Loading
+        if (cache->isValid(filePath, lastModified) || cache->loading.contains(filePath)) {
+            return;
+        }
+
+        // Check Budget - Decoded Size Must Fit the Cache At All
+        if ((qint64)imageSize.width() * imageSize.height() * 4 > cache->budgetBytes) {
+            return;
+        }
+
+        // Mark Loading
+        cache->loading.insert(filePath);
+
+        // Unlock Cache
+        locker.unlock();
+
+        // Load Image
+        cache->load(filePath, 0, lastModified, true);
+    }
+
+private:
+    // Cache
+    ImageCache*     cache;
+    // File Path
+    QString         filePath;
+    // Generation
+    int             generation;
+};
+
+
+//==============================================================================
+// Static Constructor
+//==============================================================================
+ImageCache* ImageCache::getInstance()
+{
+    // Check Singleton
+    if (!imageCache) {
+        // Create Image Cache
+        imageCache = new ImageCache();
+    }
+
+    return imageCache;
+}
+
+//==============================================================================
+// Release Instance
+//==============================================================================
+void ImageCache::release()
+{
+    // Delete Image Cache
+    delete imageCache;
+    // Reset Singleton
+    imageCache = NULL;
+}
+
+//==============================================================================
+// Constructor
+//==============================================================================
+ImageCache::ImageCache(QObject* aParent)
+    : QObject(aParent)
+    , accessCounter(0)
+    , usedBytes(0)
+    , budgetBytes((qint64)DEFAULT_IMAGE_CACHE_BUDGET_MB * 1024 * 1024)
+    , prefetchGeneration(0)
+    , prefetchDirection(0)
+    , visibleLoads(0)
+    , alphaMode(DEFAULT_ALPHA_MODE)
+{
+    qDebug() << "ImageCache::ImageCache";
+
+    // Set Max Thread Count - Leave Cores For the Visible Work
+    prefetchPool.setMaxThreadCount(qMax(1, QThread::idealThreadCount() / 2));
+}
+
+//==============================================================================
+// Get Image - Decodes On Miss, Waits For In Flight Prefetch
+//==============================================================================
+QImage ImageCache::image(const QString& aFilePath, const int& aFrame)
+{
+    // Get File Info
+    QFileInfo fileInfo(aFilePath);
+
+    // Check File
+    if (!fileInfo.isFile()) {
+        return QImage();
+    }
+
+    // Get Last Modified
+    QDateTime lastModified = fileInfo.lastModified();
+    // Get Cache Key
+    QString key = cacheKey(aFilePath, aFrame);
+
+    // Lock Cache
+    QMutexLocker locker(&cacheMutex);
+
+    // Update Recent Files
+    recentFiles.removeAll(key);
+    recentFiles.prepend(key);
+    while (recentFiles.count() > DEFAULT_IMAGE_CACHE_RECENT_COUNT) {
+        recentFiles.removeLast();
+    }
+
+    forever {
+        // Check Entry
+        if (isValid(key, lastModified)) {
+            // Update Last Access
+            entries[key].lastAccess = ++accessCounter;
+
+            return entries[key].image;
+        }
+
+        // Check Loading
+        if (!loading.contains(key)) {
+            break;
+        }
+
+        // Wait For Prefetch To Finish
+        loadFinished.wait(&cacheMutex);
+    }
+
+    // Mark Loading
+    loading.insert(key);
+
+    // Unlock Cache
+    locker.unlock();
+
+    // Inc Visible Loads
+    visibleLoads.ref();
+    // Load Image
+    QImage image = load(aFilePath, aFrame, lastModified, false);
+    // Dec Visible Loads
+    visibleLoads.deref();
+
+    return image;
+}
+
+//==============================================================================
+// Get Block Hashes of Cached Image - Invalid If Not Cached, Check Against the Image
+//==============================================================================
+BlockHashGrid ImageCache::blockHashes(const QString& aFilePath, const int& aFrame)
+{
+    // Lock Cache
+    QMutexLocker locker(&cacheMutex);
+
+    return entries.value(cacheKey(aFilePath, aFrame)).hashGrid;
+}
+
+//==============================================================================
+// Prefetch Files In Priority Order - Direction Change Cancels Pending Work
+//==============================================================================
+void ImageCache::prefetch(const QStringList& aFilePaths, const int& aDirection)
+{
+    // Check Direction
+    if (aDirection != prefetchDirection) {
+        // Set Direction
+        prefetchDirection = aDirection;
+        // Bump Generation - Drops Work For the Old Direction
+        prefetchGeneration.ref();
+    }
+
+    // Remove Queued Tasks - Running Ones Finish, Their Results Are Still Useful
+    prefetchPool.clear();
+
+    // Lock Cache
+    QMutexLocker locker(&cacheMutex);
+    // Clear Wanted Files - Ranks Of the Old Direction Are Stale
+    wantedFiles.clear();
+
+    // Go Thru Files - Rebuild Ranks From the New Order
+    for (int i = aFilePaths.count() - 1; i >= 0; i--) {
+        // Set Wanted Rank - Nearest Occurrence Wins
+        wantedFiles[aFilePaths[i]] = i;
+    }
+
+    // Unlock Cache
+    locker.unlock();
+
+    // Get Generation
+    int generation = prefetchGeneration.load();
+
+    // Go Thru Files - Nearest First
+    for (int i = 0; i < aFilePaths.count(); i++) {
+        // Start Task
+        prefetchPool.start(new PrefetchTask(this, aFilePaths[i], generation), aFilePaths.count() - i);
+    }
+}
+
+//==============================================================================
+// Cancel Prefetch
+//==============================================================================
+void ImageCache::cancelPrefetch()
+{
+    // Bump Generation
+    prefetchGeneration.ref();
+    // Remove Queued Tasks
+    prefetchPool.clear();
+}
+
+//==============================================================================
+// Clear
+//==============================================================================
+void ImageCache::clear()
+{
+    // Cancel Prefetch
+    cancelPrefetch();
+
+    // Lock Cache
+    QMutexLocker locker(&cacheMutex);
+
+    // Clear Entries
+    entries.clear();
+    // Reset Used Bytes
+    usedBytes = 0;
+}
+
+//==============================================================================
+// Get Alpha Mode
+//==============================================================================
+int ImageCache::getAlphaMode()
+{
+    return alphaMode.load();
+}
+
+//==============================================================================
+// Set Alpha Mode - Cached Images Are Dropped
+//==============================================================================
+void ImageCache::setAlphaMode(const int& aAlphaMode)
+{
+    // Check Alpha Mode
+    if (alphaMode.load() != aAlphaMode) {
+        // Set Alpha Mode
+        alphaMode.store(aAlphaMode);
+        // Clear - In Flight Loads Are Rejected By Their Alpha Mode
+        clear();
+    }
+}
+
+//==============================================================================
+// Is Entry Valid
+//==============================================================================
+bool ImageCache::isValid(const QString& aFilePath, const QDateTime& aLastModified)
+{
+    // Check Entry
+    if (!entries.contains(aFilePath)) {
+        return false;
+    }
+
+    // Get Entry
+    const CacheEntry& entry = entries[aFilePath];
+
+    return entry.lastModified == aLastModified && entry.alphaMode == alphaMode.load();
+}
+
+//==============================================================================
+// Get Entry Bytes
+//==============================================================================
+qint64 ImageCache::entryBytes(const CacheEntry& aEntry)
+{
+    return aEntry.image.byteCount() + aEntry.hashGrid.hashes.count() * (qint64)sizeof(quint64);
+}
+
+//==============================================================================
+// Decode Image Into Cache
+//==============================================================================
+QImage ImageCache::load(const QString& aFilePath, const int& aFrame, const QDateTime& aLastModified, const bool& aPrefetch)
+{
+    // Get Alpha Mode
+    int loadAlphaMode = alphaMode.load();
+    // Get Cache Key
+    QString key = cacheKey(aFilePath, aFrame);
+    // Init Image Reader
+    QImageReader reader(aFilePath);
+    // Init Map Error
+    QString mapError;
+    // Map Image File - Uncompressed Files Are Not Decoded
+    QImage image = aFrame == 0 ? mapImageFile(aFilePath, mapError) : QImage();
+    // Init Decoded
+    bool decoded = false;
+    // Init Hash Grid
+    BlockHashGrid hashGrid;
+
+    // Check Map Error - Truncated Or Odd Headers Still Get a Chance With the Decoder
+    if (!mapError.isEmpty()) {
+        qDebug() << "ImageCache::load - aFilePath: " << aFilePath << " - MAP ERROR: " << mapError << " - DECODING";
+    }
+
+    // Check Mapped Layout - Only Raw Captures In the Canonical Format Skip Normalization, Netpbm Pixels Are Converted Once
+    if (!image.isNull() && image.format() != normalizedFormat(loadAlphaMode)) {
+        // Lookup Decoded Cache - Canonical Copy Stored On the First Open, Mapped Without Conversion
+        QImage canonicalImage = DecodedCache::getInstance()->lookup(aFilePath, aFrame, loadAlphaMode);
+
+        // Check Canonical Image
+        if (!canonicalImage.isNull()) {
+            // Set Image
+            image = canonicalImage;
+        } else {
+            // Set Decoded - Normalized Copy Goes To the Decoded Cache
+            decoded = true;
+        }
+    }
+
+    // Check Not Mapped - Uncompressed Files Are Wrapped Over the Page Cache
+    if (image.isNull()) {
+        // Lookup Decoded Cache - Normalized Pixels Mapped Back From Disk
+        image = DecodedCache::getInstance()->lookup(aFilePath, aFrame, loadAlphaMode);
+    }
+
+    // Check Not Mapped Or Cached
+    if (image.isNull()) {
+        // Set Decoded
+        decoded = true;
+
+        // Check Frame - Seek Directly When the Handler Can
+        if (aFrame == 0 || reader.jumpToImage(aFrame)) {
+            // Read Image
+            image = reader.read();
+        } else {
+            // Init Delay
+            int delay = 0;
+
+            // Go Thru Frames Up To the Wanted One - Animation Handlers Only Decode Forward
+            for (int frame = 0; frame <= aFrame; frame++) {
+                // Read Frame
+                if (!readNextFrame(reader, frame, 0, image, delay)) {
+                    // Reset Image - Sequence Is Shorter
+                    image = QImage();
+                    break;
+                }
+
+                // Check Preceding Frame - Cached Too, Scrubbing Mostly Moves Forward
+                if (frame < aFrame) {
+                    // Insert Frame
+                    insertFrame(aFilePath, frame, image, aLastModified, loadAlphaMode);
+                }
+            }
+        }
+    }
+
+    // Check Image
+    if (image.isNull()) {
+        qDebug() << "ImageCache::load - aFilePath: " << aFilePath << " - aFrame: " << aFrame << " - ERROR: " << reader.errorString();
+    } else {
+        // Normalize Once - Comparison Reads Canonical 32 Bit Pixels Directly, Indexed & Truecolor Sources Compare Equal
+        image = normalizeImage(image, loadAlphaMode, &hashGrid);
+
+        // Check Decoded
+        if (decoded) {
+            // Store Decoded Image - Written In the Background
+            DecodedCache::getInstance()->store(aFilePath, aFrame, loadAlphaMode, image);
+        }
+    }
+
+    // Lock Cache
+    QMutexLocker locker(&cacheMutex);
+
+    // Check Image & Alpha Mode - Mode Changed While Decoding
+    if (!image.isNull() && loadAlphaMode == alphaMode.load()) {
+        // Insert Image
+        insert(key, image, hashGrid, aLastModified, loadAlphaMode, aPrefetch);
+    }
+
+    // Remove From Loading
+    loading.remove(key);
+    // Wake Waiting Threads
+    loadFinished.wakeAll();
+
+    return image;
+}
+
+//==============================================================================
+// Insert Frame Decoded On the Way To Another One
+//==============================================================================
+void ImageCache::insertFrame(const QString& aFilePath, const int& aFrame, const QImage& aImage, const QDateTime& aLastModified, const int& aAlphaMode)
+{
+    // Get Cache Key
+    QString key = cacheKey(aFilePath, aFrame);
+
+    // Lock Cache
+    QMutexLocker locker(&cacheMutex);
+
+    // Check Cached Or Loading
+    if (isValid(key, aLastModified) || loading.contains(key)) {
+        return;
+    }
+
+    // Unlock Cache
+    locker.unlock();
+
+    // Init Hash Grid
+    BlockHashGrid hashGrid;
+    // Normalize Frame
+    QImage image = normalizeImage(aImage, aAlphaMode, &hashGrid);
+
+    // Lock Cache
+    locker.relock();
+
+    // Check Alpha Mode - Mode Changed While Normalizing
+    if (aAlphaMode == alphaMode.load()) {
+        // Insert Image - Ranked As Prefetched
+        insert(key, image, hashGrid, aLastModified, aAlphaMode, true);
+    }
+}
+
+//==============================================================================
+// Insert Image - Evicts Least Recently Used Images Over Budget
+//==============================================================================
+void ImageCache::insert(const QString& aFilePath, const QImage& aImage, const BlockHashGrid& aHashGrid, const QDateTime& aLastModified, const int& aAlphaMode, const bool& aPrefetch)
+{
+    // Get Image Bytes - Hash Grid Included
+    qint64 imageBytes = aImage.byteCount() + aHashGrid.hashes.count() * (qint64)sizeof(quint64);
+
+    // Check Budget
+    if (imageBytes > budgetBytes) {
+        return;
+    }
+
+    // Check Existing Entry
+    if (entries.contains(aFilePath)) {
+        // Dec Used Bytes
+        usedBytes -= entryBytes(entries[aFilePath]);
+        // Remove Entry
+        entries.remove(aFilePath);
+    }
+
+    // Get Unwanted Rank - Past the Farthest Wanted File
+    int unwantedRank = wantedFiles.count();
+    // Get Image Rank - On Screen Files Rank Before Any Prefetch
+    int imageRank = recentFiles.contains(aFilePath) ? -1 : wantedFiles.value(aFilePath, unwantedRank);
+
+    // Evict Until It Fits
+    while (usedBytes + imageBytes > budgetBytes) {
+        // Init Victim
+        QString victim;
+        // Init Victim Rank
+        int victimRank = -1;
+        // Init Victim Access
+        quint64 victimAccess = 0;
+
+        // Go Thru Entries - Unwanted First, Then Farthest Wanted, Least Recently Used Within a Rank
+        QHash<QString, CacheEntry>::const_iterator it = entries.constBegin();
+        while (it != entries.constEnd()) {
+            // Get Rank
+            int rank = recentFiles.contains(it.key()) ? -1 : wantedFiles.value(it.key(), unwantedRank);
+
+            // Check Better Victim
+            if (victim.isEmpty() || rank > victimRank || (rank == victimRank && it.value().lastAccess < victimAccess)) {
+                victim = it.key();
+                victimRank = rank;
+                victimAccess = it.value().lastAccess;
+            }
+
+            ++it;
+        }
+
+        // Check Victim - Prefetches Only Push Out Unwanted Or Farther Images
+        if (victim.isEmpty() || (aPrefetch && victimRank < unwantedRank && victimRank <= imageRank)) {
+            return;
+        }
+
+        // Dec Used Bytes
+        usedBytes -= entryBytes(entries[victim]);
+        // Remove Victim
+        entries.remove(victim);
+    }
+
+    // Init Entry
+    CacheEntry entry;
+    entry.image = aImage;
+    entry.hashGrid = aHashGrid;
+    entry.lastModified = aLastModified;
+    entry.alphaMode = aAlphaMode;
+    // Prefetched Images Rank Below Anything Shown
+    entry.lastAccess = aPrefetch ? 0 : ++accessCounter;
+
+    // Add Entry
+    entries[aFilePath] = entry;
+    // Inc Used Bytes
+    usedBytes += imageBytes;
+}
+
+//==============================================================================
+// Destructor
+//==============================================================================
+ImageCache::~ImageCache()
+{
+    // Cancel Prefetch
+    cancelPrefetch();
+    // Wait For Running Tasks
+    prefetchPool.waitForDone();
+
+    qDebug() << "ImageCache::~ImageCache";
+}
+
+
+
+//==============================================================================
+// Constructor
+//==============================================================================
+ImageCacheProvider::ImageCacheProvider()
+    : QQuickImageProvider(QQuickImageProvider::Image, QQmlImageProviderBase::ForceAsynchronousImageLoading)
+{
+}
+
+//==============================================================================
+// Request Image
+//==============================================================================
+QImage ImageCacheProvider::requestImage(const QString& aID, QSize* aSize, const QSize& aRequestedSize)
+{
+    // Get File Path - Strip Revision Query, Path Is Percent Encoded So It May Contain '?' & '#'
+    QString filePath = QUrl::fromPercentEncoding(aID.section('?', 0, 0).toUtf8());
+    // Get Frame
+    int frame = aID.section('?', 1).section("frame=", 1, 1).toInt();
+
+    // Get Image
+    QImage image = ImageCache::getInstance()->image(filePath, frame);
+
+    // Check Size
+    if (aSize) {
+        // Set Size
+        *aSize = image.size();
+    }
+
+    // Check Requested Size
+    if (!image.isNull() && aRequestedSize.width() > 0 && aRequestedSize.height() > 0 && aRequestedSize != image.size()) {
+        return image.scaled(aRequestedSize, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+    }
+
+    return image;
+}
@@ -0,0 +1,138 @@
+#ifndef IMAGECACHE_H
+#define IMAGECACHE_H
+
+#include <QObject>
+#include <QImage>
+#include <QString>
+#include <QStringList>
+#include <QDateTime>
+#include <QHash>
+#include <QSet>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QThreadPool>
+#include <QAtomicInt>
+#include <QQuickImageProvider>
+
+#include "blockhash.h"
+
+//==============================================================================
+// Image Cache Class - Decoded Images Shared By the Compositor & QML Views
+//==============================================================================
+class ImageCache : public QObject
+{
+    Q_OBJECT
+
+public:
+
+    // Static Constructor
+    static ImageCache* getInstance();
+    // Release Instance
+    void release();
+
+    // Get Image - Decodes On Miss, Waits For In Flight Prefetch
+    QImage image(const QString& aFilePath, const int& aFrame = 0);
+    // Get Block Hashes of Cached Image - Invalid If Not Cached, Check Against the Image
+    BlockHashGrid blockHashes(const QString& aFilePath, const int& aFrame = 0);
+
+    // Prefetch Files In Priority Order - Direction Change Cancels Pending Work
+    void prefetch(const QStringList& aFilePaths, const int& aDirection);
+
+    // Cancel Prefetch
+    void cancelPrefetch();
+
+    // Clear
+    void clear();
+
+    // Get Alpha Mode
+    int getAlphaMode();
+    // Set Alpha Mode - Cached Images Are Dropped
+    void setAlphaMode(const int& aAlphaMode);
+
+protected:
+
+    // Constructor
+    explicit ImageCache(QObject* aParent = NULL);
+
+    // Destructor
+    virtual ~ImageCache();
+
+    // Decode Image Into Cache
+    QImage load(const QString& aFilePath, const int& aFrame, const QDateTime& aLastModified, const bool& aPrefetch);
+    // Insert Frame Decoded On the Way To Another One
+    void insertFrame(const QString& aFilePath, const int& aFrame, const QImage& aImage, const QDateTime& aLastModified, const int& aAlphaMode);
+    // Insert Image - Evicts Least Recently Used Images Over Budget
+    void insert(const QString& aFilePath, const QImage& aImage, const BlockHashGrid& aHashGrid, const QDateTime& aLastModified, const int& aAlphaMode, const bool& aPrefetch);
+
+    // Is Entry Valid
+    bool isValid(const QString& aFilePath, const QDateTime& aLastModified);
+
+private:
+    friend class PrefetchTask;
+
+    // Cache Entry
+    struct CacheEntry
+    {
+        // Image
+        QImage          image;
+        // Block Hashes Computed While Normalizing
+        BlockHashGrid   hashGrid;
+        // Last Modified Time of the File
+        QDateTime       lastModified;
+        // Alpha Mode Image Was Normalized With
+        int             alphaMode;
+        // Last Access Stamp
+        quint64         lastAccess;
+    };
+
+    // Get Entry Bytes
+    static qint64 entryBytes(const CacheEntry& aEntry);
+
+    // Cache Mutex
+    QMutex                      cacheMutex;
+    // Load Finished Condition
+    QWaitCondition              loadFinished;
+    // Entries
+    QHash<QString, CacheEntry>  entries;
+    // Files Being Decoded
+    QSet<QString>               loading;
+    // Files Wanted By the Current Prefetch - Rank By Distance, Nearest First
+    QHash<QString, int>         wantedFiles;
+    // Most Recently Requested Files - The Ones On Screen
+    QStringList                 recentFiles;
+    // Access Counter
+    quint64                     accessCounter;
+    // Used Bytes
+    qint64                      usedBytes;
+    // Budget Bytes
+    qint64                      budgetBytes;
+
+    // Prefetch Thread Pool
+    QThreadPool                 prefetchPool;
+    // Prefetch Generation - Bumped To Cancel Queued Prefetches
+    QAtomicInt                  prefetchGeneration;
+    // Last Prefetch Direction
+    int                         prefetchDirection;
+    // Visible Loads In Flight - Prefetches Wait While There Are Any
+    QAtomicInt                  visibleLoads;
+    // Alpha Mode
+    QAtomicInt                  alphaMode;
+};
+
+
+
+//==============================================================================
+// Image Cache Provider Class - Serves image://imagecache/<percent encoded path>?<revision>&frame=<frame> To QML
+//==============================================================================
+class ImageCacheProvider : public QQuickImageProvider
+{
+public:
+
+    // Constructor
+    ImageCacheProvider();
+
+    // Request Image
+    virtual QImage requestImage(const QString& aID, QSize* aSize, const QSize& aRequestedSize);
+};
+
+#endif // IMAGECACHE_H
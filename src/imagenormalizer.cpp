@@ -0,0 +1,202 @@
+#include <QDebug>
+#include <QRunnable>
+#include <QThread>
+#include <QThreadPool>
+#include <QSemaphore>
+
+#include <string.h>
+
+#include "imagenormalizer.h"
+#include "blockhash.h"
+#include "constants.h"
+
+
+//==============================================================================
+// Normalize Band Task Class - Converts a Horizontal Band of Rows
+//==============================================================================
+class NormalizeBandTask : public QRunnable
+{
+public:
+
+    // Constructor
+    NormalizeBandTask(const QImage& aSource, uchar* aTargetBits, const int& aTargetBytesPerLine, const QImage::Format& aTargetFormat, const int& aFirstRow, const int& aRowCount, const int& aAlphaMode, BlockHashGrid* aHashGrid, QSemaphore& aDone)
+        : source(aSource)
+        , targetBits(aTargetBits)
+        , targetBytesPerLine(aTargetBytesPerLine)
+        , targetFormat(aTargetFormat)
+        , firstRow(aFirstRow)
+        , rowCount(aRowCount)
+        , alphaMode(aAlphaMode)
+        , hashGrid(aHashGrid)
+        , done(aDone)
+    {
+    }
+
+    // Run
+    virtual void run()
+    {
+        // Wrap Source Band - No Copy Of the Source Pixels
+        QImage band(source.constScanLine(firstRow), source.width(), rowCount, source.bytesPerLine(), source.format());
+        // Set Color Table - Indexed Formats
+        band.setColorTable(source.colorTable());
+
+        // Convert Band - Ignored Alpha Is Dropped From Straight Colors, Not Blended
+        QImage converted = band.convertToFormat(alphaMode == AMTIgnore ? QImage::Format_ARGB32 : targetFormat);
+
+        // Get Row Bytes
+        int rowBytes = source.width() * 4;
+
+        // Go Thru Rows
+        for (int y = 0; y < rowCount; y++) {
+            // Get Target Line - Raw Bits, Target Is Never Detached From the Tasks
+            uchar* targetLine = targetBits + (qint64)(firstRow + y) * targetBytesPerLine;
+            // Copy Row
+            memcpy(targetLine, converted.constScanLine(y), rowBytes);
+
+            // Check Alpha Mode
+            if (alphaMode == AMTIgnore) {
+                // Get Pixels
+                QRgb* pixels = (QRgb*)targetLine;
+
+                // Set Opaque
+                for (int x = 0; x < source.width(); x++) {
+                    pixels[x] |= 0xFF000000;
+                }
+            }
+        }
+
+        // Check Hash Grid - Band Rows Are Still Hot In the Cache
+        if (hashGrid) {
+            // Hash Block Rows - Bands Start On Block Row Boundaries
+            hashBlockRows(targetBits, targetBytesPerLine, firstRow / hashGrid->blockSize, (rowCount + hashGrid->blockSize - 1) / hashGrid->blockSize, *hashGrid);
+        }
+
+        // Release Done
+        done.release();
+    }
+
+private:
+    // Source Image
+    const QImage&   source;
+    // Target Bits
+    uchar*          targetBits;
+    // Target Bytes Per Line
+    int             targetBytesPerLine;
+    // Target Format
+    QImage::Format  targetFormat;
+    // First Row
+    int             firstRow;
+    // Row Count
+    int             rowCount;
+    // Alpha Mode
+    int             alphaMode;
+    // Hash Grid
+    BlockHashGrid*  hashGrid;
+    // Done Semaphore
+    QSemaphore&     done;
+};
+
+//==============================================================================
+// Get Normalized Format For Alpha Mode
+//==============================================================================
+QImage::Format normalizedFormat(const int& aAlphaMode)
+{
+    // Switch Alpha Mode
+    switch (aAlphaMode) {
+        case AMTPremultiplied:  return QImage::Format_ARGB32_Premultiplied;
+        case AMTIgnore:         return QImage::Format_RGB32;
+        default:                return QImage::Format_ARGB32;
+    }
+}
+
+//==============================================================================
+// Normalize Image Into the Canonical 32 Bit Layout of the Alpha Mode - Converted In Parallel Bands, Block Hashes Computed On the Way
+//==============================================================================
+QImage normalizeImage(const QImage& aImage, const int& aAlphaMode, BlockHashGrid* aHashGrid)
+{
+    // Check Image
+    if (aImage.isNull()) {
+        return QImage();
+    }
+
+    // Get Target Format
+    QImage::Format targetFormat = normalizedFormat(aAlphaMode);
+
+    // Check Format - Already Canonical
+    if (aImage.format() == targetFormat) {
+        // Check Hash Grid
+        if (aHashGrid) {
+            // Compute Block Hashes
+            *aHashGrid = computeBlockHashes(aImage);
+        }
+
+        return aImage;
+    }
+
+    // Check RGB32 Source - Opaque Pixels, Conversion Is a Plain Copy
+    if (aImage.format() == QImage::Format_RGB32 && targetFormat != QImage::Format_RGB32) {
+        // Convert Image
+        QImage converted = aImage.convertToFormat(targetFormat);
+
+        // Check Hash Grid
+        if (aHashGrid) {
+            // Compute Block Hashes
+            *aHashGrid = computeBlockHashes(converted);
+        }
+
+        return converted;
+    }
+
+    // Init Target
+    QImage target(aImage.size(), targetFormat);
+
+    // Check Target
+    if (target.isNull()) {
+        qDebug() << "normalizeImage - size: " << aImage.size() << " - ERROR ALLOCATING TARGET!";
+        return QImage();
+    }
+
+    // Get Band Count - Small Images Are Not Worth Splitting
+    int bandCount = qBound(1, aImage.height() / DEFAULT_NORMALIZE_MIN_BAND_ROWS, QThread::idealThreadCount());
+    // Get Band Rows - Whole Block Rows, So Bands Can Hash Their Own Blocks
+    int bandRows = ((aImage.height() + bandCount - 1) / bandCount + DEFAULT_BLOCK_HASH_SIZE - 1) / DEFAULT_BLOCK_HASH_SIZE * DEFAULT_BLOCK_HASH_SIZE;
+
+    // Get Target Bits - Detached Once Here
+    uchar* targetBits = target.bits();
+
+    // Check Hash Grid
+    if (aHashGrid) {
+        // Init Hash Grid - After Detaching, the Cache Key Is Final Now
+        aHashGrid->init(target);
+    }
+
+    // Init Done Semaphore
+    QSemaphore done(0);
+    // Init Started Bands
+    int startedBands = 0;
+
+    // Go Thru Bands
+    for (int firstRow = 0; firstRow < aImage.height(); firstRow += bandRows) {
+        // Init Task
+        NormalizeBandTask* task = new NormalizeBandTask(aImage, targetBits, target.bytesPerLine(), targetFormat, firstRow, qMin(bandRows, aImage.height() - firstRow), aAlphaMode, aHashGrid, done);
+
+        // Check Last Band - Run On the Calling Thread
+        if (firstRow + bandRows >= aImage.height()) {
+            // Run Task
+            task->run();
+            // Delete Task
+            delete task;
+        } else {
+            // Start Task
+            QThreadPool::globalInstance()->start(task);
+        }
+
+        // Inc Started Bands
+        startedBands++;
+    }
+
+    // Wait For Bands
+    done.acquire(startedBands);
+
+    return target;
+}
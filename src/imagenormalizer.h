@@ -0,0 +1,24 @@
+#ifndef IMAGENORMALIZER_H
+#define IMAGENORMALIZER_H
+
+#include <QImage>
+
+#include "blockhash.h"
+
+//==============================================================================
+// Alpha Modes - How Alpha Takes Part In the Comparison
+//==============================================================================
+enum AlphaModeType
+{
+    AMTStraight         = 0,
+    AMTPremultiplied,
+    AMTIgnore
+};
+
+// Get Normalized Format For Alpha Mode
+QImage::Format normalizedFormat(const int& aAlphaMode);
+
+// Normalize Image Into the Canonical 32 Bit Layout of the Alpha Mode - Converted In Parallel Bands, Block Hashes Computed On the Way
+QImage normalizeImage(const QImage& aImage, const int& aAlphaMode, BlockHashGrid* aHashGrid = NULL);
+
+#endif // IMAGENORMALIZER_H
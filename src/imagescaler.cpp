@@ -0,0 +1,592 @@
+#include <QDebug>
+#include <QRunnable>
+#include <QThread>
+#include <QThreadPool>
+#include <QSemaphore>
+#include <QVector>
+#include <QtMath>
+
+#include <string.h>
+
+#ifdef __SSE2__
+
+#include <emmintrin.h>
+
+#endif // __SSE2__
+
+#include "imagescaler.h"
+#include "constants.h"
+
+// Replicate Function - Writes Count Source Pixels Factor Times Each
+typedef void (*ReplicateFunction)(const quint32* aSource, quint32* aTarget, const int& aCount, const int& aFactor);
+
+//==============================================================================
+// Scale Spans - Source Pixels & Weights Covered By Each Target Pixel Along an Axis
+//==============================================================================
+struct ScaleSpans
+{
+    // First Source Pixel of Target Pixels
+    QVector<int>    first;
+    // Source Pixel Count of Target Pixels
+    QVector<int>    count;
+    // First Weight Index of Target Pixels
+    QVector<int>    offset;
+    // Weights - Coverage of Source Pixels, Summing To 1 For Each Target Pixel
+    QVector<float>  weights;
+};
+
+// Downscale Target Rows of a Band
+static void downscaleRows(const uchar* aSourceBits, const int& aSourceBytesPerLine, const int& aSourceWidth, uchar* aTargetBits, const int& aTargetBytesPerLine,
+                          const ScaleSpans& aSpansX, const ScaleSpans& aSpansY, const int& aFirstRow, const int& aRowCount, const bool& aPremultiply);
+
+//==============================================================================
+// Downscale Task Class - Downscales a Band of Target Rows
+//==============================================================================
+class DownscaleTask : public QRunnable
+{
+public:
+
+    // Constructor
+    DownscaleTask(const QImage& aImage, uchar* aTargetBits, const int& aTargetBytesPerLine, const ScaleSpans& aSpansX, const ScaleSpans& aSpansY, const int& aFirstRow, const int& aRowCount,
+                  const bool& aPremultiply, QSemaphore& aDone)
+        : image(aImage)
+        , targetBits(aTargetBits)
+        , targetBytesPerLine(aTargetBytesPerLine)
+        , spansX(aSpansX)
+        , spansY(aSpansY)
+        , firstRow(aFirstRow)
+        , rowCount(aRowCount)
+        , premultiply(aPremultiply)
+        , done(aDone)
+    {
+    }
+
+    // Run
+    virtual void run()
+    {
+        // Downscale Rows - Each Band Writes Its Own Target Rows
+        downscaleRows(image.constBits(), image.bytesPerLine(), image.width(), targetBits, targetBytesPerLine, spansX, spansY, firstRow, rowCount, premultiply);
+
+        // Release Done
+        done.release();
+    }
+
+private:
+    // Image
+    const QImage&       image;
+    // Target Bits
+    uchar*              targetBits;
+    // Target Bytes Per Line
+    int                 targetBytesPerLine;
+    // Horizontal Spans
+    const ScaleSpans&   spansX;
+    // Vertical Spans
+    const ScaleSpans&   spansY;
+    // First Row
+    int                 firstRow;
+    // Row Count
+    int                 rowCount;
+    // Premultiply - Straight Alpha Source
+    bool                premultiply;
+    // Done Semaphore
+    QSemaphore&         done;
+};
+
+//==============================================================================
+// Replicate Pixels By a Compile Time Factor
+//==============================================================================
+template <int Factor>
+static void replicatePixels(const quint32* aSource, quint32* aTarget, const int& aCount, const int& aFactor)
+{
+    Q_UNUSED(aFactor);
+
+    // Check Factor - Plain Copy
+    if (Factor == 1) {
+        memcpy(aTarget, aSource, aCount * sizeof(quint32));
+        return;
+    }
+
+    // Init Index
+    int i = 0;
+
+#ifdef __SSE2__
+
+    // Check Factor
+    if (Factor == 2) {
+        // Go Thru 4 Pixels At a Time
+        for (; i + 4 <= aCount; i += 4) {
+            // Load Pixels
+            __m128i pixels = _mm_loadu_si128((const __m128i*)(aSource + i));
+            // Store Pixels Doubled - Interleaved With Themselves
+            _mm_storeu_si128((__m128i*)(aTarget + i * 2), _mm_unpacklo_epi32(pixels, pixels));
+            _mm_storeu_si128((__m128i*)(aTarget + i * 2 + 4), _mm_unpackhi_epi32(pixels, pixels));
+        }
+    } else if (Factor % 4 == 0) {
+        // Go Thru 4 Pixels At a Time
+        for (; i + 4 <= aCount; i += 4) {
+            // Load Pixels
+            __m128i pixels = _mm_loadu_si128((const __m128i*)(aSource + i));
+            // Broadcast Pixels
+            __m128i pixel0 = _mm_shuffle_epi32(pixels, 0x00);
+            __m128i pixel1 = _mm_shuffle_epi32(pixels, 0x55);
+            __m128i pixel2 = _mm_shuffle_epi32(pixels, 0xAA);
+            __m128i pixel3 = _mm_shuffle_epi32(pixels, 0xFF);
+            // Get Target
+            quint32* target = aTarget + i * Factor;
+
+            // Store Broadcasts - Unrolled By the Compiler, Factor Is Constant
+            for (int k = 0; k < Factor; k += 4) {
+                _mm_storeu_si128((__m128i*)(target + k), pixel0);
+                _mm_storeu_si128((__m128i*)(target + Factor + k), pixel1);
+                _mm_storeu_si128((__m128i*)(target + Factor * 2 + k), pixel2);
+                _mm_storeu_si128((__m128i*)(target + Factor * 3 + k), pixel3);
+            }
+        }
+    }
+
+#endif // __SSE2__
+
+    // Go Thru Remaining Pixels
+    for (; i < aCount; i++) {
+        // Get Pixel
+        quint32 pixel = aSource[i];
+        // Get Target
+        quint32* target = aTarget + i * Factor;
+
+        // Store Pixel Factor Times
+        for (int k = 0; k < Factor; k++) {
+            target[k] = pixel;
+        }
+    }
+}
+
+//==============================================================================
+// Replicate Pixels By a Run Time Factor
+//==============================================================================
+static void replicatePixelsAny(const quint32* aSource, quint32* aTarget, const int& aCount, const int& aFactor)
+{
+    // Go Thru Pixels
+    for (int i = 0; i < aCount; i++) {
+        // Get Pixel
+        quint32 pixel = aSource[i];
+        // Get Target
+        quint32* target = aTarget + i * aFactor;
+
+        // Store Pixel Factor Times
+        for (int k = 0; k < aFactor; k++) {
+            target[k] = pixel;
+        }
+    }
+}
+
+//==============================================================================
+// Replicate Row Span - Partial Blocks At Both Ends Are Filled One By One
+//==============================================================================
+static void replicateRow(const quint32* aSourceRow, quint32* aTargetRow, const int& aFirstX, const int& aWidth, const int& aFactor, ReplicateFunction aReplicate)
+{
+    // Get Source X
+    int sourceX = aFirstX / aFactor;
+    // Get Lead - Target Pixels Into the First Block
+    int lead = aFirstX % aFactor;
+    // Init Target X
+    int x = 0;
+
+    // Check Lead
+    if (lead > 0) {
+        // Fill Rest of the First Block
+        for (; x < qMin(aFactor - lead, aWidth); x++) {
+            aTargetRow[x] = aSourceRow[sourceX];
+        }
+
+        // Inc Source X
+        sourceX++;
+    }
+
+    // Get Whole Blocks
+    int blocks = (aWidth - x) / aFactor;
+
+    // Replicate Whole Blocks
+    aReplicate(aSourceRow + sourceX, aTargetRow + x, blocks, aFactor);
+
+    // Inc Target X & Source X
+    x += blocks * aFactor;
+    sourceX += blocks;
+
+    // Fill Last Block
+    for (; x < aWidth; x++) {
+        aTargetRow[x] = aSourceRow[sourceX];
+    }
+}
+
+//==============================================================================
+// Replicate Pixels of 32 Bit Image By an Integer Factor - Only the Region of the Scaled Image Is Produced, Null If Not 32 Bit
+//==============================================================================
+QImage replicateImageRegion(const QImage& aImage, const int& aFactor, const QRect& aRegion)
+{
+    // Check Image & Factor
+    if (aImage.isNull() || aImage.depth() != 32 || aFactor < 1) {
+        return QImage();
+    }
+
+    // Get Region - Clipped To the Scaled Image
+    QRect region = aRegion.intersected(QRect(QPoint(0, 0), aImage.size() * aFactor));
+
+    // Check Region
+    if (region.isEmpty()) {
+        return QImage();
+    }
+
+    // Init Result
+    QImage result(region.size(), aImage.format());
+
+    // Check Result
+    if (result.isNull()) {
+        qDebug() << "replicateImageRegion - region: " << region << " - ERROR ALLOCATING IMAGE!";
+        return result;
+    }
+
+    // Init Replicate Function
+    ReplicateFunction replicate = replicatePixelsAny;
+
+    // Switch Factor - The Zoom Levels Get Their Own Kernels
+    switch (aFactor) {
+        case 1:     replicate = replicatePixels<1>;     break;
+        case 2:     replicate = replicatePixels<2>;     break;
+        case 4:     replicate = replicatePixels<4>;     break;
+        case 8:     replicate = replicatePixels<8>;     break;
+        case 16:    replicate = replicatePixels<16>;    break;
+        case 32:    replicate = replicatePixels<32>;    break;
+
+        default:
+        break;
+    }
+
+    // Get Row Bytes
+    size_t rowBytes = (size_t)region.width() * sizeof(quint32);
+    // Init Previous Source Y
+    int previousSourceY = -1;
+
+    // Go Thru Target Rows
+    for (int y = 0; y < region.height(); y++) {
+        // Get Source Y
+        int sourceY = (region.y() + y) / aFactor;
+        // Get Target Row
+        quint32* targetRow = (quint32*)result.scanLine(y);
+
+        // Check Previous Source Y - Repeated Rows Are Plain Copies
+        if (sourceY == previousSourceY) {
+            // Copy Previous Row
+            memcpy(targetRow, result.constScanLine(y - 1), rowBytes);
+        } else {
+            // Replicate Row
+            replicateRow((const quint32*)aImage.constScanLine(sourceY), targetRow, region.x(), region.width(), aFactor, replicate);
+            // Set Previous Source Y
+            previousSourceY = sourceY;
+        }
+    }
+
+    return result;
+}
+
+//==============================================================================
+// Get Scale Spans of an Axis
+//==============================================================================
+static ScaleSpans scaleSpans(const int& aSourceSize, const int& aTargetSize)
+{
+    // Init Spans
+    ScaleSpans spans;
+    spans.first.resize(aTargetSize);
+    spans.count.resize(aTargetSize);
+    spans.offset.resize(aTargetSize);
+
+    // Get Scale - Source Pixels Per Target Pixel
+    qreal scale = (qreal)aSourceSize / aTargetSize;
+
+    // Go Thru Target Pixels
+    for (int t = 0; t < aTargetSize; t++) {
+        // Get Covered Source Interval
+        qreal start = t * scale;
+        qreal end = qMin((t + 1) * scale, (qreal)aSourceSize);
+        // Get First & Last Source Pixels
+        int first = qMin((int)start, aSourceSize - 1);
+        int last = qMax(qMin(qCeil(end), aSourceSize), first + 1);
+
+        // Set First Source Pixel & Weight Index
+        spans.first[t] = first;
+        spans.offset[t] = spans.weights.count();
+        // Set Count
+        spans.count[t] = last - first;
+
+        // Go Thru Covered Source Pixels
+        for (int s = first; s < last; s++) {
+            // Add Weight - Covered Share of the Interval
+            spans.weights.append((qMin((qreal)(s + 1), end) - qMax((qreal)s, start)) / (end - start));
+        }
+    }
+
+    return spans;
+}
+
+#ifdef __SSE2__
+
+//==============================================================================
+// Get Pixel Weight - Color Channels Scaled By Alpha When Premultiplying, Alpha Is Channel 3
+//==============================================================================
+static inline __m128 pixelWeight(const __m128& aPixel, const __m128& aWeight, const bool& aPremultiply)
+{
+    // Check Premultiply
+    if (!aPremultiply) {
+        return aWeight;
+    }
+
+    // Get Alpha Weight - Alpha Broadcast To the Color Channels, 255 Kept For Alpha Itself
+    __m128 alpha = _mm_shuffle_ps(aPixel, aPixel, 0xFF);
+    __m128 alphaMask = _mm_castsi128_ps(_mm_set_epi32(0, -1, -1, -1));
+    __m128 alphaWeight = _mm_or_ps(_mm_and_ps(alphaMask, alpha), _mm_andnot_ps(alphaMask, _mm_set1_ps(255.0f)));
+
+    return _mm_mul_ps(aWeight, _mm_mul_ps(alphaWeight, _mm_set1_ps(1.0f / 255.0f)));
+}
+
+#endif // __SSE2__
+
+//==============================================================================
+// Accumulate Weighted Source Row Into the Channel Accumulator - Premultiplied By Alpha For Straight Alpha Sources
+//==============================================================================
+static inline void accumulateRow(const uchar* aSourceRow, float* aAccumulator, const int& aWidth, const float& aWeight, const bool& aPremultiply)
+{
+    // Init Index
+    int i = 0;
+
+#ifdef __SSE2__
+
+    // Init Weight & Zero
+    __m128 weight = _mm_set1_ps(aWeight);
+    __m128i zero = _mm_setzero_si128();
+
+    // Go Thru 4 Pixels At a Time
+    for (; i + 4 <= aWidth; i += 4) {
+        // Load Pixels
+        __m128i pixels = _mm_loadu_si128((const __m128i*)(aSourceRow + i * 4));
+        // Widen Channels To 16 Bit
+        __m128i low = _mm_unpacklo_epi8(pixels, zero);
+        __m128i high = _mm_unpackhi_epi8(pixels, zero);
+        // Widen Channels To 32 Bit Floats
+        __m128 pixel0 = _mm_cvtepi32_ps(_mm_unpacklo_epi16(low, zero));
+        __m128 pixel1 = _mm_cvtepi32_ps(_mm_unpackhi_epi16(low, zero));
+        __m128 pixel2 = _mm_cvtepi32_ps(_mm_unpacklo_epi16(high, zero));
+        __m128 pixel3 = _mm_cvtepi32_ps(_mm_unpackhi_epi16(high, zero));
+        // Get Accumulator
+        float* accumulator = aAccumulator + i * 4;
+
+        // Accumulate Pixels
+        _mm_storeu_ps(accumulator,      _mm_add_ps(_mm_loadu_ps(accumulator),      _mm_mul_ps(pixel0, pixelWeight(pixel0, weight, aPremultiply))));
+        _mm_storeu_ps(accumulator + 4,  _mm_add_ps(_mm_loadu_ps(accumulator + 4),  _mm_mul_ps(pixel1, pixelWeight(pixel1, weight, aPremultiply))));
+        _mm_storeu_ps(accumulator + 8,  _mm_add_ps(_mm_loadu_ps(accumulator + 8),  _mm_mul_ps(pixel2, pixelWeight(pixel2, weight, aPremultiply))));
+        _mm_storeu_ps(accumulator + 12, _mm_add_ps(_mm_loadu_ps(accumulator + 12), _mm_mul_ps(pixel3, pixelWeight(pixel3, weight, aPremultiply))));
+    }
+
+#endif // __SSE2__
+
+    // Go Thru Remaining Pixels
+    for (; i < aWidth; i++) {
+        // Get Source Channels
+        const uchar* source = aSourceRow + i * 4;
+        // Get Color Weight - Scaled By Alpha When Premultiplying
+        float colorWeight = aPremultiply ? aWeight * source[3] / 255.0f : aWeight;
+
+        // Go Thru Color Channels
+        for (int c = 0; c < 3; c++) {
+            // Accumulate Channel
+            aAccumulator[i * 4 + c] += source[c] * colorWeight;
+        }
+
+        // Accumulate Alpha
+        aAccumulator[i * 4 + 3] += source[3] * aWeight;
+    }
+}
+
+//==============================================================================
+// Reduce Channel Accumulator To Target Row - Unpremultiplied Again For Straight Alpha Targets
+//==============================================================================
+static inline void reduceRow(const float* aAccumulator, const ScaleSpans& aSpansX, quint32* aTargetRow, const int& aWidth, const bool& aPremultiply)
+{
+    // Get Spans
+    const int* first = aSpansX.first.constData();
+    const int* count = aSpansX.count.constData();
+    const int* offset = aSpansX.offset.constData();
+    const float* weights = aSpansX.weights.constData();
+
+    // Go Thru Target Pixels
+    for (int x = 0; x < aWidth; x++) {
+        // Get Source Channels
+        const float* source = aAccumulator + first[x] * 4;
+        // Get Pixel Weights
+        const float* pixelWeights = weights + offset[x];
+
+#ifdef __SSE2__
+
+        // Init Sum
+        __m128 sum = _mm_setzero_ps();
+
+        // Go Thru Covered Pixels - All 4 Channels At Once
+        for (int k = 0; k < count[x]; k++) {
+            sum = _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(source + k * 4), _mm_set1_ps(pixelWeights[k])));
+        }
+
+        // Check Premultiply - Colors Never Exceed Alpha, Transparent Pixels Stay 0
+        if (aPremultiply) {
+            // Get Alpha
+            __m128 alpha = _mm_shuffle_ps(sum, sum, 0xFF);
+            // Get Unpremultiply Factor - Alpha Itself Kept
+            __m128 alphaMask = _mm_castsi128_ps(_mm_set_epi32(0, -1, -1, -1));
+            __m128 factor = _mm_div_ps(_mm_set1_ps(255.0f), _mm_max_ps(alpha, _mm_set1_ps(1e-6f)));
+            factor = _mm_or_ps(_mm_and_ps(alphaMask, factor), _mm_andnot_ps(alphaMask, _mm_set1_ps(1.0f)));
+            // Unpremultiply Colors
+            sum = _mm_mul_ps(sum, factor);
+        }
+
+        // Round & Narrow Channels - Saturated To 8 Bit
+        __m128i channels = _mm_cvtps_epi32(sum);
+        channels = _mm_packs_epi32(channels, channels);
+        channels = _mm_packus_epi16(channels, channels);
+
+        // Store Pixel
+        aTargetRow[x] = (quint32)_mm_cvtsi128_si32(channels);
+
+#else // __SSE2__
+
+        // Init Sum
+        float sum[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+
+        // Go Thru Covered Pixels
+        for (int k = 0; k < count[x]; k++) {
+            // Go Thru Channels
+            for (int c = 0; c < 4; c++) {
+                sum[c] += source[k * 4 + c] * pixelWeights[k];
+            }
+        }
+
+        // Check Premultiply - Colors Never Exceed Alpha, Transparent Pixels Stay 0
+        if (aPremultiply) {
+            // Go Thru Color Channels
+            for (int c = 0; c < 3; c++) {
+                // Unpremultiply Channel
+                sum[c] = sum[3] > 0.0f ? sum[c] * 255.0f / sum[3] : 0.0f;
+            }
+        }
+
+        // Get Target Channels
+        uchar* target = (uchar*)(aTargetRow + x);
+
+        // Go Thru Channels
+        for (int c = 0; c < 4; c++) {
+            // Store Channel - Saturated To 8 Bit
+            target[c] = (uchar)qBound(0, qRound(sum[c]), 255);
+        }
+
+#endif // __SSE2__
+    }
+}
+
+//==============================================================================
+// Downscale Target Rows of a Band
+//==============================================================================
+static void downscaleRows(const uchar* aSourceBits, const int& aSourceBytesPerLine, const int& aSourceWidth, uchar* aTargetBits, const int& aTargetBytesPerLine,
+                          const ScaleSpans& aSpansX, const ScaleSpans& aSpansY, const int& aFirstRow, const int& aRowCount, const bool& aPremultiply)
+{
+    // Init Accumulator - One Float Per Source Channel
+    QVector<float> accumulator(aSourceWidth * 4);
+    // Get Target Width
+    int targetWidth = aSpansX.first.count();
+
+    // Go Thru Target Rows
+    for (int y = aFirstRow; y < aFirstRow + aRowCount; y++) {
+        // Reset Accumulator
+        accumulator.fill(0.0f);
+
+        // Go Thru Covered Source Rows - Vertical Pass
+        for (int k = 0; k < aSpansY.count[y]; k++) {
+            // Accumulate Source Row
+            accumulateRow(aSourceBits + (size_t)(aSpansY.first[y] + k) * aSourceBytesPerLine, accumulator.data(), aSourceWidth, aSpansY.weights[aSpansY.offset[y] + k], aPremultiply);
+        }
+
+        // Reduce Accumulator - Horizontal Pass
+        reduceRow(accumulator.constData(), aSpansX, (quint32*)(aTargetBits + (size_t)y * aTargetBytesPerLine), targetWidth, aPremultiply);
+    }
+}
+
+//==============================================================================
+// Downscale Image By Area Average - Separable, Target Rows Split Into Bands Across Threads
+//==============================================================================
+QImage downscaleImage(const QImage& aImage, const QSize& aSize)
+{
+    // Check Image & Size
+    if (aImage.isNull() || aSize.isEmpty()) {
+        return QImage();
+    }
+
+    // Check Size
+    if (aImage.size() == aSize) {
+        return aImage;
+    }
+
+    // Check Depth
+    if (aImage.depth() != 32) {
+        return aImage.scaled(aSize, Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+    }
+
+    // Init Result
+    QImage result(aSize, aImage.format());
+
+    // Check Result
+    if (result.isNull()) {
+        qDebug() << "downscaleImage - size: " << aSize << " - ERROR ALLOCATING IMAGE!";
+        return result;
+    }
+
+    // Get Premultiply - Straight Alpha Colors Are Weighted By Alpha, So Transparent Pixels Do Not Bleed Into Edges. Alpha Is the Last Byte of Each Pixel Then
+    bool premultiply = Q_BYTE_ORDER == Q_LITTLE_ENDIAN && (aImage.format() == QImage::Format_ARGB32 || aImage.format() == QImage::Format_RGBA8888);
+
+    // Get Spans
+    ScaleSpans spansX = scaleSpans(aImage.width(), aSize.width());
+    ScaleSpans spansY = scaleSpans(aImage.height(), aSize.height());
+
+    // Get Target Bits - Detached Once, Before the Bands Start
+    uchar* targetBits = result.bits();
+    // Get Target Rows
+    int rows = aSize.height();
+    // Get Band Count - Small Images Are Not Worth Splitting
+    int bandCount = qBound(1, rows / DEFAULT_DOWNSCALE_MIN_BAND_ROWS, QThread::idealThreadCount());
+    // Get Band Rows
+    int bandRows = (rows + bandCount - 1) / bandCount;
+
+    // Init Done Semaphore
+    QSemaphore done(0);
+    // Init Started Bands
+    int startedBands = 0;
+
+    // Go Thru Bands
+    for (int firstRow = 0; firstRow < rows; firstRow += bandRows) {
+        // Init Task
+        DownscaleTask* task = new DownscaleTask(aImage, targetBits, result.bytesPerLine(), spansX, spansY, firstRow, qMin(bandRows, rows - firstRow), premultiply, done);
+
+        // Check Last Band - Run On the Calling Thread
+        if (firstRow + bandRows >= rows) {
+            // Run Task
+            task->run();
+            // Delete Task
+            delete task;
+        } else {
+            // Start Task
+            QThreadPool::globalInstance()->start(task);
+        }
+
+        // Inc Started Bands
+        startedBands++;
+    }
+
+    // Wait For Bands
+    done.acquire(startedBands);
+
+    return result;
+}
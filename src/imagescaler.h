@@ -0,0 +1,18 @@
+#ifndef IMAGESCALER_H
+#define IMAGESCALER_H
+
+#include <QImage>
+#include <QRect>
+
+// Replicate Pixels of 32 Bit Image By an Integer Factor - Only the Region of the Scaled Image Is Produced, Null If Not 32 Bit
+//
+// Matches the Fast Transform Scale Pixel For Pixel, Each Source Pixel Becomes a Factor x Factor Block
+QImage replicateImageRegion(const QImage& aImage, const int& aFactor, const QRect& aRegion);
+
+// Downscale Image By Area Average - Separable, Target Rows Split Into Bands Across Threads
+//
+// Each Target Pixel Is the Coverage Weighted Mean of the Source Pixels Under It, So Thin Lines Fade Instead of Vanishing
+// Straight Alpha Colors Are Averaged Premultiplied, Other Than 32 Bit Images Fall Back To the Smooth Transform Scale
+QImage downscaleImage(const QImage& aImage, const QSize& aSize);
+
+#endif // IMAGESCALER_H
@@ -0,0 +1,516 @@
+#include <QDebug>
+#include <QFile>
+#include <QSaveFile>
+#include <QImage>
+#include <QImageReader>
+#include <QImageWriter>
+#include <QTransform>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <setjmp.h>
+
+extern "C" {
+#include <jpeglib.h>
+}
+
+#include "imagetransformer.h"
+#include "constants.h"
+
+
+//==============================================================================
+// JPEG Error Manager - Jumps Back Instead of Exiting the Process
+//==============================================================================
+struct JPEGErrorManager
+{
+    // Standard Error Manager
+    struct jpeg_error_mgr   pub;
+    // Jump Buffer
+    jmp_buf                 jumpBuffer;
+    // Error Message
+    char                    message[JMSG_LENGTH_MAX];
+};
+
+//==============================================================================
+// JPEG Error Exit
+//==============================================================================
+static void jpegErrorExit(j_common_ptr aInfo)
+{
+    // Get Error Manager
+    JPEGErrorManager* errorManager = (JPEGErrorManager*)aInfo->err;
+    // Format Message
+    (*aInfo->err->format_message)(aInfo, errorManager->message);
+    // Jump Back
+    longjmp(errorManager->jumpBuffer, 1);
+}
+
+//==============================================================================
+// JPEG Output Message - Warnings Are Not Printed
+//==============================================================================
+static void jpegOutputMessage(j_common_ptr aInfo)
+{
+    Q_UNUSED(aInfo);
+}
+
+//==============================================================================
+// Round Up To Multiple
+//==============================================================================
+static JDIMENSION roundUp(const JDIMENSION& aValue, const int& aMultiple)
+{
+    return ((aValue + aMultiple - 1) / aMultiple) * aMultiple;
+}
+
+//==============================================================================
+// Check If Transform Swaps Image Axes
+//==============================================================================
+static bool transformTransposes(const int& aTransform)
+{
+    return aTransform == ITTRotateLeft || aTransform == ITTRotateRight;
+}
+
+//==============================================================================
+// Transform DCT Coefficient Block
+//==============================================================================
+static void transformBlock(const JCOEF* aSource, JCOEF* aTarget, const int& aTransform)
+{
+    // Switch Transform - Negating Odd Frequencies Mirrors the Block
+    switch (aTransform) {
+        case ITTFlipHorizontally:
+            for (int i = 0; i < DCTSIZE; i++) {
+                for (int j = 0; j < DCTSIZE; j++) {
+                    aTarget[i * DCTSIZE + j] = (j & 1) ? -aSource[i * DCTSIZE + j] : aSource[i * DCTSIZE + j];
+                }
+            }
+        break;
+
+        case ITTFlipVertically:
+            for (int i = 0; i < DCTSIZE; i++) {
+                for (int j = 0; j < DCTSIZE; j++) {
+                    aTarget[i * DCTSIZE + j] = (i & 1) ? -aSource[i * DCTSIZE + j] : aSource[i * DCTSIZE + j];
+                }
+            }
+        break;
+
+        case ITTRotateRight:
+            // Transpose + Horizontal Mirror
+            for (int i = 0; i < DCTSIZE; i++) {
+                for (int j = 0; j < DCTSIZE; j++) {
+                    aTarget[i * DCTSIZE + j] = (j & 1) ? -aSource[j * DCTSIZE + i] : aSource[j * DCTSIZE + i];
+                }
+            }
+        break;
+
+        case ITTRotateLeft:
+            // Transpose + Vertical Mirror
+            for (int i = 0; i < DCTSIZE; i++) {
+                for (int j = 0; j < DCTSIZE; j++) {
+                    aTarget[i * DCTSIZE + j] = (i & 1) ? -aSource[j * DCTSIZE + i] : aSource[j * DCTSIZE + i];
+                }
+            }
+        break;
+
+        default:
+            memcpy(aTarget, aSource, sizeof(JBLOCK));
+        break;
+    }
+}
+
+//==============================================================================
+// Check Saved Marker Signature
+//==============================================================================
+static bool markerHasSignature(jpeg_saved_marker_ptr aMarker, const char* aSignature)
+{
+    // Get Signature Length Including Terminator
+    unsigned int length = (unsigned int)strlen(aSignature) + 1;
+
+    return aMarker->data_length >= length && memcmp(aMarker->data, aSignature, length) == 0;
+}
+
+//==============================================================================
+// Transform JPEG Coefficients - Target Buffer Lives Outside the setjmp Frame
+//==============================================================================
+static bool transformJPEGCoefficients(const QByteArray& aSource, const int& aTransform, unsigned char** aTargetBuffer, unsigned long* aTargetSize, QString& aError)
+{
+    // Source Info
+    struct jpeg_decompress_struct srcInfo;
+    // Target Info
+    struct jpeg_compress_struct dstInfo;
+    // Error Manager
+    JPEGErrorManager errorManager;
+    // Target Coefficient Arrays
+    jvirt_barray_ptr dstCoefs[MAX_COMPONENTS];
+
+    // Init Error Manager
+    srcInfo.err = jpeg_std_error(&errorManager.pub);
+    errorManager.pub.error_exit = jpegErrorExit;
+    errorManager.pub.output_message = jpegOutputMessage;
+    dstInfo.err = &errorManager.pub;
+
+    // Create Decompress & Compress Objects
+    jpeg_create_decompress(&srcInfo);
+    jpeg_create_compress(&dstInfo);
+
+    // Set Jump Target For Errors
+    if (setjmp(errorManager.jumpBuffer)) {
+        // Set Error
+        aError = QString::fromLatin1(errorManager.message);
+        // Destroy Objects
+        jpeg_destroy_compress(&dstInfo);
+        jpeg_destroy_decompress(&srcInfo);
+
+        return false;
+    }
+
+    // Set Source
+    jpeg_mem_src(&srcInfo, (unsigned char*)aSource.constData(), (unsigned long)aSource.size());
+
+    // Keep Comment & Application Markers - EXIF, ICC, XMP
+    jpeg_save_markers(&srcInfo, JPEG_COM, 0xFFFF);
+    for (int m = 0; m < 16; m++) {
+        jpeg_save_markers(&srcInfo, JPEG_APP0 + m, 0xFFFF);
+    }
+
+    // Read Header
+    jpeg_read_header(&srcInfo, TRUE);
+
+    // Get Max Sampling Factors
+    int maxHSamp = 1;
+    int maxVSamp = 1;
+    for (int ci = 0; ci < srcInfo.num_components; ci++) {
+        maxHSamp = qMax(maxHSamp, srcInfo.comp_info[ci].h_samp_factor);
+        maxVSamp = qMax(maxVSamp, srcInfo.comp_info[ci].v_samp_factor);
+    }
+
+    // Calculate iMCU Size
+    int iMCUWidth = maxHSamp * DCTSIZE;
+    int iMCUHeight = maxVSamp * DCTSIZE;
+
+    // Check Mirrored Axis Covers Whole iMCUs - Partial Edge Blocks Can't Be Moved Losslessly
+    bool perfect = true;
+    switch (aTransform) {
+        case ITTFlipHorizontally:
+        case ITTRotateLeft:
+            perfect = (srcInfo.image_width % iMCUWidth) == 0;
+        break;
+
+        case ITTFlipVertically:
+        case ITTRotateRight:
+            perfect = (srcInfo.image_height % iMCUHeight) == 0;
+        break;
+
+        default:
+        break;
+    }
+
+    // Check Perfect
+    if (!perfect) {
+        // Set Error
+        aError = QString("Image size %1x%2 is not a multiple of the %3x%4 MCU, lossless transform is not possible")
+                        .arg(srcInfo.image_width).arg(srcInfo.image_height).arg(iMCUWidth).arg(iMCUHeight);
+        // Destroy Objects
+        jpeg_destroy_compress(&dstInfo);
+        jpeg_destroy_decompress(&srcInfo);
+
+        return false;
+    }
+
+    // Get Transposes
+    bool transposes = transformTransposes(aTransform);
+
+    // Request Target Coefficient Arrays - Must Happen Before Reading Coefficients
+    for (int ci = 0; ci < srcInfo.num_components; ci++) {
+        // Get Component
+        jpeg_component_info* comp = srcInfo.comp_info + ci;
+        // Get Padded Source Size in Blocks
+        JDIMENSION srcCols = roundUp(comp->width_in_blocks, comp->h_samp_factor);
+        JDIMENSION srcRows = roundUp(comp->height_in_blocks, comp->v_samp_factor);
+
+        // Request Array
+        dstCoefs[ci] = (*srcInfo.mem->request_virt_barray)((j_common_ptr)&srcInfo, JPOOL_IMAGE, FALSE,
+                                                            transposes ? srcRows : srcCols,
+                                                            transposes ? srcCols : srcRows,
+                                                            transposes ? comp->h_samp_factor : comp->v_samp_factor);
+    }
+
+    // Read Coefficients
+    jvirt_barray_ptr* srcCoefs = jpeg_read_coefficients(&srcInfo);
+
+    // Copy Critical Parameters - Quantization Tables, Sampling, Color Space
+    jpeg_copy_critical_parameters(&srcInfo, &dstInfo);
+
+    // Check Transposes
+    if (transposes) {
+        // Swap Image Size
+        JDIMENSION width = dstInfo.image_width;
+        dstInfo.image_width = dstInfo.image_height;
+        dstInfo.image_height = width;
+
+        // Swap Sampling Factors
+        for (int ci = 0; ci < dstInfo.num_components; ci++) {
+            int hSamp = dstInfo.comp_info[ci].h_samp_factor;
+            dstInfo.comp_info[ci].h_samp_factor = dstInfo.comp_info[ci].v_samp_factor;
+            dstInfo.comp_info[ci].v_samp_factor = hSamp;
+        }
+
+        // Transpose Quantization Tables
+        for (int t = 0; t < NUM_QUANT_TBLS; t++) {
+            // Get Table
+            JQUANT_TBL* table = dstInfo.quant_tbl_ptrs[t];
+            // Check Table
+            if (table) {
+                for (int i = 0; i < DCTSIZE; i++) {
+                    for (int j = i + 1; j < DCTSIZE; j++) {
+                        UINT16 value = table->quantval[i * DCTSIZE + j];
+                        table->quantval[i * DCTSIZE + j] = table->quantval[j * DCTSIZE + i];
+                        table->quantval[j * DCTSIZE + i] = value;
+                    }
+                }
+            }
+        }
+
+        // Swap Density
+        UINT16 density = dstInfo.X_density;
+        dstInfo.X_density = dstInfo.Y_density;
+        dstInfo.Y_density = density;
+    }
+
+    // Transform Coefficients
+    for (int ci = 0; ci < srcInfo.num_components; ci++) {
+        // Get Component
+        jpeg_component_info* comp = srcInfo.comp_info + ci;
+        // Get Source Size in Blocks
+        long srcWidth = comp->width_in_blocks;
+        long srcHeight = comp->height_in_blocks;
+        // Get Padded Source Size in Blocks
+        long srcCols = roundUp(comp->width_in_blocks, comp->h_samp_factor);
+        long srcRows = roundUp(comp->height_in_blocks, comp->v_samp_factor);
+        // Get Target Size in Blocks
+        long dstCols = transposes ? srcRows : srcCols;
+        long dstRows = transposes ? srcCols : srcRows;
+
+        // Go Thru Target Block Rows
+        for (long row = 0; row < dstRows; row++) {
+            // Get Target Row
+            JBLOCKARRAY dstBuffer = (*srcInfo.mem->access_virt_barray)((j_common_ptr)&srcInfo, dstCoefs[ci], (JDIMENSION)row, 1, TRUE);
+
+            // Go Thru Target Blocks
+            for (long col = 0; col < dstCols; col++) {
+                // Init Source Block Position
+                long srcRow = row;
+                long srcCol = col;
+
+                // Switch Transform
+                switch (aTransform) {
+                    case ITTFlipHorizontally:   srcCol = srcWidth - 1 - col;                        break;
+                    case ITTFlipVertically:     srcRow = srcHeight - 1 - row;                       break;
+                    case ITTRotateRight:        srcRow = srcHeight - 1 - col;   srcCol = row;       break;
+                    case ITTRotateLeft:         srcRow = col;                   srcCol = srcWidth - 1 - row;    break;
+                    default:                                                                        break;
+                }
+
+                // Check Source Block Position - Padding Blocks Are Zeroed
+                if (srcRow < 0 || srcRow >= srcRows || srcCol < 0 || srcCol >= srcCols) {
+                    memset(dstBuffer[0][col], 0, sizeof(JBLOCK));
+                    continue;
+                }
+
+                // Get Source Row
+                JBLOCKARRAY srcBuffer = (*srcInfo.mem->access_virt_barray)((j_common_ptr)&srcInfo, srcCoefs[ci], (JDIMENSION)srcRow, 1, FALSE);
+
+                // Transform Block
+                transformBlock(srcBuffer[0][srcCol], dstBuffer[0][col], aTransform);
+            }
+        }
+    }
+
+    // Set Memory Destination
+    jpeg_mem_dest(&dstInfo, aTargetBuffer, aTargetSize);
+
+    // Write Coefficients
+    jpeg_write_coefficients(&dstInfo, dstCoefs);
+
+    // Copy Saved Markers
+    for (jpeg_saved_marker_ptr marker = srcInfo.marker_list; marker; marker = marker->next) {
+        // Skip JFIF Marker Already Written by the Library
+        if (dstInfo.write_JFIF_header && marker->marker == JPEG_APP0 && markerHasSignature(marker, "JFIF")) {
+            continue;
+        }
+
+        // Skip Adobe Marker Already Written by the Library
+        if (dstInfo.write_Adobe_marker && marker->marker == JPEG_APP0 + 14 && markerHasSignature(marker, "Adobe")) {
+            continue;
+        }
+
+        // Write Marker
+        jpeg_write_marker(&dstInfo, marker->marker, marker->data, marker->data_length);
+    }
+
+    // Finish
+    jpeg_finish_compress(&dstInfo);
+    (void)jpeg_finish_decompress(&srcInfo);
+
+    // Destroy Objects
+    jpeg_destroy_compress(&dstInfo);
+    jpeg_destroy_decompress(&srcInfo);
+
+    return true;
+}
+
+//==============================================================================
+// Transform JPEG Data in the DCT Domain - No Decode, No Re-Quantization
+//==============================================================================
+static bool transformJPEGData(const QByteArray& aSource, const int& aTransform, QByteArray& aTarget, QString& aError)
+{
+    // Target Buffer
+    unsigned char* targetBuffer = NULL;
+    // Target Size
+    unsigned long targetSize = 0;
+
+    // Transform Coefficients
+    bool result = transformJPEGCoefficients(aSource, aTransform, &targetBuffer, &targetSize, aError);
+
+    // Check Result
+    if (result) {
+        // Set Target Data
+        aTarget = QByteArray((const char*)targetBuffer, (int)targetSize);
+    }
+
+    // Check Target Buffer
+    if (targetBuffer) {
+        // Free Target Buffer
+        free(targetBuffer);
+    }
+
+    return result;
+}
+
+//==============================================================================
+// Transform JPEG File Losslessly in the DCT Domain
+//==============================================================================
+bool transformJPEGFile(const QString& aFilePath, const int& aTransform, QString& aError)
+{
+    // Init Source File
+    QFile sourceFile(aFilePath);
+
+    // Open Source File
+    if (!sourceFile.open(QIODevice::ReadOnly)) {
+        // Set Error
+        aError = sourceFile.errorString();
+        return false;
+    }
+
+    // Read Source Data
+    QByteArray sourceData = sourceFile.readAll();
+    // Close Source File
+    sourceFile.close();
+
+    // Init Target Data
+    QByteArray targetData;
+
+    // Transform Data
+    if (!transformJPEGData(sourceData, aTransform, targetData, aError)) {
+        return false;
+    }
+
+    // Init Target File - Written Next To the Original, Renamed Over It On Commit
+    QSaveFile targetFile(aFilePath);
+
+    // Open & Write Target File
+    if (!targetFile.open(QIODevice::WriteOnly) || targetFile.write(targetData) != targetData.size() || !targetFile.commit()) {
+        // Set Error
+        aError = targetFile.errorString();
+        return false;
+    }
+
+    return true;
+}
+
+//==============================================================================
+// Transform Image File In Place - Lossless for JPEG, Atomic Write for All Formats
+//==============================================================================
+bool transformImageFile(const QString& aFilePath, const int& aTransform, QString& aError)
+{
+    // Init Image Reader
+    QImageReader reader(aFilePath);
+    // Get Format
+    QByteArray format = reader.format();
+
+    // Check Format
+    if (format == DEFAULT_SUPPORTED_FORMAT_JPEG || format == DEFAULT_SUPPORTED_FORMAT_JPG) {
+        // Transform JPEG Losslessly
+        return transformJPEGFile(aFilePath, aTransform, aError);
+    }
+
+    // Check Writer Support - GIF Can Be Read But Not Written
+    if (!QImageWriter::supportedImageFormats().contains(format)) {
+        // Set Error
+        aError = QString("Writing %1 images is not supported").arg(QString(format));
+        return false;
+    }
+
+    // Read Image
+    QImage image = reader.read();
+
+    // Check Image
+    if (image.isNull()) {
+        // Set Error
+        aError = reader.errorString();
+        return false;
+    }
+
+    // Switch Transform
+    switch (aTransform) {
+        case ITTRotateLeft:
+            image = image.transformed(QTransform().rotate(TRANSFORM_ROTATE_LEFT));
+        break;
+
+        case ITTRotateRight:
+            image = image.transformed(QTransform().rotate(TRANSFORM_ROTATE_RIGHT));
+        break;
+
+        case ITTFlipHorizontally:
+            // Mirror In Place
+            image = std::move(image).mirrored(true, false);
+        break;
+
+        case ITTFlipVertically:
+            // Mirror In Place
+            image = std::move(image).mirrored(false, true);
+        break;
+
+        default:
+        break;
+    }
+
+    // Init Target File - Written Next To the Original, Renamed Over It On Commit
+    QSaveFile targetFile(aFilePath);
+
+    // Open Target File
+    if (!targetFile.open(QIODevice::WriteOnly)) {
+        // Set Error
+        aError = targetFile.errorString();
+        return false;
+    }
+
+    // Init Image Writer
+    QImageWriter writer(&targetFile, format);
+
+    // Write Image
+    if (!writer.write(image)) {
+        // Set Error
+        aError = writer.errorString();
+        // Cancel Writing
+        targetFile.cancelWriting();
+        return false;
+    }
+
+    // Commit
+    if (!targetFile.commit()) {
+        // Set Error
+        aError = targetFile.errorString();
+        return false;
+    }
+
+    return true;
+}
@@ -0,0 +1,23 @@
+#ifndef IMAGETRANSFORMER_H
+#define IMAGETRANSFORMER_H
+
+#include <QString>
+
+//==============================================================================
+// Image Transform Types
+//==============================================================================
+enum ImageTransformType
+{
+    ITTRotateLeft       = 0,
+    ITTRotateRight,
+    ITTFlipHorizontally,
+    ITTFlipVertically
+};
+
+// Transform Image File In Place - Lossless for JPEG, Atomic Write for All Formats
+bool transformImageFile(const QString& aFilePath, const int& aTransform, QString& aError);
+
+// Transform JPEG File Losslessly in the DCT Domain
+bool transformJPEGFile(const QString& aFilePath, const int& aTransform, QString& aError);
+
+#endif // IMAGETRANSFORMER_H
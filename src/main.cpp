@@ -4,6 +4,11 @@
 
 #include "imagecompareapp.h"
 #include "mainwindow.h"
+#include "imagecache.h"
+#include "resultcache.h"
+#include "decodedcache.h"
+#include "thumbnailcache.h"
+#include "headless.h"
 //#include "viewerwindow.h"
 #include "constants.h"
 
@@ -13,6 +18,12 @@
 //==============================================================================
 int main(int argc, char* argv[])
 {
+    // Check Headless Command
+    if (isHeadlessCommand(argc, argv)) {
+        // Run Headless Command
+        return runHeadlessCommand(argc, argv);
+    }
+
     qDebug() << " ";
     qDebug() << "================================================================================";
     qDebug() << " Starting Max Viewer...";
@@ -29,6 +40,13 @@ int main(int argc, char* argv[])
     // Set Organization Domain
     app.setOrganizationDomain(DEFAULT_ORGANIZATION_DOMAIN);
 
+    // Init Result Cache - Before the Worker Thread Uses It
+    ResultCache::getInstance();
+    // Init Decoded Cache - Before the Image Cache Uses It
+    DecodedCache::getInstance();
+    // Init Thumbnail Cache
+    ThumbnailCache::getInstance();
+
     // Init Browser Window
     MainWindow* mainWindow = MainWindow::getInstance();
 
@@ -50,6 +68,15 @@ int main(int argc, char* argv[])
     // Release Browser Window Instance
     mainWindow->release();
 
+    // Release Image Cache
+    ImageCache::getInstance()->release();
+    // Release Result Cache
+    ResultCache::getInstance()->release();
+    // Release Decoded Cache - Waits For Pending Writes
+    DecodedCache::getInstance()->release();
+    // Release Thumbnail Cache - Waits For Pending Thumbnails
+    ThumbnailCache::getInstance()->release();
+
     qDebug() << " ";
     qDebug() << "================================================================================";
     qDebug() << " Exiting Max Viewer...";
@@ -4,10 +4,15 @@
 #include <QFileInfo>
 #include <QFileInfoList>
 #include <QQmlContext>
+#include <QQmlEngine>
 #include <QMutexLocker>
 #include <QModelIndex>
 #include <QSettings>
 #include <QFileDialog>
+#include <QQuickWindow>
+#include <QCoreApplication>
+#include <QEventLoop>
+#include <QDialogButtonBox>
 
 #ifdef Q_OS_MACX
 
@@ -26,6 +31,11 @@
 #include "confirmationdialog.h"
 #include "dirselectordialog.h"
 #include "worker.h"
+#include "imagetransformer.h"
+#include "imagecache.h"
+#include "directorymodel.h"
+#include "thumbnailcache.h"
+#include "comparemask.h"
 #include "utility.h"
 #include "constants.h"
 #include "defaultsettings.h"
@@ -66,7 +76,7 @@ void MainWindow::release()
 MainWindow::MainWindow(QWidget* aParent)
     : QMainWindow(aParent)
     , ui(new Ui::MainWindow)
-    , fsModel(NULL)
+    , dirModel(NULL)
     , currentDir("")
     , currentFileLeft("")
     , currentFileRight("")
@@ -82,16 +92,36 @@ MainWindow::MainWindow(QWidget* aParent)
     , prevPanPosX(0.0)
     , prevPanPosY(0.0)
     , manualPanning(false)
+    , panUpdatePending(false)
+    , pendingPanPosX(0.0)
+    , pendingPanPosY(0.0)
+    , pendingZoomSteps(0)
+    , inputFrameTimerID(-1)
     , threshold(DEFAULT_COMPARE_THRESHOLD)
     , hideSources(false)
     , showGrid(false)
+    , autoAlign(DEFAULT_AUTO_ALIGN)
+    , alignOffsetX(0)
+    , alignOffsetY(0)
+    , compareMaskFile("")
+    , deepCompareCached(false)
+    , deepCompareOffset(0, 0)
+    , currentFrame(0)
+    , frameCount(0)
+    , learnedRenders(0)
     , viewerWindow(NULL)
     , aboutDialog(NULL)
     , dirSelector(NULL)
     , renameFileDialog(NULL)
     , infoDialog(NULL)
     , transferDir("")
+    , fileRevision(0)
+    , watchFiles(QSettings().value(SETTINGS_KEY_WATCH_FILES, DEFAULT_WATCH_FILES).toBool())
+    , watchTimerID(-1)
+    , watchChecks(0)
+    , stepDirection(1)
     , worker(NULL)
+    , transferOptions(0)
 {
     // Setup UI
     ui->setupUi(this);
@@ -110,6 +140,18 @@ MainWindow::MainWindow(QWidget* aParent)
 //==============================================================================
 void MainWindow::init()
 {
+    // Create Directory Model
+    dirModel = new DirectoryModel(this);
+    // Connect Files Changed Signal
+    connect(dirModel, SIGNAL(filesChanged()), this, SLOT(dirFilesChanged()));
+
+    // Add Image Cache Providers - One Per Engine, Engines Own Them
+    ui->leftView->engine()->addImageProvider(DEFAULT_IMAGE_CACHE_PROVIDER_ID, new ImageCacheProvider());
+    ui->centerView->engine()->addImageProvider(DEFAULT_IMAGE_CACHE_PROVIDER_ID, new ImageCacheProvider());
+    ui->rightView->engine()->addImageProvider(DEFAULT_IMAGE_CACHE_PROVIDER_ID, new ImageCacheProvider());
+    // Add Compare Mask Provider - Only the Compare View Shows Masks
+    ui->centerView->engine()->addImageProvider(DEFAULT_COMPARE_MASK_PROVIDER_ID, new CompareMaskProvider());
+
     // Get Root Context
     QQmlContext* leftContext = ui->leftView->rootContext();
     // Set Context Property
@@ -148,6 +190,23 @@ void MainWindow::init()
     connect(ui->centerView, SIGNAL(compositeWidthChanged(qreal)), this, SLOT(compositeWidthChanged(qreal)));
     connect(ui->centerView, SIGNAL(compositeHeightChanged(qreal)), this, SLOT(compositeHeightChanged(qreal)));
 
+    // Connect Frame Swapped Signal To Pace Pan & Zoom Input
+    connect(ui->centerView->quickWindow(), SIGNAL(frameSwapped()), this, SLOT(frameSwapped()));
+
+    // ...
+
+
+    // Add Thumbnail Provider
+    ui->thumbnailView->engine()->addImageProvider(DEFAULT_THUMBNAIL_PROVIDER_ID, new ThumbnailProvider());
+
+    // Get Root Context
+    QQmlContext* thumbnailContext = ui->thumbnailView->rootContext();
+    // Set Context Properties
+    thumbnailContext->setContextProperty(MAIN_VIEW_CONTROLLER, this);
+    thumbnailContext->setContextProperty(CONTEXT_PROPERTY_DIRECTORY_MODEL, dirModel);
+    // Set Source
+    ui->thumbnailView->setSource(QUrl(QML_SOURCE_THUMBNAIL_STRIP));
+
     // ...
 
 
@@ -169,6 +228,9 @@ void MainWindow::init()
     connect(ui->rightView, SIGNAL(mouseMoved(QPoint)), this, SLOT(panMove(QPoint)));
     connect(ui->rightView, SIGNAL(mouseReleased(QPoint)), this, SLOT(panFinished(QPoint)));
 
+    // Connect File Watcher Signal
+    connect(&fileWatcher, SIGNAL(fileChanged(QString)), this, SLOT(watchedFileChanged(QString)));
+
     // Set Zoom Level Index
     zoomDefault();
 
@@ -262,6 +324,11 @@ void MainWindow::setCurrentDir(const QString& aCurrentDir)
             currentDir = QDir::homePath();
         }
 
+        // Set Dir Path - Scanned In the Background
+        dirModel->setDirPath(currentDir);
+        // Clear Selected Files - Selection Is Made In the Thumbnail Strip of the Dir
+        setSelectedFiles(QStringList());
+
         // Emit Current Dir Changed Signal
         emit currentDirChanged(currentDir);
 
@@ -299,17 +366,49 @@ void MainWindow::setCurrentFileLeft(const QString& aCurrentFile)
     // Check Current File
     if (currentFileLeft != aCurrentFile) {
         qDebug() << "MainWindow::setCurrentFileLeft - aCurrentFile: " << aCurrentFile;
+        // Reset Current Frame
+        setCurrentFrame(0);
         // Set Current File
         currentFileLeft = aCurrentFile;
 
         // Emit Current File Changed Signal
         emit currentFileLeftChanged(currentFileLeft);
 
-        // ...
+        // Get Compare Mask File
+        QString newCompareMaskFile = ::compareMaskFile(currentFileLeft);
+
+        // Check Compare Mask File
+        if (compareMaskFile != newCompareMaskFile) {
+            // Set Compare Mask File
+            compareMaskFile = newCompareMaskFile;
+            // Emit Compare Mask File Changed Signal
+            emit compareMaskFileChanged(compareMaskFile);
+        }
 
         // Show Status Text
         showStatusText(tr("Left Image: ") + currentFileLeft);
 
+        // Get Left File Dir
+        QString leftFileDir = QFileInfo(currentFileLeft).absolutePath();
+
+        // Check Left File Dir - Thumbnail Strip Follows the Left File, Unless a Worker Operation Is Running
+        if (!currentFileLeft.isEmpty() && !currentFileLeft.startsWith(DEFAULT_SHARED_IMAGE_PREFIX) && currentDir != leftFileDir && !workerThread.isRunning()) {
+            // Set Current Dir
+            setCurrentDir(leftFileDir);
+        }
+
+        // Prefetch Neighbours
+        prefetchNeighbours();
+
+        // Update File Watcher
+        updateFileWatcher();
+
+        // Update Frame Count
+        updateFrameCount();
+
+        // Check Auto Compare
+        checkAutoCompare();
+
         // Update Menu
         updateMenu();
     }
@@ -331,6 +430,8 @@ void MainWindow::setCurrentFileRight(const QString& aCurrentFile)
     // Check Current File
     if (currentFileRight != aCurrentFile) {
         qDebug() << "MainWindow::setCurrentFileRight - aCurrentFile: " << aCurrentFile;
+        // Reset Current Frame
+        setCurrentFrame(0);
         // Set Current File
         currentFileRight = aCurrentFile;
 
@@ -342,6 +443,18 @@ void MainWindow::setCurrentFileRight(const QString& aCurrentFile)
         // Show Status Text
         showStatusText(tr("Right Image: ") + currentFileRight);
 
+        // Prefetch Neighbours
+        prefetchNeighbours();
+
+        // Update File Watcher
+        updateFileWatcher();
+
+        // Update Frame Count
+        updateFrameCount();
+
+        // Check Auto Compare
+        checkAutoCompare();
+
         // Update Menu
         updateMenu();
     }
@@ -749,6 +862,232 @@ void MainWindow::setShowGrid(const bool& aShowGrid)
     }
 }
 
+//==============================================================================
+// Get Auto Align
+//==============================================================================
+bool MainWindow::getAutoAlign()
+{
+    return autoAlign;
+}
+
+//==============================================================================
+// Set Auto Align
+//==============================================================================
+void MainWindow::setAutoAlign(const bool& aAutoAlign)
+{
+    // Check Auto Align
+    if (autoAlign != aAutoAlign) {
+        // Set Auto Align
+        autoAlign = aAutoAlign;
+        // Emit Auto Align Changed Signal
+        emit autoAlignChanged(autoAlign);
+
+        // Show Status Text
+        showStatusText(autoAlign ? tr("Auto Align: On") : tr("Auto Align: Off"));
+    }
+}
+
+//==============================================================================
+// Get Compare Mask File of the Left Image
+//==============================================================================
+QString MainWindow::getCompareMaskFile()
+{
+    return compareMaskFile;
+}
+
+//==============================================================================
+// Get Alpha Mode
+//==============================================================================
+int MainWindow::getAlphaMode()
+{
+    return ImageCache::getInstance()->getAlphaMode();
+}
+
+//==============================================================================
+// Set Alpha Mode - Images Are Normalized Again
+//==============================================================================
+void MainWindow::setAlphaMode(const int& aAlphaMode)
+{
+    // Check Alpha Mode
+    if (ImageCache::getInstance()->getAlphaMode() != aAlphaMode) {
+        // Set Alpha Mode - Drops Cached Images
+        ImageCache::getInstance()->setAlphaMode(aAlphaMode);
+        // Emit Alpha Mode Changed Signal
+        emit alphaModeChanged(aAlphaMode);
+
+        // Inc File Revision - Compositor & Views Reload Normalized Images
+        fileRevision++;
+        // Emit File Revision Changed Signal
+        emit fileRevisionChanged(fileRevision);
+
+        // Switch Alpha Mode
+        switch (aAlphaMode) {
+            case AMTPremultiplied:  showStatusText(tr("Alpha: Premultiplied")); break;
+            case AMTIgnore:         showStatusText(tr("Alpha: Ignored"));       break;
+            default:                showStatusText(tr("Alpha: Straight"));      break;
+        }
+    }
+}
+
+//==============================================================================
+// Get Current Frame
+//==============================================================================
+int MainWindow::getCurrentFrame()
+{
+    return currentFrame;
+}
+
+//==============================================================================
+// Set Current Frame
+//==============================================================================
+void MainWindow::setCurrentFrame(const int& aCurrentFrame)
+{
+    // Get Frame - Clamped To the Longest Sequence
+    int frame = qBound(0, aCurrentFrame, qMax(0, frameCount - 1));
+
+    // Check Current Frame
+    if (currentFrame != frame) {
+        // Set Current Frame
+        currentFrame = frame;
+        // Emit Current Frame Changed Signal
+        emit currentFrameChanged(currentFrame);
+
+        // Show Frame Status
+        showFrameStatus();
+    }
+}
+
+//==============================================================================
+// Get Frame Count - Longest of the Current Files
+//==============================================================================
+int MainWindow::getFrameCount()
+{
+    return frameCount;
+}
+
+//==============================================================================
+// Update Frame Count
+//==============================================================================
+void MainWindow::updateFrameCount()
+{
+    // Get Frame Count - Header Only For Multi Page Formats
+    int newFrameCount = qMax(currentFileLeft.isEmpty() ? 0 : ::frameCount(currentFileLeft),
+                             currentFileRight.isEmpty() ? 0 : ::frameCount(currentFileRight));
+
+    // Check Frame Count
+    if (frameCount != newFrameCount) {
+        // Set Frame Count
+        frameCount = newFrameCount;
+        // Emit Frame Count Changed Signal
+        emit frameCountChanged(frameCount);
+    }
+}
+
+//==============================================================================
+// Show Current Frame Status
+//==============================================================================
+void MainWindow::showFrameStatus()
+{
+    // Check Frame Sequence Result - Only Valid For the Files It Was Made Of
+    if (frameSequenceFiles == (QStringList() << currentFileLeft << currentFileRight) && currentFrame < frameSequenceResult.frames.count()) {
+        // Get Frame Statistics
+        const FrameCompareStats& stats = frameSequenceResult.frames[currentFrame];
+
+        // Show Status Text
+        showStatusText(tr("Frame %1/%2: %3 of %4 pixels differ, max %5, delay %6/%7 ms")
+                       .arg(currentFrame + 1)
+                       .arg(frameCount)
+                       .arg(stats.differingPixels)
+                       .arg(stats.pixels)
+                       .arg(stats.maxDifference)
+                       .arg(stats.leftDelay)
+                       .arg(stats.rightDelay));
+    } else {
+        // Show Status Text
+        showStatusText(tr("Frame %1/%2").arg(currentFrame + 1).arg(frameCount));
+    }
+}
+
+//==============================================================================
+// Get Align Offset X
+//==============================================================================
+int MainWindow::getAlignOffsetX()
+{
+    return alignOffsetX;
+}
+
+//==============================================================================
+// Set Align Offset X
+//==============================================================================
+void MainWindow::setAlignOffsetX(const int& aAlignOffsetX)
+{
+    // Check Align Offset X
+    if (alignOffsetX != aAlignOffsetX) {
+        // Set Align Offset X
+        alignOffsetX = aAlignOffsetX;
+        // Emit Align Offset X Changed Signal
+        emit alignOffsetXChanged(alignOffsetX);
+    }
+}
+
+//==============================================================================
+// Get Align Offset Y
+//==============================================================================
+int MainWindow::getAlignOffsetY()
+{
+    return alignOffsetY;
+}
+
+//==============================================================================
+// Set Align Offset Y
+//==============================================================================
+void MainWindow::setAlignOffsetY(const int& aAlignOffsetY)
+{
+    // Check Align Offset Y
+    if (alignOffsetY != aAlignOffsetY) {
+        // Set Align Offset Y
+        alignOffsetY = aAlignOffsetY;
+        // Emit Align Offset Y Changed Signal
+        emit alignOffsetYChanged(alignOffsetY);
+    }
+}
+
+//==============================================================================
+// Get Selected Files
+//==============================================================================
+QStringList MainWindow::getSelectedFiles()
+{
+    return selectedFiles;
+}
+
+//==============================================================================
+// Set Selected Files
+//==============================================================================
+void MainWindow::setSelectedFiles(const QStringList& aSelectedFiles)
+{
+    // Check Selected Files
+    if (selectedFiles != aSelectedFiles) {
+        // Set Selected Files
+        selectedFiles = aSelectedFiles;
+        // Emit Selected Files Changed Signal
+        emit selectedFilesChanged(selectedFiles);
+
+        // Check Selected Files
+        if (!selectedFiles.isEmpty()) {
+            // Show Status Text
+            showStatusText(tr("%1 files selected").arg(selectedFiles.count()));
+        }
+    }
+}
+
+//==============================================================================
+// Get File Revision
+//==============================================================================
+int MainWindow::getFileRevision()
+{
+    return fileRevision;
+}
+
 //==============================================================================
 // Init Worker
 //==============================================================================
@@ -756,8 +1095,8 @@ void MainWindow::initWorker()
 {
     // Check Worker Thread
     if (workerThread.isRunning()) {
-        // Terminate Worker Thread
-        workerThread.terminate();
+        // Stop Worker Thread
+        stopWorkerThread();
     }
 
     // Check Worker
@@ -769,6 +1108,8 @@ void MainWindow::initWorker()
         // Connect Signals
         connect(worker, SIGNAL(resultReady(int,int)), this, SLOT(workerResultReady(int,int)), Qt::QueuedConnection);
         connect(this, SIGNAL(operateWorker(int)), worker, SLOT(doWork(int)));
+        connect(worker, SIGNAL(progressChanged(int,int)), this, SLOT(workerProgressChanged(int,int)), Qt::QueuedConnection);
+        connect(worker, SIGNAL(transferProgressChanged(qint64,qint64,qint64,int)), this, SLOT(workerTransferProgressChanged(qint64,qint64,qint64,int)), Qt::QueuedConnection);
 
         // ...
 
@@ -778,6 +1119,438 @@ void MainWindow::initWorker()
 
     // Start Worker Thread
     workerThread.start();
+
+    // Enable Cancel Operation Action
+    ui->actionCancel_Operation->setEnabled(true);
+}
+
+//==============================================================================
+// Start File Operation On Selected/Current Files
+//==============================================================================
+void MainWindow::startFileOperation(const int& aOperation)
+{
+    // Check Worker Thread
+    if (workerThread.isRunning()) {
+        // Show Status Text
+        showStatusText(tr("Another operation is in progress"));
+        return;
+    }
+
+    // Check Selected Files
+    if (selectedFiles.count() > 0) {
+        // Set Operation Files
+        operationFiles = selectedFiles;
+    } else {
+        // Clear Operation Files
+        operationFiles.clear();
+
+        // Check Current File Left
+        if (!currentFileLeft.isEmpty()) {
+            // Add Current File Left
+            operationFiles << currentFileLeft;
+        }
+
+        // Check Current File Right
+        if (!currentFileRight.isEmpty() && currentFileRight != currentFileLeft) {
+            // Add Current File Right
+            operationFiles << currentFileRight;
+        }
+    }
+
+    // Check Operation Files
+    if (operationFiles.isEmpty()) {
+        // Show Status Text
+        showStatusText(tr("No files selected"));
+        return;
+    }
+
+    // Init Worker
+    initWorker();
+
+    // Emit Operate Worker Signal
+    emit operateWorker(aOperation);
+}
+
+//==============================================================================
+// Select Transfer Dir
+//==============================================================================
+bool MainWindow::selectTransferDir()
+{
+    // Check Dir Selector
+    if (!dirSelector) {
+        // Create Dir Selector
+        dirSelector = new DirSelectorDialog(this);
+    }
+
+    // Exec Dir Selector
+    if (dirSelector->exec() != QDialog::Accepted || dirSelector->getSelectedDir().isEmpty()) {
+        return false;
+    }
+
+    // Set Transfer Dir
+    transferDir = dirSelector->getSelectedDir();
+    // Reset Transfer Options - Yes/No To All Only Applies To One Transfer
+    transferOptions = 0;
+
+    return true;
+}
+
+//==============================================================================
+// Get Image Files of Dir In Directory Order
+//==============================================================================
+QStringList MainWindow::dirImageFiles(const QString& aDirPath)
+{
+    // Check Dir Listings
+    if (!dirListings.contains(aDirPath)) {
+        // Check Directory Model - Current Dir Is Listed Already Once Scanned
+        if (dirModel && !dirModel->getScanning() && dirModel->getDirPath() == QDir(aDirPath).absolutePath()) {
+            // Get File Paths
+            dirListings[aDirPath] = dirModel->filePaths();
+        } else {
+            // List Dir
+            dirListings[aDirPath] = imageFileList(aDirPath);
+        }
+    }
+
+    return dirListings[aDirPath];
+}
+
+//==============================================================================
+// Dir Files Changed Slot - Drops the Stale Dir Listing
+//==============================================================================
+void MainWindow::dirFilesChanged()
+{
+    // Go Thru Dir Listings
+    foreach (QString dirPath, dirListings.keys()) {
+        // Check Dir Path
+        if (QDir(dirPath).absolutePath() == dirModel->getDirPath()) {
+            // Remove Dir Listing
+            dirListings.remove(dirPath);
+        }
+    }
+}
+
+//==============================================================================
+// Get Right File Paired With Left File
+//==============================================================================
+QString MainWindow::pairedFile(const QString& aLeftFile, const QString& aRightDir, const QStringList& aRightFiles, const int& aRightIndex)
+{
+    // Check Right Files
+    if (aRightFiles.isEmpty()) {
+        return QString("");
+    }
+
+    // Check Right Dir - Pairs Across Dirs Are Matched By Name
+    if (QFileInfo(aLeftFile).absolutePath() != aRightDir) {
+        // Get Same Name In Right Dir
+        QString sameName = QDir(aRightDir).filePath(QFileInfo(aLeftFile).fileName());
+
+        // Check Same Name
+        if (aRightFiles.contains(sameName)) {
+            return sameName;
+        }
+    }
+
+    // Step Right Side By Position
+    return aRightFiles[qBound(0, aRightIndex, aRightFiles.count() - 1)];
+}
+
+//==============================================================================
+// Step Files
+//==============================================================================
+void MainWindow::stepFiles(const int& aDirection)
+{
+    // Check Current File Left
+    if (currentFileLeft.isEmpty()) {
+        return;
+    }
+
+    // Get Left Files
+    QStringList leftFiles = dirImageFiles(QFileInfo(currentFileLeft).absolutePath());
+    // Get New Left Index
+    int leftIndex = leftFiles.indexOf(QFileInfo(currentFileLeft).absoluteFilePath()) + aDirection;
+
+    // Check New Left Index
+    if (leftIndex < 0 || leftIndex >= leftFiles.count()) {
+        // Show Status Text
+        showStatusText(aDirection > 0 ? tr("Last image") : tr("First image"));
+        return;
+    }
+
+    // Get Right Dir
+    QString rightDir = currentFileRight.isEmpty() ? QString("") : QFileInfo(currentFileRight).absolutePath();
+    // Get Right Files
+    QStringList rightFiles = rightDir.isEmpty() ? QStringList() : dirImageFiles(rightDir);
+    // Get New Right Index
+    int rightIndex = rightFiles.indexOf(QFileInfo(currentFileRight).absoluteFilePath()) + aDirection;
+
+    // Set Step Direction
+    stepDirection = aDirection;
+
+    // Set Current File Left
+    setCurrentFileLeft(leftFiles[leftIndex]);
+
+    // Check Right Files
+    if (!rightFiles.isEmpty()) {
+        // Set Current File Right
+        setCurrentFileRight(pairedFile(leftFiles[leftIndex], rightDir, rightFiles, rightIndex));
+    }
+}
+
+//==============================================================================
+// Prefetch Neighbouring Images/Pairs
+//==============================================================================
+void MainWindow::prefetchNeighbours()
+{
+    // Check Current File Left
+    if (currentFileLeft.isEmpty()) {
+        return;
+    }
+
+    // Get Left Files
+    QStringList leftFiles = dirImageFiles(QFileInfo(currentFileLeft).absolutePath());
+    // Get Left Index
+    int leftIndex = leftFiles.indexOf(QFileInfo(currentFileLeft).absoluteFilePath());
+
+    // Get Right Dir
+    QString rightDir = currentFileRight.isEmpty() ? QString("") : QFileInfo(currentFileRight).absolutePath();
+    // Get Right Files
+    QStringList rightFiles = rightDir.isEmpty() ? QStringList() : dirImageFiles(rightDir);
+    // Get Right Index
+    int rightIndex = rightFiles.indexOf(QFileInfo(currentFileRight).absoluteFilePath());
+
+    // Init Prefetch Files
+    QStringList prefetchFiles;
+
+    // Go Thru Neighbours - Ahead In the Step Direction First, Then Behind
+    for (int i = 0; i < DEFAULT_PREFETCH_COUNT * 2; i++) {
+        // Get Offset
+        int offset = (i < DEFAULT_PREFETCH_COUNT ? i + 1 : DEFAULT_PREFETCH_COUNT - i - 1) * stepDirection;
+
+        // Check Left Index
+        if (leftIndex + offset < 0 || leftIndex + offset >= leftFiles.count()) {
+            continue;
+        }
+
+        // Add Left File
+        prefetchFiles << leftFiles[leftIndex + offset];
+
+        // Check Right Files
+        if (!rightFiles.isEmpty()) {
+            // Add Paired Right File
+            prefetchFiles << pairedFile(leftFiles[leftIndex + offset], rightDir, rightFiles, rightIndex + offset);
+        }
+    }
+
+    // Prefetch
+    ImageCache::getInstance()->prefetch(prefetchFiles, stepDirection);
+}
+
+//==============================================================================
+// Get Watch Stamp of File - Size & Modification Time, Empty If the File Is Gone
+//==============================================================================
+static QString watchStamp(const QString& aFilePath)
+{
+    // Get File Info
+    QFileInfo fileInfo(aFilePath);
+
+    // Check File
+    if (!fileInfo.isFile()) {
+        return QString("");
+    }
+
+    return QString("%1:%2").arg(fileInfo.size()).arg(fileInfo.lastModified().toMSecsSinceEpoch());
+}
+
+//==============================================================================
+// Update File Watcher - Watches the Current Files
+//==============================================================================
+void MainWindow::updateFileWatcher()
+{
+    // Check Watched Files
+    if (!fileWatcher.files().isEmpty()) {
+        // Remove Watched Files
+        fileWatcher.removePaths(fileWatcher.files());
+    }
+
+    // Clear Stamps
+    watchStamps.clear();
+    watchCheckStamps.clear();
+
+    // Check Watch Files
+    if (!watchFiles) {
+        return;
+    }
+
+    // Go Thru Current Files
+    foreach (QString filePath, QStringList() << currentFileLeft << currentFileRight) {
+        // Check File - Shared Memory Sources Are Not On Disk
+        if (filePath.isEmpty() || !QFileInfo(filePath).isFile()) {
+            continue;
+        }
+
+        // Add Path
+        fileWatcher.addPath(filePath);
+        // Set Stamps
+        watchStamps[filePath] = watchCheckStamps[filePath] = watchStamp(filePath);
+    }
+}
+
+//==============================================================================
+// Watched File Changed Slot - Restarts the Debounce Timer
+//==============================================================================
+void MainWindow::watchedFileChanged(const QString& aFilePath)
+{
+    qDebug() << "MainWindow::watchedFileChanged - aFilePath: " << aFilePath;
+
+    // Check Watch Timer ID
+    if (watchTimerID != -1) {
+        // Kill Timer - Writes Still Going On
+        killTimer(watchTimerID);
+    }
+
+    // Reset Watch Checks
+    watchChecks = 0;
+    // Start Watch Timer
+    watchTimerID = startTimer(DEFAULT_FILE_WATCH_DEBOUNCE_MS);
+}
+
+//==============================================================================
+// Check Watched Files - Reloads Them Once Writes Settled
+//==============================================================================
+void MainWindow::checkWatchedFiles()
+{
+    // Init Settled, Changed, Pending & Missing
+    bool settled = true;
+    bool changed = false;
+    bool pending = false;
+    bool missing = false;
+
+    // Go Thru Watched Files
+    foreach (QString filePath, watchStamps.keys()) {
+        // Get Stamp
+        QString stamp = watchStamp(filePath);
+
+        // Check Stamp - Replaced By Rename, Not There Yet
+        if (stamp.isEmpty()) {
+            // Reset Settled
+            settled = false;
+            // Set Missing
+            missing = true;
+            continue;
+        }
+
+        // Check Stamp Since Last Load - Settled Or Not
+        if (stamp != watchStamps[filePath]) {
+            // Set Pending
+            pending = true;
+        }
+
+        // Check Watched - Replacing Renames Drop the Watch
+        if (!fileWatcher.files().contains(filePath)) {
+            // Add Path
+            fileWatcher.addPath(filePath);
+        }
+
+        // Check Stamp Since Last Check - Still Being Written
+        if (stamp != watchCheckStamps[filePath]) {
+            // Set Check Stamp
+            watchCheckStamps[filePath] = stamp;
+            // Reset Settled
+            settled = false;
+        // Check Stamp Since Last Load
+        } else if (stamp != watchStamps[filePath]) {
+            // Set Changed
+            changed = true;
+        }
+    }
+
+    // Check Settled - Files Gone For Good Are Not Waited For Forever
+    if (!settled && ++watchChecks < DEFAULT_FILE_WATCH_MAX_CHECKS) {
+        // Start Watch Timer - Check Again After Another Quiet Period
+        watchTimerID = startTimer(DEFAULT_FILE_WATCH_DEBOUNCE_MS);
+        return;
+    }
+
+    // Check Missing - A Replacing File Showing Up Later Has No Watch To Signal It, Keep Polling Slowly
+    if (missing) {
+        // Start Watch Timer
+        watchTimerID = startTimer(DEFAULT_FILE_WATCH_MISSING_POLL_MS);
+    }
+
+    // Check Changed - On the Last Check Unsettled Files Are Reloaded With Their Latest Stamps Too, Never Dropped
+    if (changed || pending) {
+        qDebug() << "MainWindow::checkWatchedFiles - RELOADING";
+
+        // Set Stamps
+        watchStamps = watchCheckStamps;
+
+        // Inc File Revision - Compositor Patches Changed Blocks, Zoom & Pan Are Kept
+        fileRevision++;
+        // Emit File Revision Changed Signal
+        emit fileRevisionChanged(fileRevision);
+
+        // Update Frame Count
+        updateFrameCount();
+
+        // Show Status Text
+        showStatusText(tr("Reloaded Changed Files"));
+    }
+}
+
+//==============================================================================
+// Request Frame For Coalesced Input - Next Frame Swap Or the Fallback Timer, Whichever Comes First
+//==============================================================================
+void MainWindow::requestInputFrame()
+{
+    // Check Center View
+    if (ui->centerView && ui->centerView->quickWindow()) {
+        // Request Frame
+        ui->centerView->quickWindow()->update();
+
+        // Check Fallback Timer - QQuickWidget May Render Without Emitting Frame Swapped
+        if (inputFrameTimerID == -1) {
+            // Start Fallback Timer
+            inputFrameTimerID = startTimer(DEFAULT_COMPOSITOR_DISPATCH_FALLBACK_MS);
+        }
+    } else {
+        // No Frames To Pace By, Apply Right Away
+        frameSwapped();
+    }
+}
+
+//==============================================================================
+// Frame Swapped Slot - Applies Coalesced Pan & Zoom Input
+//==============================================================================
+void MainWindow::frameSwapped()
+{
+    // Check Fallback Timer
+    if (inputFrameTimerID != -1) {
+        // Kill Fallback Timer
+        killTimer(inputFrameTimerID);
+        // Reset Fallback Timer ID
+        inputFrameTimerID = -1;
+    }
+
+    // Check Pending Zoom Steps - All Steps Applied As One Zoom Level Change
+    if (pendingZoomSteps != 0) {
+        // Get Zoom Steps
+        int zoomSteps = pendingZoomSteps;
+        // Reset Pending Zoom Steps
+        pendingZoomSteps = 0;
+        // Zoom By Steps
+        zoomBySteps(zoomSteps);
+    }
+
+    // Check Pan Update Pending
+    if (panUpdatePending) {
+        // Reset Pan Update Pending
+        panUpdatePending = false;
+        // Set Pan Pos X
+        setPanPosX(pendingPanPosX);
+        // Set Pan Pos Y
+        setPanPosY(pendingPanPosY);
+    }
 }
 
 //==============================================================================
@@ -813,211 +1586,368 @@ void MainWindow::saveSettings()
 }
 
 //==============================================================================
-// Rotate Current Image Left
+// Rotate Current Image Left
+//==============================================================================
+void MainWindow::rotateLeft()
+{
+    qDebug() << "MainWindow::rotateLeft";
+
+    // Start File Operation
+    startFileOperation(OTRotateFilesLeft);
+}
+
+//==============================================================================
+// Rotate Current Image Right
+//==============================================================================
+void MainWindow::rotateRigth()
+{
+    qDebug() << "MainWindow::rotateRigth";
+
+    // Start File Operation
+    startFileOperation(OTRotateFilesRight);
+}
+
+//==============================================================================
+// Flip Current Image Horizontally
+//==============================================================================
+void MainWindow::flipHorizontally()
+{
+    qDebug() << "MainWindow::flipHorizontally";
+
+    // Start File Operation
+    startFileOperation(OTFlipFilesHorizontally);
+}
+
+//==============================================================================
+// Flip Current Image Vertically
+//==============================================================================
+void MainWindow::flipVertically()
+{
+    qDebug() << "MainWindow::flipVertically";
+
+    // Start File Operation
+    startFileOperation(OTFlipFilesVertically);
+}
+
+//==============================================================================
+// Step To Next Image/Pair
+//==============================================================================
+void MainWindow::nextFiles()
+{
+    // Step Files
+    stepFiles(1);
+}
+
+//==============================================================================
+// Step To Previous Image/Pair
+//==============================================================================
+void MainWindow::prevFiles()
+{
+    // Step Files
+    stepFiles(-1);
+}
+
+//==============================================================================
+// Copy Current/Selected Image(s) To Directory
+//==============================================================================
+void MainWindow::copyToDirectory()
+{
+    qDebug() << "MainWindow::copyToDirectory";
+
+    // Check Worker Thread & Select Transfer Dir
+    if (!workerThread.isRunning() && selectTransferDir()) {
+        // Start File Operation
+        startFileOperation(OTCopyToFiles);
+    }
+}
+
+//==============================================================================
+// Move Current/Selected Image(s) To Directory
 //==============================================================================
-void MainWindow::rotateLeft()
+void MainWindow::moveToDirectory()
 {
-    qDebug() << "MainWindow::rotateLeft";
+    qDebug() << "MainWindow::moveToDirectory";
 
-    // Init Worker
-    initWorker();
+    // Check Worker Thread & Select Transfer Dir
+    if (!workerThread.isRunning() && selectTransferDir()) {
+        // Start File Operation
+        startFileOperation(OTMoveToFiles);
+    }
+}
 
-    // Emit Operate Worker Signal
-    emit operateWorker(OTRotateFilesLeft);
+//==============================================================================
+// Cancel Running Worker Operation
+//==============================================================================
+void MainWindow::cancelOperation()
+{
+    // Check Worker Thread
+    if (worker && workerThread.isRunning()) {
+        qDebug() << "MainWindow::cancelOperation";
+        // Cancel Worker - Running Files Are Finished, Queued Ones Skipped
+        worker->cancel();
+        // Show Status Text
+        showStatusText(tr("Cancelling..."));
+    }
 }
 
 //==============================================================================
-// Rotate Current Image Right
+// Learn Compare Mask From Selected Renders
 //==============================================================================
-void MainWindow::rotateRigth()
+void MainWindow::learnCompareMask()
 {
-    qDebug() << "MainWindow::rotateRigth";
+    qDebug() << "MainWindow::learnCompareMask";
 
-    // Init Worker
-    initWorker();
+    // Check Selected Files - Strip Selection Takes Precedence
+    if (selectedFiles.count() < 2) {
+        // Init Filter Text
+        QString filterText = QString("Image files (%1)").arg(DEFAULT_SUPPORTED_FORMATS_FILTER);
 
-    // Emit Operate Worker Signal
-    emit operateWorker(OTRotateFilesRight);
+        // Init File Dialog
+        QFileDialog fileDialog(this, tr("Select Renders"), currentDir.isEmpty() ? lastOpenPath : currentDir, filterText);
+
+        // Set File Mode
+        fileDialog.setFileMode(QFileDialog::ExistingFiles);
+
+        // Exec File Dialog
+        if (fileDialog.exec()) {
+            // Set Last Open Path
+            lastOpenPath = fileDialog.directory().absolutePath();
+            // Set Selected Files
+            setSelectedFiles(fileDialog.selectedFiles());
+        }
+    }
+
+    // Check Selected Files - Variance Needs At Least Two Renders
+    if (selectedFiles.count() < 2) {
+        // Show Status Text
+        showStatusText(tr("Select at least 2 renders of the same screen"));
+        return;
+    }
+
+    // Start File Operation
+    startFileOperation(OTLearnCompareMask);
 }
 
 //==============================================================================
-// Flip Current Image Horizontally
+// Compare Current Files At 16 Bits Per Channel
 //==============================================================================
-void MainWindow::flipHorizontally()
+void MainWindow::compareDeep()
 {
-    qDebug() << "MainWindow::flipHorizontally";
+    qDebug() << "MainWindow::compareDeep";
+
+    // Check Worker Thread
+    if (workerThread.isRunning()) {
+        // Show Status Text
+        showStatusText(tr("Another operation is in progress"));
+        return;
+    }
+
+    // Check Current Files
+    if (currentFileLeft.isEmpty() || currentFileRight.isEmpty()) {
+        // Show Status Text
+        showStatusText(tr("Deep compare needs both images"));
+        return;
+    }
+
+    // Set Operation Files - Worker Reads These, Not the Current Files
+    operationFiles = QStringList() << currentFileLeft << currentFileRight;
+    // Set Deep Compare Offset - Same Registration As the Compositor
+    deepCompareOffset = autoAlign ? QPoint(alignOffsetX, alignOffsetY) : QPoint(0, 0);
+
+    // Show Status Text
+    showStatusText(tr("Comparing at 16 bits per channel..."));
 
     // Init Worker
     initWorker();
 
     // Emit Operate Worker Signal
-    emit operateWorker(OTFlipFilesHorizontally);
+    emit operateWorker(OTCompareDeep);
 }
 
 //==============================================================================
-// Flip Current Image Vertically
+// Compare Current Files Frame By Frame
 //==============================================================================
-void MainWindow::flipVertically()
+void MainWindow::compareFrames()
 {
-    qDebug() << "MainWindow::flipVertically";
+    qDebug() << "MainWindow::compareFrames";
+
+    // Check Worker Thread
+    if (workerThread.isRunning()) {
+        // Show Status Text
+        showStatusText(tr("Another operation is in progress"));
+        return;
+    }
+
+    // Check Current Files
+    if (currentFileLeft.isEmpty() || currentFileRight.isEmpty()) {
+        // Show Status Text
+        showStatusText(tr("Frame compare needs both images"));
+        return;
+    }
+
+    // Reset Frame Sequence Files - The Worker Overwrites the Result
+    frameSequenceFiles.clear();
+
+    // Set Operation Files - Worker Reads These, Not the Current Files
+    operationFiles = QStringList() << currentFileLeft << currentFileRight;
+
+    // Show Status Text
+    showStatusText(tr("Comparing frames..."));
 
     // Init Worker
     initWorker();
 
     // Emit Operate Worker Signal
-    emit operateWorker(OTFlipFilesVertically);
+    emit operateWorker(OTCompareFrames);
 }
 
 //==============================================================================
-// Rotate Current/Selected Image(s) Left
+// Start Frame Compare For Frame Sequences, Deep Compare For High Bit Depth Files
 //==============================================================================
-void MainWindow::doRotateLeft()
+void MainWindow::checkAutoCompare()
 {
-//    // Init index
-//    int index = currentIndex ;
-
-//    // Check Popup Index
-//    if (popupIndex != -1) {
-//        qDebug() << "MainWindow::doRotateLeft - popupIndex: " << popupIndex;
+    // Check Current Files & Worker Thread
+    if (currentFileLeft.isEmpty() || currentFileRight.isEmpty() || workerThread.isRunning()) {
+        return;
+    }
 
-//        // Set Index
-//        index = popupIndex;
-//        // Reset Popup Index
-//        popupIndex = -1;
+    // Check Frame Count - The Compositor Shows One Frame At a Time
+    if (frameCount > 1) {
+        // Compare Frames
+        compareFrames();
+        return;
+    }
 
-//    } else {
-//        qDebug() << "MainWindow::doRotateLeft - currentIndex: " << currentIndex;
-//    }
+    // Check Bit Depths - Header Only, The 8 Bit View Would Hide Differences
+    if (isHighBitDepthFile(currentFileLeft) || isHighBitDepthFile(currentFileRight)) {
+        // Compare Deep
+        compareDeep();
+    }
+}
 
-//    // Rotate By Index
-//    rotateFileByIndex(index, RDTLeft);
+//==============================================================================
+// Rotate Current/Selected Image(s) Left
+//==============================================================================
+int MainWindow::doRotateLeft()
+{
+    // Transform Files
+    return worker->transformFiles(operationFiles, ITTRotateLeft);
 }
 
 //==============================================================================
 // Rotate Current/Selected Image(s) Right
 //==============================================================================
-void MainWindow::doRotateRigth()
+int MainWindow::doRotateRigth()
 {
-//    // Init index
-//    int index = currentIndex ;
-
-//    // Check Popup Index
-//    if (popupIndex != -1) {
-//        qDebug() << "MainWindow::doRotateRigth - popupIndex: " << popupIndex;
-
-//        // Set Index
-//        index = popupIndex;
-//        // Reset Popup Index
-//        popupIndex = -1;
-
-//    } else {
-//        qDebug() << "MainWindow::doRotateRigth - currentIndex: " << currentIndex;
-//    }
-
-//    // Rotate By Index
-//    rotateFileByIndex(index, RDTRight);
+    // Transform Files
+    return worker->transformFiles(operationFiles, ITTRotateRight);
 }
 
 //==============================================================================
 // Flip Current/Selected Image(s) Horizontally
 //==============================================================================
-void MainWindow::doFlipHorizontally()
+int MainWindow::doFlipHorizontally()
 {
-//    // Init index
-//    int index = currentIndex ;
-
-//    // Check Popup Index
-//    if (popupIndex != -1) {
-//        qDebug() << "MainWindow::doFlipHorizontally - popupIndex: " << popupIndex;
-
-//        // Set Index
-//        index = popupIndex;
-//        // Reset Popup Index
-//        popupIndex = -1;
-
-//    } else {
-//        qDebug() << "MainWindow::doFlipHorizontally - currentIndex: " << currentIndex;
-//    }
-
-//    // Flip By Index
-//    flipFileByIndex(index, FDTHorizontal);
+    // Transform Files
+    return worker->transformFiles(operationFiles, ITTFlipHorizontally);
 }
 
 //==============================================================================
 // Flip Current/Selected Image(s) Vertically
 //==============================================================================
-void MainWindow::doFlipVertically()
+int MainWindow::doFlipVertically()
 {
-//    // Init index
-//    int index = currentIndex ;
+    // Transform Files
+    return worker->transformFiles(operationFiles, ITTFlipVertically);
+}
 
-//    // Check Popup Index
-//    if (popupIndex != -1) {
-//        qDebug() << "MainWindow::doFlipVertically - popupIndex: " << popupIndex;
+//==============================================================================
+// Copy Current/Selected Image(s) To Directory
+//==============================================================================
+int MainWindow::doCopyToDirectory()
+{
+    // Transfer Files
+    return worker->transferFiles(operationFiles, transferDir, false);
+}
 
-//        // Set Index
-//        index = popupIndex;
-//        // Reset Popup Index
-//        popupIndex = -1;
+//==============================================================================
+// Move Current/Selected Image(s) To Directory
+//==============================================================================
+int MainWindow::doMoveToDirectory()
+{
+    // Transfer Files
+    return worker->transferFiles(operationFiles, transferDir, true);
+}
 
-//    } else {
-//        qDebug() << "MainWindow::doFlipVertically - currentIndex: " << currentIndex;
-//    }
+//==============================================================================
+// Learn Compare Mask From Selected Renders - Returns Masked Pixel Count, -1 On Failure
+//==============================================================================
+int MainWindow::doLearnCompareMask()
+{
+    // Reset Learned Renders
+    learnedRenders = 0;
 
-//    // Flip By Index
-//    flipFileByIndex(index, FDTVertical);
+    // Learn Compare Mask
+    return worker->learnCompareMask(operationFiles, learnedRenders);
 }
 
 //==============================================================================
-// Zoom In
+// Compare Current Files At 16 Bits Per Channel - Returns 1 If Different, 0 If Matching, -1 On Failure
 //==============================================================================
-void MainWindow::zoomIn()
+int MainWindow::doCompareDeep()
 {
-    // Check Center View
-    if (!ui->centerView) {
-        return;
-    }
+    // Reset Deep Compare Error
+    deepCompareError.clear();
 
-    // Check Composite Sizes
-    if (ui->centerView->getSourceCompositeWidth() <= 0.0 || ui->centerView->getSourceCompositeHeight() <= 0.0) {
-        return;
+    // Compare Files - Repeated Pairs Come From the Result Cache, Compare Mask & Align Offset Applied Like the Compositor
+    if (!compareFilesDeepCached(operationFiles[0], operationFiles[1], DEFAULT_DEEP_COMPARE_TOLERANCE, deepCompareResult, deepCompareCached, deepCompareError, deepCompareOffset)) {
+        return -1;
     }
 
-    // Check Zoom Fit
-    if (zoomFit) {
-        // Reset Zoom Fit
-        zoomFit = false;
-        // Init Zoom Level Index
-        int newZoomLevelIndex = 0;
-        // Iterate Through Zoom Levels
-        while (zoomLevels[newZoomLevelIndex] < zoomLevel && newZoomLevelIndex < DEFAULT_ZOOM_LEVEL_INDEX_MAX) {
-            // Inc Zoom Level
-            newZoomLevelIndex++;
-        }
+    return deepCompareResult.stats.differingPixels > 0 ? 1 : 0;
+}
 
-        // Set Zoom Level Index
-        setZoomLevelIndex(newZoomLevelIndex);
-    } else {
-        // Check Zoom Level Index
-        if (zoomLevelIndex < DEFAULT_ZOOM_LEVEL_INDEX_MAX) {
-            //qDebug() << "MainWindow::zoomIn";
+//==============================================================================
+// Compare Current Files Frame By Frame - Returns 1 If Different, 0 If Matching, -1 On Failure
+//==============================================================================
+int MainWindow::doCompareFrames()
+{
+    // Reset Frame Compare Error
+    frameCompareError.clear();
 
-            // Set Zoom Level Index
-            setZoomLevelIndex(zoomLevelIndex + 1);
-        }
+    // Compare Frame Sequences
+    if (!compareFrameSequences(operationFiles[0], operationFiles[1], DEFAULT_FRAME_TIMING_TOLERANCE, frameSequenceResult, frameCompareError)) {
+        return -1;
     }
 
-    // Configure Menu
-    updateMenu();
+    return frameSequenceResult.matches() ? 0 : 1;
+}
+
+//==============================================================================
+// Zoom In
+//==============================================================================
+void MainWindow::zoomIn()
+{
+    // Zoom By One Step
+    zoomBySteps(1);
 }
 
 //==============================================================================
 // Zoom Out
 //==============================================================================
 void MainWindow::zoomOut()
+{
+    // Zoom By One Step
+    zoomBySteps(-1);
+}
+
+//==============================================================================
+// Zoom By Steps - Net Wheel Steps Applied As One Zoom Level Change
+//==============================================================================
+void MainWindow::zoomBySteps(const int& aSteps)
 {
     // Check Center View
-    if (!ui->centerView) {
+    if (!ui->centerView || aSteps == 0) {
         return;
     }
 
@@ -1026,30 +1956,45 @@ void MainWindow::zoomOut()
         return;
     }
 
-    // Check Zoom Fit
+    // Init Zoom Level Index
+    int newZoomLevelIndex = zoomLevelIndex;
+    // Init Remaining Steps
+    int steps = aSteps;
+
+    // Check Zoom Fit - First Step Snaps To the Nearest Zoom Level
     if (zoomFit) {
-        // reset Zoom Fit
+        // Reset Zoom Fit
         zoomFit = false;
-        // Reset Zoom Level Index
-        int newZoomLevelIndex = DEFAULT_ZOOM_LEVEL_INDEX_MAX;
-        // Iterate Through Zoom Levels
-        while (zoomLevels[newZoomLevelIndex] > zoomLevel && newZoomLevelIndex > 0) {
-            // Dec Zoom Level Index
-            newZoomLevelIndex--;
-        }
 
-        // Set Zoom Level Index
-        setZoomLevelIndex(newZoomLevelIndex);
-    } else {
-        // Check Zoom Level Index
-        if (zoomLevelIndex > 0) {
-            //qDebug() << "MainWindow::zoomOut";
+        // Check Direction
+        if (steps > 0) {
+            // Init Zoom Level Index
+            newZoomLevelIndex = 0;
+            // Iterate Through Zoom Levels
+            while (zoomLevels[newZoomLevelIndex] < zoomLevel && newZoomLevelIndex < DEFAULT_ZOOM_LEVEL_INDEX_MAX) {
+                // Inc Zoom Level
+                newZoomLevelIndex++;
+            }
+
+            // Dec Remaining Steps
+            steps--;
+        } else {
+            // Reset Zoom Level Index
+            newZoomLevelIndex = DEFAULT_ZOOM_LEVEL_INDEX_MAX;
+            // Iterate Through Zoom Levels
+            while (zoomLevels[newZoomLevelIndex] > zoomLevel && newZoomLevelIndex > 0) {
+                // Dec Zoom Level Index
+                newZoomLevelIndex--;
+            }
 
-            // Set Zoom Level Index
-            setZoomLevelIndex(zoomLevelIndex - 1);
+            // Inc Remaining Steps
+            steps++;
         }
     }
 
+    // Set Zoom Level Index - Clamped To the Zoom Levels
+    setZoomLevelIndex(qBound(0, newZoomLevelIndex + steps, DEFAULT_ZOOM_LEVEL_INDEX_MAX));
+
     // Configure Menu
     updateMenu();
 }
@@ -1395,11 +2340,19 @@ void MainWindow::stopWorkerThread()
 {
     if (workerThread.isRunning()) {
         qDebug() << "MainWindow::stopWorkerThread";
-        // Terminate
-        workerThread.terminate();
-        // Wait
-        //workerThread.wait();
+        // Cancel Worker - Files Being Written Are Finished, Queued Ones Skipped
+        worker->cancel();
+        // Quit
+        workerThread.quit();
+        // Wait - Keep Serving Blocking Calls From the Worker, Like Transfer Confirmations
+        while (!workerThread.wait(DEFAULT_TRANSFER_PROGRESS_INTERVAL)) {
+            // Process Events
+            QCoreApplication::processEvents(QEventLoop::ExcludeUserInputEvents);
+        }
     }
+
+    // Disable Cancel Operation Action
+    ui->actionCancel_Operation->setEnabled(false);
 }
 
 //==============================================================================
@@ -1412,8 +2365,168 @@ void MainWindow::workerResultReady(const int& aOperation, const int& aResult)
     // Quit
     workerThread.quit();
 
+    // Disable Cancel Operation Action
+    ui->actionCancel_Operation->setEnabled(false);
+
     // Switch Operation
     switch (aOperation) {
+        case OTRotateFilesLeft:
+        case OTRotateFilesRight:
+        case OTFlipFilesHorizontally:
+        case OTFlipFilesVertically: {
+            // Show Status Text
+            showStatusText(aResult > 0 ? tr("Transformed %1 files, %2 failed").arg(operationFiles.count() - aResult).arg(aResult)
+                                       : tr("Transformed %1 files").arg(operationFiles.count()));
+
+            // Clear Operation Files
+            operationFiles.clear();
+
+            // Inc File Revision
+            fileRevision++;
+            // Emit File Revision Changed Signal
+            emit fileRevisionChanged(fileRevision);
+        } break;
+
+        case OTCopyToFiles:
+        case OTMoveToFiles: {
+            // Show Status Text
+            showStatusText(aResult > 0 ? tr("Transferred %1 files, %2 failed").arg(operationFiles.count() - aResult).arg(aResult)
+                                       : tr("Transferred %1 files to %2").arg(operationFiles.count()).arg(transferDir));
+
+            // Clear Dir Listings - Target & Source Dirs Changed
+            dirListings.clear();
+
+            // Check Operation
+            if (aOperation == OTMoveToFiles) {
+                // Get Moved Left File
+                QString movedLeft = QDir(transferDir).filePath(QFileInfo(currentFileLeft).fileName());
+                // Get Moved Right File
+                QString movedRight = QDir(transferDir).filePath(QFileInfo(currentFileRight).fileName());
+
+                // Check Current File Left Moved
+                if (operationFiles.contains(currentFileLeft) && !QFile::exists(currentFileLeft) && QFile::exists(movedLeft)) {
+                    // Follow Moved File
+                    setCurrentFileLeft(movedLeft);
+                }
+
+                // Check Current File Right Moved
+                if (operationFiles.contains(currentFileRight) && !QFile::exists(currentFileRight) && QFile::exists(movedRight)) {
+                    // Follow Moved File
+                    setCurrentFileRight(movedRight);
+                }
+
+                // Init Remaining Selected Files
+                QStringList remainingFiles;
+
+                // Go Thru Selected Files
+                for (int i = 0; i < selectedFiles.count(); i++) {
+                    // Check Selected File Still In Place - Failed & Skipped Moves Stay Selected
+                    if (QFile::exists(selectedFiles[i])) {
+                        // Keep Selected File
+                        remainingFiles << selectedFiles[i];
+                    }
+                }
+
+                // Set Selected Files
+                setSelectedFiles(remainingFiles);
+            }
+
+            // Clear Operation Files
+            operationFiles.clear();
+        } break;
+
+        case OTCompareDeep: {
+            // Check Result
+            if (aResult < 0) {
+                // Show Status Text
+                showStatusText(tr("Deep compare failed: %1").arg(deepCompareError));
+            } else {
+                // Show Status Text
+                showStatusText(tr("Deep compare (%1/%2 bit): %3 of %4 pixels differ in %5 regions, max %6, mean %7%8")
+                               .arg(deepCompareResult.stats.leftDepth)
+                               .arg(deepCompareResult.stats.rightDepth)
+                               .arg(deepCompareResult.stats.differingPixels)
+                               .arg(deepCompareResult.stats.pixels)
+                               .arg(deepCompareResult.regions.count())
+                               .arg(deepCompareResult.stats.maxDifference)
+                               .arg(deepCompareResult.stats.meanDifference(), 0, 'f', 3)
+                               .arg(deepCompareCached ? tr(" (cached)") : QString()));
+            }
+
+            // Clear Operation Files
+            operationFiles.clear();
+        } break;
+
+        case OTCompareFrames: {
+            // Check Result
+            if (aResult < 0) {
+                // Show Status Text
+                showStatusText(tr("Frame compare failed: %1").arg(frameCompareError));
+            } else {
+                // Set Frame Sequence Files
+                frameSequenceFiles = operationFiles;
+
+                // Go Thru Frames
+                for (int i = 0; i < frameSequenceResult.frames.count(); i++) {
+                    // Get Frame Statistics
+                    const FrameCompareStats& stats = frameSequenceResult.frames[i];
+                    qDebug() << "MainWindow::workerResultReady - frame: " << stats.frame << " - differing: " << stats.differingPixels << "/" << stats.pixels
+                             << " - max: " << stats.maxDifference << " - delay: " << stats.leftDelay << "/" << stats.rightDelay;
+                }
+
+                // Get First Changed Frame - Pixels First, Timing Otherwise
+                int firstFrame = frameSequenceResult.firstDifferingFrame >= 0 ? frameSequenceResult.firstDifferingFrame : frameSequenceResult.firstTimingFrame;
+
+                // Check First Changed Frame & Current Files - Scrub To It
+                if (firstFrame >= 0 && frameSequenceFiles == (QStringList() << currentFileLeft << currentFileRight)) {
+                    // Set Current Frame
+                    setCurrentFrame(firstFrame);
+                }
+
+                // Show Status Text
+                showStatusText(aResult == 0 ? tr("Frames match: %1 frames").arg(frameSequenceResult.leftFrames)
+                                            : tr("Frames differ: %1/%2 frames, %3 differ from frame %4, %5 with different timing")
+                                              .arg(frameSequenceResult.leftFrames)
+                                              .arg(frameSequenceResult.rightFrames)
+                                              .arg(frameSequenceResult.differingFrames)
+                                              .arg(frameSequenceResult.firstDifferingFrame + 1)
+                                              .arg(frameSequenceResult.timingFrames));
+            }
+
+            // Clear Operation Files
+            operationFiles.clear();
+        } break;
+
+        case OTLearnCompareMask: {
+            // Show Status Text
+            showStatusText(aResult < 0 ? tr("Learning compare mask failed")
+                                       : tr("Learned compare mask from %1 renders, %2 pixels ignored").arg(learnedRenders).arg(aResult));
+
+            // Clear Operation Files
+            operationFiles.clear();
+
+            // Check Result
+            if (aResult >= 0) {
+                // Clear Compare Masks - Sidecar Changed
+                clearCompareMasks();
+
+                // Get Compare Mask File
+                QString newCompareMaskFile = ::compareMaskFile(currentFileLeft);
+
+                // Check Compare Mask File
+                if (compareMaskFile != newCompareMaskFile) {
+                    // Set Compare Mask File
+                    compareMaskFile = newCompareMaskFile;
+                    // Emit Compare Mask File Changed Signal
+                    emit compareMaskFileChanged(compareMaskFile);
+                }
+
+                // Inc File Revision - Compositor & Compare View Reload the Mask
+                fileRevision++;
+                // Emit File Revision Changed Signal
+                emit fileRevisionChanged(fileRevision);
+            }
+        } break;
 
         default:
 
@@ -1423,6 +2536,68 @@ void MainWindow::workerResultReady(const int& aOperation, const int& aResult)
     // ...
 }
 
+//==============================================================================
+// Worker Progress Changed Slot
+//==============================================================================
+void MainWindow::workerProgressChanged(const int& aDone, const int& aTotal)
+{
+    // Show Status Text
+    showStatusText(tr("Processing %1/%2").arg(aDone).arg(aTotal));
+}
+
+//==============================================================================
+// Worker Transfer Progress Changed Slot
+//==============================================================================
+void MainWindow::workerTransferProgressChanged(const qint64& aBytesDone, const qint64& aBytesTotal, const qint64& aBytesPerSecond, const int& aSecondsRemaining)
+{
+    // Check Seconds Remaining
+    if (aSecondsRemaining < 0) {
+        // Show Status Text
+        showStatusText(tr("Transferring %1 of %2").arg(formatSize(aBytesDone)).arg(formatSize(aBytesTotal)));
+    } else {
+        // Show Status Text
+        showStatusText(tr("Transferring %1 of %2 - %3/s - %4 s remaining").arg(formatSize(aBytesDone))
+                                                                            .arg(formatSize(aBytesTotal))
+                                                                            .arg(formatSize(aBytesPerSecond))
+                                                                            .arg(aSecondsRemaining));
+    }
+}
+
+//==============================================================================
+// Confirm Transfer Overwrite - Returns Clicked Button
+//==============================================================================
+int MainWindow::confirmTransferOverwrite(const QString& aTargetPath)
+{
+    // Check Worker Cancelled - We May Be Waiting For the Worker Thread To Stop
+    if (!worker || worker->isCancelled()) {
+        return QDialogButtonBox::No;
+    }
+
+    // Init Confirmation Dialog
+    ConfirmationDialog confirmDialog(this);
+    // Set Confirmation Text
+    confirmDialog.setConfirmationText(tr("%1 already exists.\nOverwrite?").arg(aTargetPath));
+    // Set Buttons
+    confirmDialog.setStandardButtons(QDialogButtonBox::Yes | QDialogButtonBox::YesToAll | QDialogButtonBox::No | QDialogButtonBox::NoToAll);
+
+    // Exec Dialog
+    confirmDialog.exec();
+
+    // Get Clicked Button
+    int button = confirmDialog.getClickedButton();
+
+    // Check Yes To All
+    if (button == QDialogButtonBox::YesToAll) {
+        // Set Transfer Options
+        transferOptions |= DEFAULT_TRANSFER_OPTIONS_YES_TO_ALL;
+    } else if (button == QDialogButtonBox::NoToAll) {
+        // Set Transfer Options
+        transferOptions |= DEFAULT_TRANSFER_OPTIONS_NO_TO_ALL;
+    }
+
+    return button;
+}
+
 //==============================================================================
 // View Window Closed Slot
 //==============================================================================
@@ -1475,11 +2650,17 @@ void MainWindow::panMove(const QPoint& aPos)
 {
     //qDebug() << "MainWindow::panMove - aPos: " << aPos;
 
-    // Set Pan Pos X
-    setPanPosX(boundedPanPosX(aPos.x() - panPressX + panPosLastX));
+    // Set Pending Pan Pos X - Only the Latest Position Per Frame Is Applied
+    pendingPanPosX = boundedPanPosX(aPos.x() - panPressX + panPosLastX);
+
+    // Set Pending Pan Pos Y
+    pendingPanPosY = boundedPanPosY(aPos.y() - panPressY + panPosLastY);
 
-    // Set Pan Pos Y
-    setPanPosY(boundedPanPosY(aPos.y() - panPressY + panPosLastY));
+    // Set Pan Update Pending
+    panUpdatePending = true;
+
+    // Request Frame
+    requestInputFrame();
 
     // ...
 }
@@ -1492,6 +2673,12 @@ void MainWindow::panFinished(const QPoint& aPos)
     Q_UNUSED(aPos);
     //qDebug() << "MainWindow::panFinished - aPos: " << aPos;
 
+    // Check Pan Update Pending
+    if (panUpdatePending) {
+        // Apply Last Pending Pan Position
+        frameSwapped();
+    }
+
     // Reset Manual Panning
     setManualPanning(false);
 
@@ -1605,6 +2792,60 @@ void MainWindow::on_actionFlip_Vertically_triggered()
     flipVertically();
 }
 
+//==============================================================================
+// Action Copy To Directory Triggered
+//==============================================================================
+void MainWindow::on_actionCopy_To_Directory_triggered()
+{
+    // Copy To Directory
+    copyToDirectory();
+}
+
+//==============================================================================
+// Action Move To Directory Triggered
+//==============================================================================
+void MainWindow::on_actionMove_To_Directory_triggered()
+{
+    // Move To Directory
+    moveToDirectory();
+}
+
+//==============================================================================
+// Action Cancel Operation Triggered
+//==============================================================================
+void MainWindow::on_actionCancel_Operation_triggered()
+{
+    // Cancel Operation
+    cancelOperation();
+}
+
+//==============================================================================
+// Action Learn Compare Mask Triggered Slot
+//==============================================================================
+void MainWindow::on_actionLearn_Compare_Mask_triggered()
+{
+    // Learn Compare Mask
+    learnCompareMask();
+}
+
+//==============================================================================
+// Action Deep Compare Triggered Slot
+//==============================================================================
+void MainWindow::on_actionDeep_Compare_triggered()
+{
+    // Compare Deep
+    compareDeep();
+}
+
+//==============================================================================
+// Action Compare Frames Triggered Slot
+//==============================================================================
+void MainWindow::on_actionCompare_Frames_triggered()
+{
+    // Compare Frames
+    compareFrames();
+}
+
 //==============================================================================
 // Reset Zoom & Panning Pos Button Clicked Slot
 //==============================================================================
@@ -1809,6 +3050,26 @@ void MainWindow::keyReleaseEvent(QKeyEvent* aEvent)
                 QApplication::exit();
             break;
 
+            case Qt::Key_A:
+                // Toggle Auto Align
+                setAutoAlign(!autoAlign);
+            break;
+
+            case Qt::Key_N:
+                // Cycle Alpha Modes
+                setAlphaMode((getAlphaMode() + 1) % (AMTIgnore + 1));
+            break;
+
+            case Qt::Key_Comma:
+                // Previous Frame
+                setCurrentFrame(currentFrame - 1);
+            break;
+
+            case Qt::Key_Period:
+                // Next Frame
+                setCurrentFrame(currentFrame + 1);
+            break;
+
             case Qt::Key_G:
                 // Toggle Show Grid
                 setShowGrid(!showGrid);
@@ -1833,6 +3094,16 @@ void MainWindow::keyReleaseEvent(QKeyEvent* aEvent)
                 setHideSources(!hideSources);
             break;
 
+            case Qt::Key_PageDown:
+                // Step To Next Image/Pair
+                nextFiles();
+            break;
+
+            case Qt::Key_PageUp:
+                // Step To Previous Image/Pair
+                prevFiles();
+            break;
+
             default:
             break;
         }
@@ -1851,6 +3122,21 @@ void MainWindow::timerEvent(QTimerEvent* aEvent)
 {
     // Check Event
     if (aEvent) {
+        // Check Watch Timer
+        if (aEvent->timerId() == watchTimerID) {
+            // Kill Timer
+            killTimer(watchTimerID);
+            // Reset Watch Timer ID
+            watchTimerID = -1;
+            // Check Watched Files
+            checkWatchedFiles();
+        }
+
+        // Check Input Frame Fallback Timer - No Frame Swapped Came
+        if (aEvent->timerId() == inputFrameTimerID) {
+            // Apply Coalesced Input - Kills the Timer
+            frameSwapped();
+        }
 
         // ...
 
@@ -1875,31 +3161,43 @@ void MainWindow::wheelEvent(QWheelEvent* aEvent)
         if (keyModifiers & modifier) {
             // Check Angle Delta Y
             if (aEvent->angleDelta().y() > 0) {
-                // Zoom In
-                zoomIn();
+                // Inc Pending Zoom Steps
+                pendingZoomSteps++;
             } else if (aEvent->angleDelta().y() < 0) {
-                // Zoom Out
-                zoomOut();
+                // Dec Pending Zoom Steps
+                pendingZoomSteps--;
             }
         } else {
+            // Check Pan Update Pending
+            if (!panUpdatePending) {
+                // Init Pending Pan Positions
+                pendingPanPosX = panPosX;
+                pendingPanPosY = panPosY;
+                // Set Pan Update Pending
+                panUpdatePending = true;
+            }
+
             // Check Angle Delta Y
             if (aEvent->angleDelta().y() > 0) {
-                // Set Pan Pos Y
-                setPanPosY(panPosY + DEFAULT_MOUSE_WHEEL_PAN_STEP);
+                // Inc Pending Pan Pos Y
+                pendingPanPosY += DEFAULT_MOUSE_WHEEL_PAN_STEP;
             } else if (aEvent->angleDelta().y() < 0) {
-                // Set Pan Pos Y
-                setPanPosY(panPosY - DEFAULT_MOUSE_WHEEL_PAN_STEP);
+                // Dec Pending Pan Pos Y
+                pendingPanPosY -= DEFAULT_MOUSE_WHEEL_PAN_STEP;
             }
 
             // Check Angle Delta X
             if (aEvent->angleDelta().x() > 0) {
-                // Set Pan Pos X
-                setPanPosX(panPosX + DEFAULT_MOUSE_WHEEL_PAN_STEP);
+                // Inc Pending Pan Pos X
+                pendingPanPosX += DEFAULT_MOUSE_WHEEL_PAN_STEP;
             } else if (aEvent->angleDelta().x() < 0) {
-                // Set Pan Pos X
-                setPanPosX(panPosX - DEFAULT_MOUSE_WHEEL_PAN_STEP);
+                // Dec Pending Pan Pos X
+                pendingPanPosX -= DEFAULT_MOUSE_WHEEL_PAN_STEP;
             }
         }
+
+        // Request Frame
+        requestInputFrame();
     }
 }
 
@@ -1923,11 +3221,14 @@ MainWindow::~MainWindow()
     // Delete Right View To Avoid Crash
     delete ui->rightView;
 
+    // Delete Thumbnail View To Avoid Crash
+    delete ui->thumbnailView;
+
     // Delete UI
     delete ui;
 
-    // Reset File System Model
-    fsModel = NULL;
+    // Reset Directory Model - Owned By the Window
+    dirModel = NULL;
 
     // Check About Dialog
     if (aboutDialog) {
@@ -2,17 +2,22 @@
 #define MAINWINDOW_H
 
 #include <QMainWindow>
-#include <QFileSystemModel>
+#include <QFileSystemWatcher>
 #include <QModelIndex>
 #include <QString>
+#include <QStringList>
 #include <QSettings>
 #include <QThread>
 #include <QTimerEvent>
 #include <QMultiMap>
+#include <QHash>
 #include <QKeyEvent>
 #include <QWheelEvent>
 
 #include "constants.h"
+#include "deepcompare.h"
+#include "framecompare.h"
+#include "resultcache.h"
 
 namespace Ui {
 class MainWindow;
@@ -25,6 +30,7 @@ class RenameFileDialog;
 class InfoDialog;
 class CompareDialog;
 class Worker;
+class DirectoryModel;
 
 //==============================================================================
 // Main Window
@@ -55,6 +61,21 @@ class MainWindow : public QMainWindow
 
     Q_PROPERTY(bool showGrid READ getShowGrid WRITE setShowGrid NOTIFY showGridChanged)
 
+    Q_PROPERTY(bool autoAlign READ getAutoAlign WRITE setAutoAlign NOTIFY autoAlignChanged)
+    Q_PROPERTY(int alignOffsetX READ getAlignOffsetX WRITE setAlignOffsetX NOTIFY alignOffsetXChanged)
+    Q_PROPERTY(int alignOffsetY READ getAlignOffsetY WRITE setAlignOffsetY NOTIFY alignOffsetYChanged)
+
+    Q_PROPERTY(QString compareMaskFile READ getCompareMaskFile NOTIFY compareMaskFileChanged)
+
+    Q_PROPERTY(int alphaMode READ getAlphaMode WRITE setAlphaMode NOTIFY alphaModeChanged)
+
+    Q_PROPERTY(int currentFrame READ getCurrentFrame WRITE setCurrentFrame NOTIFY currentFrameChanged)
+    Q_PROPERTY(int frameCount READ getFrameCount NOTIFY frameCountChanged)
+
+    Q_PROPERTY(QStringList selectedFiles READ getSelectedFiles WRITE setSelectedFiles NOTIFY selectedFilesChanged)
+
+    Q_PROPERTY(int fileRevision READ getFileRevision NOTIFY fileRevisionChanged)
+
 public:
 
     // Static Constructor
@@ -120,6 +141,45 @@ public:
     // Set Show Grid
     void setShowGrid(const bool& aShowGrid);
 
+    // Get Auto Align
+    bool getAutoAlign();
+    // Set Auto Align
+    void setAutoAlign(const bool& aAutoAlign);
+
+    // Get Align Offset X
+    int getAlignOffsetX();
+    // Set Align Offset X
+    void setAlignOffsetX(const int& aAlignOffsetX);
+
+    // Get Align Offset Y
+    int getAlignOffsetY();
+    // Set Align Offset Y
+    void setAlignOffsetY(const int& aAlignOffsetY);
+
+    // Get Compare Mask File of the Left Image
+    QString getCompareMaskFile();
+
+    // Get Alpha Mode
+    int getAlphaMode();
+    // Set Alpha Mode - Images Are Normalized Again
+    void setAlphaMode(const int& aAlphaMode);
+
+    // Get Current Frame
+    int getCurrentFrame();
+    // Set Current Frame
+    void setCurrentFrame(const int& aCurrentFrame);
+
+    // Get Frame Count - Longest of the Current Files
+    int getFrameCount();
+
+    // Get Selected Files
+    QStringList getSelectedFiles();
+    // Set Selected Files
+    void setSelectedFiles(const QStringList& aSelectedFiles);
+
+    // Get File Revision
+    int getFileRevision();
+
 protected:
 
     // Constructor
@@ -170,6 +230,28 @@ public slots:
     // Flip Current/Selected Image(s) Vertically
     void flipVertically();
 
+    // Step To Next Image/Pair
+    void nextFiles();
+    // Step To Previous Image/Pair
+    void prevFiles();
+
+    // Copy Current/Selected Image(s) To Directory
+    void copyToDirectory();
+    // Move Current/Selected Image(s) To Directory
+    void moveToDirectory();
+
+    // Cancel Running Worker Operation
+    void cancelOperation();
+
+    // Learn Compare Mask From Selected Renders
+    void learnCompareMask();
+
+    // Compare Current Files At 16 Bits Per Channel
+    void compareDeep();
+
+    // Compare Current Files Frame By Frame
+    void compareFrames();
+
     // Stop Worker
     void stopWorkerThread();
 
@@ -221,6 +303,30 @@ signals:
     // Show Grid Changed Signal
     void showGridChanged(const bool& aShowGrid);
 
+    // Auto Align Changed Signal
+    void autoAlignChanged(const bool& aAutoAlign);
+    // Align Offset X Changed Signal
+    void alignOffsetXChanged(const int& aAlignOffsetX);
+    // Align Offset Y Changed Signal
+    void alignOffsetYChanged(const int& aAlignOffsetY);
+
+    // Compare Mask File Changed Signal
+    void compareMaskFileChanged(const QString& aCompareMaskFile);
+
+    // Alpha Mode Changed Signal
+    void alphaModeChanged(const int& aAlphaMode);
+
+    // Current Frame Changed Signal
+    void currentFrameChanged(const int& aCurrentFrame);
+    // Frame Count Changed Signal
+    void frameCountChanged(const int& aFrameCount);
+
+    // Selected Files Changed Signal
+    void selectedFilesChanged(const QStringList& aSelectedFiles);
+
+    // File Revision Changed Signal
+    void fileRevisionChanged(const int& aFileRevision);
+
     // Current File Updated Signal
     void currentFileUdated();
 
@@ -242,6 +348,13 @@ private slots:
 
     // Worker Result Ready Slot
     void workerResultReady(const int& aOperation, const int& aResult);
+    // Worker Progress Changed Slot
+    void workerProgressChanged(const int& aDone, const int& aTotal);
+    // Worker Transfer Progress Changed Slot
+    void workerTransferProgressChanged(const qint64& aBytesDone, const qint64& aBytesTotal, const qint64& aBytesPerSecond, const int& aSecondsRemaining);
+
+    // Confirm Transfer Overwrite - Returns Clicked Button
+    int confirmTransferOverwrite(const QString& aTargetPath);
 
     // View Window Closed Slot
     void viewerWindowClosed();
@@ -259,6 +372,15 @@ private slots:
     // Set Manual Panning
     void setManualPanning(const bool& aManualPanning);
 
+    // Watched File Changed Slot - Restarts the Debounce Timer
+    void watchedFileChanged(const QString& aFilePath);
+
+    // Dir Files Changed Slot - Drops the Stale Dir Listing
+    void dirFilesChanged();
+
+    // Frame Swapped Slot - Applies Coalesced Pan & Zoom Input
+    void frameSwapped();
+
     // Compositor Double Clicked Slot
     void compositorDoubleClicked();
     // Side Viev Double Clicked Slot
@@ -300,6 +422,18 @@ private slots:
     void on_actionFlip_Horizontally_triggered();
     // Action Flip Vertically Triggered Slot
     void on_actionFlip_Vertically_triggered();
+    // Action Copy To Directory Triggered Slot
+    void on_actionCopy_To_Directory_triggered();
+    // Action Move To Directory Triggered Slot
+    void on_actionMove_To_Directory_triggered();
+    // Action Cancel Operation Triggered Slot
+    void on_actionCancel_Operation_triggered();
+    // Action Learn Compare Mask Triggered Slot
+    void on_actionLearn_Compare_Mask_triggered();
+    // Action Deep Compare Triggered Slot
+    void on_actionDeep_Compare_triggered();
+    // Action Compare Frames Triggered Slot
+    void on_actionCompare_Frames_triggered();
     // Action Quit Triggered Slot
     void on_actionQuit_triggered();
     // Reset Zoom & Panning Pos Button Clicked Slot
@@ -346,17 +480,64 @@ private:
     // Init Worker
     void initWorker();
 
+    // Start File Operation On Selected/Current Files
+    void startFileOperation(const int& aOperation);
+
+    // Select Transfer Dir
+    bool selectTransferDir();
+
+    // Get Image Files of Dir In Directory Order
+    QStringList dirImageFiles(const QString& aDirPath);
+    // Get Right File Paired With Left File
+    QString pairedFile(const QString& aLeftFile, const QString& aRightDir, const QStringList& aRightFiles, const int& aRightIndex);
+    // Step Files
+    void stepFiles(const int& aDirection);
+    // Prefetch Neighbouring Images/Pairs
+    void prefetchNeighbours();
+
+    // Update File Watcher - Watches the Current Files
+    void updateFileWatcher();
+    // Check Watched Files - Reloads Them Once Writes Settled
+    void checkWatchedFiles();
+
+    // Request Frame For Coalesced Input - Next Frame Swap Or the Fallback Timer, Whichever Comes First
+    void requestInputFrame();
+    // Zoom By Steps - Net Wheel Steps Applied As One Zoom Level Change
+    void zoomBySteps(const int& aSteps);
+
     // Save Settings
     void saveSettings();
 
-    // Rotate Current/Selected Image(s) Left
-    void doRotateLeft();
-    // Rotate Current/Selected Image(s) Right
-    void doRotateRigth();
-    // Flip Current/Selected Image(s) Horizontally
-    void doFlipHorizontally();
-    // Flip Current/Selected Image(s) Vertically
-    void doFlipVertically();
+    // Rotate Current/Selected Image(s) Left - Returns Failed Count
+    int doRotateLeft();
+    // Rotate Current/Selected Image(s) Right - Returns Failed Count
+    int doRotateRigth();
+    // Flip Current/Selected Image(s) Horizontally - Returns Failed Count
+    int doFlipHorizontally();
+    // Flip Current/Selected Image(s) Vertically - Returns Failed Count
+    int doFlipVertically();
+
+    // Copy Current/Selected Image(s) To Directory - Returns Failed Count
+    int doCopyToDirectory();
+    // Move Current/Selected Image(s) To Directory - Returns Failed Count
+    int doMoveToDirectory();
+
+    // Learn Compare Mask From Selected Renders - Returns Masked Pixel Count, -1 On Failure
+    int doLearnCompareMask();
+
+    // Compare Current Files At 16 Bits Per Channel - Returns 1 If Different, 0 If Matching, -1 On Failure
+    int doCompareDeep();
+
+    // Compare Current Files Frame By Frame - Returns 1 If Different, 0 If Matching, -1 On Failure
+    int doCompareFrames();
+
+    // Start Frame Compare For Frame Sequences, Deep Compare For High Bit Depth Files
+    void checkAutoCompare();
+
+    // Update Frame Count
+    void updateFrameCount();
+    // Show Current Frame Status
+    void showFrameStatus();
 
 protected:
 
@@ -375,8 +556,8 @@ private:
 
     // UI
     Ui::MainWindow*                 ui;
-    // File System Model
-    QFileSystemModel*               fsModel;
+    // Directory Model of the Current Dir
+    DirectoryModel*                 dirModel;
 
     // Current Dir
     QString                         currentDir;
@@ -425,6 +606,17 @@ private:
     // Manual Panning
     bool                            manualPanning;
 
+    // Pan Update Pending Until Next Frame
+    bool                            panUpdatePending;
+    // Pending Pan Pos X
+    qreal                           pendingPanPosX;
+    // Pending Pan Pos Y
+    qreal                           pendingPanPosY;
+    // Pending Zoom Steps
+    int                             pendingZoomSteps;
+    // Input Frame Fallback Timer ID
+    int                             inputFrameTimerID;
+
     // Composite Width
     qreal                           compositeWidth;
     // Composite Height
@@ -441,6 +633,38 @@ private:
     // Show Grid
     bool                            showGrid;
 
+    // Auto Align
+    bool                            autoAlign;
+    // Align Offset X - Estimated By the Compositor
+    int                             alignOffsetX;
+    // Align Offset Y - Estimated By the Compositor
+    int                             alignOffsetY;
+
+    // Compare Mask File of the Left Image
+    QString                         compareMaskFile;
+
+    // Deep Compare Result
+    CachedCompareResult             deepCompareResult;
+    // Deep Compare Result Came From the Result Cache
+    bool                            deepCompareCached;
+    // Deep Compare Error
+    QString                         deepCompareError;
+    // Deep Compare Align Offset - Taken When the Compare Starts
+    QPoint                          deepCompareOffset;
+
+    // Current Frame
+    int                             currentFrame;
+    // Frame Count
+    int                             frameCount;
+    // Frame Sequence Compare Result
+    FrameSequenceResult             frameSequenceResult;
+    // Files the Frame Sequence Result Belongs To
+    QStringList                     frameSequenceFiles;
+    // Frame Compare Error
+    QString                         frameCompareError;
+    // Renders Used By the Last Learned Compare Mask
+    int                             learnedRenders;
+
     // Viewer Window
     ViewerWindow*                   viewerWindow;
     // About Form
@@ -457,6 +681,32 @@ private:
     // Selected Transfer Dir
     QString                         transferDir;
 
+    // Selected Files
+    QStringList                     selectedFiles;
+    // Files of the Running Operation
+    QStringList                     operationFiles;
+
+    // File Revision - Bumped When Files Are Modified
+    int                             fileRevision;
+
+    // Watch Current Files
+    bool                            watchFiles;
+    // File Watcher
+    QFileSystemWatcher              fileWatcher;
+    // Watch Debounce Timer ID
+    int                             watchTimerID;
+    // Watch Checks Since the Last Change Signal
+    int                             watchChecks;
+    // Stamps of Watched Files When Last Loaded
+    QHash<QString, QString>         watchStamps;
+    // Stamps of Watched Files When Last Checked
+    QHash<QString, QString>         watchCheckStamps;
+
+    // Last Step Direction
+    int                             stepDirection;
+    // Dir Listings
+    QHash<QString, QStringList>     dirListings;
+
     // File Operation Worker
     Worker*                         worker;
 
@@ -0,0 +1,200 @@
+#include <QDebug>
+#include <QFile>
+#include <QFileInfo>
+
+#include <ctype.h>
+
+#include "mappedimage.h"
+#include "sharedimage.h"
+#include "constants.h"
+
+
+//==============================================================================
+// Unmap Image File - Called By QImage When the Last Copy Is Destroyed
+//==============================================================================
+static void unmapImageFile(void* aInfo)
+{
+    // Delete File - Unmaps & Closes It
+    delete (QFile*)aInfo;
+}
+
+//==============================================================================
+// Read Netpbm Header Token - Skips Whitespace & Comments
+//==============================================================================
+static QByteArray netpbmToken(const uchar* aData, const qint64& aSize, qint64& aPosition)
+{
+    // Skip Whitespace & Comments
+    while (aPosition < aSize && (isspace(aData[aPosition]) || aData[aPosition] == '#')) {
+        // Check Comment
+        if (aData[aPosition] == '#') {
+            // Skip To End of Line
+            while (aPosition < aSize && aData[aPosition] != '\n') {
+                aPosition++;
+            }
+        } else {
+            aPosition++;
+        }
+    }
+
+    // Get Token Start
+    qint64 start = aPosition;
+
+    // Go Thru Token - Headers Are Short, Give Up On Runaway Tokens
+    while (aPosition < aSize && !isspace(aData[aPosition]) && aPosition - start < DEFAULT_MAPPED_IMAGE_MAX_TOKEN) {
+        aPosition++;
+    }
+
+    return QByteArray((const char*)aData + start, aPosition - start);
+}
+
+//==============================================================================
+// Parse Netpbm Header - Returns Pixel Data Offset, 0 If Not a Mappable Netpbm Image
+//==============================================================================
+static qint64 parseNetpbmHeader(const uchar* aData, const qint64& aSize, int& aWidth, int& aHeight, QImage::Format& aFormat)
+{
+    // Init Position
+    qint64 position = 0;
+    // Get Magic
+    QByteArray magic = netpbmToken(aData, aSize, position);
+    // Init Depth & Max Value
+    int depth = 0;
+    int maxValue = 0;
+
+    // Check Binary Graymap & Pixmap
+    if (magic == "P5" || magic == "P6") {
+        // Read Header Values
+        aWidth = netpbmToken(aData, aSize, position).toInt();
+        aHeight = netpbmToken(aData, aSize, position).toInt();
+        maxValue = netpbmToken(aData, aSize, position).toInt();
+        // Set Depth
+        depth = magic == "P5" ? 1 : 3;
+    // Check Arbitrary Map
+    } else if (magic == "P7") {
+        // Go Thru Header Lines - Tuple Type Follows From Depth
+        while (position < aSize) {
+            // Get Key
+            QByteArray key = netpbmToken(aData, aSize, position);
+
+            // Check End of Header
+            if (key == "ENDHDR" || key.isEmpty()) {
+                break;
+            }
+
+            // Get Value
+            QByteArray value = netpbmToken(aData, aSize, position);
+
+            // Check Key
+            if (key == "WIDTH") {
+                aWidth = value.toInt();
+            } else if (key == "HEIGHT") {
+                aHeight = value.toInt();
+            } else if (key == "DEPTH") {
+                depth = value.toInt();
+            } else if (key == "MAXVAL") {
+                maxValue = value.toInt();
+            }
+        }
+    } else {
+        return 0;
+    }
+
+    // Skip the Single Whitespace Before the Pixels
+    position++;
+
+    // Check Values - 16 Bit Samples Are Big Endian, Left To the Decoder
+    if (aWidth <= 0 || aHeight <= 0 || maxValue != 255 || position + (qint64)aWidth * aHeight * depth > aSize) {
+        return 0;
+    }
+
+    // Switch Depth
+    switch (depth) {
+        case 1:     aFormat = QImage::Format_Grayscale8;    break;
+        case 3:     aFormat = QImage::Format_RGB888;        break;
+        case 4:     aFormat = QImage::Format_RGBA8888;      break;
+        default:    return 0;
+    }
+
+    return position;
+}
+
+//==============================================================================
+// Check If File Has a Mappable Format Suffix - pam, ppm, pgm, raw
+//==============================================================================
+bool isMappedImageFile(const QString& aFilePath)
+{
+    return QString(DEFAULT_MAPPED_IMAGE_SUFFIXES).split(' ').contains(QFileInfo(aFilePath).suffix().toLower());
+}
+
+//==============================================================================
+// Map Image File - Uncompressed Pixels Wrapped Over the Mapping, No Decode. Null With Empty Error If Not Mappable
+//==============================================================================
+QImage mapImageFile(const QString& aFilePath, QString& aError)
+{
+    // Check Suffix
+    if (!isMappedImageFile(aFilePath)) {
+        return QImage();
+    }
+
+    // Init File - Owned By the Image From Here
+    QFile* file = new QFile(aFilePath);
+
+    // Open File
+    if (!file->open(QIODevice::ReadOnly)) {
+        // Set Error
+        aError = aFilePath + ": " + file->errorString();
+        // Delete File
+        delete file;
+        return QImage();
+    }
+
+    // Get Size
+    qint64 size = file->size();
+    // Map File - Read Only, Shared Page Cache
+    const uchar* data = size > 0 ? file->map(0, size) : NULL;
+
+    // Check Data
+    if (!data) {
+        // Set Error
+        aError = aFilePath + ": " + file->errorString();
+        // Delete File
+        delete file;
+        return QImage();
+    }
+
+    // Init Image
+    QImage image;
+
+    // Check Raw File
+    if (QFileInfo(aFilePath).suffix().toLower() == DEFAULT_MAPPED_IMAGE_RAW_SUFFIX) {
+        // Wrap Raw Image
+        image = wrapSharedImage(data, size, unmapImageFile, file, aError);
+
+        // Check Image
+        if (image.isNull()) {
+            // Set Error
+            aError = aFilePath + ": " + aError;
+        }
+    } else {
+        // Init Width, Height & Format
+        int width = 0;
+        int height = 0;
+        QImage::Format format = QImage::Format_Invalid;
+
+        // Parse Header
+        qint64 dataOffset = parseNetpbmHeader(data, size, width, height, format);
+
+        // Check Data Offset - Others Are Left To the Decoder
+        if (dataOffset > 0) {
+            // Wrap Pixels - Tightly Packed Lines, No Copy
+            image = QImage(data + dataOffset, width, height, width * QImage::toPixelFormat(format).bitsPerPixel() / 8, format, unmapImageFile, file);
+        }
+    }
+
+    // Check Image
+    if (image.isNull()) {
+        // Delete File
+        delete file;
+    }
+
+    return image;
+}
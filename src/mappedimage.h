@@ -0,0 +1,18 @@
+#ifndef MAPPEDIMAGE_H
+#define MAPPEDIMAGE_H
+
+#include <QString>
+#include <QImage>
+
+// Check If File Has a Mappable Format Suffix - pam, ppm, pgm, raw
+bool isMappedImageFile(const QString& aFilePath);
+
+// Map Image File - Uncompressed Pixels Wrapped Over the Mapping, No Decode. Null With Empty Error If Not Mappable
+//
+// 8 Bit PAM, PPM & PGM Files, And Raw Files Starting With a SharedImageHeader, Are Mapped.
+// The Page Cache Is Shared With Every Process Mapping the Same File. Only Raw Files Stored In
+// the Normalized Format (ARGB32 For Straight Alpha) Are Used Without a Copy, Netpbm Pixels
+// Are Grayscale8, RGB888 Or RGBA8888 & Get Converted Once By the Image Cache
+QImage mapImageFile(const QString& aFilePath, QString& aError);
+
+#endif // MAPPEDIMAGE_H
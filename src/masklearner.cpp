@@ -0,0 +1,289 @@
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QSaveFile>
+#include <QTextStream>
+
+#include "masklearner.h"
+#include "imagenormalizer.h"
+#include "constants.h"
+
+
+//==============================================================================
+// Constructor
+//==============================================================================
+MaskLearner::MaskLearner()
+    : size(0, 0)
+    , renders(0)
+{
+}
+
+//==============================================================================
+// Add Render - Welford Update, Memory Stays Fixed Regardless of Render Count
+//==============================================================================
+bool MaskLearner::addImage(const QImage& aImage)
+{
+    // Check Image
+    if (aImage.isNull()) {
+        return false;
+    }
+
+    // Check First Render
+    if (renders == 0) {
+        // Set Size
+        size = aImage.size();
+        // Init Accumulators
+        mean.fill(0.0f, size.width() * size.height() * 3);
+        m2.fill(0.0f, size.width() * size.height());
+    } else if (aImage.size() != size) {
+        qDebug() << "MaskLearner::addImage - size: " << aImage.size() << " - ERROR: SIZE MISMATCH, EXPECTED: " << size;
+        return false;
+    }
+
+    // Get Normalized Image
+    QImage image = normalizeImage(aImage, AMTStraight);
+
+    // Inc Render Count
+    renders++;
+
+    // Get Weight
+    float weight = 1.0f / renders;
+
+    // Get Accumulators
+    float* meanData = mean.data();
+    float* m2Data = m2.data();
+
+    // Go Thru Rows
+    for (int y = 0; y < size.height(); y++) {
+        // Get Line
+        const QRgb* line = (const QRgb*)image.constScanLine(y);
+        // Get Row Offset
+        int rowOffset = y * size.width();
+
+        // Go Thru Pixels
+        for (int x = 0; x < size.width(); x++) {
+            // Get Channels
+            float channels[3] = { (float)qRed(line[x]), (float)qGreen(line[x]), (float)qBlue(line[x]) };
+            // Get Mean
+            float* pixelMean = meanData + (rowOffset + x) * 3;
+            // Init Squared Difference
+            float squared = 0.0f;
+
+            // Go Thru Channels
+            for (int c = 0; c < 3; c++) {
+                // Get Delta To Old Mean
+                float delta = channels[c] - pixelMean[c];
+                // Update Mean
+                pixelMean[c] += delta * weight;
+                // Add Delta Times Delta To New Mean
+                squared += delta * (channels[c] - pixelMean[c]);
+            }
+
+            // Update Sum of Squares
+            m2Data[rowOffset + x] += squared;
+        }
+    }
+
+    return true;
+}
+
+//==============================================================================
+// Get Render Count
+//==============================================================================
+int MaskLearner::count() const
+{
+    return renders;
+}
+
+//==============================================================================
+// Get Learned Mask - White Opaque Where Renders Differ, Dilated By Radius
+//==============================================================================
+QImage MaskLearner::mask(const qreal& aStdDevThreshold, const int& aDilateRadius, int& aMaskedPixels) const
+{
+    // Reset Masked Pixels
+    aMaskedPixels = 0;
+
+    // Check Render Count
+    if (renders < 2) {
+        return QImage();
+    }
+
+    // Get Width & Height
+    int width = size.width();
+    int height = size.height();
+
+    // Get Variance Threshold - Summed Over 3 Channels
+    float varianceThreshold = (float)(aStdDevThreshold * aStdDevThreshold * 3.0);
+
+    // Init Volatile Map
+    QVector<uchar> volatileMap(width * height, 0);
+
+    // Go Thru Pixels
+    for (int i = 0; i < width * height; i++) {
+        // Check Sample Variance
+        volatileMap[i] = m2[i] / (renders - 1) > varianceThreshold ? 1 : 0;
+    }
+
+    // Check Dilate Radius - Covers Antialiased Edges Around Changing Content
+    if (aDilateRadius > 0) {
+        // Init Horizontal Pass
+        QVector<uchar> dilated(width * height, 0);
+
+        // Dilate Rows - Running Count of Set Pixels In the Window
+        for (int y = 0; y < height; y++) {
+            // Get Row
+            const uchar* row = volatileMap.constData() + y * width;
+            // Init Window Count
+            int windowCount = 0;
+
+            // Prime Window
+            for (int x = 0; x < qMin(aDilateRadius, width); x++) {
+                windowCount += row[x];
+            }
+
+            // Go Thru Pixels
+            for (int x = 0; x < width; x++) {
+                // Add Entering Pixel
+                if (x + aDilateRadius < width) {
+                    windowCount += row[x + aDilateRadius];
+                }
+
+                // Remove Leaving Pixel
+                if (x - aDilateRadius - 1 >= 0) {
+                    windowCount -= row[x - aDilateRadius - 1];
+                }
+
+                // Set Dilated
+                dilated[y * width + x] = windowCount > 0 ? 1 : 0;
+            }
+        }
+
+        // Dilate Columns
+        for (int x = 0; x < width; x++) {
+            // Init Window Count
+            int windowCount = 0;
+
+            // Prime Window
+            for (int y = 0; y < qMin(aDilateRadius, height); y++) {
+                windowCount += dilated[y * width + x];
+            }
+
+            // Go Thru Pixels
+            for (int y = 0; y < height; y++) {
+                // Add Entering Pixel
+                if (y + aDilateRadius < height) {
+                    windowCount += dilated[(y + aDilateRadius) * width + x];
+                }
+
+                // Remove Leaving Pixel
+                if (y - aDilateRadius - 1 >= 0) {
+                    windowCount -= dilated[(y - aDilateRadius - 1) * width + x];
+                }
+
+                // Set Volatile
+                volatileMap[y * width + x] = windowCount > 0 ? 1 : 0;
+            }
+        }
+    }
+
+    // Init Mask
+    QImage maskImage(size, QImage::Format_ARGB32);
+
+    // Go Thru Rows
+    for (int y = 0; y < height; y++) {
+        // Get Line
+        QRgb* line = (QRgb*)maskImage.scanLine(y);
+
+        // Go Thru Pixels
+        for (int x = 0; x < width; x++) {
+            // Check Volatile
+            if (volatileMap[y * width + x]) {
+                // Set Ignored
+                line[x] = 0xFFFFFFFF;
+                // Inc Masked Pixels
+                aMaskedPixels++;
+            } else {
+                // Set Compared
+                line[x] = 0;
+            }
+        }
+    }
+
+    return maskImage;
+}
+
+//==============================================================================
+// Reset
+//==============================================================================
+void MaskLearner::reset()
+{
+    // Reset Size
+    size = QSize(0, 0);
+    // Reset Render Count
+    renders = 0;
+    // Clear Accumulators
+    mean.clear();
+    m2.clear();
+}
+
+//==============================================================================
+// Save Learned Mask Into Dir & Reference It From the Dir Compare Mask Sidecar
+//==============================================================================
+bool saveLearnedMask(const QImage& aMask, const QString& aDirPath, QString& aError)
+{
+    // Init Dir
+    QDir dir(aDirPath);
+
+    // Init Mask Image File
+    QSaveFile maskImageFile(dir.filePath(DEFAULT_LEARNED_MASK_FILE_NAME));
+
+    // Open Mask Image File
+    if (!maskImageFile.open(QIODevice::WriteOnly)) {
+        // Set Error
+        aError = maskImageFile.errorString();
+        return false;
+    }
+
+    // Write Mask Image
+    if (!aMask.save(&maskImageFile, "PNG") || !maskImageFile.commit()) {
+        // Set Error
+        aError = maskImageFile.errorString();
+        return false;
+    }
+
+    // Get Image Line
+    QString imageLine = QString("image %1").arg(DEFAULT_LEARNED_MASK_FILE_NAME);
+    // Init Sidecar File
+    QFile sidecarFile(dir.filePath(DEFAULT_COMPARE_MASK_DIR_FILE_NAME));
+
+    // Check Existing Sidecar - Keep Hand Written Shapes
+    if (sidecarFile.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        // Init Text Stream
+        QTextStream sidecarStream(&sidecarFile);
+
+        // Read Lines
+        while (!sidecarStream.atEnd()) {
+            // Check Line - Already Referenced
+            if (sidecarStream.readLine().trimmed() == imageLine) {
+                return true;
+            }
+        }
+
+        // Close Sidecar File
+        sidecarFile.close();
+    }
+
+    // Open Sidecar For Append
+    if (!sidecarFile.open(QIODevice::WriteOnly | QIODevice::Append | QIODevice::Text)) {
+        // Set Error
+        aError = sidecarFile.errorString();
+        return false;
+    }
+
+    // Init Text Stream
+    QTextStream sidecarStream(&sidecarFile);
+    // Write Image Line
+    sidecarStream << "# Learned From Repeated Renders" << endl << imageLine << endl;
+
+    return true;
+}
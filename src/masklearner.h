@@ -0,0 +1,46 @@
+#ifndef MASKLEARNER_H
+#define MASKLEARNER_H
+
+#include <QImage>
+#include <QSize>
+#include <QString>
+#include <QVector>
+
+//==============================================================================
+// Mask Learner Class - Streaming Per Pixel Variance Over Renders of the Same Screen
+//==============================================================================
+class MaskLearner
+{
+public:
+
+    // Constructor
+    MaskLearner();
+
+    // Add Render - Welford Update, Memory Stays Fixed Regardless of Render Count
+    bool addImage(const QImage& aImage);
+
+    // Get Render Count
+    int count() const;
+
+    // Get Learned Mask - White Opaque Where Renders Differ, Dilated By Radius
+    QImage mask(const qreal& aStdDevThreshold, const int& aDilateRadius, int& aMaskedPixels) const;
+
+    // Reset
+    void reset();
+
+private:
+
+    // Image Size
+    QSize               size;
+    // Render Count
+    int                 renders;
+    // Running Mean Per Channel
+    QVector<float>      mean;
+    // Sum of Squared Differences From the Mean, Summed Over Channels
+    QVector<float>      m2;
+};
+
+// Save Learned Mask Into Dir & Reference It From the Dir Compare Mask Sidecar
+bool saveLearnedMask(const QImage& aMask, const QString& aDirPath, QString& aError);
+
+#endif // MASKLEARNER_H
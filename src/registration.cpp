@@ -0,0 +1,359 @@
+#include <QDebug>
+#include <QVector>
+#include <QElapsedTimer>
+
+#include <algorithm>
+#include <complex>
+#include <qmath.h>
+
+#include "registration.h"
+#include "constants.h"
+
+// Complex Type
+typedef std::complex<float> Complex;
+
+
+//==============================================================================
+// Get Next Power of Two
+//==============================================================================
+static int nextPowerOfTwo(const int& aValue)
+{
+    // Init Result
+    int result = 1;
+
+    // Shift Until Large Enough
+    while (result < aValue) {
+        result <<= 1;
+    }
+
+    return result;
+}
+
+//==============================================================================
+// In Place Radix-2 FFT
+//==============================================================================
+static void fft(Complex* aData, const int& aSize, const bool& aInverse)
+{
+    // Bit Reversal Permutation
+    for (int i = 1, j = 0; i < aSize; i++) {
+        int bit = aSize >> 1;
+        for (; j & bit; bit >>= 1) {
+            j ^= bit;
+        }
+        j ^= bit;
+
+        // Check Swap
+        if (i < j) {
+            std::swap(aData[i], aData[j]);
+        }
+    }
+
+    // Butterflies
+    for (int length = 2; length <= aSize; length <<= 1) {
+        // Get Twiddle Step
+        double angle = 2.0 * M_PI / length * (aInverse ? 1.0 : -1.0);
+        Complex twiddleStep((float)cos(angle), (float)sin(angle));
+        // Get Half Length
+        int half = length >> 1;
+
+        for (int i = 0; i < aSize; i += length) {
+            // Init Twiddle
+            Complex twiddle(1.0f, 0.0f);
+
+            for (int j = 0; j < half; j++) {
+                Complex even = aData[i + j];
+                Complex odd = aData[i + j + half] * twiddle;
+
+                aData[i + j] = even + odd;
+                aData[i + j + half] = even - odd;
+
+                twiddle *= twiddleStep;
+            }
+        }
+    }
+}
+
+//==============================================================================
+// In Place 2D FFT - Rows, Then Columns
+//==============================================================================
+static void fft2D(QVector<Complex>& aData, const int& aWidth, const int& aHeight, const bool& aInverse)
+{
+    // Go Thru Rows
+    for (int y = 0; y < aHeight; y++) {
+        fft(aData.data() + y * aWidth, aWidth, aInverse);
+    }
+
+    // Init Column Buffer
+    QVector<Complex> column(aHeight);
+
+    // Go Thru Columns
+    for (int x = 0; x < aWidth; x++) {
+        // Gather Column
+        for (int y = 0; y < aHeight; y++) {
+            column[y] = aData[y * aWidth + x];
+        }
+
+        // Transform Column
+        fft(column.data(), aHeight, aInverse);
+
+        // Scatter Column
+        for (int y = 0; y < aHeight; y++) {
+            aData[y * aWidth + x] = column[y];
+        }
+    }
+}
+
+//==============================================================================
+// Get Luma of 32 Bit Pixel
+//==============================================================================
+static inline int pixelLuma(const QRgb& aPixel)
+{
+    return qGray(aPixel);
+}
+
+//==============================================================================
+// Downsample Image To Windowed Luma Spectrum Input - Box Filter, Mean Removed, Hann Window
+//==============================================================================
+static void downsampleLuma(const QImage& aImage, const int& aFactor, const int& aWidth, const int& aHeight, QVector<Complex>& aTarget)
+{
+    // Get Level Size
+    int levelWidth = aImage.width() / aFactor;
+    int levelHeight = aImage.height() / aFactor;
+
+    // Init Level
+    QVector<float> level(levelWidth * levelHeight, 0.0f);
+    // Init Row Sums
+    QVector<int> rowSums(levelWidth);
+
+    // Go Thru Level Rows
+    for (int ly = 0; ly < levelHeight; ly++) {
+        // Reset Row Sums
+        rowSums.fill(0);
+
+        // Go Thru Source Rows of the Box
+        for (int sy = ly * aFactor; sy < (ly + 1) * aFactor; sy++) {
+            // Get Source Line
+            const QRgb* line = (const QRgb*)aImage.constScanLine(sy);
+
+            // Go Thru Level Columns
+            for (int lx = 0; lx < levelWidth; lx++) {
+                // Get Box Start
+                const QRgb* box = line + lx * aFactor;
+
+                // Sum Box Row
+                for (int i = 0; i < aFactor; i++) {
+                    rowSums[lx] += pixelLuma(box[i]);
+                }
+            }
+        }
+
+        // Store Averages
+        for (int lx = 0; lx < levelWidth; lx++) {
+            level[ly * levelWidth + lx] = (float)rowSums[lx] / (aFactor * aFactor);
+        }
+    }
+
+    // Calculate Mean
+    double mean = 0.0;
+    for (int i = 0; i < level.count(); i++) {
+        mean += level[i];
+    }
+    mean /= qMax(1, level.count());
+
+    // Init Target - Zero Padded
+    aTarget.fill(Complex(0.0f, 0.0f), aWidth * aHeight);
+
+    // Go Thru Level - Hann Window Suppresses the Border Discontinuity
+    for (int ly = 0; ly < levelHeight; ly++) {
+        // Get Vertical Window
+        float windowY = 0.5f - 0.5f * (float)cos(2.0 * M_PI * ly / qMax(1, levelHeight - 1));
+
+        for (int lx = 0; lx < levelWidth; lx++) {
+            // Get Horizontal Window
+            float windowX = 0.5f - 0.5f * (float)cos(2.0 * M_PI * lx / qMax(1, levelWidth - 1));
+
+            // Set Target
+            aTarget[ly * aWidth + lx] = Complex((level[ly * levelWidth + lx] - (float)mean) * windowX * windowY, 0.0f);
+        }
+    }
+}
+
+//==============================================================================
+// Refine Offset At Full Resolution - Sampled Mean Absolute Luma Difference
+//==============================================================================
+static QPoint refineOffset(const QImage& aLeftImage, const QImage& aRightImage, const QPoint& aCoarse, const int& aRadius)
+{
+    // Get Candidate Range
+    int minDX = aCoarse.x() - aRadius;
+    int maxDX = aCoarse.x() + aRadius;
+    int minDY = aCoarse.y() - aRadius;
+    int maxDY = aCoarse.y() + aRadius;
+
+    // Get Left Region Valid For Every Candidate
+    int left = qMax(0, -minDX);
+    int top = qMax(0, -minDY);
+    int right = qMin(aLeftImage.width(), aRightImage.width() - maxDX);
+    int bottom = qMin(aLeftImage.height(), aRightImage.height() - maxDY);
+
+    // Check Region
+    if (right - left < DEFAULT_REGISTRATION_REFINE_SAMPLES || bottom - top < DEFAULT_REGISTRATION_REFINE_SAMPLES) {
+        return aCoarse;
+    }
+
+    // Get Sample Steps
+    int stepX = (right - left) / DEFAULT_REGISTRATION_REFINE_SAMPLES;
+    int stepY = (bottom - top) / DEFAULT_REGISTRATION_REFINE_SAMPLES;
+
+    // Init Sample Rows & Columns
+    QVector<int> sampleX;
+    QVector<int> sampleY;
+    for (int i = 0; i < DEFAULT_REGISTRATION_REFINE_SAMPLES; i++) {
+        sampleX << left + i * stepX;
+        sampleY << top + i * stepY;
+    }
+
+    // Init Left Samples - Same For Every Candidate
+    QVector<int> leftSamples;
+    leftSamples.reserve(sampleX.count() * sampleY.count());
+
+    // Go Thru Sample Rows
+    for (int j = 0; j < sampleY.count(); j++) {
+        // Get Left Line
+        const QRgb* line = (const QRgb*)aLeftImage.constScanLine(sampleY[j]);
+
+        // Go Thru Sample Columns
+        for (int i = 0; i < sampleX.count(); i++) {
+            leftSamples << pixelLuma(line[sampleX[i]]);
+        }
+    }
+
+    // Init Best
+    QPoint best = aCoarse;
+    qint64 bestSum = -1;
+
+    // Go Thru Candidates
+    for (int dy = minDY; dy <= maxDY; dy++) {
+        for (int dx = minDX; dx <= maxDX; dx++) {
+            // Init Sum
+            qint64 sum = 0;
+            // Init Sample Index
+            int s = 0;
+
+            // Go Thru Sample Rows
+            for (int j = 0; j < sampleY.count() && (bestSum < 0 || sum < bestSum); j++) {
+                // Get Right Line
+                const QRgb* line = (const QRgb*)aRightImage.constScanLine(sampleY[j] + dy);
+
+                // Go Thru Sample Columns
+                for (int i = 0; i < sampleX.count(); i++, s++) {
+                    sum += qAbs(leftSamples[s] - pixelLuma(line[sampleX[i] + dx]));
+                }
+            }
+
+            // Check Best - Early Exit Above Keeps Losing Candidates Cheap
+            if (bestSum < 0 || sum < bestSum) {
+                bestSum = sum;
+                best = QPoint(dx, dy);
+            }
+        }
+    }
+
+    return best;
+}
+
+//==============================================================================
+// Estimate Translation of Right Image Relative To Left - Phase Correlation On a Downsampled Level, Refined At Full Resolution
+//==============================================================================
+bool estimateTranslation(const QImage& aLeftImage, const QImage& aRightImage, QPoint& aOffset)
+{
+    // Reset Offset
+    aOffset = QPoint(0, 0);
+
+    // Check Images
+    if (aLeftImage.isNull() || aRightImage.isNull()) {
+        return false;
+    }
+
+    // Init Elapsed Timer
+    QElapsedTimer elapsedTimer;
+    elapsedTimer.start();
+
+    // Get 32 Bit Images - Cache Delivers These Already, Conversion Is a No-Op Then
+    QImage leftImage = aLeftImage.format() == QImage::Format_RGB32 || aLeftImage.format() == QImage::Format_ARGB32 ? aLeftImage : aLeftImage.convertToFormat(QImage::Format_ARGB32);
+    QImage rightImage = aRightImage.format() == QImage::Format_RGB32 || aRightImage.format() == QImage::Format_ARGB32 ? aRightImage : aRightImage.convertToFormat(QImage::Format_ARGB32);
+
+    // Get Max Dimension
+    int maxDimension = qMax(qMax(leftImage.width(), leftImage.height()), qMax(rightImage.width(), rightImage.height()));
+    // Get Downsample Factor
+    int factor = qMax(1, (maxDimension + DEFAULT_REGISTRATION_LEVEL_SIZE - 1) / DEFAULT_REGISTRATION_LEVEL_SIZE);
+
+    // Get Transform Size
+    int width = nextPowerOfTwo(qMax(leftImage.width(), rightImage.width()) / factor);
+    int height = nextPowerOfTwo(qMax(leftImage.height(), rightImage.height()) / factor);
+
+    // Check Size
+    if (width < DEFAULT_REGISTRATION_MIN_LEVEL_SIZE || height < DEFAULT_REGISTRATION_MIN_LEVEL_SIZE) {
+        return false;
+    }
+
+    // Init Spectra
+    QVector<Complex> leftSpectrum;
+    QVector<Complex> rightSpectrum;
+
+    // Downsample
+    downsampleLuma(leftImage, factor, width, height, leftSpectrum);
+    downsampleLuma(rightImage, factor, width, height, rightSpectrum);
+
+    // Forward Transforms
+    fft2D(leftSpectrum, width, height, false);
+    fft2D(rightSpectrum, width, height, false);
+
+    // Normalized Cross Power Spectrum - Into Right Spectrum
+    for (int i = 0; i < rightSpectrum.count(); i++) {
+        // Get Cross Power
+        Complex cross = rightSpectrum[i] * std::conj(leftSpectrum[i]);
+        // Get Magnitude
+        float magnitude = std::abs(cross);
+        // Normalize
+        rightSpectrum[i] = magnitude > 1e-6f ? cross / magnitude : Complex(0.0f, 0.0f);
+    }
+
+    // Inverse Transform
+    fft2D(rightSpectrum, width, height, true);
+
+    // Find Peak
+    int peakIndex = 0;
+    float peakValue = rightSpectrum[0].real();
+    for (int i = 1; i < rightSpectrum.count(); i++) {
+        if (rightSpectrum[i].real() > peakValue) {
+            peakValue = rightSpectrum[i].real();
+            peakIndex = i;
+        }
+    }
+
+    // Get Peak Confidence - A Perfect Shift Concentrates All Energy In One Bin
+    float confidence = peakValue / (width * height);
+
+    // Check Confidence
+    if (confidence < DEFAULT_REGISTRATION_MIN_CONFIDENCE) {
+        qDebug() << "estimateTranslation - confidence: " << confidence << " - NO RELIABLE PEAK";
+        return false;
+    }
+
+    // Get Peak Position - Wrapped Around For Negative Shifts
+    int peakX = peakIndex % width;
+    int peakY = peakIndex / width;
+    if (peakX > width / 2) {
+        peakX -= width;
+    }
+    if (peakY > height / 2) {
+        peakY -= height;
+    }
+
+    // Refine At Full Resolution
+    aOffset = refineOffset(leftImage, rightImage, QPoint(peakX * factor, peakY * factor), factor / 2 + DEFAULT_REGISTRATION_REFINE_RADIUS);
+
+    qDebug() << "estimateTranslation - aOffset: " << aOffset << " - confidence: " << confidence << " - elapsed: " << elapsedTimer.elapsed() << "ms";
+
+    return true;
+}
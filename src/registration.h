@@ -0,0 +1,10 @@
+#ifndef REGISTRATION_H
+#define REGISTRATION_H
+
+#include <QImage>
+#include <QPoint>
+
+// Estimate Translation of Right Image Relative To Left - Phase Correlation On a Downsampled Level, Refined At Full Resolution
+bool estimateTranslation(const QImage& aLeftImage, const QImage& aRightImage, QPoint& aOffset);
+
+#endif // REGISTRATION_H
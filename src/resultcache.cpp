@@ -0,0 +1,474 @@
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QImageReader>
+#include <QSaveFile>
+#include <QSettings>
+#include <QStandardPaths>
+#include <QCryptographicHash>
+#include <QMutexLocker>
+
+#include <string.h>
+#include <sys/stat.h>
+
+#include "resultcache.h"
+#include "utility.h"
+#include "comparemask.h"
+#include "constants.h"
+#include "defaultsettings.h"
+
+// Result Cache Singleton
+static ResultCache* resultCache = NULL;
+
+//==============================================================================
+// Result Cache Entry Header - Followed By Regions & the Bit Packed Diff Map
+//==============================================================================
+struct ResultCacheHeader
+{
+    // Magic
+    quint32     magic;
+    // Format Version
+    quint32     version;
+    // Key - Guards Against Hash Prefix Collisions In File Names
+    char        key[20];
+    // Reserved - Keeps 64 Bit Fields Aligned
+    quint32     reserved;
+    // Statistics
+    qint64      pixels;
+    qint64      differingPixels;
+    quint64     differenceSum;
+    qint32      maxDifference;
+    qint32      leftDepth;
+    qint32      rightDepth;
+    // Region Count
+    qint32      regionCount;
+    // Diff Map Block Size
+    qint32      blockSize;
+    // Image Size
+    qint32      imageWidth;
+    qint32      imageHeight;
+    // Diff Map Size In Blocks
+    qint32      mapWidth;
+    qint32      mapHeight;
+};
+
+
+//==============================================================================
+// Static Constructor
+//==============================================================================
+ResultCache* ResultCache::getInstance()
+{
+    // Check Singleton
+    if (!resultCache) {
+        // Create Result Cache
+        resultCache = new ResultCache();
+    }
+
+    return resultCache;
+}
+
+//==============================================================================
+// Release Instance
+//==============================================================================
+void ResultCache::release()
+{
+    // Delete Result Cache
+    delete resultCache;
+    // Reset Singleton
+    resultCache = NULL;
+}
+
+//==============================================================================
+// Constructor
+//==============================================================================
+ResultCache::ResultCache()
+    : cacheDir(QDir(QStandardPaths::writableLocation(QStandardPaths::CacheLocation)).filePath(DEFAULT_RESULT_CACHE_DIR_NAME))
+    , budgetBytes((qint64)QSettings().value(SETTINGS_KEY_RESULT_CACHE_SIZE_MB, DEFAULT_RESULT_CACHE_SIZE_MB).toInt() * 1024 * 1024)
+{
+    qDebug() << "ResultCache::ResultCache - cacheDir: " << cacheDir;
+
+    // Create Cache Dir
+    QDir().mkpath(cacheDir);
+}
+
+//==============================================================================
+// Get Key - File Identities Or Content Hashes of Both Files, Mode, Threshold & Mask Version. Empty If a File Can Not Be Read
+//==============================================================================
+QByteArray ResultCache::key(const QString& aLeftFile, const QString& aRightFile, const QString& aMode, const qreal& aThreshold, const QByteArray& aMaskVersion, const bool& aContentKey)
+{
+    // Get File Hashes - Identities Are Tagged, Never Equal To a Content Hash
+    QByteArray leftHash = aContentKey ? contentHash(aLeftFile) : fileIdentity(aLeftFile);
+    QByteArray rightHash = aContentKey ? contentHash(aRightFile) : fileIdentity(aRightFile);
+
+    // Check Content Hashes
+    if (leftHash.isEmpty() || rightHash.isEmpty()) {
+        return QByteArray();
+    }
+
+    // Init Key Hash
+    QCryptographicHash keyHash(QCryptographicHash::Sha1);
+
+    // Add Key Parts - Separated So Parts Can Not Run Into Each Other
+    keyHash.addData(leftHash);
+    keyHash.addData(rightHash);
+    keyHash.addData(aMode.toUtf8() + '\n');
+    keyHash.addData(QByteArray::number(aThreshold, 'g', 17) + '\n');
+    keyHash.addData(aMaskVersion);
+
+    return keyHash.result();
+}
+
+//==============================================================================
+// Lookup Result - Memory Mapped, No Decoding
+//==============================================================================
+bool ResultCache::lookup(const QByteArray& aKey, CachedCompareResult& aResult)
+{
+    // Init Entry File
+    QFile entryFile(entryFilePath(aKey));
+
+    // Open Entry File
+    if (!entryFile.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    // Get Entry Size
+    qint64 entrySize = entryFile.size();
+
+    // Check Entry Size
+    if (entrySize < (qint64)sizeof(ResultCacheHeader)) {
+        return false;
+    }
+
+    // Map Entry
+    const uchar* data = entryFile.map(0, entrySize);
+
+    // Check Data
+    if (!data) {
+        return false;
+    }
+
+    // Init Header
+    ResultCacheHeader header;
+    // Copy Header - Mapped Data Need Not Be Aligned
+    memcpy(&header, data, sizeof(header));
+
+    // Get Map Bytes
+    qint64 mapBytes = ((qint64)header.mapWidth * header.mapHeight + 7) / 8;
+
+    // Check Header - Entries Are Written Whole, Anything Else Is a Foreign Or Older Format
+    if (header.magic != DEFAULT_RESULT_CACHE_MAGIC || header.version != DEFAULT_RESULT_CACHE_VERSION ||
+        memcmp(header.key, aKey.constData(), qMin(aKey.size(), (int)sizeof(header.key))) != 0 ||
+        header.regionCount < 0 || header.mapWidth < 0 || header.mapHeight < 0 ||
+        entrySize != (qint64)sizeof(header) + (qint64)header.regionCount * 4 * (qint64)sizeof(qint32) + mapBytes) {
+        qDebug() << "ResultCache::lookup - aKey: " << aKey.toHex() << " - ERROR: INVALID ENTRY!";
+        // Unmap Entry
+        entryFile.unmap((uchar*)data);
+        return false;
+    }
+
+    // Set Statistics
+    aResult.stats.pixels = header.pixels;
+    aResult.stats.differingPixels = header.differingPixels;
+    aResult.stats.differenceSum = header.differenceSum;
+    aResult.stats.maxDifference = (quint16)header.maxDifference;
+    aResult.stats.leftDepth = header.leftDepth;
+    aResult.stats.rightDepth = header.rightDepth;
+
+    // Get Regions
+    const uchar* regionData = data + sizeof(header);
+    // Init Region
+    qint32 region[4];
+
+    // Reset Regions
+    aResult.regions.resize(header.regionCount);
+
+    // Go Thru Regions
+    for (int i = 0; i < header.regionCount; i++) {
+        // Copy Region
+        memcpy(region, regionData + i * sizeof(region), sizeof(region));
+        // Set Region
+        aResult.regions[i] = QRect(region[0], region[1], region[2], region[3]);
+    }
+
+    // Get Map Data
+    const uchar* mapData = regionData + header.regionCount * sizeof(region);
+
+    // Set Diff Map
+    aResult.diffMap.blockSize = header.blockSize;
+    aResult.diffMap.imageSize = QSize(header.imageWidth, header.imageHeight);
+    aResult.diffMap.size = QSize(header.mapWidth, header.mapHeight);
+    aResult.diffMap.blocks.resize(header.mapWidth * header.mapHeight);
+
+    // Go Thru Blocks - Unpack Bits
+    for (int i = 0; i < aResult.diffMap.blocks.size(); i++) {
+        aResult.diffMap.blocks[i] = (mapData[i >> 3] >> (i & 7)) & 1;
+    }
+
+    // Unmap Entry
+    entryFile.unmap((uchar*)data);
+
+#if QT_VERSION >= QT_VERSION_CHECK(5, 10, 0)
+    // Touch Entry - Modification Time Is the Recency Eviction Goes By
+    entryFile.setFileTime(QDateTime::currentDateTime(), QFileDevice::FileModificationTime);
+#endif // QT_VERSION >= 5.10
+
+    return true;
+}
+
+//==============================================================================
+// Store Result - Evicts Oldest Entries Over Budget
+//==============================================================================
+bool ResultCache::store(const QByteArray& aKey, const CachedCompareResult& aResult)
+{
+    // Init Header
+    ResultCacheHeader header;
+    memset(&header, 0, sizeof(header));
+
+    // Set Header
+    header.magic = DEFAULT_RESULT_CACHE_MAGIC;
+    header.version = DEFAULT_RESULT_CACHE_VERSION;
+    memcpy(header.key, aKey.constData(), qMin(aKey.size(), (int)sizeof(header.key)));
+    header.pixels = aResult.stats.pixels;
+    header.differingPixels = aResult.stats.differingPixels;
+    header.differenceSum = aResult.stats.differenceSum;
+    header.maxDifference = aResult.stats.maxDifference;
+    header.leftDepth = aResult.stats.leftDepth;
+    header.rightDepth = aResult.stats.rightDepth;
+    header.regionCount = aResult.regions.count();
+    header.blockSize = aResult.diffMap.blockSize;
+    header.imageWidth = aResult.diffMap.imageSize.width();
+    header.imageHeight = aResult.diffMap.imageSize.height();
+    header.mapWidth = aResult.diffMap.size.width();
+    header.mapHeight = aResult.diffMap.size.height();
+
+    // Init Entry
+    QByteArray entry((const char*)&header, sizeof(header));
+
+    // Go Thru Regions
+    for (int i = 0; i < aResult.regions.count(); i++) {
+        // Get Region
+        qint32 region[4] = { aResult.regions[i].x(), aResult.regions[i].y(), aResult.regions[i].width(), aResult.regions[i].height() };
+        // Add Region
+        entry.append((const char*)region, sizeof(region));
+    }
+
+    // Init Map Bits
+    QByteArray mapBits((aResult.diffMap.blocks.size() + 7) / 8, 0);
+
+    // Go Thru Blocks - Pack Bits
+    for (int i = 0; i < aResult.diffMap.blocks.size(); i++) {
+        // Check Block
+        if (aResult.diffMap.blocks[i]) {
+            mapBits[i >> 3] = mapBits[i >> 3] | (char)(1 << (i & 7));
+        }
+    }
+
+    // Add Map Bits
+    entry.append(mapBits);
+
+    // Get Entry File Path
+    QString entryPath = entryFilePath(aKey);
+    // Create Entry Dir
+    QDir().mkpath(QFileInfo(entryPath).absolutePath());
+
+    // Init Entry File - Renamed Into Place, Readers Never See a Partial Entry
+    QSaveFile entryFile(entryPath);
+
+    // Write Entry
+    if (!entryFile.open(QIODevice::WriteOnly) || entryFile.write(entry) != entry.size() || !entryFile.commit()) {
+        qDebug() << "ResultCache::store - entryPath: " << entryPath << " - ERROR: " << entryFile.errorString();
+        return false;
+    }
+
+    // Account Stored Bytes
+    accountDiskCache(cacheDir, DEFAULT_RESULT_CACHE_FILE_SUFFIX, budgetBytes, entry.size());
+
+    return true;
+}
+
+//==============================================================================
+// Set Budget
+//==============================================================================
+void ResultCache::setBudget(const qint64& aBudgetBytes)
+{
+    // Set Budget Bytes
+    budgetBytes = aBudgetBytes;
+}
+
+//==============================================================================
+// Get Identity of File - Path, Size, Modification Time, Device & Inode, No Content Read
+//==============================================================================
+QByteArray ResultCache::fileIdentity(const QString& aFilePath)
+{
+    // Get File Info
+    QFileInfo fileInfo(aFilePath);
+
+    // Check File
+    if (!fileInfo.isFile()) {
+        return QByteArray();
+    }
+
+    // Init Stat
+    struct stat fileStat;
+
+    // Stat File - Device & Inode Tell a Replaced File From the Old One
+    if (::stat(QFile::encodeName(fileInfo.absoluteFilePath()).constData(), &fileStat) != 0) {
+        return QByteArray();
+    }
+
+    // Init Identity Hash
+    QCryptographicHash identityHash(QCryptographicHash::Sha1);
+
+    // Add Identity Parts - Tagged So an Identity Never Equals a Content Hash
+    identityHash.addData("identity\n");
+    identityHash.addData(fileInfo.absoluteFilePath().toUtf8() + '\n');
+    identityHash.addData(QByteArray::number(fileInfo.size()) + '\n');
+    identityHash.addData(QByteArray::number(fileInfo.lastModified().toMSecsSinceEpoch()) + '\n');
+    identityHash.addData(QByteArray::number((qulonglong)fileStat.st_dev) + ':' + QByteArray::number((qulonglong)fileStat.st_ino) + '\n');
+
+    return identityHash.result();
+}
+
+//==============================================================================
+// Get Content Hash of File - Remembered Per Size & Modification Time
+//==============================================================================
+QByteArray ResultCache::contentHash(const QString& aFilePath)
+{
+    // Get File Info
+    QFileInfo fileInfo(aFilePath);
+
+    // Check File
+    if (!fileInfo.isFile()) {
+        return QByteArray();
+    }
+
+    // Lock Hashes
+    QMutexLocker locker(&hashMutex);
+
+    // Check Remembered Hash
+    if (contentHashes.contains(aFilePath)) {
+        // Get Hash Entry
+        const HashEntry& hashEntry = contentHashes[aFilePath];
+
+        // Check File Unchanged
+        if (hashEntry.size == fileInfo.size() && hashEntry.lastModified == fileInfo.lastModified()) {
+            return hashEntry.hash;
+        }
+    }
+
+    // Unlock Hashes
+    locker.unlock();
+
+    // Init File
+    QFile file(aFilePath);
+    // Init Hash
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+
+    // Open File & Hash Content
+    if (!file.open(QIODevice::ReadOnly) || !hash.addData(&file)) {
+        qDebug() << "ResultCache::contentHash - aFilePath: " << aFilePath << " - ERROR: " << file.errorString();
+        return QByteArray();
+    }
+
+    // Init Hash Entry
+    HashEntry hashEntry;
+    hashEntry.size = fileInfo.size();
+    hashEntry.lastModified = fileInfo.lastModified();
+    hashEntry.hash = hash.result();
+
+    // Lock Hashes
+    locker.relock();
+    // Remember Hash
+    contentHashes[aFilePath] = hashEntry;
+
+    return hashEntry.hash;
+}
+
+//==============================================================================
+// Get Entry File Path
+//==============================================================================
+QString ResultCache::entryFilePath(const QByteArray& aKey)
+{
+    // Get Key Hex
+    QString keyHex = QString::fromLatin1(aKey.toHex());
+
+    // Fan Out By the First Byte - Keeps Directories Small
+    return QString("%1/%2/%3%4").arg(cacheDir).arg(keyHex.left(2)).arg(keyHex).arg(DEFAULT_RESULT_CACHE_FILE_SUFFIX);
+}
+
+//==============================================================================
+// Destructor
+//==============================================================================
+ResultCache::~ResultCache()
+{
+    qDebug() << "ResultCache::~ResultCache";
+}
+
+
+
+//==============================================================================
+// Compare Files At 16 Bits Per Channel Through the Result Cache - Compare Mask of the Left File Applied
+//==============================================================================
+bool compareFilesDeepCached(const QString& aLeftFile, const QString& aRightFile, const quint16& aTolerance, CachedCompareResult& aResult, bool& aCached, QString& aError,
+                            const QPoint& aAlignOffset)
+{
+    // Reset Cached
+    aCached = false;
+
+    // Get Mask Version
+    QByteArray maskVersion = compareMaskVersion(aLeftFile);
+    // Get Mode - Align Offset Changes Which Pixels Are Paired
+    QString mode = aAlignOffset.isNull() ? QString(DEFAULT_RESULT_CACHE_MODE_DEEP) : QString("%1@%2,%3").arg(DEFAULT_RESULT_CACHE_MODE_DEEP).arg(aAlignOffset.x()).arg(aAlignOffset.y());
+
+    // Get Identity Key - No File Content Read
+    QByteArray key = ResultCache::getInstance()->key(aLeftFile, aRightFile, mode, aTolerance, maskVersion);
+
+    // Lookup Result
+    if (!key.isEmpty() && ResultCache::getInstance()->lookup(key, aResult)) {
+        // Set Cached
+        aCached = true;
+        return true;
+    }
+
+    // Get Content Key - Fallback For Copies & Touched Files
+    QByteArray contentKey = ResultCache::getInstance()->key(aLeftFile, aRightFile, mode, aTolerance, maskVersion, true);
+
+    // Lookup Result
+    if (!contentKey.isEmpty() && ResultCache::getInstance()->lookup(contentKey, aResult)) {
+        // Check Key
+        if (!key.isEmpty()) {
+            // Store Result Under the Identity Key - Next Lookup Reads No Content
+            ResultCache::getInstance()->store(key, aResult);
+        }
+
+        // Set Cached
+        aCached = true;
+        return true;
+    }
+
+    // Get Keep Mask - Rasterized At the Left Image Size
+    QImage keepMask = maskVersion.isEmpty() ? QImage() : compareMask(aLeftFile, QImageReader(aLeftFile).size());
+
+    // Compare Files
+    if (!compareFilesDeep(aLeftFile, aRightFile, aTolerance, aResult.stats, aError, &aResult.diffMap, keepMask, aAlignOffset)) {
+        return false;
+    }
+
+    // Get Regions
+    aResult.regions = aResult.diffMap.regions();
+
+    // Check Key
+    if (!key.isEmpty()) {
+        // Store Result
+        ResultCache::getInstance()->store(key, aResult);
+    }
+
+    // Check Content Key
+    if (!contentKey.isEmpty()) {
+        // Store Result
+        ResultCache::getInstance()->store(contentKey, aResult);
+    }
+
+    return true;
+}
@@ -0,0 +1,94 @@
+#ifndef RESULTCACHE_H
+#define RESULTCACHE_H
+
+#include <QString>
+#include <QByteArray>
+#include <QDateTime>
+#include <QHash>
+#include <QMutex>
+#include <QVector>
+#include <QRect>
+#include <QPoint>
+
+#include "deepcompare.h"
+
+//==============================================================================
+// Cached Compare Result
+//==============================================================================
+struct CachedCompareResult
+{
+    // Statistics - Verdict Is Differing Pixels Being 0
+    DeepCompareStats        stats;
+    // Differing Regions In Pixels
+    QVector<QRect>          regions;
+    // Diff Map
+    DeepCompareDiffMap      diffMap;
+};
+
+//==============================================================================
+// Result Cache Class - Compare Results Kept On Disk Across Runs & Processes
+//==============================================================================
+class ResultCache
+{
+public:
+
+    // Static Constructor
+    static ResultCache* getInstance();
+    // Release Instance
+    void release();
+
+    // Get Key - File Identities (Path, Size, Modification Time, Inode) Or Content Hashes of Both Files, Mode, Threshold & Mask Version
+    // Identity Keys Need No Reads, Content Keys Are the Fallback That Also Hits For Copies & Touched Files. Empty If a File Can Not Be Read
+    QByteArray key(const QString& aLeftFile, const QString& aRightFile, const QString& aMode, const qreal& aThreshold, const QByteArray& aMaskVersion, const bool& aContentKey = false);
+
+    // Lookup Result - Memory Mapped, No Decoding
+    bool lookup(const QByteArray& aKey, CachedCompareResult& aResult);
+    // Store Result - Evicts Oldest Entries Over Budget
+    bool store(const QByteArray& aKey, const CachedCompareResult& aResult);
+
+    // Set Budget
+    void setBudget(const qint64& aBudgetBytes);
+
+protected:
+
+    // Constructor
+    ResultCache();
+
+    // Destructor
+    virtual ~ResultCache();
+
+    // Get Identity of File - Path, Size, Modification Time, Device & Inode, No Content Read
+    QByteArray fileIdentity(const QString& aFilePath);
+    // Get Content Hash of File - Remembered Per Size & Modification Time
+    QByteArray contentHash(const QString& aFilePath);
+    // Get Entry File Path
+    QString entryFilePath(const QByteArray& aKey);
+
+private:
+
+    // Content Hash Entry
+    struct HashEntry
+    {
+        // File Size
+        qint64      size;
+        // Last Modified Time of the File
+        QDateTime   lastModified;
+        // Content Hash
+        QByteArray  hash;
+    };
+
+    // Cache Dir
+    QString                     cacheDir;
+    // Budget Bytes
+    qint64                      budgetBytes;
+    // Hash Mutex
+    QMutex                      hashMutex;
+    // Content Hashes - Keyed By File Path
+    QHash<QString, HashEntry>   contentHashes;
+};
+
+// Compare Files At 16 Bits Per Channel Through the Result Cache - Compare Mask of the Left File Applied
+bool compareFilesDeepCached(const QString& aLeftFile, const QString& aRightFile, const quint16& aTolerance, CachedCompareResult& aResult, bool& aCached, QString& aError,
+                            const QPoint& aAlignOffset = QPoint(0, 0));
+
+#endif // RESULTCACHE_H
@@ -0,0 +1,335 @@
+#include <QDebug>
+
+#include <string.h>
+
+#ifdef Q_OS_UNIX
+
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+
+#endif // Q_OS_UNIX
+
+#include "sharedimage.h"
+#include "constants.h"
+
+#ifdef Q_OS_UNIX
+
+//==============================================================================
+// Mapped Region - Cleanup Info of Wrapped Images
+//==============================================================================
+struct MappedRegion
+{
+    // Address
+    void*       address;
+    // Size
+    size_t      size;
+};
+
+//==============================================================================
+// Unmap Shared Image - Called By QImage When the Last Copy Is Destroyed
+//==============================================================================
+static void unmapSharedImage(void* aInfo)
+{
+    // Get Region
+    MappedRegion* region = (MappedRegion*)aInfo;
+
+    // Unmap Region
+    munmap(region->address, region->size);
+
+    // Delete Region
+    delete region;
+}
+
+#endif // Q_OS_UNIX
+
+//==============================================================================
+// Check If Source Names a Shared Image - shm:<name>
+//==============================================================================
+bool isSharedImageSource(const QString& aSource)
+{
+    return aSource.startsWith(DEFAULT_SHARED_IMAGE_PREFIX);
+}
+
+//==============================================================================
+// Read Shared Image By Name - Mapped, Not Copied
+//==============================================================================
+QImage readSharedImage(const QString& aSource, QString& aError)
+{
+#ifdef Q_OS_UNIX
+
+    // Get Name
+    QByteArray name = aSource.mid(QString(DEFAULT_SHARED_IMAGE_PREFIX).length()).toLocal8Bit();
+
+    // Open Shared Memory Object - Read Only, the Renderer Owns It
+    int descriptor = shm_open(name.constData(), O_RDONLY, 0);
+
+    // Check Descriptor
+    if (descriptor < 0) {
+        // Set Error
+        aError = aSource + ": " + QString::fromLocal8Bit(strerror(errno));
+        return QImage();
+    }
+
+    return mapSharedImage(descriptor, aError);
+
+#else // Q_OS_UNIX
+
+    // Set Error
+    aError = aSource + ": shared images need a POSIX system";
+
+    return QImage();
+
+#endif // Q_OS_UNIX
+}
+
+//==============================================================================
+// Wrap Shared Image Data - Header Validated, Pixels Not Copied. Cleanup Is Not Called On Failure
+//==============================================================================
+QImage wrapSharedImage(const uchar* aData, const qint64& aSize, QImageCleanupFunction aCleanupFunction, void* aCleanupInfo, QString& aError)
+{
+    // Check Size
+    if (aSize < (qint64)sizeof(SharedImageHeader)) {
+        // Set Error
+        aError = QString("Shared image too small");
+        return QImage();
+    }
+
+    // Init Header
+    SharedImageHeader header;
+    // Copy Header
+    memcpy(&header, aData, sizeof(header));
+
+    // Get Format
+    QImage::Format format = (QImage::Format)header.format;
+
+    // Check Header - Every Line Must Lie Within the Data
+    if (header.magic != DEFAULT_SHARED_IMAGE_MAGIC || header.version != DEFAULT_SHARED_IMAGE_VERSION ||
+        format <= QImage::Format_Invalid || format >= QImage::NImageFormats ||
+        header.width == 0 || header.height == 0 || header.dataOffset % 4 != 0 ||
+        (quint64)header.stride * 8 < (quint64)header.width * QImage::toPixelFormat(format).bitsPerPixel() ||
+        header.dataOffset + (quint64)header.stride * header.height > (quint64)aSize) {
+        // Set Error
+        aError = QString("Invalid shared image header");
+        return QImage();
+    }
+
+    // Wrap Pixels - No Copy, Writes Would Detach Into a Private Copy
+    return QImage(aData + header.dataOffset, header.width, header.height, header.stride, format, aCleanupFunction, aCleanupInfo);
+}
+
+//==============================================================================
+// Map Shared Image From Descriptor - Takes Ownership of the Descriptor, Unmapped When the Last Image Copy Goes
+//==============================================================================
+QImage mapSharedImage(const int& aDescriptor, QString& aError)
+{
+#ifdef Q_OS_UNIX
+
+    // Init Stat
+    struct stat descriptorStat;
+
+    // Get Size
+    if (fstat(aDescriptor, &descriptorStat) != 0 || descriptorStat.st_size < (off_t)sizeof(SharedImageHeader)) {
+        // Set Error
+        aError = QString("Shared image too small");
+        // Close Descriptor
+        ::close(aDescriptor);
+        return QImage();
+    }
+
+    // Get Size
+    size_t size = (size_t)descriptorStat.st_size;
+    // Map Object
+    void* address = mmap(NULL, size, PROT_READ, MAP_SHARED, aDescriptor, 0);
+
+    // Close Descriptor - The Mapping Keeps the Object Alive
+    ::close(aDescriptor);
+
+    // Check Address
+    if (address == MAP_FAILED) {
+        // Set Error
+        aError = QString::fromLocal8Bit(strerror(errno));
+        return QImage();
+    }
+
+    // Init Region
+    MappedRegion* region = new MappedRegion;
+    region->address = address;
+    region->size = size;
+
+    // Wrap Pixels
+    QImage image = wrapSharedImage((const uchar*)address, size, unmapSharedImage, region, aError);
+
+    // Check Image
+    if (image.isNull()) {
+        // Unmap Region
+        unmapSharedImage(region);
+    }
+
+    return image;
+
+#else // Q_OS_UNIX
+
+    Q_UNUSED(aDescriptor);
+
+    // Set Error
+    aError = QString("Shared images need a POSIX system");
+
+    return QImage();
+
+#endif // Q_OS_UNIX
+}
+
+//==============================================================================
+// Send Shared Compare Request Over a Connected Local Socket Descriptor
+//==============================================================================
+bool sendSharedCompareRequest(const int& aSocketDescriptor, const quint32& aRequestID, const quint16& aTolerance, const int& aLeftDescriptor, const int& aRightDescriptor)
+{
+#ifdef Q_OS_UNIX
+
+    // Init Request
+    SharedCompareRequest request;
+    request.magic = DEFAULT_SHARED_IMAGE_MAGIC;
+    request.requestID = aRequestID;
+    request.tolerance = aTolerance;
+
+    // Init Data Vector
+    struct iovec dataVector;
+    dataVector.iov_base = &request;
+    dataVector.iov_len = sizeof(request);
+
+    // Init Control Buffer - Aligned For cmsghdr
+    union {
+        char            buffer[CMSG_SPACE(2 * sizeof(int))];
+        struct cmsghdr  align;
+    } control;
+    memset(&control, 0, sizeof(control));
+
+    // Init Message
+    struct msghdr message;
+    memset(&message, 0, sizeof(message));
+    message.msg_iov = &dataVector;
+    message.msg_iovlen = 1;
+    message.msg_control = control.buffer;
+    message.msg_controllen = sizeof(control.buffer);
+
+    // Set Descriptors
+    struct cmsghdr* controlMessage = CMSG_FIRSTHDR(&message);
+    controlMessage->cmsg_level = SOL_SOCKET;
+    controlMessage->cmsg_type = SCM_RIGHTS;
+    controlMessage->cmsg_len = CMSG_LEN(2 * sizeof(int));
+    int descriptors[2] = { aLeftDescriptor, aRightDescriptor };
+    memcpy(CMSG_DATA(controlMessage), descriptors, sizeof(descriptors));
+
+    return sendmsg(aSocketDescriptor, &message, 0) == (ssize_t)sizeof(request);
+
+#else // Q_OS_UNIX
+
+    Q_UNUSED(aSocketDescriptor);
+    Q_UNUSED(aRequestID);
+    Q_UNUSED(aTolerance);
+    Q_UNUSED(aLeftDescriptor);
+    Q_UNUSED(aRightDescriptor);
+
+    return false;
+
+#endif // Q_OS_UNIX
+}
+
+//==============================================================================
+// Receive Shared Compare Request - Returns 1 On Request, 0 If Nothing Complete Yet, -1 On Close Or Error
+//==============================================================================
+int receiveSharedCompareRequest(const int& aSocketDescriptor, SharedCompareRequest& aRequest, int& aLeftDescriptor, int& aRightDescriptor)
+{
+    // Reset Descriptors
+    aLeftDescriptor = -1;
+    aRightDescriptor = -1;
+
+#ifdef Q_OS_UNIX
+
+    // Init Data Vector
+    struct iovec dataVector;
+    dataVector.iov_base = &aRequest;
+    dataVector.iov_len = sizeof(aRequest);
+
+    // Init Control Buffer
+    union {
+        char            buffer[CMSG_SPACE(2 * sizeof(int))];
+        struct cmsghdr  align;
+    } control;
+
+    // Init Message
+    struct msghdr message;
+    memset(&message, 0, sizeof(message));
+    message.msg_iov = &dataVector;
+    message.msg_iovlen = 1;
+    message.msg_control = control.buffer;
+    message.msg_controllen = sizeof(control.buffer);
+
+    // Receive Message - Requests Are Sent Whole By sendmsg, Descriptors Closed On Exec
+    ssize_t received = recvmsg(aSocketDescriptor, &message, MSG_DONTWAIT | MSG_CMSG_CLOEXEC);
+
+    // Check Nothing Available
+    if (received < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)) {
+        return 0;
+    }
+
+    // Go Thru Control Messages - Take Every Descriptor So None Leaks
+    for (struct cmsghdr* controlMessage = CMSG_FIRSTHDR(&message); received > 0 && controlMessage; controlMessage = CMSG_NXTHDR(&message, controlMessage)) {
+        // Check Rights
+        if (controlMessage->cmsg_level == SOL_SOCKET && controlMessage->cmsg_type == SCM_RIGHTS) {
+            // Get Descriptor Count
+            int count = (controlMessage->cmsg_len - CMSG_LEN(0)) / sizeof(int);
+            // Init Descriptors
+            int descriptors[2] = { -1, -1 };
+            // Copy Descriptors
+            memcpy(descriptors, CMSG_DATA(controlMessage), qMin(count, 2) * sizeof(int));
+
+            // Go Thru Extra Descriptors
+            for (int i = 2; i < count; i++) {
+                // Init Extra Descriptor
+                int extra = -1;
+                memcpy(&extra, CMSG_DATA(controlMessage) + i * sizeof(int), sizeof(int));
+                // Close Extra Descriptor
+                ::close(extra);
+            }
+
+            // Set Descriptors
+            aLeftDescriptor = descriptors[0];
+            aRightDescriptor = descriptors[1];
+        }
+    }
+
+    // Check Request
+    if (received != (ssize_t)sizeof(aRequest) || aRequest.magic != DEFAULT_SHARED_IMAGE_MAGIC || aLeftDescriptor < 0 || aRightDescriptor < 0) {
+        // Check Closed - Orderly Shutdown
+        if (received != 0) {
+            qDebug() << "receiveSharedCompareRequest - received: " << received << " - ERROR: INVALID REQUEST!";
+        }
+
+        // Close Descriptors
+        if (aLeftDescriptor >= 0) {
+            ::close(aLeftDescriptor);
+        }
+
+        if (aRightDescriptor >= 0) {
+            ::close(aRightDescriptor);
+        }
+
+        return -1;
+    }
+
+    return 1;
+
+#else // Q_OS_UNIX
+
+    Q_UNUSED(aSocketDescriptor);
+    Q_UNUSED(aRequest);
+
+    return -1;
+
+#endif // Q_OS_UNIX
+}
@@ -0,0 +1,65 @@
+#ifndef SHAREDIMAGE_H
+#define SHAREDIMAGE_H
+
+#include <QString>
+#include <QImage>
+
+//==============================================================================
+// Shared Image Header - At Offset 0 of a POSIX Shared Memory Object Or memfd
+//
+// Pixels Follow At dataOffset, height Lines of stride Bytes In QImage::Format format.
+// Renderers Fill the Object & Pass It By Name As shm:<name> Or By Descriptor Over
+// the Daemon's Descriptor Socket, It Is Wrapped As a QImage Without Copying
+//==============================================================================
+struct SharedImageHeader
+{
+    // Magic
+    quint32     magic;
+    // Format Version
+    quint32     version;
+    // Width
+    quint32     width;
+    // Height
+    quint32     height;
+    // Bytes Per Line
+    quint32     stride;
+    // QImage::Format
+    quint32     format;
+    // Offset of the First Line - 4 Byte Aligned
+    quint32     dataOffset;
+    // Reserved
+    quint32     reserved;
+};
+
+//==============================================================================
+// Shared Compare Request - Sent With the Left & Right Descriptors As SCM_RIGHTS
+//==============================================================================
+struct SharedCompareRequest
+{
+    // Magic
+    quint32     magic;
+    // Request ID
+    quint32     requestID;
+    // Tolerance In 16 Bit Channel Units
+    quint32     tolerance;
+};
+
+// Check If Source Names a Shared Image - shm:<name>
+bool isSharedImageSource(const QString& aSource);
+
+// Read Shared Image By Name - Mapped, Not Copied
+QImage readSharedImage(const QString& aSource, QString& aError);
+
+// Wrap Shared Image Data - Header Validated, Pixels Not Copied. Cleanup Is Not Called On Failure
+QImage wrapSharedImage(const uchar* aData, const qint64& aSize, QImageCleanupFunction aCleanupFunction, void* aCleanupInfo, QString& aError);
+
+// Map Shared Image From Descriptor - Takes Ownership of the Descriptor, Unmapped When the Last Image Copy Goes
+QImage mapSharedImage(const int& aDescriptor, QString& aError);
+
+// Send Shared Compare Request Over a Connected Local Socket Descriptor
+bool sendSharedCompareRequest(const int& aSocketDescriptor, const quint32& aRequestID, const quint16& aTolerance, const int& aLeftDescriptor, const int& aRightDescriptor);
+
+// Receive Shared Compare Request - Returns 1 On Request, 0 If Nothing Complete Yet, -1 On Close Or Error
+int receiveSharedCompareRequest(const int& aSocketDescriptor, SharedCompareRequest& aRequest, int& aLeftDescriptor, int& aRightDescriptor);
+
+#endif // SHAREDIMAGE_H
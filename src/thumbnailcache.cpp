@@ -0,0 +1,443 @@
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QUrl>
+#include <QImageReader>
+#include <QStandardPaths>
+#include <QCryptographicHash>
+#include <QRunnable>
+#include <QThread>
+#include <QAtomicInt>
+#include <QMutexLocker>
+#include <QtEndian>
+
+#include <string.h>
+
+#include "thumbnailcache.h"
+#include "mappedimage.h"
+#include "constants.h"
+#include "defaultsettings.h"
+
+// Thumbnail Cache Singleton
+static ThumbnailCache* thumbnailCache = NULL;
+
+//==============================================================================
+// Read TIFF Value - 2 Or 4 Bytes In the Byte Order of the EXIF Block
+//==============================================================================
+static quint32 tiffValue(const uchar* aData, const int& aBytes, const bool& aBigEndian)
+{
+    // Check Bytes
+    if (aBytes == 2) {
+        return aBigEndian ? qFromBigEndian<quint16>(aData) : qFromLittleEndian<quint16>(aData);
+    }
+
+    return aBigEndian ? qFromBigEndian<quint32>(aData) : qFromLittleEndian<quint32>(aData);
+}
+
+//==============================================================================
+// Read Thumbnail of EXIF Block - Stored In IFD1 As a Small JPEG
+//==============================================================================
+static QImage exifThumbnail(const uchar* aTiff, const quint32& aSize)
+{
+    // Check Size
+    if (aSize < 8) {
+        return QImage();
+    }
+
+    // Get Byte Order
+    bool bigEndian = aTiff[0] == 'M';
+    // Get IFD0 Offset
+    quint32 ifdOffset = tiffValue(aTiff + 4, 4, bigEndian);
+
+    // Check IFD0
+    if (ifdOffset + 2 > aSize) {
+        return QImage();
+    }
+
+    // Get Next IFD Offset Position - After the IFD0 Entries
+    quint32 nextPosition = ifdOffset + 2 + tiffValue(aTiff + ifdOffset, 2, bigEndian) * 12;
+
+    // Check Next IFD Offset Position
+    if (nextPosition + 4 > aSize) {
+        return QImage();
+    }
+
+    // Get IFD1 Offset
+    ifdOffset = tiffValue(aTiff + nextPosition, 4, bigEndian);
+
+    // Check IFD1
+    if (ifdOffset == 0 || ifdOffset + 2 > aSize) {
+        return QImage();
+    }
+
+    // Get Entry Count
+    quint32 entryCount = tiffValue(aTiff + ifdOffset, 2, bigEndian);
+    // Init Thumbnail Offset & Length
+    quint32 thumbnailOffset = 0;
+    quint32 thumbnailLength = 0;
+
+    // Go Thru Entries
+    for (quint32 i = 0; i < entryCount; i++) {
+        // Get Entry Position
+        quint32 entryPosition = ifdOffset + 2 + i * 12;
+
+        // Check Entry
+        if (entryPosition + 12 > aSize) {
+            break;
+        }
+
+        // Switch Tag
+        switch (tiffValue(aTiff + entryPosition, 2, bigEndian)) {
+            case DEFAULT_EXIF_TAG_THUMBNAIL_OFFSET: thumbnailOffset = tiffValue(aTiff + entryPosition + 8, 4, bigEndian); break;
+            case DEFAULT_EXIF_TAG_THUMBNAIL_LENGTH: thumbnailLength = tiffValue(aTiff + entryPosition + 8, 4, bigEndian); break;
+            default: break;
+        }
+    }
+
+    // Check Thumbnail
+    if (thumbnailOffset == 0 || thumbnailLength == 0 || thumbnailOffset + thumbnailLength > aSize) {
+        return QImage();
+    }
+
+    return QImage::fromData(aTiff + thumbnailOffset, thumbnailLength, "JPG");
+}
+
+//==============================================================================
+// Read Embedded EXIF Thumbnail of JPEG File - Null If There Is None
+//==============================================================================
+static QImage readExifThumbnail(const QString& aFilePath)
+{
+    // Init File
+    QFile file(aFilePath);
+
+    // Open File
+    if (!file.open(QIODevice::ReadOnly)) {
+        return QImage();
+    }
+
+    // Read Head - APP1 Segments Are Limited To 64 KB
+    QByteArray head = file.read(DEFAULT_THUMBNAIL_EXIF_READ_SIZE);
+    // Get Data
+    const uchar* data = (const uchar*)head.constData();
+    // Get Size
+    int size = head.size();
+
+    // Check Start of Image
+    if (size < 4 || data[0] != 0xFF || data[1] != 0xD8) {
+        return QImage();
+    }
+
+    // Go Thru Segments
+    for (int position = 2; position + 4 <= size && data[position] == 0xFF; ) {
+        // Get Marker
+        uchar marker = data[position + 1];
+        // Get Segment Length - Length Field Included
+        int length = (data[position + 2] << 8) | data[position + 3];
+
+        // Check Start of Scan - No Metadata After It
+        if (marker == 0xDA) {
+            break;
+        }
+
+        // Check EXIF Segment
+        if (marker == 0xE1 && length >= 16 && position + 2 + length <= size && memcmp(data + position + 4, "Exif\0\0", 6) == 0) {
+            return exifThumbnail(data + position + 10, length - 8);
+        }
+
+        // Next Segment
+        position += 2 + length;
+    }
+
+    return QImage();
+}
+
+
+
+//==============================================================================
+// Thumbnail Response Class - Produced On the Thumbnail Pool
+//==============================================================================
+class ThumbnailResponse : public QQuickImageResponse, public QRunnable
+{
+public:
+
+    // Constructor
+    ThumbnailResponse(const QString& aFilePath, const QSize& aRequestedSize)
+        : filePath(aFilePath)
+        , requestedSize(aRequestedSize)
+        , cancelled(0)
+    {
+        // Set Auto Delete - The Engine Deletes Responses
+        setAutoDelete(false);
+    }
+
+    // Get Texture Factory
+    virtual QQuickTextureFactory* textureFactory() const
+    {
+        return QQuickTextureFactory::textureFactoryForImage(image);
+    }
+
+    // Run
+    virtual void run()
+    {
+        // Check Cancelled - Delegate Scrolled Out Before Its Turn
+        if (!cancelled.load()) {
+            // Get Thumbnail
+            image = ThumbnailCache::getInstance()->thumbnail(filePath);
+
+            // Check Requested Size
+            if (!image.isNull() && requestedSize.isValid() && (image.width() > requestedSize.width() || image.height() > requestedSize.height())) {
+                // Scale Image
+                image = image.scaled(requestedSize, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+            }
+        }
+
+        // Emit Finished Signal - Cancelled Responses Too, So the Engine Cleans Up
+        emit finished();
+    }
+
+    // Cancel
+    virtual void cancel()
+    {
+        // Set Cancelled
+        cancelled.store(1);
+    }
+
+private:
+    // File Path
+    QString     filePath;
+    // Requested Size
+    QSize       requestedSize;
+    // Image
+    QImage      image;
+    // Cancelled
+    QAtomicInt  cancelled;
+};
+
+
+
+//==============================================================================
+// Static Constructor
+//==============================================================================
+ThumbnailCache* ThumbnailCache::getInstance()
+{
+    // Check Singleton
+    if (!thumbnailCache) {
+        // Create Thumbnail Cache
+        thumbnailCache = new ThumbnailCache();
+    }
+
+    return thumbnailCache;
+}
+
+//==============================================================================
+// Release Instance
+//==============================================================================
+void ThumbnailCache::release()
+{
+    // Delete Thumbnail Cache
+    delete thumbnailCache;
+    // Reset Singleton
+    thumbnailCache = NULL;
+}
+
+//==============================================================================
+// Constructor
+//==============================================================================
+ThumbnailCache::ThumbnailCache()
+    : thumbnailDir(QDir(QStandardPaths::writableLocation(QStandardPaths::GenericCacheLocation)).filePath(DEFAULT_THUMBNAIL_DIR_NAME))
+    , memoryCache(DEFAULT_THUMBNAIL_MEMORY_CACHE_MB * 1024)
+{
+    qDebug() << "ThumbnailCache::ThumbnailCache - thumbnailDir: " << thumbnailDir;
+
+    // Set Max Thread Count - Leave Cores To the Compositor
+    thumbnailPool.setMaxThreadCount(qMax(1, QThread::idealThreadCount() / 2));
+}
+
+//==============================================================================
+// Get Thumbnail Pool
+//==============================================================================
+QThreadPool* ThumbnailCache::pool()
+{
+    return &thumbnailPool;
+}
+
+//==============================================================================
+// Get Thumbnail - Null If the File Can Not Be Read
+//==============================================================================
+QImage ThumbnailCache::thumbnail(const QString& aFilePath)
+{
+    // Get File Info
+    QFileInfo fileInfo(aFilePath);
+
+    // Check File
+    if (!fileInfo.isFile()) {
+        return QImage();
+    }
+
+    // Get Modification Time - Seconds, As the Thumbnail Spec Stores It
+    QString modified = QString::number(fileInfo.lastModified().toMSecsSinceEpoch() / 1000);
+    // Get Memory Key
+    QString key = fileInfo.absoluteFilePath() + '\n' + modified;
+
+    // Lock Cache
+    QMutexLocker locker(&cacheMutex);
+
+    // Check Memory Cache
+    if (memoryCache.contains(key)) {
+        return *memoryCache.object(key);
+    }
+
+    // Unlock Cache
+    locker.unlock();
+
+    // Get File URI
+    QByteArray fileURI = QUrl::fromLocalFile(fileInfo.absoluteFilePath()).toEncoded();
+    // Get Thumbnail File Path
+    QString thumbnailPath = thumbnailFilePath(fileURI);
+    // Read Stored Thumbnail
+    QImage image(thumbnailPath);
+
+    // Check Stored Thumbnail - Stale Once the File Changed
+    if (image.isNull() || image.text(DEFAULT_THUMBNAIL_KEY_MTIME) != modified) {
+        // Generate Thumbnail
+        image = generate(aFilePath);
+
+        // Check Image
+        if (!image.isNull()) {
+            // Set Thumbnail Keys
+            image.setText(DEFAULT_THUMBNAIL_KEY_URI, QString::fromLatin1(fileURI));
+            image.setText(DEFAULT_THUMBNAIL_KEY_MTIME, modified);
+
+            // Create Thumbnail Dir - Private To the User As the Spec Asks
+            if (QDir().mkpath(QFileInfo(thumbnailPath).absolutePath())) {
+                QFile::setPermissions(QFileInfo(thumbnailPath).absolutePath(), QFile::ReadOwner | QFile::WriteOwner | QFile::ExeOwner);
+            }
+
+            // Init Thumbnail File - Renamed Into Place, Other Readers Never See a Partial One
+            QSaveFile thumbnailFile(thumbnailPath);
+
+            // Write Thumbnail
+            if (!thumbnailFile.open(QIODevice::WriteOnly) || !image.save(&thumbnailFile, "PNG") || !thumbnailFile.commit()) {
+                qDebug() << "ThumbnailCache::thumbnail - thumbnailPath: " << thumbnailPath << " - ERROR: " << thumbnailFile.errorString();
+            }
+        }
+    }
+
+    // Lock Cache
+    locker.relock();
+
+    // Insert Into Memory Cache - Failures Too, So They Are Not Retried While Scrolling
+    memoryCache.insert(key, new QImage(image), qMax(1, image.byteCount() / 1024));
+
+    return image;
+}
+
+//==============================================================================
+// Get Thumbnail File Path of File URI
+//==============================================================================
+QString ThumbnailCache::thumbnailFilePath(const QByteArray& aFileURI)
+{
+    return QString("%1/%2.png").arg(thumbnailDir).arg(QString::fromLatin1(QCryptographicHash::hash(aFileURI, QCryptographicHash::Md5).toHex()));
+}
+
+//==============================================================================
+// Generate Thumbnail
+//==============================================================================
+QImage ThumbnailCache::generate(const QString& aFilePath)
+{
+    // Init Image
+    QImage image;
+    // Get Suffix
+    QString suffix = QFileInfo(aFilePath).suffix().toLower();
+
+    // Check JPEG - Cameras Embed Small Previews
+    if (suffix == DEFAULT_SUPPORTED_FORMAT_JPG || suffix == DEFAULT_SUPPORTED_FORMAT_JPEG) {
+        // Read EXIF Thumbnail
+        image = readExifThumbnail(aFilePath);
+    }
+
+    // Check Image & Mapped Format - Uncompressed Pixels Are Sampled In Place
+    if (image.isNull() && isMappedImageFile(aFilePath)) {
+        // Init Error
+        QString error;
+        // Map Image
+        image = mapImageFile(aFilePath, error);
+    }
+
+    // Check Image
+    if (image.isNull()) {
+        // Init Reader
+        QImageReader reader(aFilePath);
+        // Get Size From Header
+        QSize size = reader.size();
+
+        // Check Size - JPEG Decodes At Reduced Resolution Then
+        if (size.isValid() && (size.width() > DEFAULT_THUMBNAIL_SIZE || size.height() > DEFAULT_THUMBNAIL_SIZE)) {
+            // Set Scaled Size
+            reader.setScaledSize(size.scaled(DEFAULT_THUMBNAIL_SIZE, DEFAULT_THUMBNAIL_SIZE, Qt::KeepAspectRatio));
+        }
+
+        // Read Image
+        image = reader.read();
+    }
+
+    // Check Image
+    if (image.isNull()) {
+        qDebug() << "ThumbnailCache::generate - aFilePath: " << aFilePath << " - ERROR READING IMAGE!";
+        return image;
+    }
+
+    // Check Size
+    if (image.width() > DEFAULT_THUMBNAIL_SIZE || image.height() > DEFAULT_THUMBNAIL_SIZE) {
+        // Check Large Image - Step Down Fast First, Smooth Scaling Reads Every Source Pixel
+        if (qMax(image.width(), image.height()) > DEFAULT_THUMBNAIL_SIZE * 4) {
+            // Scale Image
+            image = image.scaled(DEFAULT_THUMBNAIL_SIZE * 2, DEFAULT_THUMBNAIL_SIZE * 2, Qt::KeepAspectRatio, Qt::FastTransformation);
+        }
+
+        // Scale Image
+        image = image.scaled(DEFAULT_THUMBNAIL_SIZE, DEFAULT_THUMBNAIL_SIZE, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+    }
+
+    // Convert - Own Pixels, Not the Mapping, Stored As PNG
+    return image.convertToFormat(image.hasAlphaChannel() ? QImage::Format_ARGB32 : QImage::Format_RGB32);
+}
+
+//==============================================================================
+// Destructor
+//==============================================================================
+ThumbnailCache::~ThumbnailCache()
+{
+    // Clear Thread Pool
+    thumbnailPool.clear();
+    // Wait For Thumbnails In Progress
+    thumbnailPool.waitForDone();
+
+    qDebug() << "ThumbnailCache::~ThumbnailCache";
+}
+
+
+
+//==============================================================================
+// Constructor
+//==============================================================================
+ThumbnailProvider::ThumbnailProvider()
+    : QQuickAsyncImageProvider()
+{
+}
+
+//==============================================================================
+// Request Image Response - Served From the Thumbnail Pool
+//==============================================================================
+QQuickImageResponse* ThumbnailProvider::requestImageResponse(const QString& aID, const QSize& aRequestedSize)
+{
+    // Init Response - ID Is the Percent Encoded File Path
+    ThumbnailResponse* response = new ThumbnailResponse(QUrl::fromPercentEncoding(aID.toUtf8()), aRequestedSize);
+
+    // Start Response
+    ThumbnailCache::getInstance()->pool()->start(response);
+
+    return response;
+}
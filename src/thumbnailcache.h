@@ -0,0 +1,74 @@
+#ifndef THUMBNAILCACHE_H
+#define THUMBNAILCACHE_H
+
+#include <QString>
+#include <QImage>
+#include <QCache>
+#include <QMutex>
+#include <QThreadPool>
+#include <QQuickAsyncImageProvider>
+
+//==============================================================================
+// Thumbnail Cache Class - Small Previews For Browsing Dirs
+//
+// Previews Come From Memory, Then From the Shared Freedesktop Thumbnail Dir, Then
+// From Embedded EXIF Thumbnails Or Reduced Resolution Decodes, Stored For Next Time
+//==============================================================================
+class ThumbnailCache
+{
+public:
+
+    // Static Constructor
+    static ThumbnailCache* getInstance();
+    // Release Instance
+    void release();
+
+    // Get Thumbnail - Null If the File Can Not Be Read
+    QImage thumbnail(const QString& aFilePath);
+
+    // Get Thumbnail Pool
+    QThreadPool* pool();
+
+protected:
+
+    // Constructor
+    ThumbnailCache();
+
+    // Destructor
+    virtual ~ThumbnailCache();
+
+    // Get Thumbnail File Path of File URI
+    QString thumbnailFilePath(const QByteArray& aFileURI);
+
+    // Generate Thumbnail
+    QImage generate(const QString& aFilePath);
+
+private:
+
+    // Thumbnail Dir
+    QString                     thumbnailDir;
+    // Cache Mutex
+    QMutex                      cacheMutex;
+    // Memory Cache - Cost In KB
+    QCache<QString, QImage>     memoryCache;
+    // Thumbnail Pool
+    QThreadPool                 thumbnailPool;
+};
+
+
+
+//==============================================================================
+// Thumbnail Provider Class - Serves image://thumbnail/<path> To QML
+//==============================================================================
+class ThumbnailProvider : public QQuickAsyncImageProvider
+{
+public:
+
+    // Constructor
+    ThumbnailProvider();
+
+    // Request Image Response - Served From the Thumbnail Pool
+    virtual QQuickImageResponse* requestImageResponse(const QString& aID, const QSize& aRequestedSize);
+};
+
+#endif // THUMBNAILCACHE_H
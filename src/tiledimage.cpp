@@ -0,0 +1,1419 @@
+#include <QDebug>
+#include <QSettings>
+#include <QFileInfo>
+#include <QRunnable>
+#include <QThread>
+#include <QMutexLocker>
+#include <QMultiMap>
+#include <QQuickWindow>
+#include <QSGNode>
+#include <QSGSimpleTextureNode>
+#include <QSGTexture>
+
+#include <math.h>
+
+#include "tiledimage.h"
+#include "imagecache.h"
+#include "decodedcache.h"
+#include "imagescaler.h"
+#include "constants.h"
+#include "defaultsettings.h"
+
+
+//==============================================================================
+// Get Tile Key of Level & Tile Position
+//==============================================================================
+quint64 tileKey(const int& aLevel, const int& aTileX, const int& aTileY)
+{
+    return (quint64)aLevel << 48 | (quint64)aTileY << 24 | (quint64)aTileX;
+}
+
+//==============================================================================
+// Get Level Size - Each Level Halves the Previous One, As Stored Pyramids Do
+//==============================================================================
+static QSize levelSize(const QSize& aSize, const int& aLevel)
+{
+    return QSize(qMax(aSize.width() >> aLevel, 1), qMax(aSize.height() >> aLevel, 1));
+}
+
+//==============================================================================
+// Release Tile Source - Called By QImage When the Last Tile Wrapping It Is Destroyed
+//==============================================================================
+static void releaseTileSource(void* aInfo)
+{
+    // Delete Source Image - Drops the Reference Keeping Its Pixels
+    delete (QImage*)aInfo;
+}
+
+//==============================================================================
+// Get Overview Level - The First Level Fitting Into the Overview Size
+//==============================================================================
+static int overviewLevel(const QSize& aSize)
+{
+    // Init Level
+    int level = 0;
+
+    // Find Level
+    while (qMax(aSize.width(), aSize.height()) >> level > DEFAULT_TILED_IMAGE_OVERVIEW_SIZE) {
+        // Inc Level
+        level++;
+    }
+
+    return level;
+}
+
+
+
+//==============================================================================
+// Tiled Image Open Task Class - Opens a Source & Builds Its Overview
+//==============================================================================
+class TiledImageOpenTask : public QRunnable
+{
+public:
+
+    // Constructor
+    TiledImageOpenTask(TiledImage* aItem, const QString& aSource, const int& aFirstLevel)
+        : item(aItem)
+        , source(aSource)
+        , firstLevel(aFirstLevel)
+    {
+    }
+
+    // Run
+    virtual void run()
+    {
+        // Check Wanted - Stepped Past Before It Started
+        if (!isWanted()) {
+            // Post Overview Ready - Marks the Open Finished
+            QMetaObject::invokeMethod(item, "overviewReady", Qt::QueuedConnection, Q_ARG(QString, source));
+            return;
+        }
+
+        // Init Opened Source
+        TiledImage::OpenedSource openedSource;
+        // Set Last Modified - Taken Before Decoding, Changes Meanwhile Invalidate the Entry
+        openedSource.lastModified = QFileInfo(source).lastModified();
+
+        // Get Base Image - Mapped, From the Decoded Cache Or Decoded Once
+        QImage baseImage = ImageCache::getInstance()->image(source);
+        // Get Size
+        QSize size = baseImage.size();
+        // Get Overview Level
+        int lastLevel = baseImage.isNull() ? 0 : overviewLevel(size);
+
+        // Set Size - Kept When the Base Image Is Released
+        openedSource.size = size;
+
+        // Check Base Image
+        if (!baseImage.isNull()) {
+            // Init Level Images
+            openedSource.levelImages.resize(lastLevel + 1);
+            // Set Base Image
+            openedSource.levelImages[0] = baseImage;
+        }
+
+        // Get Alpha Mode
+        int alphaMode = ImageCache::getInstance()->getAlphaMode();
+
+        // Go Thru Levels - Stored Pyramid Levels Are Mapped, No Decode
+        for (int level = 1; level <= lastLevel; level++) {
+            // Lookup Level
+            QImage levelImage = DecodedCache::getInstance()->lookup(source, 0, alphaMode, level);
+
+            // Check Level Image - Levels Are Stored In Order
+            if (levelImage.isNull() || levelImage.size() != levelSize(size, level)) {
+                break;
+            }
+
+            // Set Level Image
+            openedSource.levelImages[level] = levelImage;
+        }
+
+        // Get Preload - Decided Once, a Preload Becoming Current Meanwhile Is Opened Again For Its Missing Levels
+        bool preload = !isCurrent();
+        // Get Inserted - Only the Current Source Pins the Base Image, Until Its Levels Are Built
+        bool inserted = !preload || baseImage.isNull();
+
+        // Lock Opened Sources
+        QMutexLocker locker(&item->openedMutex);
+
+        // Check Inserted
+        if (inserted) {
+            // Insert Opened Source
+            item->insertOpenedSource(source, openedSource);
+        }
+
+        // Unlock Opened Sources
+        locker.unlock();
+
+        // Check Inserted
+        if (inserted) {
+            // Post Source Opened - Tiles Can Start Before the Overview
+            QMetaObject::invokeMethod(item, "sourceOpened", Qt::QueuedConnection, Q_ARG(QString, source));
+        }
+
+        // Check Base Image & Wanted - Building the Levels Is the Expensive Part
+        if (!baseImage.isNull() && isWanted()) {
+            // Init Level - Stored Levels Are Kept
+            int level = 1;
+
+            // Go Thru Missing Levels - Each Built Once From the Level Below, Tiles Never Scale Down From the Base
+            for (; level <= lastLevel && isWanted(); level++) {
+                // Check Level Image
+                if (openedSource.levelImages[level].isNull()) {
+                    // Build Level Image
+                    openedSource.levelImages[level] = downscaleImage(openedSource.levelImages[level - 1], levelSize(size, level));
+                }
+            }
+
+            // Check Levels Built - Stepped Past Otherwise, the Overview Is Left Unset
+            if (level > lastLevel) {
+                // Set Overview - Last Level Fits the Overview Size
+                openedSource.overview = openedSource.levelImages[lastLevel];
+
+                // Check Last Level - Small Images Are Their Own Overview
+                if (lastLevel > 0) {
+                    // Get Kept Level - Preloads Keep Only the Levels Their First View Draws From
+                    int keptLevel = isCurrent() ? 1 : qBound(1, firstLevel, lastLevel);
+
+                    // Go Thru Released Levels - Level 0 Tiles Come From the Image Cache, Under Its Budget
+                    for (int level = 0; level < keptLevel; level++) {
+                        // Release Level Image
+                        openedSource.levelImages[level] = QImage();
+                    }
+
+                    // Release Base Image
+                    baseImage = QImage();
+                }
+
+                // Relock Opened Sources
+                locker.relock();
+
+                // Check Preload Or Opened Source - Evicted Meanwhile Otherwise
+                if (preload || item->openedSources.contains(source)) {
+                    // Insert Opened Source - Charged By Bytes Again With the Built Levels
+                    item->insertOpenedSource(source, openedSource);
+                }
+
+                // Unlock Opened Sources
+                locker.unlock();
+            }
+        }
+
+        // Post Overview Ready
+        QMetaObject::invokeMethod(item, "overviewReady", Qt::QueuedConnection, Q_ARG(QString, source));
+    }
+
+private:
+
+    // Check If Source Is Still Wanted
+    bool isWanted()
+    {
+        // Lock Opened Sources
+        QMutexLocker locker(&item->openedMutex);
+
+        return item->wantedSources.contains(source);
+    }
+
+    // Check If Source Is the Current One
+    bool isCurrent()
+    {
+        // Lock Opened Sources
+        QMutexLocker locker(&item->openedMutex);
+
+        return item->currentSource == source;
+    }
+
+    // Item
+    TiledImage*     item;
+    // Source
+    QString         source;
+    // First Level - Drawn By the First View of a Preload
+    int             firstLevel;
+};
+
+
+
+//==============================================================================
+// Tiled Image Tile Task Class - Decodes One Tile
+//==============================================================================
+class TiledImageTileTask : public QRunnable
+{
+public:
+
+    // Constructor
+    TiledImageTileTask(TiledImage* aItem, const QString& aSource, const int& aLevel, const int& aTileX, const int& aTileY, const QRect& aTileRect, const int& aGeneration)
+        : item(aItem)
+        , source(aSource)
+        , level(aLevel)
+        , tileX(aTileX)
+        , tileY(aTileY)
+        , tileRect(aTileRect)
+        , generation(aGeneration)
+    {
+    }
+
+    // Run
+    virtual void run()
+    {
+        // Get Key
+        quint64 key = tileKey(level, tileX, tileY);
+
+        // Lock Source
+        QMutexLocker locker(&item->sourceMutex);
+
+        // Check Generation & Wanted - Scrolled Out Before It Started
+        if (item->generation.load() != generation || !item->wantedTiles.contains(key)) {
+            return;
+        }
+
+        // Mark Running
+        item->runningTiles.insert(key);
+
+        // Unlock Source
+        locker.unlock();
+
+        // Init Source Level
+        int sourceLevel = 0;
+        // Get Level Source
+        QImage sourceImage = item->levelSource(level, sourceLevel);
+
+        // Check Base Level Released - Held By the Image Cache Instead
+        if (sourceImage.isNull() && sourceLevel == 0) {
+            // Get Base Image
+            sourceImage = ImageCache::getInstance()->image(source);
+        }
+
+        // Get Factor
+        int factor = 1 << (level - sourceLevel);
+        // Get Source Rect
+        QRect sourceRect = QRect(tileRect.topLeft() * factor, tileRect.size() * factor).intersected(sourceImage.rect());
+        // Init Tile
+        QImage tile;
+
+        // Check Source Rect
+        if (!sourceRect.isEmpty()) {
+            // Wrap Tile Over the Source Rows - No Copy, the Source Is Kept Until the Tile Is Uploaded
+            tile = QImage(sourceImage.constScanLine(sourceRect.y()) + sourceRect.x() * sourceImage.depth() / 8, sourceRect.width(), sourceRect.height(),
+                          sourceImage.bytesPerLine(), sourceImage.format(), releaseTileSource, new QImage(sourceImage));
+        }
+
+        // Check Factor - Area Averaged Down From the Nearest Finer Level
+        if (factor > 1 && !tile.isNull()) {
+            // Scale Tile
+            tile = downscaleImage(tile, tileRect.size());
+        }
+
+        // Relock Source
+        locker.relock();
+
+        // Unmark Running
+        item->runningTiles.remove(key);
+
+        // Check Generation
+        if (item->generation.load() == generation) {
+            // Post Tile Ready
+            QMetaObject::invokeMethod(item, "tileReady", Qt::QueuedConnection, Q_ARG(int, level), Q_ARG(int, tileX), Q_ARG(int, tileY), Q_ARG(QImage, tile), Q_ARG(int, generation));
+        }
+    }
+
+private:
+    // Item
+    TiledImage*     item;
+    // Source
+    QString         source;
+    // Level
+    int             level;
+    // Tile X
+    int             tileX;
+    // Tile Y
+    int             tileY;
+    // Tile Rect In Level Pixels
+    QRect           tileRect;
+    // Generation
+    int             generation;
+};
+
+
+
+//==============================================================================
+// Tiled Image Node Class - Overview & Tile Textures, Deleted On the Render Thread
+//==============================================================================
+class TiledImageNode : public QSGNode
+{
+public:
+
+    // Tile Texture
+    struct TileTexture
+    {
+        // Texture
+        QSGTexture*     texture;
+        // Bytes
+        qint64          bytes;
+        // Last Used Frame
+        quint64         lastUse;
+    };
+
+    // Constructor
+    TiledImageNode()
+        : QSGNode()
+        , overviewTexture(NULL)
+        , textureBytes(0)
+        , frame(0)
+        , usedNodes(0)
+    {
+    }
+
+    // Set Overview Texture
+    void setOverview(QSGTexture* aTexture)
+    {
+        // Delete Previous Overview Texture
+        delete overviewTexture;
+        // Set Overview Texture
+        overviewTexture = aTexture;
+    }
+
+    // Get Overview Texture
+    QSGTexture* overview()
+    {
+        return overviewTexture;
+    }
+
+    // Clear Textures
+    void clearTextures()
+    {
+        // Go Thru Tile Textures
+        foreach (const TileTexture& tileTexture, tileTextures) {
+            // Delete Texture
+            delete tileTexture.texture;
+        }
+
+        // Clear Tile Textures
+        tileTextures.clear();
+        // Reset Texture Bytes
+        textureBytes = 0;
+        // Reset Overview
+        setOverview(NULL);
+    }
+
+    // Insert Tile Texture
+    void insertTile(const quint64& aKey, QSGTexture* aTexture, const qint64& aBytes)
+    {
+        // Init Tile Texture
+        TileTexture tileTexture;
+        // Set Tile Texture
+        tileTexture.texture = aTexture;
+        tileTexture.bytes = aBytes;
+        tileTexture.lastUse = frame;
+
+        // Check Previous Texture
+        if (tileTextures.contains(aKey)) {
+            // Dec Texture Bytes
+            textureBytes -= tileTextures[aKey].bytes;
+            // Delete Previous Texture
+            delete tileTextures[aKey].texture;
+        }
+
+        // Insert Tile Texture
+        tileTextures[aKey] = tileTexture;
+        // Inc Texture Bytes
+        textureBytes += aBytes;
+    }
+
+    // Get Tile Texture - Marks It Used This Frame
+    QSGTexture* tile(const quint64& aKey)
+    {
+        // Find Tile Texture
+        QHash<quint64, TileTexture>::iterator it = tileTextures.find(aKey);
+
+        // Check Tile Texture
+        if (it == tileTextures.end()) {
+            return NULL;
+        }
+
+        // Set Last Use
+        it->lastUse = frame;
+
+        return it->texture;
+    }
+
+    // Evict Least Recently Used Tiles Over Budget - Returns Evicted Keys
+    QList<quint64> evict(const qint64& aBudgetBytes)
+    {
+        // Init Evicted Keys
+        QList<quint64> evictedKeys;
+
+        // Evict Least Recently Used - Tiles Drawn This Frame Are Kept
+        while (textureBytes > aBudgetBytes) {
+            // Init Oldest
+            QHash<quint64, TileTexture>::iterator oldest = tileTextures.end();
+
+            // Go Thru Tile Textures
+            for (QHash<quint64, TileTexture>::iterator it = tileTextures.begin(); it != tileTextures.end(); ++it) {
+                // Check Last Use
+                if (it->lastUse < frame && (oldest == tileTextures.end() || it->lastUse < oldest->lastUse)) {
+                    // Set Oldest
+                    oldest = it;
+                }
+            }
+
+            // Check Oldest
+            if (oldest == tileTextures.end()) {
+                break;
+            }
+
+            // Dec Texture Bytes
+            textureBytes -= oldest->bytes;
+            // Delete Texture
+            delete oldest->texture;
+            // Add Evicted Key
+            evictedKeys << oldest.key();
+            // Remove Tile Texture
+            tileTextures.erase(oldest);
+        }
+
+        return evictedKeys;
+    }
+
+    // Begin Frame - Draw Nodes Are Reused
+    void beginFrame()
+    {
+        // Inc Frame
+        frame++;
+        // Reset Used Nodes
+        usedNodes = 0;
+    }
+
+    // Draw Texture
+    void draw(QSGTexture* aTexture, const QRectF& aRect, const QRectF& aSourceRect, const QSGTexture::Filtering& aFiltering)
+    {
+        // Check Used Nodes
+        if (usedNodes == drawNodes.count()) {
+            // Create Draw Node
+            QSGSimpleTextureNode* drawNode = new QSGSimpleTextureNode();
+            // Append Child Node
+            appendChildNode(drawNode);
+            // Append Draw Node
+            drawNodes << drawNode;
+        }
+
+        // Get Draw Node
+        QSGSimpleTextureNode* drawNode = drawNodes[usedNodes++];
+
+        // Set Texture
+        drawNode->setTexture(aTexture);
+        // Set Rect
+        drawNode->setRect(aRect);
+        // Set Source Rect
+        drawNode->setSourceRect(aSourceRect);
+        // Set Filtering
+        drawNode->setFiltering(aFiltering);
+    }
+
+    // End Frame - Removes Unused Draw Nodes
+    void endFrame()
+    {
+        // Go Thru Unused Draw Nodes
+        while (drawNodes.count() > usedNodes) {
+            // Take Draw Node
+            QSGSimpleTextureNode* drawNode = drawNodes.takeLast();
+            // Remove Child Node
+            removeChildNode(drawNode);
+            // Delete Draw Node
+            delete drawNode;
+        }
+    }
+
+    // Destructor
+    virtual ~TiledImageNode()
+    {
+        // Clear Textures - Draw Nodes Are Deleted As Children
+        clearTextures();
+    }
+
+private:
+    // Overview Texture
+    QSGTexture*                     overviewTexture;
+    // Tile Textures
+    QHash<quint64, TileTexture>     tileTextures;
+    // Texture Bytes
+    qint64                          textureBytes;
+    // Frame
+    quint64                         frame;
+    // Draw Nodes
+    QList<QSGSimpleTextureNode*>    drawNodes;
+    // Used Draw Nodes
+    int                             usedNodes;
+};
+
+
+
+//==============================================================================
+// Constructor
+//==============================================================================
+TiledImage::TiledImage(QQuickItem* aParent)
+    : QQuickItem(aParent)
+    , source("")
+    , status(TSNull)
+    , zoomLevel(1.0)
+    , panPosX(0.0)
+    , panPosY(0.0)
+    , sourceSize(0, 0)
+    , levelCount(0)
+    , generation(0)
+    , overviewDirty(false)
+    , clearTextures(false)
+    , textureBudgetBytes((qint64)QSettings().value(SETTINGS_KEY_TILED_IMAGE_TEXTURE_CACHE_MB, DEFAULT_TILED_IMAGE_TEXTURE_CACHE_MB).toInt() * 1024 * 1024)
+    , requestScheduled(false)
+{
+    // Set Flags
+    setFlag(QQuickItem::ItemHasContents, true);
+
+    // Set Max Thread Count - Leave Room For the Render & GUI Threads
+    tilePool.setMaxThreadCount(qMax(1, QThread::idealThreadCount() / 2));
+    // Set Max Thread Count - Decoding the Current Source Never Waits For More Than One Preload
+    openPool.setMaxThreadCount(DEFAULT_TILED_IMAGE_OPEN_THREADS);
+}
+
+//==============================================================================
+// Get Source
+//==============================================================================
+QString TiledImage::getSource()
+{
+    return source;
+}
+
+//==============================================================================
+// Set Source - Opened In the Background, At Once When Preloaded
+//==============================================================================
+void TiledImage::setSource(const QString& aSource)
+{
+    // Check Source
+    if (source != aSource) {
+        qDebug() << "TiledImage::setSource - aSource: " << aSource;
+
+        // Set Source
+        source = aSource;
+
+        // Lock Source
+        QMutexLocker locker(&sourceMutex);
+
+        // Inc Generation - Queued & Running Tiles Are Dropped
+        generation.ref();
+        // Clear Level Images
+        levelImages.clear();
+        // Clear Wanted Tiles
+        wantedTiles.clear();
+
+        // Unlock Source
+        locker.unlock();
+
+        // Clear Tile Pool
+        tilePool.clear();
+        // Clear Pending Tiles
+        pendingTiles.clear();
+        // Clear Upload Tiles
+        uploadTiles.clear();
+        // Clear Textured Tiles
+        texturedTiles.clear();
+        // Reset Overview
+        overview = QImage();
+        // Reset Overview Dirty
+        overviewDirty = false;
+        // Set Clear Textures
+        clearTextures = true;
+
+        // Reset Source Size
+        sourceSize = QSize(0, 0);
+        // Reset Level Count
+        levelCount = 0;
+
+        // Emit Source Size Changed Signals
+        emit sourceWidthChanged(0);
+        emit sourceHeightChanged(0);
+
+        // Emit Source Changed Signal
+        emit sourceChanged(source);
+
+        // Update Wanted Sources - Opens No Longer Wanted Are Skipped
+        updateWantedSources();
+
+        // Check Source
+        if (source.isEmpty()) {
+            // Set Status
+            setStatus(TSNull);
+        } else {
+            // Set Status
+            setStatus(TSLoading);
+
+            // Apply Opened Source - Preloaded Sources Show At Once
+            if (!applyOpenedSource() || (status == TSReady && overview.isNull())) {
+                // Open Source - Ahead of Preloads
+                openSource(source, 1);
+            }
+        }
+
+        // Update
+        update();
+    }
+}
+
+//==============================================================================
+// Get Preload Sources
+//==============================================================================
+QStringList TiledImage::getPreloadSources()
+{
+    return preloadSources;
+}
+
+//==============================================================================
+// Set Preload Sources - Opened In Order When Idle, Dropped Ones Are Skipped
+//==============================================================================
+void TiledImage::setPreloadSources(const QStringList& aPreloadSources)
+{
+    // Check Preload Sources
+    if (preloadSources != aPreloadSources) {
+        // Set Preload Sources
+        preloadSources = aPreloadSources;
+        // Emit Preload Sources Changed Signal
+        emit preloadSourcesChanged(preloadSources);
+
+        // Update Wanted Sources
+        updateWantedSources();
+
+        // Go Thru Preload Sources
+        foreach (const QString& preloadSource, preloadSources) {
+            // Lock Opened Sources
+            QMutexLocker locker(&openedMutex);
+            // Check Opened Source
+            bool opened = openedSources.contains(preloadSource) && openedSources[preloadSource].lastModified == QFileInfo(preloadSource).lastModified();
+            // Unlock Opened Sources
+            locker.unlock();
+
+            // Check Opened
+            if (!opened) {
+                // Open Source - Behind the Current One
+                openSource(preloadSource, 0);
+            }
+        }
+    }
+}
+
+//==============================================================================
+// Get Status
+//==============================================================================
+int TiledImage::getStatus()
+{
+    return status;
+}
+
+//==============================================================================
+// Set Status
+//==============================================================================
+void TiledImage::setStatus(const int& aStatus)
+{
+    // Check Status
+    if (status != aStatus) {
+        // Set Status
+        status = aStatus;
+        // Emit Status Changed Signal
+        emit statusChanged(status);
+    }
+}
+
+//==============================================================================
+// Get Zoom Level
+//==============================================================================
+qreal TiledImage::getZoomLevel()
+{
+    return zoomLevel;
+}
+
+//==============================================================================
+// Set Zoom Level
+//==============================================================================
+void TiledImage::setZoomLevel(const qreal& aZoomLevel)
+{
+    // Check Zoom Level
+    if (zoomLevel != aZoomLevel && aZoomLevel > 0.0) {
+        // Set Zoom Level
+        zoomLevel = aZoomLevel;
+        // Emit Zoom Level Changed Signal
+        emit zoomLevelChanged(zoomLevel);
+        // Update
+        update();
+    }
+}
+
+//==============================================================================
+// Get Pan Pos X - Image Center Offset From the Item Center
+//==============================================================================
+qreal TiledImage::getPanPosX()
+{
+    return panPosX;
+}
+
+//==============================================================================
+// Set Pan Pos X
+//==============================================================================
+void TiledImage::setPanPosX(const qreal& aPanPosX)
+{
+    // Check Pan Pos X
+    if (panPosX != aPanPosX) {
+        // Set Pan Pos X
+        panPosX = aPanPosX;
+        // Emit Pan Pos X Changed Signal
+        emit panPosXChanged(panPosX);
+        // Update
+        update();
+    }
+}
+
+//==============================================================================
+// Get Pan Pos Y - Image Center Offset From the Item Center
+//==============================================================================
+qreal TiledImage::getPanPosY()
+{
+    return panPosY;
+}
+
+//==============================================================================
+// Set Pan Pos Y
+//==============================================================================
+void TiledImage::setPanPosY(const qreal& aPanPosY)
+{
+    // Check Pan Pos Y
+    if (panPosY != aPanPosY) {
+        // Set Pan Pos Y
+        panPosY = aPanPosY;
+        // Emit Pan Pos Y Changed Signal
+        emit panPosYChanged(panPosY);
+        // Update
+        update();
+    }
+}
+
+//==============================================================================
+// Get Source Width
+//==============================================================================
+int TiledImage::getSourceWidth()
+{
+    return sourceSize.width();
+}
+
+//==============================================================================
+// Get Source Height
+//==============================================================================
+int TiledImage::getSourceHeight()
+{
+    return sourceSize.height();
+}
+
+//==============================================================================
+// Source Opened Slot - Posted By the Open Task
+//==============================================================================
+void TiledImage::sourceOpened(const QString& aSource)
+{
+    // Check Source & Status - Preloads Only Fill the Opened Sources
+    if (aSource == source && status == TSLoading) {
+        // Apply Opened Source
+        applyOpenedSource();
+    }
+}
+
+//==============================================================================
+// Overview Ready Slot - Posted By the Open Task When Finished
+//==============================================================================
+void TiledImage::overviewReady(const QString& aSource)
+{
+    // Remove Opening Source
+    openingSources.remove(aSource);
+
+    // Check Source
+    if (aSource != source) {
+        return;
+    }
+
+    // Check Loading - Preloads Are Only Inserted Once Their Levels Are Built
+    if (status == TSLoading) {
+        // Apply Opened Source
+        if (!applyOpenedSource()) {
+            // Open Source - Skipped Before the Source Became Current
+            openSource(source, 1);
+        }
+
+        return;
+    }
+
+    // Init Opened Source
+    OpenedSource openedSource;
+    // Lock Opened Sources
+    QMutexLocker locker(&openedMutex);
+
+    // Check Opened Source
+    if (openedSources.contains(source)) {
+        // Get Opened Source
+        openedSource = openedSources[source];
+    }
+
+    // Unlock Opened Sources
+    locker.unlock();
+
+    // Check Levels Built
+    if (!openedSource.overview.isNull()) {
+        // Lock Source
+        QMutexLocker sourceLocker(&sourceMutex);
+        // Set Level Images - Built Levels, Base Image Released
+        levelImages = openedSource.levelImages;
+        // Unlock Source
+        sourceLocker.unlock();
+
+        // Check Overview - Kept If Already Shown
+        if (!overview.isNull()) {
+            return;
+        }
+
+        // Set Overview
+        overview = openedSource.overview;
+
+        // Set Overview Dirty
+        overviewDirty = true;
+        // Update
+        update();
+    } else if (overview.isNull() && status != TSError) {
+        // Open Source - Skipped, Or the Overview Was, Before the Source Became Current
+        openSource(source, 1);
+    }
+}
+
+//==============================================================================
+// Open Source - Unless Already Opening
+//==============================================================================
+void TiledImage::openSource(const QString& aSource, const int& aPriority)
+{
+    // Check Opening Sources
+    if (!openingSources.contains(aSource)) {
+        // Add Opening Source
+        openingSources.insert(aSource);
+        // Start Open Task - Preloads Are Trimmed To the Levels of the Current Zoom
+        openPool.start(new TiledImageOpenTask(this, aSource, zoomLevel >= 1.0 ? 0 : (int)floor(log2(1.0 / zoomLevel))), aPriority);
+    }
+}
+
+//==============================================================================
+// Apply Opened Source - False If Not Opened Yet Or Stale
+//==============================================================================
+bool TiledImage::applyOpenedSource()
+{
+    // Lock Opened Sources
+    QMutexLocker locker(&openedMutex);
+
+    // Check Opened Source
+    if (!openedSources.contains(source)) {
+        return false;
+    }
+
+    // Check Last Modified - Changed On Disk Since Opened
+    if (openedSources[source].lastModified != QFileInfo(source).lastModified()) {
+        // Remove Opened Source
+        openedSources.remove(source);
+        openedOrder.removeAll(source);
+        return false;
+    }
+
+    // Get Opened Source
+    OpenedSource openedSource = openedSources[source];
+
+    // Move To Front - Most Recently Used
+    openedOrder.removeAll(source);
+    openedOrder.prepend(source);
+
+    // Unlock Opened Sources
+    locker.unlock();
+
+    // Check Level Images
+    if (openedSource.levelImages.isEmpty()) {
+        qDebug() << "TiledImage::applyOpenedSource - source: " << source << " - ERROR OPENING SOURCE!";
+        // Set Status
+        setStatus(TSError);
+        return true;
+    }
+
+    // Lock Source
+    QMutexLocker sourceLocker(&sourceMutex);
+    // Set Level Images
+    levelImages = openedSource.levelImages;
+    // Unlock Source
+    sourceLocker.unlock();
+
+    // Set Source Size
+    sourceSize = openedSource.size;
+    // Set Level Count - Last Level Is the Overview
+    levelCount = levelImages.count();
+
+    // Emit Source Size Changed Signals
+    emit sourceWidthChanged(sourceSize.width());
+    emit sourceHeightChanged(sourceSize.height());
+
+    // Check Overview - Still Being Built Unless Preloaded
+    if (!openedSource.overview.isNull()) {
+        // Set Overview
+        overview = openedSource.overview;
+        // Set Overview Dirty
+        overviewDirty = true;
+    }
+
+    // Set Status - Tiles Start Arriving Before the Overview
+    setStatus(TSReady);
+
+    // Go Thru Levels Above the Base - Preloads Keep Only Their First View Levels
+    for (int level = 1; level < levelCount; level++) {
+        // Check Level Image
+        if (openedSource.levelImages[level].isNull()) {
+            // Open Source - Builds the Missing Levels, No Op While Still Opening
+            openSource(source, 1);
+            break;
+        }
+    }
+
+    // Update
+    update();
+
+    return true;
+}
+
+//==============================================================================
+// Insert Opened Source - Opened Mutex Held, Evicts Least Recently Used Unwanted Sources Over the Byte Budget
+//==============================================================================
+void TiledImage::insertOpenedSource(const QString& aSource, const OpenedSource& aOpenedSource)
+{
+    // Insert Opened Source
+    openedSources[aSource] = aOpenedSource;
+    // Move To Front
+    openedOrder.removeAll(aSource);
+    openedOrder.prepend(aSource);
+
+    // Init Opened Bytes
+    qint64 openedBytes = 0;
+
+    // Go Thru Opened Sources
+    foreach (const OpenedSource& openedSource, openedSources) {
+        // Go Thru Level Images - The Overview Is the Last Level
+        foreach (const QImage& levelImage, openedSource.levelImages) {
+            // Add Bytes
+            openedBytes += levelImage.byteCount();
+        }
+    }
+
+    // Go Thru Opened Sources From the Least Recently Used - Charged By Bytes, Level Images Are Not Under the Image Cache Budget
+    for (int i = openedOrder.count() - 1; i >= 0 && openedBytes > (qint64)DEFAULT_TILED_IMAGE_OPENED_MAX_MB * 1024 * 1024; i--) {
+        // Check Wanted
+        if (!wantedSources.contains(openedOrder[i])) {
+            // Go Thru Level Images of the Removed Source
+            foreach (const QImage& levelImage, openedSources[openedOrder[i]].levelImages) {
+                // Sub Bytes
+                openedBytes -= levelImage.byteCount();
+            }
+
+            // Remove Opened Source
+            openedSources.remove(openedOrder.takeAt(i));
+        }
+    }
+}
+
+//==============================================================================
+// Update Wanted Sources - Current & Preload Sources
+//==============================================================================
+void TiledImage::updateWantedSources()
+{
+    // Lock Opened Sources
+    QMutexLocker locker(&openedMutex);
+
+    // Set Wanted Sources
+    wantedSources = QSet<QString>::fromList(preloadSources);
+    // Set Current Source
+    currentSource = source;
+
+    // Check Source
+    if (!source.isEmpty()) {
+        // Add Source
+        wantedSources.insert(source);
+    }
+}
+
+//==============================================================================
+// Tile Ready Slot - Posted By Tile Tasks
+//==============================================================================
+void TiledImage::tileReady(const int& aLevel, const int& aTileX, const int& aTileY, const QImage& aTile, const int& aGeneration)
+{
+    // Get Key
+    quint64 key = tileKey(aLevel, aTileX, aTileY);
+
+    // Check Generation
+    if (aGeneration != generation.load()) {
+        return;
+    }
+
+    // Remove Pending Tile
+    pendingTiles.remove(key);
+
+    // Check Tile
+    if (aTile.isNull()) {
+        qDebug() << "TiledImage::tileReady - source: " << source << " - aLevel: " << aLevel << " - ERROR DECODING TILE!";
+        return;
+    }
+
+    // Add Upload Tile
+    uploadTiles[key] = aTile;
+
+    // Update
+    update();
+}
+
+//==============================================================================
+// Request Tiles - Queues the Missing Visible Tiles
+//==============================================================================
+void TiledImage::requestTiles()
+{
+    // Reset Request Scheduled
+    requestScheduled = false;
+
+    // Check Status
+    if (status != TSReady) {
+        return;
+    }
+
+    // Get Level
+    int level = levelForZoom();
+    // Init Wanted Keys
+    QList<quint64> wantedKeys;
+    // Init Visible Tiles
+    QList<QPoint> tiles;
+
+    // Check Level - The Overview Level Needs No Tiles
+    if (level < levelCount - 1) {
+        // Get Visible Tiles - With a Ring Around the Viewport For Panning
+        tiles = visibleTiles(level, DEFAULT_TILED_IMAGE_PRELOAD_TILES);
+    }
+
+    // Go Thru Tiles
+    foreach (const QPoint& tile, tiles) {
+        // Get Key
+        quint64 key = tileKey(level, tile.x(), tile.y());
+
+        // Check Textured & Uploading
+        if (!texturedTiles.contains(key) && !uploadTiles.contains(key)) {
+            // Add Wanted Key
+            wantedKeys << key;
+        }
+    }
+
+    // Clear Tile Pool - Queued Tiles No Longer Visible Are Dropped, Running Ones Finish
+    tilePool.clear();
+
+    // Lock Source
+    QMutexLocker locker(&sourceMutex);
+
+    // Set Wanted Tiles
+    wantedTiles = QSet<quint64>::fromList(wantedKeys);
+    // Reset Pending Tiles - Only the Running Ones Survived the Clear
+    pendingTiles = runningTiles;
+
+    // Unlock Source
+    locker.unlock();
+
+    // Init Priority - Nearest To the Center Runs First
+    int priority = tiles.count();
+
+    // Go Thru Tiles
+    foreach (const QPoint& tile, tiles) {
+        // Get Key
+        quint64 key = tileKey(level, tile.x(), tile.y());
+
+        // Check Wanted & Pending
+        if (wantedTiles.contains(key) && !pendingTiles.contains(key)) {
+            // Add Pending Tile
+            pendingTiles.insert(key);
+            // Start Tile Task
+            tilePool.start(new TiledImageTileTask(this, source, level, tile.x(), tile.y(), tileRect(level, tile.x(), tile.y()), generation.load()), priority);
+        }
+
+        // Dec Priority
+        priority--;
+    }
+}
+
+//==============================================================================
+// Get Image Rect In Item Coordinates
+//==============================================================================
+QRectF TiledImage::imageRect()
+{
+    // Get Image Width & Height
+    qreal imageWidth = sourceSize.width() * zoomLevel;
+    qreal imageHeight = sourceSize.height() * zoomLevel;
+
+    return QRectF(width() / 2 + panPosX - imageWidth / 2, height() / 2 + panPosY - imageHeight / 2, imageWidth, imageHeight);
+}
+
+//==============================================================================
+// Get Level For Zoom Level - 0 Is Full Resolution
+//==============================================================================
+int TiledImage::levelForZoom()
+{
+    // Check Zoom Level
+    if (zoomLevel >= 1.0 || levelCount <= 0) {
+        return 0;
+    }
+
+    // Get Level - Finer Side, Tiles Are Never Stretched When Zoomed Out
+    return qBound(0, (int)floor(log2(1.0 / zoomLevel)), levelCount - 1);
+}
+
+//==============================================================================
+// Get Tile Rect In Level Pixels
+//==============================================================================
+QRect TiledImage::tileRect(const int& aLevel, const int& aTileX, const int& aTileY)
+{
+    return QRect(aTileX * DEFAULT_TILED_IMAGE_TILE_SIZE, aTileY * DEFAULT_TILED_IMAGE_TILE_SIZE, DEFAULT_TILED_IMAGE_TILE_SIZE, DEFAULT_TILED_IMAGE_TILE_SIZE).intersected(QRect(QPoint(0, 0), levelSize(sourceSize, aLevel)));
+}
+
+//==============================================================================
+// Get Tile Rect In Item Coordinates
+//==============================================================================
+QRectF TiledImage::tileItemRect(const int& aLevel, const QRect& aTileRect)
+{
+    // Get Image Rect
+    QRectF rect = imageRect();
+    // Get Level Size
+    QSize size = levelSize(sourceSize, aLevel);
+    // Get Scales - Level Pixel To Item, Exact At the Image Edges
+    qreal scaleX = rect.width() / size.width();
+    qreal scaleY = rect.height() / size.height();
+
+    return QRectF(rect.x() + aTileRect.x() * scaleX, rect.y() + aTileRect.y() * scaleY, aTileRect.width() * scaleX, aTileRect.height() * scaleY);
+}
+
+//==============================================================================
+// Get Visible Tiles of Level - Nearest To the Center First
+//==============================================================================
+QList<QPoint> TiledImage::visibleTiles(const int& aLevel, const int& aMargin)
+{
+    // Init Tiles
+    QList<QPoint> tiles;
+
+    // Get Image Rect
+    QRectF rect = imageRect();
+    // Get Visible Rect
+    QRectF visibleRect = rect.intersected(QRectF(0.0, 0.0, width(), height()));
+
+    // Check Visible Rect
+    if (visibleRect.isEmpty()) {
+        return tiles;
+    }
+
+    // Get Level Size
+    QSize size = levelSize(sourceSize, aLevel);
+    // Get Scales - Item To Level Pixel
+    qreal scaleX = size.width() / rect.width();
+    qreal scaleY = size.height() / rect.height();
+    // Get Tile Counts
+    int tileColumns = (size.width() + DEFAULT_TILED_IMAGE_TILE_SIZE - 1) / DEFAULT_TILED_IMAGE_TILE_SIZE;
+    int tileRows = (size.height() + DEFAULT_TILED_IMAGE_TILE_SIZE - 1) / DEFAULT_TILED_IMAGE_TILE_SIZE;
+
+    // Get Visible Tile Range
+    int firstColumn = qMax((int)((visibleRect.left() - rect.left()) * scaleX) / DEFAULT_TILED_IMAGE_TILE_SIZE - aMargin, 0);
+    int lastColumn = qMin((int)ceil((visibleRect.right() - rect.left()) * scaleX - 1) / DEFAULT_TILED_IMAGE_TILE_SIZE + aMargin, tileColumns - 1);
+    int firstRow = qMax((int)((visibleRect.top() - rect.top()) * scaleY) / DEFAULT_TILED_IMAGE_TILE_SIZE - aMargin, 0);
+    int lastRow = qMin((int)ceil((visibleRect.bottom() - rect.top()) * scaleY - 1) / DEFAULT_TILED_IMAGE_TILE_SIZE + aMargin, tileRows - 1);
+
+    // Get Center In Tiles
+    qreal centerColumn = (firstColumn + lastColumn) / 2.0;
+    qreal centerRow = (firstRow + lastRow) / 2.0;
+
+    // Init Distances
+    QMultiMap<qreal, QPoint> distances;
+
+    // Go Thru Tile Rows
+    for (int row = firstRow; row <= lastRow; row++) {
+        // Go Thru Tile Columns
+        for (int column = firstColumn; column <= lastColumn; column++) {
+            // Insert Tile By Distance
+            distances.insert((column - centerColumn) * (column - centerColumn) + (row - centerRow) * (row - centerRow), QPoint(column, row));
+        }
+    }
+
+    return distances.values();
+}
+
+//==============================================================================
+// Get Nearest Finer Level Image - Thread Safe, Null For a Released Base Image
+//==============================================================================
+QImage TiledImage::levelSource(const int& aLevel, int& aSourceLevel)
+{
+    // Lock Source
+    QMutexLocker locker(&sourceMutex);
+
+    // Init Source Level
+    aSourceLevel = qMin(aLevel, levelImages.count() - 1);
+
+    // Find Stored Level
+    while (aSourceLevel > 0 && levelImages[aSourceLevel].isNull()) {
+        // Dec Source Level
+        aSourceLevel--;
+    }
+
+    return aSourceLevel >= 0 ? levelImages[aSourceLevel] : QImage();
+}
+
+//==============================================================================
+// Update Paint Node
+//==============================================================================
+QSGNode* TiledImage::updatePaintNode(QSGNode* aOldNode, UpdatePaintNodeData* aData)
+{
+    Q_UNUSED(aData);
+
+    // Get Node
+    TiledImageNode* node = static_cast<TiledImageNode*>(aOldNode);
+
+    // Check Node - Textures Are Gone With the Previous One
+    if (!node) {
+        // Create Node
+        node = new TiledImageNode();
+        // Clear Textured Tiles
+        texturedTiles.clear();
+        // Set Overview Dirty
+        overviewDirty = !overview.isNull();
+        // Reset Clear Textures
+        clearTextures = false;
+    }
+
+    // Check Clear Textures
+    if (clearTextures) {
+        // Clear Textures
+        node->clearTextures();
+        // Reset Clear Textures
+        clearTextures = false;
+    }
+
+    // Check Overview Dirty
+    if (overviewDirty) {
+        // Set Overview Texture
+        node->setOverview(window()->createTextureFromImage(overview));
+        // Reset Overview Dirty
+        overviewDirty = false;
+    }
+
+    // Go Thru Upload Tiles
+    for (QHash<quint64, QImage>::const_iterator it = uploadTiles.constBegin(); it != uploadTiles.constEnd(); ++it) {
+        // Insert Tile Texture
+        node->insertTile(it.key(), window()->createTextureFromImage(it.value()), (qint64)it.value().width() * it.value().height() * 4);
+        // Add Textured Tile
+        texturedTiles.insert(it.key());
+    }
+
+    // Clear Upload Tiles
+    uploadTiles.clear();
+
+    // Begin Frame
+    node->beginFrame();
+
+    // Check Status
+    if (status == TSReady) {
+        // Get Image Rect
+        QRectF rect = imageRect();
+        // Get Visible Rect
+        QRectF visibleRect = rect.intersected(QRectF(0.0, 0.0, width(), height()));
+        // Get Filtering - Pixels Stay Sharp Zoomed In
+        QSGTexture::Filtering filtering = zoomLevel > 1.0 ? QSGTexture::Nearest : QSGTexture::Linear;
+        // Get Level
+        int level = levelForZoom();
+        // Init Missing Tiles
+        bool missingTiles = false;
+
+        // Check Overview Texture & Visible Rect - Fills In Under Missing Tiles
+        if (node->overview() && !visibleRect.isEmpty()) {
+            // Get Overview Scales
+            qreal scaleX = node->overview()->textureSize().width() / rect.width();
+            qreal scaleY = node->overview()->textureSize().height() / rect.height();
+
+            // Draw Visible Part of the Overview
+            node->draw(node->overview(), visibleRect, QRectF((visibleRect.x() - rect.x()) * scaleX, (visibleRect.y() - rect.y()) * scaleY, visibleRect.width() * scaleX, visibleRect.height() * scaleY), filtering);
+        }
+
+        // Check Level - The Overview Level Needs No Tiles
+        if (level < levelCount - 1) {
+            // Go Thru Visible Tiles
+            foreach (const QPoint& tile, visibleTiles(level, 0)) {
+                // Get Tile Texture
+                QSGTexture* texture = node->tile(tileKey(level, tile.x(), tile.y()));
+
+                // Check Tile Texture
+                if (texture) {
+                    // Draw Tile
+                    node->draw(texture, tileItemRect(level, tileRect(level, tile.x(), tile.y())), QRectF(QPointF(0.0, 0.0), texture->textureSize()), filtering);
+                }
+            }
+
+            // Go Thru Tiles Around the Viewport
+            foreach (const QPoint& tile, visibleTiles(level, DEFAULT_TILED_IMAGE_PRELOAD_TILES)) {
+                // Get Key
+                quint64 key = tileKey(level, tile.x(), tile.y());
+
+                // Check Textured & Pending
+                if (!texturedTiles.contains(key) && !pendingTiles.contains(key)) {
+                    // Set Missing Tiles
+                    missingTiles = true;
+                    break;
+                }
+            }
+        }
+
+        // Check Missing Tiles & Request Scheduled
+        if (missingTiles && !requestScheduled) {
+            // Set Request Scheduled
+            requestScheduled = true;
+            // Schedule Request Tiles - On the GUI Thread
+            QMetaObject::invokeMethod(this, "requestTiles", Qt::QueuedConnection);
+        }
+    }
+
+    // End Frame
+    node->endFrame();
+
+    // Go Thru Evicted Tiles - Least Recently Drawn Over Budget
+    foreach (quint64 key, node->evict(textureBudgetBytes)) {
+        // Remove Textured Tile
+        texturedTiles.remove(key);
+    }
+
+    return node;
+}
+
+//==============================================================================
+// Geometry Changed
+//==============================================================================
+void TiledImage::geometryChanged(const QRectF& aNewGeometry, const QRectF& aOldGeometry)
+{
+    QQuickItem::geometryChanged(aNewGeometry, aOldGeometry);
+
+    // Update
+    update();
+}
+
+//==============================================================================
+// Destructor
+//==============================================================================
+TiledImage::~TiledImage()
+{
+    // Inc Generation
+    generation.ref();
+    // Clear Tile Pool
+    tilePool.clear();
+    // Clear Open Pool
+    openPool.clear();
+    // Wait For Running Tasks - They Reference the Item
+    tilePool.waitForDone();
+    openPool.waitForDone();
+
+    qDebug() << "TiledImage::~TiledImage";
+}
@@ -0,0 +1,245 @@
+#ifndef TILEDIMAGE_H
+#define TILEDIMAGE_H
+
+#include <QQuickItem>
+#include <QImage>
+#include <QString>
+#include <QRectF>
+#include <QSet>
+#include <QList>
+#include <QHash>
+#include <QVector>
+#include <QMutex>
+#include <QThreadPool>
+#include <QAtomicInt>
+#include <QDateTime>
+#include <QStringList>
+
+// Get Tile Key of Level & Tile Position
+quint64 tileKey(const int& aLevel, const int& aTileX, const int& aTileY);
+
+//==============================================================================
+// Tiled Image Component Class - Draws Large Images From a Tile Pyramid
+//
+// Only the Tiles Covering the Viewport Are Decoded, At the Level Matching the Zoom,
+// Nearest To the Center First. Tiles Are Kept As Textures Up To a Budget, a
+// Downscaled Overview Fills In Until the Tiles Arrive. Preload Sources Are Opened
+// Ahead With the Levels of Their First View Only, So Stepping To Them Shows Their Overview At Once
+//==============================================================================
+class TiledImage : public QQuickItem
+{
+    Q_OBJECT
+
+    Q_PROPERTY(QString source READ getSource WRITE setSource NOTIFY sourceChanged)
+    Q_PROPERTY(QStringList preloadSources READ getPreloadSources WRITE setPreloadSources NOTIFY preloadSourcesChanged)
+    Q_PROPERTY(int status READ getStatus NOTIFY statusChanged)
+
+    Q_PROPERTY(qreal zoomLevel READ getZoomLevel WRITE setZoomLevel NOTIFY zoomLevelChanged)
+    Q_PROPERTY(qreal panPosX READ getPanPosX WRITE setPanPosX NOTIFY panPosXChanged)
+    Q_PROPERTY(qreal panPosY READ getPanPosY WRITE setPanPosY NOTIFY panPosYChanged)
+
+    Q_PROPERTY(int sourceWidth READ getSourceWidth NOTIFY sourceWidthChanged)
+    Q_PROPERTY(int sourceHeight READ getSourceHeight NOTIFY sourceHeightChanged)
+
+public:
+
+    // Tiled Image Status Type
+    enum TiledImageStatusType
+    {
+        TSNull = 0,
+        TSLoading,
+        TSReady,
+        TSError
+    };
+
+    Q_ENUMS(TiledImageStatusType)
+
+    // Constructor
+    TiledImage(QQuickItem* aParent = NULL);
+
+    // Get Source
+    QString getSource();
+    // Set Source - Opened In the Background, At Once When Preloaded
+    void setSource(const QString& aSource);
+
+    // Get Preload Sources
+    QStringList getPreloadSources();
+    // Set Preload Sources - Opened In Order When Idle, Dropped Ones Are Skipped
+    void setPreloadSources(const QStringList& aPreloadSources);
+
+    // Get Status
+    int getStatus();
+
+    // Get Zoom Level
+    qreal getZoomLevel();
+    // Set Zoom Level
+    void setZoomLevel(const qreal& aZoomLevel);
+
+    // Get Pan Pos X - Image Center Offset From the Item Center
+    qreal getPanPosX();
+    // Set Pan Pos X
+    void setPanPosX(const qreal& aPanPosX);
+
+    // Get Pan Pos Y - Image Center Offset From the Item Center
+    qreal getPanPosY();
+    // Set Pan Pos Y
+    void setPanPosY(const qreal& aPanPosY);
+
+    // Get Source Width
+    int getSourceWidth();
+    // Get Source Height
+    int getSourceHeight();
+
+    // Destructor
+    virtual ~TiledImage();
+
+signals:
+
+    // Source Changed Signal
+    void sourceChanged(const QString& aSource);
+    // Preload Sources Changed Signal
+    void preloadSourcesChanged(const QStringList& aPreloadSources);
+    // Status Changed Signal
+    void statusChanged(const int& aStatus);
+
+    // Zoom Level Changed Signal
+    void zoomLevelChanged(const qreal& aZoomLevel);
+    // Pan Pos X Changed Signal
+    void panPosXChanged(const qreal& aPanPosX);
+    // Pan Pos Y Changed Signal
+    void panPosYChanged(const qreal& aPanPosY);
+
+    // Source Width Changed Signal
+    void sourceWidthChanged(const int& aSourceWidth);
+    // Source Height Changed Signal
+    void sourceHeightChanged(const int& aSourceHeight);
+
+protected slots:
+
+    // Source Opened Slot - Posted By the Open Task
+    void sourceOpened(const QString& aSource);
+    // Overview Ready Slot - Posted By the Open Task When Finished
+    void overviewReady(const QString& aSource);
+    // Tile Ready Slot - Posted By Tile Tasks
+    void tileReady(const int& aLevel, const int& aTileX, const int& aTileY, const QImage& aTile, const int& aGeneration);
+
+    // Request Tiles - Queues the Missing Visible Tiles
+    void requestTiles();
+
+protected:
+    friend class TiledImageOpenTask;
+    friend class TiledImageTileTask;
+
+    // Update Paint Node
+    virtual QSGNode* updatePaintNode(QSGNode* aOldNode, UpdatePaintNodeData* aData);
+
+    // Geometry Changed
+    virtual void geometryChanged(const QRectF& aNewGeometry, const QRectF& aOldGeometry);
+
+    // Set Status
+    void setStatus(const int& aStatus);
+
+    // Opened Source - Kept For the Current & Neighbouring Sources
+    struct OpenedSource
+    {
+        // Last Modified Time of the File
+        QDateTime       lastModified;
+        // Source Size
+        QSize           size;
+        // Level Images - Empty If the Source Could Not Be Opened, Base Image Released Once the Levels Are Built
+        QVector<QImage> levelImages;
+        // Overview
+        QImage          overview;
+    };
+
+    // Open Source - Unless Already Opening
+    void openSource(const QString& aSource, const int& aPriority);
+    // Apply Opened Source - False If Not Opened Yet Or Stale
+    bool applyOpenedSource();
+    // Insert Opened Source - Opened Mutex Held, Evicts Least Recently Used Unwanted Sources Over the Byte Budget
+    void insertOpenedSource(const QString& aSource, const OpenedSource& aOpenedSource);
+    // Update Wanted Sources - Current & Preload Sources
+    void updateWantedSources();
+
+    // Get Image Rect In Item Coordinates
+    QRectF imageRect();
+    // Get Level For Zoom Level - 0 Is Full Resolution
+    int levelForZoom();
+    // Get Tile Rect In Level Pixels
+    QRect tileRect(const int& aLevel, const int& aTileX, const int& aTileY);
+    // Get Tile Rect In Item Coordinates
+    QRectF tileItemRect(const int& aLevel, const QRect& aTileRect);
+    // Get Visible Tiles of Level - Nearest To the Center First
+    QList<QPoint> visibleTiles(const int& aLevel, const int& aMargin);
+
+    // Get Nearest Finer Level Image - Thread Safe, Null For a Released Base Image
+    QImage levelSource(const int& aLevel, int& aSourceLevel);
+
+private:
+
+    // Source
+    QString                 source;
+    // Preload Sources
+    QStringList             preloadSources;
+    // Status
+    int                     status;
+    // Zoom Level
+    qreal                   zoomLevel;
+    // Pan Pos X
+    qreal                   panPosX;
+    // Pan Pos Y
+    qreal                   panPosY;
+
+    // Source Size
+    QSize                   sourceSize;
+    // Level Count - The Last Level Is Drawn From the Overview
+    int                     levelCount;
+
+    // Source Mutex - Guards Level Images, Wanted & Running Tiles
+    QMutex                  sourceMutex;
+    // Level Images - Stored Pyramid Levels Mapped From the Decoded Cache, Others Built Once. Base Image Only Until the Levels Are Built
+    QVector<QImage>         levelImages;
+    // Wanted Tiles - Visible Tiles Not Yet Decoded
+    QSet<quint64>           wantedTiles;
+    // Running Tiles - Being Decoded
+    QSet<quint64>           runningTiles;
+
+    // Opened Mutex - Guards Opened & Wanted Sources
+    QMutex                  openedMutex;
+    // Opened Sources - Level Images Share Pixels With the Image Cache
+    QHash<QString, OpenedSource> openedSources;
+    // Opened Order - Most Recently Used First
+    QStringList             openedOrder;
+    // Wanted Sources - Current & Preload Sources
+    QSet<QString>           wantedSources;
+    // Current Source - Source As Seen By the Open Tasks
+    QString                 currentSource;
+    // Opening Sources
+    QSet<QString>           openingSources;
+    // Open Pool
+    QThreadPool             openPool;
+
+    // Tile Generation - Bumped To Drop Tiles of the Previous Source
+    QAtomicInt              generation;
+    // Tile Pool
+    QThreadPool             tilePool;
+    // Tiles Queued Or Running
+    QSet<quint64>           pendingTiles;
+
+    // Overview - Whole Image Downscaled, Uploaded Once
+    QImage                  overview;
+    // Overview Dirty
+    bool                    overviewDirty;
+    // Decoded Tiles Waiting For Upload
+    QHash<quint64, QImage>  uploadTiles;
+    // Textured Tiles - Mirrors the Node's Texture Cache
+    QSet<quint64>           texturedTiles;
+    // Clear Textures - Set When the Source Changes
+    bool                    clearTextures;
+    // Texture Budget Bytes
+    qint64                  textureBudgetBytes;
+    // Request Scheduled
+    bool                    requestScheduled;
+};
+
+#endif // TILEDIMAGE_H
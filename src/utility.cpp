@@ -1,30 +1,434 @@
 
 #include <QDebug>
+#include <QDir>
+#include <QFileInfo>
+#include <QDirIterator>
+#include <QFile>
+#include <QSaveFile>
+#include <QLockFile>
+#include <QMultiMap>
+#include <QPair>
+#include <QDateTime>
+#include <QRunnable>
+#include <QThread>
+#include <QThreadPool>
+#include <QSemaphore>
+#include <QAtomicInt>
+
+#ifdef __SSE2__
+
+#include <emmintrin.h>
+
+#endif // __SSE2__
 
 #include "utility.h"
+#include "directorymodel.h"
+#include "constants.h"
 
 
 //==============================================================================
-// Compare Images Pixel By Pixel
+// Pixel Band Task Class - Verifies Rows of a Region, Stops Once Any Band Differs
 //==============================================================================
-bool compareImagesByPixel(const QImage& aLeftImage, const QImage& aRightImage)
+class PixelBandTask : public QRunnable
 {
-    // Check Sizes First
-    if (aLeftImage.size() == aRightImage.size()) {
-        // Go Thru Image Pixels
-        for (int y=0; y<aLeftImage.height(); y++) {
-            for (int x=0; x<aLeftImage.width(); x++) {
+public:
+
+    // Constructor
+    PixelBandTask(const QImage& aLeftImage, const QPoint& aLeftOrigin, const QImage& aRightImage, const QPoint& aRightOrigin, const QImage& aKeepMask, const int& aWidth, const int& aFirstRow, const int& aRowCount, QAtomicInt& aDiffers, QSemaphore& aDone)
+        : leftImage(aLeftImage)
+        , leftOrigin(aLeftOrigin)
+        , rightImage(aRightImage)
+        , rightOrigin(aRightOrigin)
+        , keepMask(aKeepMask)
+        , width(aWidth)
+        , firstRow(aFirstRow)
+        , rowCount(aRowCount)
+        , differs(aDiffers)
+        , done(aDone)
+    {
+    }
+
+    // Run
+    virtual void run()
+    {
+        // Init Keep Row - Used When There Is No Mask, Every Pixel Compared
+        QVector<QRgb> keepAll(keepMask.isNull() ? width : 0, 0xFFFFFFFF);
+
+        // Go Thru Rows - Other Bands Finding a Difference Ends This One Too
+        for (int y = firstRow; y < firstRow + rowCount && differs.load() == 0; y++) {
+            // Get Rows
+            const QRgb* leftRow = (const QRgb*)leftImage.constScanLine(leftOrigin.y() + y) + leftOrigin.x();
+            const QRgb* rightRow = (const QRgb*)rightImage.constScanLine(rightOrigin.y() + y) + rightOrigin.x();
+            const QRgb* keepRow = keepMask.isNull() ? keepAll.constData() : (const QRgb*)keepMask.constScanLine(leftOrigin.y() + y) + leftOrigin.x();
+
+            // Compare Rows
+            if (!comparePixelRows(leftRow, rightRow, keepRow, width)) {
+                // Set Differs
+                differs.store(1);
+            }
+        }
+
+        // Release Band
+        done.release();
+    }
+
+private:
+    // Left Image
+    QImage          leftImage;
+    // Left Origin
+    QPoint          leftOrigin;
+    // Right Image
+    QImage          rightImage;
+    // Right Origin
+    QPoint          rightOrigin;
+    // Keep Mask
+    QImage          keepMask;
+    // Region Width
+    int             width;
+    // First Row
+    int             firstRow;
+    // Row Count
+    int             rowCount;
+    // Differs Flag
+    QAtomicInt&     differs;
+    // Done Semaphore
+    QSemaphore&     done;
+};
+
+//==============================================================================
+// Sample Pixel Grids Coarse To Fine - Finds Differences Larger Than the Finest Stride After Touching Few Pixels
+//==============================================================================
+static bool samplePixelGrids(const QImage& aLeftImage, const QPoint& aLeftOrigin, const QImage& aRightImage, const QPoint& aRightOrigin, const QSize& aSize, const QImage& aKeepMask)
+{
+    // Go Thru Strides - Each Level Halves the Previous One
+    for (int stride = DEFAULT_COARSE_COMPARE_START_STRIDE; stride >= DEFAULT_COARSE_COMPARE_END_STRIDE; stride /= 2) {
+        // Go Thru Sampled Rows
+        for (int y = 0; y < aSize.height(); y += stride) {
+            // Check Row Sampled By the Coarser Level - Only Odd Multiples of the Stride Are New There
+            bool coarserRow = stride < DEFAULT_COARSE_COMPARE_START_STRIDE && y % (stride * 2) == 0;
+            // Get First Column & Column Step
+            int firstX = coarserRow ? stride : 0;
+            int stepX = coarserRow ? stride * 2 : stride;
+
+            // Get Rows
+            const QRgb* leftRow = (const QRgb*)aLeftImage.constScanLine(aLeftOrigin.y() + y) + aLeftOrigin.x();
+            const QRgb* rightRow = (const QRgb*)aRightImage.constScanLine(aRightOrigin.y() + y) + aRightOrigin.x();
+            const QRgb* keepRow = aKeepMask.isNull() ? NULL : (const QRgb*)aKeepMask.constScanLine(aLeftOrigin.y() + y) + aLeftOrigin.x();
+
+            // Go Thru Sampled Pixels
+            for (int x = firstX; x < aSize.width(); x += stepX) {
                 // Check Pixels
-                if (aLeftImage.pixel(x, y) != aRightImage.pixel(x, y)) {
+                if ((leftRow[x] ^ rightRow[x]) & (keepRow ? keepRow[x] : 0xFFFFFFFF)) {
                     return false;
                 }
             }
         }
+    }
+
+    return true;
+}
+
+//==============================================================================
+// Compare Hashed Pixel Regions - Blocks With Equal Hashes Are Skipped, Differing & Partial Blocks Compared Row By Row
+//==============================================================================
+static bool compareHashedRegions(const QImage& aLeftImage, const QPoint& aLeftOrigin, const QImage& aRightImage, const QPoint& aRightOrigin, const QSize& aSize, const QImage& aKeepMask,
+                                 const BlockHashGrid& aLeftGrid, const BlockHashGrid& aRightGrid)
+{
+    // Get Block Size
+    int blockSize = aLeftGrid.blockSize;
+    // Get Left Region
+    QRect region(aLeftOrigin, aSize);
+    // Get Offset - Whole Blocks
+    QPoint offset = aRightOrigin - aLeftOrigin;
+    // Get Block Offset
+    int blockOffsetX = offset.x() / blockSize;
+    int blockOffsetY = offset.y() / blockSize;
+    // Init Keep Row - Used When There Is No Mask, Every Pixel Compared
+    QVector<QRgb> keepAll(aKeepMask.isNull() ? blockSize : 0, 0xFFFFFFFF);
+
+    // Go Thru Block Rows of the Region
+    for (int blockY = region.top() / blockSize; blockY <= region.bottom() / blockSize; blockY++) {
+        // Go Thru Block Columns of the Region
+        for (int blockX = region.left() / blockSize; blockX <= region.right() / blockSize; blockX++) {
+            // Get Left Block Index
+            int leftIndex = blockY * aLeftGrid.size.width() + blockX;
+            // Get Right Block Index
+            int rightIndex = (blockY + blockOffsetY) * aRightGrid.size.width() + blockX + blockOffsetX;
+            // Get Left Block Rect
+            QRect blockRect = aLeftGrid.blockRect(leftIndex);
+
+            // Check Whole Block Inside the Region & Paired With a Whole Right Block of Equal Hash
+            if (region.contains(blockRect) && aRightGrid.blockRect(rightIndex).translated(-offset) == blockRect &&
+                aLeftGrid.hashes[leftIndex] == aRightGrid.hashes[rightIndex]) {
+                continue;
+            }
+
+            // Get Compared Rect - Partial Blocks Only Within the Region
+            QRect compareRect = blockRect.intersected(region);
+
+            // Go Thru Rows
+            for (int y = compareRect.top(); y <= compareRect.bottom(); y++) {
+                // Get Rows
+                const QRgb* leftRow = (const QRgb*)aLeftImage.constScanLine(y) + compareRect.x();
+                const QRgb* rightRow = (const QRgb*)aRightImage.constScanLine(y + offset.y()) + compareRect.x() + offset.x();
+                const QRgb* keepRow = aKeepMask.isNull() ? keepAll.constData() : (const QRgb*)aKeepMask.constScanLine(y) + compareRect.x();
 
+                // Compare Rows
+                if (!comparePixelRows(leftRow, rightRow, keepRow, compareRect.width())) {
+                    return false;
+                }
+            }
+        }
+    }
+
+    return true;
+}
+
+//==============================================================================
+// Compare 32 Bit Pixel Regions Coarse To Fine - Sparse Grids First, Then Every Row In Parallel Bands
+//==============================================================================
+bool comparePixelRegions(const QImage& aLeftImage, const QPoint& aLeftOrigin, const QImage& aRightImage, const QPoint& aRightOrigin, const QSize& aSize, const QImage& aKeepMask,
+                         const BlockHashGrid* aLeftGrid, const BlockHashGrid* aRightGrid)
+{
+    // Check Size
+    if (aSize.isEmpty()) {
         return true;
     }
 
-    return false;
+    // Check Hash Grids - Both Must Hash These Exact Images In the Same Block Size
+    if (aLeftGrid && aRightGrid && aLeftGrid->isValidFor(aLeftImage) && aRightGrid->isValidFor(aRightImage) && aLeftGrid->blockSize == aRightGrid->blockSize) {
+        // Get Block Size
+        int blockSize = aLeftGrid->blockSize;
+
+        // Check Origins - Blocks Only Pair Up When the Regions Are a Whole Number of Blocks Apart
+        if ((aRightOrigin.x() - aLeftOrigin.x()) % blockSize == 0 && (aRightOrigin.y() - aLeftOrigin.y()) % blockSize == 0) {
+            return compareHashedRegions(aLeftImage, aLeftOrigin, aRightImage, aRightOrigin, aSize, aKeepMask, *aLeftGrid, *aRightGrid);
+        }
+    }
+
+    // Sample Pixel Grids - Most Real Differences Span More Than a Few Pixels
+    if (!samplePixelGrids(aLeftImage, aLeftOrigin, aRightImage, aRightOrigin, aSize, aKeepMask)) {
+        return false;
+    }
+
+    // Get Band Count - Small Regions Are Not Worth Splitting
+    int bandCount = qBound(1, aSize.height() / DEFAULT_COARSE_COMPARE_MIN_BAND_ROWS, QThread::idealThreadCount());
+    // Get Band Rows
+    int bandRows = (aSize.height() + bandCount - 1) / bandCount;
+
+    // Init Differs Flag
+    QAtomicInt differs(0);
+    // Init Done Semaphore
+    QSemaphore done(0);
+    // Init Started Bands
+    int startedBands = 0;
+
+    // Go Thru Bands
+    for (int firstRow = 0; firstRow < aSize.height(); firstRow += bandRows) {
+        // Init Task
+        PixelBandTask* task = new PixelBandTask(aLeftImage, aLeftOrigin, aRightImage, aRightOrigin, aKeepMask, aSize.width(), firstRow, qMin(bandRows, aSize.height() - firstRow), differs, done);
+
+        // Check Last Band - Run On the Calling Thread
+        if (firstRow + bandRows >= aSize.height()) {
+            // Run Task
+            task->run();
+            // Delete Task
+            delete task;
+        } else {
+            // Start Task
+            QThreadPool::globalInstance()->start(task);
+        }
+
+        // Inc Started Bands
+        startedBands++;
+    }
+
+    // Wait For Bands
+    done.acquire(startedBands);
+
+    return differs.load() == 0;
 }
 
+//==============================================================================
+// Compare Images Pixel By Pixel - Normalized First, So Equal Pixels In Different Formats Match
+//==============================================================================
+bool compareImagesByPixel(const QImage& aLeftImage, const QImage& aRightImage, const int& aAlphaMode)
+{
+    // Check Sizes First
+    if (aLeftImage.size() != aRightImage.size()) {
+        return false;
+    }
+
+    // Normalize Images - No Op For Images From the Image Cache
+    QImage leftImage = normalizeImage(aLeftImage, aAlphaMode);
+    QImage rightImage = normalizeImage(aRightImage, aAlphaMode);
 
+    return comparePixelRegions(leftImage, QPoint(0, 0), rightImage, QPoint(0, 0), leftImage.size());
+}
+
+//==============================================================================
+// Compare 32 Bit Pixel Rows - Bits Cleared In the Keep Mask Are Ignored
+//==============================================================================
+bool comparePixelRows(const QRgb* aLeftRow, const QRgb* aRightRow, const QRgb* aKeepRow, const int& aCount)
+{
+    // Init Index
+    int i = 0;
+
+#ifdef __SSE2__
+
+    // Init Zero
+    const __m128i zero = _mm_setzero_si128();
+
+    // Go Thru 4 Pixels At a Time
+    for (; i + 4 <= aCount; i += 4) {
+        // Get Differing Bits Not Masked Out
+        __m128i diff = _mm_and_si128(_mm_xor_si128(_mm_loadu_si128((const __m128i*)(aLeftRow + i)),
+                                                   _mm_loadu_si128((const __m128i*)(aRightRow + i))),
+                                     _mm_loadu_si128((const __m128i*)(aKeepRow + i)));
+
+        // Check Diff
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(diff, zero)) != 0xFFFF) {
+            return false;
+        }
+    }
+
+#endif // __SSE2__
+
+    // Go Thru Remaining Pixels
+    for (; i < aCount; i++) {
+        // Check Pixels
+        if ((aLeftRow[i] ^ aRightRow[i]) & aKeepRow[i]) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+//==============================================================================
+// Get Supported Image Files of Dir Sorted By Name
+//==============================================================================
+QStringList imageFileList(const QString& aDirPath)
+{
+    // Init Dir
+    QDir dir(aDirPath);
+    // Read File Names - Matched By Suffix, No Stat Per Entry
+    QStringList fileNames = readImageFileNames(dir.absolutePath());
+
+    // Init File List
+    QStringList fileList;
+
+    // Go Thru File Names
+    for (int i = 0; i < fileNames.count(); i++) {
+        // Add File Path
+        fileList << dir.absoluteFilePath(fileNames[i]);
+    }
+
+    return fileList;
+}
+
+//==============================================================================
+// Format Byte Count For Display
+//==============================================================================
+QString formatSize(const qint64& aSize)
+{
+    // Check Size
+    if (aSize >= 1024 * 1024 * 1024) {
+        return QString("%1 GB").arg((double)aSize / (1024.0 * 1024.0 * 1024.0), 0, 'f', 2);
+    }
+
+    // Check Size
+    if (aSize >= 1024 * 1024) {
+        return QString("%1 MB").arg((double)aSize / (1024.0 * 1024.0), 0, 'f', 1);
+    }
+
+    // Check Size
+    if (aSize >= 1024) {
+        return QString("%1 KB").arg((double)aSize / 1024.0, 0, 'f', 1);
+    }
+
+    return QString("%1 B").arg(aSize);
+}
+
+//==============================================================================
+// Account Bytes Stored In Disk Cache - Evicts Oldest Entries Under the Cache Lock When Over Budget
+//==============================================================================
+void accountDiskCache(const QString& aCacheDir, const QString& aEntrySuffix, const qint64& aBudgetBytes, const qint64& aBytes)
+{
+    // Init Lock File - Shared By All Processes Using the Cache
+    QLockFile lockFile(QDir(aCacheDir).filePath(DEFAULT_DISK_CACHE_LOCK_FILE_NAME));
+
+    // Lock - Skip Accounting Rather Than Stall a Compare, the Next Scan Catches Up
+    if (!lockFile.tryLock(DEFAULT_DISK_CACHE_LOCK_TIMEOUT)) {
+        qDebug() << "accountDiskCache - ERROR: CACHE LOCKED!";
+        return;
+    }
+
+    // Get Usage File Path
+    QString usagePath = QDir(aCacheDir).filePath(DEFAULT_DISK_CACHE_USAGE_FILE_NAME);
+    // Init Usage File
+    QFile usageFile(usagePath);
+    // Init Used Bytes - Unknown Until Read Or Scanned
+    qint64 usedBytes = -1;
+
+    // Open Usage File
+    if (usageFile.open(QIODevice::ReadOnly)) {
+        // Init Ok
+        bool ok = false;
+        // Read Used Bytes
+        qint64 readBytes = usageFile.readAll().trimmed().toLongLong(&ok);
+        // Check Ok
+        if (ok) {
+            usedBytes = readBytes + aBytes;
+        }
+        // Close Usage File
+        usageFile.close();
+    }
+
+    // Check Used Bytes - Scan When Unknown Or Over Budget, Replaced Entries & Crashed Writers Make the Count Drift
+    if (usedBytes < 0 || usedBytes > aBudgetBytes) {
+        // Init Entries - Oldest First
+        QMultiMap<QDateTime, QPair<QString, qint64> > entries;
+        // Reset Used Bytes
+        usedBytes = 0;
+
+        // Init Dir Iterator
+        QDirIterator it(aCacheDir, QStringList() << QString("*%1").arg(aEntrySuffix), QDir::Files, QDirIterator::Subdirectories);
+
+        // Go Thru Entries
+        while (it.hasNext()) {
+            // Next Entry
+            it.next();
+            // Add Entry
+            entries.insert(it.fileInfo().lastModified(), qMakePair(it.filePath(), it.fileInfo().size()));
+            // Inc Used Bytes
+            usedBytes += it.fileInfo().size();
+        }
+
+        // Get Target Bytes - Evict Below Budget So the Next Stores Do Not Rescan At Once
+        qint64 targetBytes = aBudgetBytes * DEFAULT_DISK_CACHE_LOW_WATER_PERCENT / 100;
+
+        // Go Thru Entries - Oldest First
+        QMultiMap<QDateTime, QPair<QString, qint64> >::const_iterator entry = entries.constBegin();
+        while (usedBytes > targetBytes && entry != entries.constEnd()) {
+            // Remove Entry - Processes Still Mapping It Keep Their View
+            if (QFile::remove(entry.value().first)) {
+                // Dec Used Bytes
+                usedBytes -= entry.value().second;
+            }
+
+            ++entry;
+        }
+
+        qDebug() << "accountDiskCache - usedBytes: " << usedBytes << " - budgetBytes: " << aBudgetBytes;
+    }
+
+    // Init Usage Save File
+    QSaveFile usageSaveFile(usagePath);
+
+    // Write Used Bytes
+    if (usageSaveFile.open(QIODevice::WriteOnly)) {
+        usageSaveFile.write(QByteArray::number(usedBytes));
+        usageSaveFile.commit();
+    }
+}
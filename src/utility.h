@@ -2,9 +2,29 @@
 #define UTILITY_H
 
 #include <QImage>
+#include <QString>
 
-// Compare Images Pixel By Pixel
-bool compareImagesByPixel(const QImage& aLeftImage, const QImage& aRightImage);
+#include "imagenormalizer.h"
+
+// Compare Images Pixel By Pixel - Normalized First, So Equal Pixels In Different Formats Match
+bool compareImagesByPixel(const QImage& aLeftImage, const QImage& aRightImage, const int& aAlphaMode = AMTStraight);
+
+// Compare 32 Bit Pixel Rows - Bits Cleared In the Keep Mask Are Ignored
+bool comparePixelRows(const QRgb* aLeftRow, const QRgb* aRightRow, const QRgb* aKeepRow, const int& aCount);
+
+// Compare 32 Bit Pixel Regions Coarse To Fine - Sparse Grids First, Then Every Row In Parallel Bands. Keep Mask Is In Left Coordinates
+// With Hash Grids Valid For Both Images & Origins a Whole Number of Blocks Apart, Only Differing & Partial Blocks Are Compared
+bool comparePixelRegions(const QImage& aLeftImage, const QPoint& aLeftOrigin, const QImage& aRightImage, const QPoint& aRightOrigin, const QSize& aSize, const QImage& aKeepMask = QImage(),
+                         const BlockHashGrid* aLeftGrid = NULL, const BlockHashGrid* aRightGrid = NULL);
+
+// Get Supported Image Files of Dir Sorted By Name
+QStringList imageFileList(const QString& aDirPath);
+
+// Format Byte Count For Display
+QString formatSize(const qint64& aSize);
+
+// Account Bytes Stored In Disk Cache - Evicts Oldest Entries Under the Cache Lock When Over Budget
+void accountDiskCache(const QString& aCacheDir, const QString& aEntrySuffix, const qint64& aBudgetBytes, const qint64& aBytes);
 
 #endif // UTILITY_H
 
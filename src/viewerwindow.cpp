@@ -3,9 +3,12 @@
 #include <QSettings>
 #include <QQmlContext>
 #include <QRect>
+#include <QFileInfo>
 
 #include "mainwindow.h"
 #include "viewerwindow.h"
+#include "tiledimage.h"
+#include "utility.h"
 #include "constants.h"
 #include "defaultsettings.h"
 
@@ -47,6 +50,8 @@ ViewerWindow::ViewerWindow(QWidget* aParent)
     , ui(new Ui::ViewerWindow)
     , mainWindow(MainWindow::getInstance())
     , currentFile("")
+    , dirFilesPath("")
+    , stepDirection(1)
     , zoomLevelIndex(DEFAULT_ZOOM_LEVEL_INDEX)
     , zoomLevel(zoomLevels[zoomLevelIndex])
     , zoomFit(false)
@@ -73,6 +78,9 @@ ViewerWindow::ViewerWindow(QWidget* aParent)
     // Set Context Property
     qmlContext->setContextProperty(VIEWER_VIEW_CONTROLLER, this);
 
+    // Register Tiled Image
+    qmlRegisterType<TiledImage>(DEFAULT_CUSTOM_COMPONENTS, 0, 1, DEFAULT_CUSTOM_COMPONENT_TILED_IMAGE);
+
     // Set Source
     ui->viewerWidget->setSource(QUrl(QML_SOURCE_VIEWER_VIEW));
 
@@ -101,6 +109,90 @@ void ViewerWindow::setCurrentFile(const QString& aCurrentFile)
         emit currentFileChanged(currentFile);
         // Show Status Text
         showStatusText(currentFile);
+
+        // Update Neighbour Files - Preloaded By the Viewer Image
+        updateNeighbourFiles();
+    }
+}
+
+//==============================================================================
+// Get Neighbour Files - Ahead In the Step Direction First
+//==============================================================================
+QStringList ViewerWindow::getNeighbourFiles()
+{
+    return neighbourFiles;
+}
+
+//==============================================================================
+// Step File
+//==============================================================================
+void ViewerWindow::stepFile(const int& aDirection)
+{
+    // Check Current File
+    if (currentFile.isEmpty()) {
+        return;
+    }
+
+    // Update Neighbour Files - Lists the Dir If Needed
+    updateNeighbourFiles();
+
+    // Get New Index
+    int index = dirFiles.indexOf(QFileInfo(currentFile).absoluteFilePath()) + aDirection;
+
+    // Check New Index
+    if (index < 0 || index >= dirFiles.count()) {
+        // Show Status Text
+        showStatusText(aDirection > 0 ? tr("Last image") : tr("First image"));
+        return;
+    }
+
+    // Set Step Direction
+    stepDirection = aDirection;
+
+    // Set Current File
+    setCurrentFile(dirFiles[index]);
+}
+
+//==============================================================================
+// Update Neighbour Files
+//==============================================================================
+void ViewerWindow::updateNeighbourFiles()
+{
+    // Get Dir Path
+    QString dirPath = currentFile.isEmpty() ? QString("") : QFileInfo(currentFile).absolutePath();
+
+    // Check Dir Path
+    if (dirFilesPath != dirPath) {
+        // Set Dir Files Path
+        dirFilesPath = dirPath;
+        // List Dir
+        dirFiles = dirPath.isEmpty() ? QStringList() : imageFileList(dirPath);
+    }
+
+    // Get Index
+    int index = dirFiles.indexOf(QFileInfo(currentFile).absoluteFilePath());
+
+    // Init New Neighbour Files
+    QStringList newNeighbourFiles;
+
+    // Go Thru Neighbours - Ahead In the Step Direction First, Then Behind
+    for (int i = 0; i < DEFAULT_PREFETCH_COUNT * 2 && index >= 0; i++) {
+        // Get Offset
+        int offset = (i < DEFAULT_PREFETCH_COUNT ? i + 1 : DEFAULT_PREFETCH_COUNT - i - 1) * stepDirection;
+
+        // Check Index
+        if (index + offset >= 0 && index + offset < dirFiles.count()) {
+            // Add Neighbour File
+            newNeighbourFiles << dirFiles[index + offset];
+        }
+    }
+
+    // Check Neighbour Files
+    if (neighbourFiles != newNeighbourFiles) {
+        // Set Neighbour Files
+        neighbourFiles = newNeighbourFiles;
+        // Emit Neighbour Files Changed Signal
+        emit neighbourFilesChanged(neighbourFiles);
     }
 }
 
@@ -718,6 +810,18 @@ void ViewerWindow::keyReleaseEvent(QKeyEvent* aEvent)
                 reset();
             break;
 
+            case Qt::Key_Right:
+            case Qt::Key_PageDown:
+                // Step To Next File
+                stepFile(1);
+            break;
+
+            case Qt::Key_Left:
+            case Qt::Key_PageUp:
+                // Step To Previous File
+                stepFile(-1);
+            break;
+
             default:
             break;
         }
@@ -7,6 +7,7 @@
 #include <QWheelEvent>
 #include <QMouseEvent>
 #include <QResizeEvent>
+#include <QStringList>
 
 #include "constants.h"
 
@@ -25,6 +26,7 @@ class ViewerWindow : public QMainWindow
     Q_OBJECT
 
     Q_PROPERTY(QString currentFile READ getCurrentFile WRITE setCurrentFile NOTIFY currentFileChanged)
+    Q_PROPERTY(QStringList neighbourFiles READ getNeighbourFiles NOTIFY neighbourFilesChanged)
 
     Q_PROPERTY(qreal zoomLevel READ getZoomLevel NOTIFY zoomLevelChanged)
 
@@ -50,6 +52,9 @@ public:
     // Set Current File
     void setCurrentFile(const QString& aCurrentFile);
 
+    // Get Neighbour Files - Ahead In the Step Direction First
+    QStringList getNeighbourFiles();
+
     // Get Zoom Level
     qreal getZoomLevel();
 
@@ -87,6 +92,8 @@ signals:
 
     // Current File Changed Slot
     void currentFileChanged(const QString& aFilePath);
+    // Neighbour Files Changed Signal
+    void neighbourFilesChanged(const QStringList& aNeighbourFiles);
 
     // Zoom Level Changed Signal
     void zoomLevelChanged(const qreal& aZoomLevel);
@@ -174,6 +181,11 @@ private:
     // Set Zoom Level
     void setZoomLevel(const qreal& aZoomLevel);
 
+    // Step File
+    void stepFile(const int& aDirection);
+    // Update Neighbour Files
+    void updateNeighbourFiles();
+
 protected:
 
     // Key Press Event
@@ -208,6 +220,14 @@ private:
 
     // Current File
     QString                 currentFile;
+    // Dir Files - Listing of the Current File's Dir
+    QStringList             dirFiles;
+    // Dir Files Path
+    QString                 dirFilesPath;
+    // Step Direction
+    int                     stepDirection;
+    // Neighbour Files
+    QStringList             neighbourFiles;
 
     // Current Zoom LEvel Index
     int                     zoomLevelIndex;
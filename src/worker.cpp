@@ -1,7 +1,154 @@
 #include <QDebug>
+#include <QRunnable>
+#include <QDir>
+#include <QFileInfo>
+#include <QElapsedTimer>
+#include <QMetaObject>
+#include <QDialogButtonBox>
+#include <QImageReader>
 
 #include "mainwindow.h"
 #include "worker.h"
+#include "imagetransformer.h"
+#include "filetransfer.h"
+#include "masklearner.h"
+#include "constants.h"
+#include "defaultsettings.h"
+
+
+//==============================================================================
+// Transform File Task Class
+//==============================================================================
+class TransformFileTask : public QRunnable
+{
+public:
+
+    // Constructor
+    TransformFileTask(Worker* aWorker, const QString& aFilePath, const int& aTransform)
+        : worker(aWorker)
+        , filePath(aFilePath)
+        , transform(aTransform)
+    {
+    }
+
+    // Run
+    virtual void run()
+    {
+        // Check Cancelled
+        if (worker->isCancelled()) {
+            return;
+        }
+
+        // Init Error
+        QString error;
+
+        // Transform Image File
+        if (!transformImageFile(filePath, transform, error)) {
+            qDebug() << "TransformFileTask::run - filePath: " << filePath << " - ERROR: " << error;
+            // Inc Failed Count
+            worker->failedCount.ref();
+        }
+
+        // Inc Done Count
+        worker->doneCount.ref();
+    }
+
+private:
+    // Worker
+    Worker*         worker;
+    // File Path
+    QString         filePath;
+    // Transform
+    int             transform;
+};
+
+
+//==============================================================================
+// Transfer File Task Class
+//==============================================================================
+class TransferFileTask : public QRunnable
+{
+public:
+
+    // Constructor
+    TransferFileTask(Worker* aWorker, const QString& aFilePath, const qint64& aFileSize, const qint64& aSourceDevice,
+                     const QString& aTargetDir, const qint64& aTargetDevice, const bool& aMove)
+        : worker(aWorker)
+        , filePath(aFilePath)
+        , fileSize(aFileSize)
+        , sourceDevice(aSourceDevice)
+        , targetDir(aTargetDir)
+        , targetDevice(aTargetDevice)
+        , move(aMove)
+    {
+    }
+
+    // Run
+    virtual void run()
+    {
+        // Check Cancelled
+        if (worker->isCancelled()) {
+            return;
+        }
+
+        // Get Target Path
+        QString targetPath = QDir(targetDir).filePath(QFileInfo(filePath).fileName());
+
+        // Check Target Exists & Conflict
+        if (QFileInfo::exists(targetPath) && !worker->resolveConflict(targetPath)) {
+            // Skipped Files Count As Transferred For Progress
+            worker->bytesDone.fetchAndAddRelaxed(fileSize);
+            // Inc Done Count
+            worker->doneCount.ref();
+            return;
+        }
+
+        // Get Device Slots - Acquired In Device Order To Avoid Deadlocks
+        QSemaphore* firstSlots = worker->deviceSlots.value(qMin(sourceDevice, targetDevice));
+        QSemaphore* secondSlots = sourceDevice != targetDevice ? worker->deviceSlots.value(qMax(sourceDevice, targetDevice)) : NULL;
+
+        // Acquire Slots
+        firstSlots->acquire();
+        if (secondSlots) {
+            secondSlots->acquire();
+        }
+
+        // Init Error
+        QString error;
+
+        // Transfer File
+        if (!transferFile(filePath, targetPath, move, worker->bytesDone, worker->cancelled, error)) {
+            qDebug() << "TransferFileTask::run - filePath: " << filePath << " - ERROR: " << error;
+            // Inc Failed Count
+            worker->failedCount.ref();
+        }
+
+        // Release Slots
+        if (secondSlots) {
+            secondSlots->release();
+        }
+        firstSlots->release();
+
+        // Inc Done Count
+        worker->doneCount.ref();
+    }
+
+private:
+    // Worker
+    Worker*         worker;
+    // File Path
+    QString         filePath;
+    // File Size
+    qint64          fileSize;
+    // Source Device
+    qint64          sourceDevice;
+    // Target Dir
+    QString         targetDir;
+    // Target Device
+    qint64          targetDevice;
+    // Move
+    bool            move;
+};
 
 
 //==============================================================================
@@ -10,41 +157,303 @@
 Worker::Worker(QObject* aParent)
     : QObject(aParent)
     , mainWindow(MainWindow::getInstance())
+    , cancelled(0)
+    , doneCount(0)
+    , failedCount(0)
+    , bytesDone(0)
 {
     qDebug() << "Worker::Worker";
 
+    // Set Max Thread Count - Use Every Core
+    taskPool.setMaxThreadCount(QThread::idealThreadCount());
+
     // ...
 }
 
+//==============================================================================
+// Transform Files In Parallel - Returns Failed Count
+//==============================================================================
+int Worker::transformFiles(const QStringList& aFiles, const int& aTransform)
+{
+    // Get Total Count
+    int totalCount = aFiles.count();
+
+    qDebug() << "Worker::transformFiles - totalCount: " << totalCount << " - aTransform: " << aTransform;
+
+    // Reset Counters
+    cancelled.store(0);
+    doneCount.store(0);
+    failedCount.store(0);
+
+    // Go Thru Files
+    for (int i = 0; i < totalCount; i++) {
+        // Start Task
+        taskPool.start(new TransformFileTask(this, aFiles[i], aTransform));
+    }
+
+    // Wait For Tasks, Report Progress Meanwhile
+    while (!taskPool.waitForDone(DEFAULT_TRANSFORM_PROGRESS_INTERVAL)) {
+        // Check Cancelled
+        if (isCancelled()) {
+            // Remove Queued Tasks - Running Ones Finish Their File
+            taskPool.clear();
+        }
+
+        // Emit Progress Changed Signal
+        emit progressChanged(doneCount.load(), totalCount);
+    }
+
+    // Emit Progress Changed Signal
+    emit progressChanged(doneCount.load(), totalCount);
+
+    // Skipped Files Count As Failed
+    return failedCount.load() + (totalCount - doneCount.load());
+}
+
+//==============================================================================
+// Copy/Move Files To Dir In Parallel - Returns Failed Count
+//==============================================================================
+int Worker::transferFiles(const QStringList& aFiles, const QString& aTargetDir, const bool& aMove)
+{
+    // Get Total Count
+    int totalCount = aFiles.count();
+
+    qDebug() << "Worker::transferFiles - totalCount: " << totalCount << " - aTargetDir: " << aTargetDir << " - aMove: " << aMove;
+
+    // Reset Counters
+    cancelled.store(0);
+    doneCount.store(0);
+    failedCount.store(0);
+    bytesDone.store(0);
+
+    // Get Target Device
+    qint64 targetDevice = fileDeviceID(aTargetDir);
+
+    // Check Target Device
+    if (targetDevice < 0) {
+        qDebug() << "Worker::transferFiles - aTargetDir: " << aTargetDir << " - ERROR ACCESSING TARGET DIR!";
+        return totalCount;
+    }
+
+    // Init Device Slots
+    deviceSlots[targetDevice] = new QSemaphore(DEFAULT_TRANSFER_DEVICE_PARALLELISM);
+
+    // Init Bytes Total
+    qint64 bytesTotal = 0;
+    // Init Task List
+    QList<TransferFileTask*> tasks;
+
+    // Go Thru Files
+    for (int i = 0; i < totalCount; i++) {
+        // Get File Info
+        QFileInfo fileInfo(aFiles[i]);
+        // Get Source Device
+        qint64 sourceDevice = fileDeviceID(aFiles[i]);
+
+        // Check Source Device
+        if (!fileInfo.isFile() || sourceDevice < 0) {
+            qDebug() << "Worker::transferFiles - file: " << aFiles[i] << " - ERROR ACCESSING FILE!";
+            // Inc Failed & Done Count
+            failedCount.ref();
+            doneCount.ref();
+            continue;
+        }
+
+        // Check Device Slots
+        if (!deviceSlots.contains(sourceDevice)) {
+            // Add Device Slots
+            deviceSlots[sourceDevice] = new QSemaphore(DEFAULT_TRANSFER_DEVICE_PARALLELISM);
+        }
+
+        // Add To Bytes Total
+        bytesTotal += fileInfo.size();
+        // Add Task
+        tasks << new TransferFileTask(this, aFiles[i], fileInfo.size(), sourceDevice, aTargetDir, targetDevice, aMove);
+    }
+
+    // Go Thru Tasks - Started After All Device Slots Exist
+    for (int i = 0; i < tasks.count(); i++) {
+        // Start Task
+        taskPool.start(tasks[i]);
+    }
+
+    // Init Elapsed Timer
+    QElapsedTimer elapsedTimer;
+    elapsedTimer.start();
+
+    // Wait For Tasks, Report Throughput Meanwhile
+    while (!taskPool.waitForDone(DEFAULT_TRANSFER_PROGRESS_INTERVAL)) {
+        // Check Cancelled
+        if (isCancelled()) {
+            // Remove Queued Tasks
+            taskPool.clear();
+        }
+
+        // Get Bytes Done
+        qint64 done = bytesDone.load();
+        // Get Bytes Per Second
+        qint64 bytesPerSecond = elapsedTimer.elapsed() > 0 ? done * 1000 / elapsedTimer.elapsed() : 0;
+        // Get Seconds Remaining
+        int secondsRemaining = bytesPerSecond > 0 ? (int)((bytesTotal - done) / bytesPerSecond) : -1;
+
+        // Emit Transfer Progress Changed Signal
+        emit transferProgressChanged(done, bytesTotal, bytesPerSecond, secondsRemaining);
+    }
+
+    // Emit Transfer Progress Changed Signal
+    emit transferProgressChanged(bytesDone.load(), bytesTotal, 0, 0);
+
+    // Delete Device Slots
+    qDeleteAll(deviceSlots);
+    deviceSlots.clear();
+
+    // Skipped Files Count As Failed
+    return failedCount.load() + (totalCount - doneCount.load());
+}
+
+//==============================================================================
+// Resolve Transfer Conflict - Returns True To Overwrite
+//==============================================================================
+bool Worker::resolveConflict(const QString& aTargetPath)
+{
+    // Lock Conflict Mutex - Options Set By One Answer Apply To the Rest
+    QMutexLocker locker(&conflictMutex);
+
+    // Check Yes To All
+    if (mainWindow->transferOptions & DEFAULT_TRANSFER_OPTIONS_YES_TO_ALL) {
+        return true;
+    }
+
+    // Check No To All
+    if (mainWindow->transferOptions & DEFAULT_TRANSFER_OPTIONS_NO_TO_ALL) {
+        return false;
+    }
+
+    // Check Cancelled
+    if (isCancelled()) {
+        return false;
+    }
+
+    // Init Button
+    int button = QDialogButtonBox::No;
+
+    // Ask On the GUI Thread
+    QMetaObject::invokeMethod(mainWindow, "confirmTransferOverwrite", Qt::BlockingQueuedConnection,
+                              Q_RETURN_ARG(int, button),
+                              Q_ARG(QString, aTargetPath));
+
+    return button == QDialogButtonBox::Yes || button == QDialogButtonBox::YesToAll;
+}
+
+//==============================================================================
+// Learn Compare Mask From Renders of the Same Screen - Returns Masked Pixel Count, -1 On Failure. Sets the Renders Actually Used
+//==============================================================================
+int Worker::learnCompareMask(const QStringList& aFiles, int& aRenderCount)
+{
+    // Get Total Count
+    int totalCount = aFiles.count();
+
+    qDebug() << "Worker::learnCompareMask - totalCount: " << totalCount;
+
+    // Reset Cancelled
+    cancelled.store(0);
+
+    // Init Mask Learner
+    MaskLearner maskLearner;
+
+    // Go Thru Files - One Decoded Render In Memory At a Time
+    for (int i = 0; i < totalCount && !isCancelled(); i++) {
+        // Init Image Reader
+        QImageReader reader(aFiles[i]);
+        // Read Image - Bypasses the Image Cache, Renders Are Read Once
+        QImage image = reader.read();
+
+        // Check Image
+        if (image.isNull()) {
+            qDebug() << "Worker::learnCompareMask - file: " << aFiles[i] << " - ERROR: " << reader.errorString();
+        } else {
+            // Add Image
+            maskLearner.addImage(image);
+        }
+
+        // Emit Progress Changed Signal
+        emit progressChanged(i + 1, totalCount);
+    }
+
+    // Set Render Count - Unreadable & Differently Sized Renders Are Skipped
+    aRenderCount = maskLearner.count();
+
+    // Check Cancelled & Render Count
+    if (isCancelled() || maskLearner.count() < 2) {
+        return -1;
+    }
+
+    // Init Masked Pixels
+    int maskedPixels = 0;
+    // Get Mask
+    QImage mask = maskLearner.mask(DEFAULT_MASK_LEARN_STDDEV_THRESHOLD, DEFAULT_MASK_LEARN_DILATE_RADIUS, maskedPixels);
+
+    // Init Error
+    QString error;
+
+    // Save Learned Mask Next To the Renders
+    if (!saveLearnedMask(mask, QFileInfo(aFiles[0]).absolutePath(), error)) {
+        qDebug() << "Worker::learnCompareMask - ERROR SAVING MASK: " << error;
+        return -1;
+    }
+
+    return maskedPixels;
+}
+
+//==============================================================================
+// Cancel Running Operation - Safe To Call From Any Thread
+//==============================================================================
+void Worker::cancel()
+{
+    // Set Cancelled
+    cancelled.store(1);
+}
+
+//==============================================================================
+// Is Cancelled
+//==============================================================================
+bool Worker::isCancelled()
+{
+    return cancelled.load() != 0;
+}
+
 //==============================================================================
 // Do Work
 //==============================================================================
 void Worker::doWork(const int& aOperation)
 {
+    // Init Result
+    int result = 0;
+
     // Switch Operation
     switch (aOperation) {
         case OTRotateFilesLeft: {
             //qDebug() << "Worker::doWork - Rotate Left";
             // Do Rotate Left
-            //mainBrowserWindow->doRotateLeft();
+            result = mainWindow->doRotateLeft();
         } break;
 
         case OTRotateFilesRight: {
             //qDebug() << "Worker::doWork - Rotate Right";
             // Do Rotate Right
-            //mainBrowserWindow->doRotateRigth();
+            result = mainWindow->doRotateRigth();
         } break;
 
         case OTFlipFilesHorizontally: {
             //qDebug() << "Worker::doWork - Flip Horizontally";
-            // Do Rotate Right
-            //mainBrowserWindow->doFlipHorizontally();
+            // Do Flip Horizontally
+            result = mainWindow->doFlipHorizontally();
         } break;
 
         case OTFlipFilesVertically: {
             //qDebug() << "Worker::doWork - Flip Vertically";
-            // Do Rotate Right
-            //mainBrowserWindow->doFlipVertically();
+            // Do Flip Vertically
+            result = mainWindow->doFlipVertically();
         } break;
 
         case OTDeleteFiles: {
@@ -61,14 +470,14 @@ void Worker::doWork(const int& aOperation)
 
         case OTCopyToFiles: {
             //qDebug() << "Worker::doWork - Copy To Dir";
-            // Do Rotate Right
-            //mainBrowserWindow->doCopyToDirectory();
+            // Do Copy To Dir
+            result = mainWindow->doCopyToDirectory();
         } break;
 
         case OTMoveToFiles: {
             //qDebug() << "Worker::doWork - Move To Dir";
-            // Do Rotate Right
-            //mainBrowserWindow->doMoveToDirectory();
+            // Do Move To Dir
+            result = mainWindow->doMoveToDirectory();
         } break;
 
         case OTFindDuplicates: {
@@ -76,13 +485,28 @@ void Worker::doWork(const int& aOperation)
             //mainBrowserWindow->doFindDuplicates();
         } break;
 
+        case OTLearnCompareMask: {
+            // Do Learn Compare Mask
+            result = mainWindow->doLearnCompareMask();
+        } break;
+
+        case OTCompareDeep: {
+            // Do Deep Compare
+            result = mainWindow->doCompareDeep();
+        } break;
+
+        case OTCompareFrames: {
+            // Do Frame Compare
+            result = mainWindow->doCompareFrames();
+        } break;
+
         default:
             qDebug() << "Worker::doWork - aOperation: " << aOperation << " - UNHANDLED OPERATION!";
         break;
     }
 
     // Emit Result Ready
-    emit resultReady(aOperation, 0);
+    emit resultReady(aOperation, result);
 }
 
 //==============================================================================
@@ -94,8 +518,11 @@ void Worker::stop()
     if (mainWindow->workerThread.isRunning()) {
         qDebug() << "Worker::stop";
 
-        // Terminate Worker Thread
-        mainWindow->workerThread.terminate();
+        // Cancel
+        cancel();
+
+        // Quit Worker Thread - Event Loop Exits After the Current Operation
+        mainWindow->workerThread.quit();
 
         // ...
     }
@@ -2,6 +2,13 @@
 #define WORKER_H
 
 #include <QObject>
+#include <QStringList>
+#include <QThreadPool>
+#include <QAtomicInt>
+#include <QAtomicInteger>
+#include <QMutex>
+#include <QSemaphore>
+#include <QHash>
 
 class MainWindow;
 
@@ -18,7 +25,10 @@ enum OperationType
     OTRenameFiles,
     OTCopyToFiles,
     OTMoveToFiles,
-    OTFindDuplicates
+    OTFindDuplicates,
+    OTLearnCompareMask,
+    OTCompareDeep,
+    OTCompareFrames
 };
 
 
@@ -37,6 +47,21 @@ public:
     // Destructor
     virtual ~Worker();
 
+    // Transform Files In Parallel - Returns Failed Count
+    int transformFiles(const QStringList& aFiles, const int& aTransform);
+
+    // Copy/Move Files To Dir In Parallel - Returns Failed Count
+    int transferFiles(const QStringList& aFiles, const QString& aTargetDir, const bool& aMove);
+
+    // Learn Compare Mask From Renders of the Same Screen - Returns Masked Pixel Count, -1 On Failure. Sets the Renders Actually Used
+    int learnCompareMask(const QStringList& aFiles, int& aRenderCount);
+
+    // Cancel Running Operation - Safe To Call From Any Thread
+    void cancel();
+
+    // Is Cancelled
+    bool isCancelled();
+
 signals:
 
     // Populate Browser Model
@@ -47,6 +72,10 @@ signals:
     void fileRenamed(const QString& aFileName);
     // Refresh View
     void refreshView();
+    // Progress Changed Signal
+    void progressChanged(const int& aDone, const int& aTotal);
+    // Transfer Progress Changed Signal
+    void transferProgressChanged(const qint64& aBytesDone, const qint64& aBytesTotal, const qint64& aBytesPerSecond, const int& aSecondsRemaining);
 
 public slots:
 
@@ -57,8 +86,31 @@ public slots:
     void stop();
 
 private:
+    friend class TransformFileTask;
+    friend class TransferFileTask;
+
+    // Resolve Transfer Conflict - Returns True To Overwrite
+    bool resolveConflict(const QString& aTargetPath);
+
     // Main Window
     MainWindow*      mainWindow;
+
+    // Task Thread Pool
+    QThreadPool      taskPool;
+
+    // Cancelled
+    QAtomicInt       cancelled;
+    // Done Count
+    QAtomicInt       doneCount;
+    // Failed Count
+    QAtomicInt       failedCount;
+
+    // Transferred Bytes
+    QAtomicInteger<qint64> bytesDone;
+    // Conflict Mutex - One Confirmation At a Time
+    QMutex           conflictMutex;
+    // Transfer Slots Per Device
+    QHash<qint64, QSemaphore*> deviceSlots;
 };
 
 #endif // WORKER_H
@@ -0,0 +1,47 @@
+
+# Target
+TARGET      = tst_imagecompare
+
+# Template
+TEMPLATE    = app
+
+# Qt Modules/Config
+QT          += core gui
+QT          += qml quick
+QT          += testlib
+
+CONFIG      += testcase
+CONFIG      += console
+CONFIG      -= app_bundle
+
+# Include Path
+INCLUDEPATH += ../src
+
+# Soures
+SOURCES     += tst_imagecompare.cpp \
+            ../src/blockhash.cpp \
+            ../src/imagescaler.cpp \
+            ../src/imagenormalizer.cpp \
+            ../src/masklearner.cpp \
+            ../src/resultcache.cpp \
+            ../src/deepcompare.cpp \
+            ../src/comparemask.cpp \
+            ../src/mappedimage.cpp \
+            ../src/sharedimage.cpp \
+            ../src/directorymodel.cpp \
+            ../src/utility.cpp \
+
+# Headers
+HEADERS     += ../src/blockhash.h \
+            ../src/imagescaler.h \
+            ../src/imagenormalizer.h \
+            ../src/masklearner.h \
+            ../src/resultcache.h \
+            ../src/deepcompare.h \
+            ../src/comparemask.h \
+            ../src/mappedimage.h \
+            ../src/sharedimage.h \
+            ../src/directorymodel.h \
+            ../src/utility.h \
+            ../src/constants.h \
+            ../src/defaultsettings.h \
@@ -0,0 +1,461 @@
+#include <QtTest>
+#include <QImage>
+#include <QFile>
+#include <QTemporaryDir>
+#include <QStandardPaths>
+
+#include "blockhash.h"
+#include "imagescaler.h"
+#include "imagenormalizer.h"
+#include "masklearner.h"
+#include "resultcache.h"
+#include "mappedimage.h"
+#include "utility.h"
+#include "constants.h"
+
+
+//==============================================================================
+// Image Compare Tests Class - Kernels & Caches Shared By the Viewer, Batch Mode & the Daemon
+//==============================================================================
+class ImageCompareTests : public QObject
+{
+    Q_OBJECT
+
+private slots:
+
+    // Init Test Case
+    void initTestCase();
+
+    // Block Hashes - Equal Images Hash Equal, a Changed Pixel Flags Its Block Only
+    void blockHashes();
+    // Hashed Region Compare - Equal Hashes Skip Blocks, Also At Block Aligned Offsets
+    void hashedRegionCompare();
+
+    // Area Downscale - Coverage Weighted Mean
+    void areaDownscale();
+    // Area Downscale - Transparent Colors Do Not Bleed
+    void areaDownscaleAlpha();
+
+    // Replication - Matches the Fast Transform Scale Over a Region
+    void replication();
+
+    // Welford Mask - Volatile Pixels Masked, Dilated By Radius
+    void welfordMask();
+
+    // Result Cache - Entries Round Trip, Identity & Content Keys
+    void resultCache();
+
+    // Netpbm Mapping - 8 Bit Files Wrapped, Others Left To the Decoder
+    void netpbmMapping();
+
+private:
+
+    // Write File
+    bool writeFile(const QString& aFilePath, const QByteArray& aData);
+
+    // Temp Dir
+    QTemporaryDir   tempDir;
+};
+
+//==============================================================================
+// Init Test Case
+//==============================================================================
+void ImageCompareTests::initTestCase()
+{
+    // Set Test Mode - Caches Go Under the Test Locations
+    QStandardPaths::setTestModeEnabled(true);
+
+    QVERIFY(tempDir.isValid());
+}
+
+//==============================================================================
+// Write File
+//==============================================================================
+bool ImageCompareTests::writeFile(const QString& aFilePath, const QByteArray& aData)
+{
+    // Init File
+    QFile file(aFilePath);
+
+    return file.open(QIODevice::WriteOnly) && file.write(aData) == aData.size();
+}
+
+//==============================================================================
+// Block Hashes - Equal Images Hash Equal, a Changed Pixel Flags Its Block Only
+//==============================================================================
+void ImageCompareTests::blockHashes()
+{
+    // Init Image - Partial Blocks At the Right & Bottom Edges
+    QImage leftImage(DEFAULT_BLOCK_HASH_SIZE * 3 - 5, DEFAULT_BLOCK_HASH_SIZE * 3 - 7, QImage::Format_ARGB32);
+    leftImage.fill(0xFF336699);
+    // Copy Image
+    QImage rightImage = leftImage.copy();
+
+    // Compute Block Hashes
+    BlockHashGrid leftGrid = computeBlockHashes(leftImage);
+    BlockHashGrid rightGrid = computeBlockHashes(rightImage);
+
+    QCOMPARE(leftGrid.size, QSize(3, 3));
+    QVERIFY(leftGrid.isValidFor(leftImage));
+    QVERIFY(!leftGrid.isValidFor(rightImage));
+    QVERIFY(differingBlocks(leftGrid, rightGrid).isEmpty());
+
+    // Change Pixel In the Middle Bottom Block
+    rightImage.setPixel(DEFAULT_BLOCK_HASH_SIZE + 1, DEFAULT_BLOCK_HASH_SIZE * 2 + 1, 0xFF336698);
+    // Compute Block Hashes
+    rightGrid = computeBlockHashes(rightImage);
+
+    QCOMPARE(differingBlocks(leftGrid, rightGrid), QVector<int>() << 7);
+    QCOMPARE(leftGrid.blockRect(8), QRect(DEFAULT_BLOCK_HASH_SIZE * 2, DEFAULT_BLOCK_HASH_SIZE * 2, DEFAULT_BLOCK_HASH_SIZE - 5, DEFAULT_BLOCK_HASH_SIZE - 7));
+}
+
+//==============================================================================
+// Hashed Region Compare - Equal Hashes Skip Blocks, Also At Block Aligned Offsets
+//==============================================================================
+void ImageCompareTests::hashedRegionCompare()
+{
+    // Init Images - Right Image Shifted By One Block
+    QImage leftImage(DEFAULT_BLOCK_HASH_SIZE * 4, DEFAULT_BLOCK_HASH_SIZE * 4, QImage::Format_ARGB32);
+    QImage rightImage(DEFAULT_BLOCK_HASH_SIZE * 5, DEFAULT_BLOCK_HASH_SIZE * 5, QImage::Format_ARGB32);
+
+    // Go Thru Pixels - Distinct Values, Shifted Copies Only Match When Paired Right
+    for (int y = 0; y < rightImage.height(); y++) {
+        for (int x = 0; x < rightImage.width(); x++) {
+            // Set Right Pixel
+            rightImage.setPixel(x, y, qRgba(x, y, x ^ y, 255));
+
+            // Check Left Pixel
+            if (x >= DEFAULT_BLOCK_HASH_SIZE && y >= DEFAULT_BLOCK_HASH_SIZE) {
+                // Set Left Pixel
+                leftImage.setPixel(x - DEFAULT_BLOCK_HASH_SIZE, y - DEFAULT_BLOCK_HASH_SIZE, qRgba(x, y, x ^ y, 255));
+            }
+        }
+    }
+
+    // Compute Block Hashes
+    BlockHashGrid leftGrid = computeBlockHashes(leftImage);
+    BlockHashGrid rightGrid = computeBlockHashes(rightImage);
+    // Get Right Origin
+    QPoint rightOrigin(DEFAULT_BLOCK_HASH_SIZE, DEFAULT_BLOCK_HASH_SIZE);
+
+    QVERIFY(comparePixelRegions(leftImage, QPoint(0, 0), rightImage, rightOrigin, leftImage.size(), QImage(), &leftGrid, &rightGrid));
+    // Partial Blocks At Both Ends of the Region
+    QVERIFY(comparePixelRegions(leftImage, QPoint(5, 3), rightImage, rightOrigin + QPoint(5, 3), QSize(70, 90), QImage(), &leftGrid, &rightGrid));
+
+    // Change Pixel - Inside a Whole Block Of the Region
+    leftImage.setPixel(DEFAULT_BLOCK_HASH_SIZE * 2 + 3, DEFAULT_BLOCK_HASH_SIZE + 4, 0xFF000000);
+    // Compute Block Hashes
+    leftGrid = computeBlockHashes(leftImage);
+
+    QVERIFY(!comparePixelRegions(leftImage, QPoint(0, 0), rightImage, rightOrigin, leftImage.size(), QImage(), &leftGrid, &rightGrid));
+    // Unhashed Compare Agrees
+    QVERIFY(!comparePixelRegions(leftImage, QPoint(0, 0), rightImage, rightOrigin, leftImage.size()));
+
+    // Init Keep Mask - The Changed Pixel Ignored
+    QImage keepMask(leftImage.size(), QImage::Format_ARGB32);
+    keepMask.fill(0xFFFFFFFF);
+    keepMask.setPixel(DEFAULT_BLOCK_HASH_SIZE * 2 + 3, DEFAULT_BLOCK_HASH_SIZE + 4, 0);
+
+    QVERIFY(comparePixelRegions(leftImage, QPoint(0, 0), rightImage, rightOrigin, leftImage.size(), keepMask, &leftGrid, &rightGrid));
+
+    // Get Changed Block Indices - Left Block & Its Shifted Right Pair
+    int leftIndex = 1 * leftGrid.size.width() + 2;
+    int rightIndex = 2 * rightGrid.size.width() + 3;
+
+    // Forge Right Hash - Equal Hashes Must Skip the Block Without Reading Its Pixels
+    rightGrid.hashes[rightIndex] = leftGrid.hashes[leftIndex];
+
+    QVERIFY(comparePixelRegions(leftImage, QPoint(0, 0), rightImage, rightOrigin, leftImage.size(), QImage(), &leftGrid, &rightGrid));
+    // Partial Blocks Are Never Skipped
+    QVERIFY(!comparePixelRegions(leftImage, QPoint(DEFAULT_BLOCK_HASH_SIZE * 2 + 1, DEFAULT_BLOCK_HASH_SIZE), rightImage, rightOrigin + QPoint(DEFAULT_BLOCK_HASH_SIZE * 2 + 1, DEFAULT_BLOCK_HASH_SIZE),
+                                 QSize(DEFAULT_BLOCK_HASH_SIZE - 1, DEFAULT_BLOCK_HASH_SIZE), QImage(), &leftGrid, &rightGrid));
+
+    // Forge Right Hash At No Offset - Same Block Skipped When Origins Match
+    QImage sameImage = leftImage.copy();
+    // Change Pixel - Alpha Flipped
+    sameImage.setPixel(3, 4, 0xFF000000 ^ sameImage.pixel(3, 4));
+    // Compute Block Hashes
+    BlockHashGrid sameGrid = computeBlockHashes(sameImage);
+    sameGrid.hashes[0] = leftGrid.hashes[0];
+
+    QVERIFY(comparePixelRegions(leftImage, QPoint(0, 0), sameImage, QPoint(0, 0), leftImage.size(), QImage(), &leftGrid, &sameGrid));
+    QVERIFY(!comparePixelRegions(leftImage, QPoint(0, 0), sameImage, QPoint(0, 0), leftImage.size()));
+}
+
+//==============================================================================
+// Area Downscale - Coverage Weighted Mean
+//==============================================================================
+void ImageCompareTests::areaDownscale()
+{
+    // Init Checker - Black & White Opaque Pixels
+    QImage checker(2, 2, QImage::Format_ARGB32);
+    checker.setPixel(0, 0, 0xFF000000);
+    checker.setPixel(1, 0, 0xFFFFFFFF);
+    checker.setPixel(0, 1, 0xFFFFFFFF);
+    checker.setPixel(1, 1, 0xFF000000);
+
+    // Downscale Checker
+    QRgb gray = downscaleImage(checker, QSize(1, 1)).pixel(0, 0);
+
+    QVERIFY(qAbs(qRed(gray) - 128) <= 1);
+    QVERIFY(qAbs(qGreen(gray) - 128) <= 1);
+    QCOMPARE(qAlpha(gray), 255);
+
+    // Init Line Image - One White Column, Fades Instead of Vanishing
+    QImage lineImage(8, 8, QImage::Format_ARGB32);
+    lineImage.fill(0xFF000000);
+
+    // Go Thru Rows
+    for (int y = 0; y < 8; y++) {
+        // Set Line Pixel
+        lineImage.setPixel(1, y, 0xFFFFFFFF);
+    }
+
+    // Downscale Line Image
+    QImage scaled = downscaleImage(lineImage, QSize(2, 2));
+
+    QVERIFY(qAbs(qRed(scaled.pixel(0, 0)) - 64) <= 1);
+    QCOMPARE(qRed(scaled.pixel(1, 1)), 0);
+
+    // Non Integer Factor - Weights Sum To 1
+    QImage white(7, 5, QImage::Format_ARGB32);
+    white.fill(0xFFFFFFFF);
+
+    QCOMPARE(downscaleImage(white, QSize(3, 2)).pixel(2, 1), (QRgb)0xFFFFFFFF);
+}
+
+//==============================================================================
+// Area Downscale - Transparent Colors Do Not Bleed
+//==============================================================================
+void ImageCompareTests::areaDownscaleAlpha()
+{
+    // Init Image - Transparent Green Next To Opaque Red, Wide Enough For the Vector Path
+    QImage image(8, 1, QImage::Format_ARGB32);
+
+    // Go Thru Pixels
+    for (int x = 0; x < 8; x++) {
+        // Set Pixel
+        image.setPixel(x, 0, x < 4 ? 0x0000FF00 : 0xFFFF0000);
+    }
+
+    // Downscale Image
+    QRgb edge = downscaleImage(image, QSize(1, 1)).pixel(0, 0);
+
+    QVERIFY(qAbs(qAlpha(edge) - 128) <= 1);
+    QCOMPARE(qRed(edge), 255);
+    QCOMPARE(qGreen(edge), 0);
+
+    // Downscale Transparent Pixels Only
+    QImage transparent = downscaleImage(image.copy(0, 0, 4, 1), QSize(1, 1));
+
+    QCOMPARE(qAlpha(transparent.pixel(0, 0)), 0);
+}
+
+//==============================================================================
+// Replication - Matches the Fast Transform Scale Over a Region
+//==============================================================================
+void ImageCompareTests::replication()
+{
+    // Init Image - Distinct Pixels
+    QImage image(5, 3, QImage::Format_ARGB32);
+
+    // Go Thru Pixels
+    for (int y = 0; y < image.height(); y++) {
+        for (int x = 0; x < image.width(); x++) {
+            image.setPixel(x, y, qRgba(x * 40, y * 80, 7, 255));
+        }
+    }
+
+    // Go Thru Factors - Compile Time Kernels & the Run Time One
+    foreach (int factor, QList<int>() << 1 << 2 << 3 << 4 << 8) {
+        // Get Scaled Image
+        QImage scaled = image.scaled(image.size() * factor, Qt::IgnoreAspectRatio, Qt::FastTransformation);
+        // Get Region - Partial Blocks At Both Ends
+        QRect region(1, factor > 1 ? 1 : 0, image.width() * factor - 2, image.height() * factor - 1);
+
+        QCOMPARE(replicateImageRegion(image, factor, region), scaled.copy(region));
+    }
+
+    // Region Clipped To the Scaled Image
+    QCOMPARE(replicateImageRegion(image, 2, QRect(8, 4, 10, 10)).size(), QSize(2, 2));
+    // Not 32 Bit
+    QVERIFY(replicateImageRegion(image.convertToFormat(QImage::Format_Grayscale8), 2, QRect(0, 0, 4, 4)).isNull());
+}
+
+//==============================================================================
+// Welford Mask - Volatile Pixels Masked, Dilated By Radius
+//==============================================================================
+void ImageCompareTests::welfordMask()
+{
+    // Init Learner
+    MaskLearner learner;
+
+    // Go Thru Renders - One Pixel Changes, the Rest Is Stable
+    foreach (int value, QList<int>() << 0 << 128 << 255) {
+        // Init Render
+        QImage render(6, 5, QImage::Format_RGB32);
+        render.fill(0xFF808080);
+        render.setPixel(2, 1, qRgb(value, value, value));
+
+        QVERIFY(learner.addImage(render));
+    }
+
+    // Size Mismatch Rejected
+    QVERIFY(!learner.addImage(QImage(3, 3, QImage::Format_RGB32)));
+    QCOMPARE(learner.count(), 3);
+
+    // Init Masked Pixels
+    int maskedPixels = 0;
+    // Get Mask
+    QImage mask = learner.mask(10.0, 0, maskedPixels);
+
+    QCOMPARE(maskedPixels, 1);
+    QCOMPARE(mask.pixel(2, 1), (QRgb)0xFFFFFFFF);
+    QCOMPARE(qAlpha(mask.pixel(0, 0)), 0);
+
+    // Get Dilated Mask - 3 x 3 Around the Pixel
+    mask = learner.mask(10.0, 1, maskedPixels);
+
+    QCOMPARE(maskedPixels, 9);
+    QCOMPARE(mask.pixel(1, 0), (QRgb)0xFFFFFFFF);
+    QCOMPARE(mask.pixel(3, 2), (QRgb)0xFFFFFFFF);
+    QCOMPARE(qAlpha(mask.pixel(4, 1)), 0);
+
+    // Threshold Above the Spread - Nothing Masked
+    learner.mask(200.0, 0, maskedPixels);
+
+    QCOMPARE(maskedPixels, 0);
+}
+
+//==============================================================================
+// Result Cache - Entries Round Trip, Identity & Content Keys
+//==============================================================================
+void ImageCompareTests::resultCache()
+{
+    // Get File Paths
+    QString leftFile = tempDir.filePath("left.bin");
+    QString rightFile = tempDir.filePath("right.bin");
+    QString copyFile = tempDir.filePath("copy.bin");
+
+    QVERIFY(writeFile(leftFile, QByteArray(1000, 'L')));
+    QVERIFY(writeFile(rightFile, QByteArray(1000, 'R')));
+    QVERIFY(writeFile(copyFile, QByteArray(1000, 'L')));
+
+    // Get Result Cache
+    ResultCache* resultCache = ResultCache::getInstance();
+
+    // Get Keys
+    QByteArray identityKey = resultCache->key(leftFile, rightFile, DEFAULT_RESULT_CACHE_MODE_DEEP, 0, QByteArray());
+    QByteArray contentKey = resultCache->key(leftFile, rightFile, DEFAULT_RESULT_CACHE_MODE_DEEP, 0, QByteArray(), true);
+
+    QVERIFY(!identityKey.isEmpty());
+    QVERIFY(!contentKey.isEmpty());
+    QVERIFY(identityKey != contentKey);
+
+    // Copies Share the Content Key Only
+    QCOMPARE(resultCache->key(copyFile, rightFile, DEFAULT_RESULT_CACHE_MODE_DEEP, 0, QByteArray(), true), contentKey);
+    QVERIFY(resultCache->key(copyFile, rightFile, DEFAULT_RESULT_CACHE_MODE_DEEP, 0, QByteArray()) != identityKey);
+    // Mode, Threshold & Mask Version Are Part of the Key
+    QVERIFY(resultCache->key(leftFile, rightFile, DEFAULT_RESULT_CACHE_MODE_EXACT, 0, QByteArray()) != identityKey);
+    QVERIFY(resultCache->key(leftFile, rightFile, DEFAULT_RESULT_CACHE_MODE_DEEP, 1, QByteArray()) != identityKey);
+    QVERIFY(resultCache->key(leftFile, rightFile, DEFAULT_RESULT_CACHE_MODE_DEEP, 0, QByteArray("mask")) != identityKey);
+    // Missing Files Have No Key
+    QVERIFY(resultCache->key(tempDir.filePath("missing.bin"), rightFile, DEFAULT_RESULT_CACHE_MODE_DEEP, 0, QByteArray()).isEmpty());
+
+    // Init Result
+    CachedCompareResult result;
+    result.stats.pixels = 800;
+    result.stats.differingPixels = 3;
+    result.stats.maxDifference = 4097;
+    result.stats.differenceSum = 12345;
+    result.stats.leftDepth = 16;
+    result.stats.rightDepth = 8;
+    result.regions << QRect(1, 2, 3, 4) << QRect(20, 10, 16, 16);
+    result.diffMap.blockSize = 16;
+    result.diffMap.imageSize = QSize(40, 20);
+    result.diffMap.size = QSize(3, 2);
+    result.diffMap.blocks = QByteArray("\x00\x01\x00\x00\x00\x01", 6);
+
+    QVERIFY(resultCache->store(identityKey, result));
+
+    // Lookup Result
+    CachedCompareResult cachedResult;
+
+    QVERIFY(resultCache->lookup(identityKey, cachedResult));
+    QCOMPARE(cachedResult.stats.pixels, result.stats.pixels);
+    QCOMPARE(cachedResult.stats.differingPixels, result.stats.differingPixels);
+    QCOMPARE(cachedResult.stats.maxDifference, result.stats.maxDifference);
+    QCOMPARE(cachedResult.stats.differenceSum, result.stats.differenceSum);
+    QCOMPARE(cachedResult.stats.leftDepth, result.stats.leftDepth);
+    QCOMPARE(cachedResult.stats.rightDepth, result.stats.rightDepth);
+    QCOMPARE(cachedResult.regions, result.regions);
+    QCOMPARE(cachedResult.diffMap.blockSize, result.diffMap.blockSize);
+    QCOMPARE(cachedResult.diffMap.imageSize, result.diffMap.imageSize);
+    QCOMPARE(cachedResult.diffMap.size, result.diffMap.size);
+    QCOMPARE(cachedResult.diffMap.blocks, result.diffMap.blocks);
+
+    // Other Keys Miss
+    QVERIFY(!resultCache->lookup(contentKey, cachedResult));
+
+    // Release Result Cache
+    resultCache->release();
+}
+
+//==============================================================================
+// Netpbm Mapping - 8 Bit Files Wrapped, Others Left To the Decoder
+//==============================================================================
+void ImageCompareTests::netpbmMapping()
+{
+    // Get File Paths
+    QString pixmapFile = tempDir.filePath("pixmap.ppm");
+    QString graymapFile = tempDir.filePath("graymap.pgm");
+    QString arbitraryFile = tempDir.filePath("arbitrary.pam");
+    QString deepFile = tempDir.filePath("deep.ppm");
+    QString truncatedFile = tempDir.filePath("truncated.ppm");
+
+    QVERIFY(writeFile(pixmapFile, QByteArray("P6\n# comment\n2 1\n255\n") + QByteArray("\x10\x20\x30\x40\x50\x60", 6)));
+    QVERIFY(writeFile(graymapFile, QByteArray("P5 2 2 255\n") + QByteArray("\x00\x40\x80\xFF", 4)));
+    QVERIFY(writeFile(arbitraryFile, QByteArray("P7\nWIDTH 1\nHEIGHT 1\nDEPTH 4\nMAXVAL 255\nTUPLTYPE RGB_ALPHA\nENDHDR\n") + QByteArray("\x11\x22\x33\x44", 4)));
+    QVERIFY(writeFile(deepFile, QByteArray("P6\n1 1\n65535\n") + QByteArray(6, 0)));
+    QVERIFY(writeFile(truncatedFile, QByteArray("P6\n4 4\n255\n") + QByteArray(6, 0)));
+
+    // Init Error
+    QString error;
+
+    // Map Pixmap
+    QImage pixmap = mapImageFile(pixmapFile, error);
+
+    QCOMPARE(pixmap.format(), QImage::Format_RGB888);
+    QCOMPARE(pixmap.size(), QSize(2, 1));
+    QCOMPARE(pixmap.pixel(0, 0), qRgb(0x10, 0x20, 0x30));
+    QCOMPARE(pixmap.pixel(1, 0), qRgb(0x40, 0x50, 0x60));
+
+    // Map Graymap
+    QImage graymap = mapImageFile(graymapFile, error);
+
+    QCOMPARE(graymap.format(), QImage::Format_Grayscale8);
+    QCOMPARE(qGray(graymap.pixel(1, 1)), 0xFF);
+    QCOMPARE(qGray(graymap.pixel(1, 0)), 0x40);
+
+    // Map Arbitrary Map
+    QImage arbitrary = mapImageFile(arbitraryFile, error);
+
+    QCOMPARE(arbitrary.format(), QImage::Format_RGBA8888);
+    QCOMPARE(arbitrary.pixel(0, 0), qRgba(0x11, 0x22, 0x33, 0x44));
+
+    // Normalized Copy Matches the Mapped Pixels
+    QCOMPARE(normalizeImage(pixmap, AMTStraight).pixel(1, 0), qRgb(0x40, 0x50, 0x60));
+
+    // 16 Bit & Truncated Files Are Left To the Decoder - No Error, Not Mapped
+    error.clear();
+    QVERIFY(mapImageFile(deepFile, error).isNull());
+    QVERIFY(mapImageFile(truncatedFile, error).isNull());
+    QVERIFY(error.isEmpty());
+
+    // Other Suffixes Are Not Mapped
+    QVERIFY(!isMappedImageFile(tempDir.filePath("image.png")));
+    QVERIFY(mapImageFile(tempDir.filePath("image.png"), error).isNull());
+}
+
+QTEST_MAIN(ImageCompareTests)
+
+#include "tst_imagecompare.moc"